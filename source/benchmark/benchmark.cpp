@@ -0,0 +1,962 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <base/commandline.h>
+#include <base/file.h>
+#include <base/string.h>
+
+#include <graphics/entry.h>
+
+#include "benchmark.h"
+
+static const char* s_workloadName[] =
+{
+	"draw",
+	"transient",
+	"uniform",
+	"dynamic",
+	"texture",
+	"static",
+	"static-batch",
+	"topology",
+	"topology-incremental",
+};
+BASE_STATIC_ASSERT(BASE_COUNTOF(s_workloadName) == Workload::Count);
+
+static const char* s_phaseName[] =
+{
+	"submit",
+	"frame",
+	"swap",
+	"sort",
+	"execCommands",
+	"render",
+};
+BASE_STATIC_ASSERT(BASE_COUNTOF(s_phaseName) == Phase::Count);
+
+struct PosColorVertex
+{
+	float    x, y, z;
+	uint32_t abgr;
+};
+
+static const PosColorVertex s_cubeVertices[] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeIndices[] =
+{
+	0, 1, 2, 1, 3, 2,
+	4, 6, 5, 5, 6, 7,
+	0, 2, 4, 4, 2, 6,
+	1, 5, 3, 5, 7, 3,
+	0, 4, 1, 4, 5, 1,
+	2, 3, 6, 6, 3, 7,
+};
+
+void Benchmark::init(const Settings& _settings)
+{
+	m_settings = _settings;
+	m_workload = Workload::Draw;
+	m_frame    = 0;
+
+	m_layout
+		.begin()
+		.add(graphics::Attrib::Position, 3, graphics::AttribType::Float)
+		.add(graphics::Attrib::Color0,   4, graphics::AttribType::Uint8, true)
+		.end();
+
+	m_vbh = graphics::createVertexBuffer(graphics::makeRef(s_cubeVertices, sizeof(s_cubeVertices) ), m_layout);
+	m_ibh = graphics::createIndexBuffer(graphics::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
+
+	m_program = graphics::createProgram(
+		  createShader(BASE_MAKEFOURCC('V', 'S', 'H', 11), m_settings.numUniforms)
+		, createShader(BASE_MAKEFOURCC('F', 'S', 'H', 11), m_settings.numUniforms)
+		, true
+		);
+
+	m_uniform = graphics::createUniform("u_benchmark", graphics::UniformType::Vec4, uint16_t(m_settings.numUniforms) );
+	m_sampler = graphics::createUniform("s_benchmark", graphics::UniformType::Sampler);
+
+	for (uint32_t ii = 0; ii < BASE_COUNTOF(m_uniformData); ++ii)
+	{
+		m_uniformData[ii] = float(ii);
+	}
+
+	initGrid();
+
+	for (uint32_t ii = 0; ii < m_settings.numViews; ++ii)
+	{
+		graphics::setViewRect(graphics::ViewId(ii), 0, 0, graphics::BackbufferRatio::Equal);
+	}
+
+	for (uint32_t ii = 1; ii < m_settings.numThreads; ++ii)
+	{
+		EncoderThread& et = m_thread[ii];
+		et.m_benchmark = this;
+		et.m_exit      = false;
+		et.m_thread.init(EncoderThread::threadFunc, &et, 0, "graphics-benchmark-encoder");
+	}
+}
+
+void Benchmark::shutdown()
+{
+	for (uint32_t ii = 1; ii < m_settings.numThreads; ++ii)
+	{
+		EncoderThread& et = m_thread[ii];
+		et.m_exit = true;
+		et.m_start.post();
+		et.m_thread.shutdown();
+	}
+
+	graphics::destroy(m_sampler);
+	graphics::destroy(m_uniform);
+	graphics::destroy(m_program);
+	graphics::destroy(m_ibh);
+	graphics::destroy(m_vbh);
+
+	base::free(entry::getAllocator(), m_gridVertices);
+	base::free(entry::getAllocator(), m_gridIndices);
+	base::free(entry::getAllocator(), m_gridSorted);
+	base::free(entry::getAllocator(), m_gridOrder);
+}
+
+// Wavy grid mesh with BENCHMARK_GRID_SIZE^2 vertices, used by topology workloads.
+void Benchmark::initGrid()
+{
+	const uint32_t size    = BENCHMARK_GRID_SIZE;
+	const uint32_t numTris = (size-1)*(size-1)*2;
+
+	m_gridNumIndices = numTris*3;
+	m_gridVertices   = (float*   )base::alloc(entry::getAllocator(), size*size*3*sizeof(float) );
+	m_gridIndices    = (uint32_t*)base::alloc(entry::getAllocator(), m_gridNumIndices*sizeof(uint32_t) );
+	m_gridSorted     = (uint32_t*)base::alloc(entry::getAllocator(), m_gridNumIndices*sizeof(uint32_t) );
+	m_gridOrder      = (uint32_t*)base::alloc(entry::getAllocator(), numTris*sizeof(uint32_t) );
+
+	for (uint32_t yy = 0; yy < size; ++yy)
+	{
+		for (uint32_t xx = 0; xx < size; ++xx)
+		{
+			float* vertex = &m_gridVertices[(yy*size + xx)*3];
+			vertex[0] = float(xx);
+			vertex[1] = base::sin(float(xx)*0.1f) * base::cos(float(yy)*0.1f) * 4.0f;
+			vertex[2] = float(yy);
+		}
+	}
+
+	uint32_t* index = m_gridIndices;
+	for (uint32_t yy = 0; yy < size-1; ++yy)
+	{
+		for (uint32_t xx = 0; xx < size-1; ++xx)
+		{
+			const uint32_t i0 = yy*size + xx;
+			index[0] = i0;
+			index[1] = i0 + size;
+			index[2] = i0 + 1;
+			index[3] = i0 + 1;
+			index[4] = i0 + size;
+			index[5] = i0 + size + 1;
+			index += 6;
+		}
+	}
+}
+
+void Benchmark::sortGrid(uint32_t _frame)
+{
+	// Camera slowly orbiting around grid center.
+	const float angle = float(_frame)*0.002f;
+	const float pos[3] =
+	{
+		BENCHMARK_GRID_SIZE*0.5f + base::cos(angle)*BENCHMARK_GRID_SIZE,
+		32.0f,
+		BENCHMARK_GRID_SIZE*0.5f + base::sin(angle)*BENCHMARK_GRID_SIZE,
+	};
+	const float dir[3] = { 0.0f, 0.0f, 1.0f };
+
+	if (Workload::TopologyIncremental == m_workload)
+	{
+		graphics::topologySortTriList(
+			  graphics::TopologySort::DistanceBackToFrontAvg
+			, m_gridSorted
+			, m_gridNumIndices*sizeof(uint32_t)
+			, dir
+			, pos
+			, m_gridVertices
+			, sizeof(float)*3
+			, m_gridIndices
+			, m_gridNumIndices
+			, true
+			, m_gridOrder
+			);
+	}
+	else
+	{
+		graphics::topologySortTriList(
+			  graphics::TopologySort::DistanceBackToFrontAvg
+			, m_gridSorted
+			, m_gridNumIndices*sizeof(uint32_t)
+			, dir
+			, pos
+			, m_gridVertices
+			, sizeof(float)*3
+			, m_gridIndices
+			, m_gridNumIndices
+			, true
+			);
+	}
+}
+
+uint32_t Benchmark::writeShader(uint8_t* _dst, uint32_t _magic, uint32_t _numUniforms)
+{
+	// Header without uniforms is all that frontend needs to create shader and link program.
+	// Noop renderer never looks at shader code, GL renderer compiles it and finds uniforms
+	// by introspection.
+	char code[1024];
+	const int32_t codeLen = 'V' == (_magic & 0xff)
+		? base::snprintf(code, sizeof(code)
+			, "attribute vec3 a_position;\n"
+			  "attribute vec4 a_color0;\n"
+			  "varying vec4 v_color0;\n"
+			  "uniform mat4 u_modelViewProj;\n"
+			  "uniform vec4 u_benchmark[%d];\n"
+			  "void main()\n"
+			  "{\n"
+			  "\tvec4 color = a_color0;\n"
+			  "\tfor (int ii = 0; ii < %d; ++ii) { color += u_benchmark[ii]*0.0001; }\n"
+			  "\tgl_Position = u_modelViewProj*vec4(a_position, 1.0);\n"
+			  "\tv_color0 = color;\n"
+			  "}\n"
+			, _numUniforms
+			, _numUniforms
+			)
+		: base::snprintf(code, sizeof(code)
+			, "varying vec4 v_color0;\n"
+			  "void main()\n"
+			  "{\n"
+			  "\tgl_FragColor = v_color0;\n"
+			  "}\n"
+			)
+		;
+
+	const uint32_t hash  = 0;
+	const uint16_t count = 0;
+	const uint32_t size  = uint32_t(codeLen);
+	base::memCopy(&_dst[ 0], &_magic, sizeof(_magic) );
+	base::memCopy(&_dst[ 4], &hash,   sizeof(hash)   );
+	base::memCopy(&_dst[ 8], &hash,   sizeof(hash)   );
+	base::memCopy(&_dst[12], &count,  sizeof(count)  );
+	base::memCopy(&_dst[14], &size,   sizeof(size)   );
+	base::memCopy(&_dst[18], code,    codeLen + 1    );
+
+	return uint32_t(18 + codeLen + 1);
+}
+
+graphics::ShaderHandle Benchmark::createShader(uint32_t _magic, uint32_t _numUniforms)
+{
+	uint8_t shader[BENCHMARK_MAX_SHADER_SIZE];
+	const uint32_t size = writeShader(shader, _magic, _numUniforms);
+	return graphics::createShader(graphics::copy(shader, size) );
+}
+
+void Benchmark::createResources()
+{
+	const uint32_t num = m_settings.numResources;
+
+	if (Workload::DynamicBuffer == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			m_dvbh[ii] = graphics::createDynamicVertexBuffer(BASE_COUNTOF(s_cubeVertices), m_layout);
+			graphics::update(m_dvbh[ii], 0, graphics::copy(s_cubeVertices, sizeof(s_cubeVertices) ) );
+		}
+	}
+	else if (Workload::Texture == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const graphics::Memory* mem = graphics::alloc(64*64*4);
+			base::memSet(mem->data, uint8_t(ii), mem->size);
+			m_texture[ii] = graphics::createTexture2D(64, 64, false, 1, graphics::TextureFormat::RGBA8, GRAPHICS_TEXTURE_NONE, mem);
+		}
+	}
+	else if (Workload::Static == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			m_svbh[ii] = graphics::createVertexBuffer(graphics::makeRef(s_cubeVertices, sizeof(s_cubeVertices) ), m_layout);
+			m_sibh[ii] = graphics::createIndexBuffer(graphics::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
+		}
+	}
+	else if (Workload::StaticBatch == m_workload)
+	{
+		graphics::VertexBufferDesc vbDesc[BENCHMARK_MAX_RESOURCES];
+		graphics::IndexBufferDesc  ibDesc[BENCHMARK_MAX_RESOURCES];
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			vbDesc[ii].mem    = graphics::makeRef(s_cubeVertices, sizeof(s_cubeVertices) );
+			vbDesc[ii].layout = &m_layout;
+			vbDesc[ii].flags  = GRAPHICS_BUFFER_NONE;
+
+			ibDesc[ii].mem   = graphics::makeRef(s_cubeIndices, sizeof(s_cubeIndices) );
+			ibDesc[ii].flags = GRAPHICS_BUFFER_NONE;
+		}
+
+		graphics::createVertexBuffers(uint16_t(num), vbDesc, m_svbh);
+		graphics::createIndexBuffers(uint16_t(num), ibDesc, m_sibh);
+	}
+	else if (Workload::Topology            == m_workload
+		 ||  Workload::TopologyIncremental == m_workload)
+	{
+		sortGrid(m_frame);
+	}
+}
+
+void Benchmark::destroyResources()
+{
+	const uint32_t num = m_settings.numResources;
+
+	if (Workload::DynamicBuffer == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			graphics::destroy(m_dvbh[ii]);
+		}
+	}
+	else if (Workload::Texture == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			graphics::destroy(m_texture[ii]);
+		}
+	}
+	else if (Workload::Static == m_workload)
+	{
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			graphics::destroy(m_svbh[ii]);
+			graphics::destroy(m_sibh[ii]);
+		}
+	}
+	else if (Workload::StaticBatch == m_workload)
+	{
+		graphics::destroy(uint16_t(num), m_svbh);
+		graphics::destroy(uint16_t(num), m_sibh);
+	}
+}
+
+void Benchmark::encode(graphics::Encoder* _encoder, uint32_t _begin, uint32_t _end)
+{
+	if (NULL == _encoder)
+	{
+		return;
+	}
+
+	const uint32_t numViews     = m_settings.numViews;
+	const uint32_t numResources = m_settings.numResources;
+
+	float mtx[16];
+
+	for (uint32_t ii = _begin; ii < _end; ++ii)
+	{
+		base::mtxTranslate(mtx, float(ii%64), float( (ii/64)%64), float(ii/4096) );
+		_encoder->setTransform(mtx);
+
+		switch (m_workload)
+		{
+		case Workload::Transient:
+			{
+				graphics::TransientVertexBuffer tvb;
+				graphics::TransientIndexBuffer  tib;
+				if (!_encoder->allocTransientBuffers(&tvb, m_layout, BASE_COUNTOF(s_cubeVertices), &tib, BASE_COUNTOF(s_cubeIndices) ) )
+				{
+					continue;
+				}
+
+				base::memCopy(tvb.data, s_cubeVertices, sizeof(s_cubeVertices) );
+				base::memCopy(tib.data, s_cubeIndices,  sizeof(s_cubeIndices)  );
+				_encoder->setVertexBuffer(0, &tvb);
+				_encoder->setIndexBuffer(&tib);
+			}
+			break;
+
+		case Workload::Uniform:
+			// Window into uniform data shifts every draw, so that renderer sees changed values.
+			_encoder->setUniform(m_uniform, &m_uniformData[(ii%4)*4], uint16_t(m_settings.numUniforms) );
+			_encoder->setVertexBuffer(0, m_vbh);
+			_encoder->setIndexBuffer(m_ibh);
+			break;
+
+		case Workload::DynamicBuffer:
+			_encoder->setVertexBuffer(0, m_dvbh[ii%numResources]);
+			_encoder->setIndexBuffer(m_ibh);
+			break;
+
+		case Workload::Texture:
+			_encoder->setTexture(0, m_sampler, m_texture[ii%numResources]);
+			_encoder->setMaterial(ii%numResources);
+			_encoder->setVertexBuffer(0, m_vbh);
+			_encoder->setIndexBuffer(m_ibh);
+			break;
+
+		case Workload::Static:
+		case Workload::StaticBatch:
+			_encoder->setVertexBuffer(0, m_svbh[ii%numResources]);
+			_encoder->setIndexBuffer(m_sibh[ii%numResources]);
+			break;
+
+		default:
+			_encoder->setVertexBuffer(0, m_vbh);
+			_encoder->setIndexBuffer(m_ibh);
+			break;
+		}
+
+		_encoder->setState(GRAPHICS_STATE_DEFAULT);
+		_encoder->submit(graphics::ViewId(ii%numViews), m_program, ii);
+	}
+}
+
+void Benchmark::run(Workload::Enum _workload, Result& _result)
+{
+	m_workload = _workload;
+
+	_result.workload  = _workload;
+	_result.numFrames = 0;
+	_result.numDraws  = 0;
+	_result.numUniformCalls = 0;
+	_result.numMultiDraws   = 0;
+	_result.numMultiDrawBatches = 0;
+	_result.totalTime = 0;
+
+	for (uint32_t ii = 0; ii < Phase::Count; ++ii)
+	{
+		_result.phase[ii].reset();
+	}
+
+	const uint32_t numThreads = m_settings.numThreads;
+	const uint32_t numDraws   = m_settings.numDraws;
+	const uint32_t perThread  = (numDraws + numThreads - 1)/numThreads;
+
+	m_gridOrder[0] = UINT32_MAX;
+
+	for (uint32_t frame = 0, num = m_settings.numWarmup + m_settings.numFrames; frame < num; ++frame)
+	{
+		const int64_t timeBegin = base::getHPCounter();
+
+		m_frame = frame;
+
+		createResources();
+
+		for (uint32_t ii = 1; ii < numThreads; ++ii)
+		{
+			EncoderThread& et = m_thread[ii];
+			et.m_begin = base::min(ii*perThread,   numDraws);
+			et.m_end   = base::min(et.m_begin+perThread, numDraws);
+			et.m_start.post();
+		}
+
+		encode(graphics::begin(), 0, base::min(perThread, numDraws) );
+
+		for (uint32_t ii = 1; ii < numThreads; ++ii)
+		{
+			m_thread[ii].m_done.wait();
+		}
+
+		destroyResources();
+
+		const int64_t timeSubmit = base::getHPCounter();
+
+		graphics::frame();
+
+		const int64_t timeEnd = base::getHPCounter();
+
+		if (frame < m_settings.numWarmup)
+		{
+			continue;
+		}
+
+		const graphics::Stats* stats = graphics::getStats();
+
+		_result.numFrames++;
+		_result.numDraws  += stats->numDraw;
+		_result.numUniformCalls += stats->numUniformCalls;
+		_result.numMultiDraws   += stats->numMultiDraws;
+		_result.numMultiDrawBatches += stats->numMultiDrawBatches;
+		_result.totalTime += timeEnd - timeBegin;
+
+		PhaseResult* phase = _result.phase;
+		phase[Phase::Submit      ].add(timeSubmit - timeBegin);
+		phase[Phase::Frame       ].add(timeEnd    - timeSubmit);
+		phase[Phase::Swap        ].add(stats->cpuTimeSwap);
+		phase[Phase::Sort        ].add(stats->cpuTimeSort);
+		phase[Phase::ExecCommands].add(stats->cpuTimeExecCommands);
+		phase[Phase::Render      ].add(stats->cpuTimeEnd - stats->cpuTimeBegin);
+	}
+}
+
+int32_t EncoderThread::threadFunc(base::Thread* _thread, void* _userData)
+{
+	BASE_UNUSED(_thread);
+
+	EncoderThread* et = (EncoderThread*)_userData;
+
+	for (;;)
+	{
+		et->m_start.wait();
+
+		if (et->m_exit)
+		{
+			break;
+		}
+
+		graphics::Encoder* encoder = graphics::begin(true);
+		et->m_benchmark->encode(encoder, et->m_begin, et->m_end);
+		graphics::end(encoder);
+
+		et->m_done.post();
+	}
+
+	return base::kExitSuccess;
+}
+
+static void printResult(const Settings& _settings, const Result& _result)
+{
+	const uint32_t numFrames = base::max(_result.numFrames, 1u);
+
+	base::printf("\n%s: %d draws, %d views, %d threads, %d frames\n"
+		, s_workloadName[_result.workload]
+		, _settings.numDraws
+		, _settings.numViews
+		, _settings.numThreads
+		, _result.numFrames
+		);
+
+	base::printf("  %-14s %10s %10s %10s\n", "phase [ms]", "min", "avg", "max");
+
+	for (uint32_t ii = 0; ii < Phase::Count; ++ii)
+	{
+		const PhaseResult& phase = _result.phase[ii];
+		base::printf("  %-14s %10.4f %10.4f %10.4f\n"
+			, s_phaseName[ii]
+			, toMs(phase.min)
+			, toMs(phase.sum)/numFrames
+			, toMs(phase.max)
+			);
+	}
+
+	base::printf("  draws/sec %.0f\n"
+		, double(_result.numDraws)*1000.0/base::max(toMs(_result.totalTime), 0.001)
+		);
+
+	base::printf("  uniform calls/draw %.2f\n"
+		, double(_result.numUniformCalls)/double(base::max<uint64_t>(_result.numDraws, 1) )
+		);
+
+	if (0 != _result.numMultiDrawBatches)
+	{
+		base::printf("  multi-draw %.2f draws/call, %.1f%% draws coalesced\n"
+			, double(_result.numMultiDraws)/double(_result.numMultiDrawBatches)
+			, double(_result.numMultiDraws)*100.0/double(base::max<uint64_t>(_result.numDraws, 1) )
+			);
+	}
+}
+
+static bool writeJson(const char* _filePath, const Settings& _settings, const Result* _result, uint32_t _num)
+{
+	base::FileWriter writer;
+	base::Error err;
+
+	if (!base::open(&writer, _filePath, false, &err) )
+	{
+		return false;
+	}
+
+	base::write(&writer, &err
+		, "{\n"
+		  "\t\"renderer\": \"%s\",\n"
+		  "\t\"draws\": %d,\n"
+		  "\t\"views\": %d,\n"
+		  "\t\"threads\": %d,\n"
+		  "\t\"resources\": %d,\n"
+		  "\t\"uniforms\": %d,\n"
+		  "\t\"results\": [\n"
+		, graphics::getRendererName(graphics::getRendererType() )
+		, _settings.numDraws
+		, _settings.numViews
+		, _settings.numThreads
+		, _settings.numResources
+		, _settings.numUniforms
+		);
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		const Result& result = _result[ii];
+		const uint32_t numFrames = base::max(result.numFrames, 1u);
+
+		base::write(&writer, &err
+			, "\t\t{ \"workload\": \"%s\", \"frames\": %d, \"drawsPerSec\": %.0f, \"uniformCallsPerDraw\": %f"
+			, s_workloadName[result.workload]
+			, result.numFrames
+			, double(result.numDraws)*1000.0/base::max(toMs(result.totalTime), 0.001)
+			, double(result.numUniformCalls)/double(base::max<uint64_t>(result.numDraws, 1) )
+			);
+
+		for (uint32_t jj = 0; jj < Phase::Count; ++jj)
+		{
+			const PhaseResult& phase = result.phase[jj];
+			base::write(&writer, &err
+				, ", \"%s\": { \"min\": %f, \"avg\": %f, \"max\": %f }"
+				, s_phaseName[jj]
+				, toMs(phase.min)
+				, toMs(phase.sum)/numFrames
+				, toMs(phase.max)
+				);
+		}
+
+		base::write(&writer, &err, " }%s\n", ii+1 < _num ? "," : "");
+	}
+
+	base::write(&writer, &err, "\t]\n}\n");
+
+	base::close(&writer);
+
+	return err.isOk();
+}
+
+static void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		base::printf("Error:\n%s\n\n", _error);
+	}
+
+	base::printf(
+		"graphics-benchmark, headless CPU benchmark running on noop renderer.\n"
+		"Copyright 2011-2023 Branimir Karadzic. All rights reserved.\n"
+		"License: https://github.com/bkaradzic/graphics/blob/master/LICENSE\n\n"
+		);
+
+	base::printf(
+		"Usage: graphics-benchmark [options]\n"
+
+		"\n"
+		"Options:\n"
+		"  -h, --help                    Display this help and exit.\n"
+		"  -w, --workload <name>         Workload to run. Default is all.\n"
+		"           draw                 Static vertex and index buffers.\n"
+		"           transient            Transient vertex and index buffers allocated per draw.\n"
+		"           uniform              Uniform array set per draw.\n"
+		"           dynamic              Dynamic vertex buffers created and destroyed every frame.\n"
+		"           texture              Textures created and destroyed every frame.\n"
+		"           static               Static buffers created and destroyed every frame, one call each.\n"
+		"           static-batch         Static buffers created and destroyed every frame, in batches.\n"
+		"           topology             Large mesh triangles sorted every frame from scratch.\n"
+		"           topology-incremental Large mesh triangles sorted every frame, reusing previous order.\n"
+		"           all                  Run all workloads.\n"
+		"           none                 Run no workload, only modes selected with other options.\n"
+		"  -f, --frames <num>            Number of measured frames. Default is 256.\n"
+		"      --warmup <num>            Number of frames before measurement starts. Default is 16.\n"
+		"  -n, --draws <num>             Number of draw calls per frame. Default is 10000.\n"
+		"  -v, --views <num>             Number of views draw calls are spread across. Default is 4.\n"
+		"  -t, --threads <num>           Number of encoder threads. Default is 1.\n"
+		"      --resources <num>         Number of resources churned per frame. Default is 64.\n"
+		"      --uniforms <num>          Number of vec4 uniforms set per draw. Default is 16.\n"
+		"      --renderer <name>         Renderer to run on, noop or gl. Default is noop.\n"
+		"      --no-ubo                  Disable uniform buffer path (GRAPHICS_CONFIG_UNIFORM_BUFFER), set uniforms with glUniform* calls.\n"
+		"      --headless                Initialize renderer without window and back buffer. With gl renderer\n"
+		"                                on EGL, context is created on surfaceless or device platform.\n"
+		"      --json <file path>        Write results as JSON.\n"
+		"      --stream <size>           Compare full and streamed load of <size>^2 texture.\n"
+		"      --stream-budget <bytes>   Bytes streamed per frame. Default is 1MiB.\n"
+		"      --ktx2 <num>              Compare parsing <num> uncompressed and supercompressed KTX2 textures.\n"
+		"      --zlib-check <size>       Check zlib and supercompressed KTX2 round trip of <size> bytes.\n"
+		"      --input <num>             Compare polled and event driven input bindings over <num> frames.\n"
+		"      --events <num>            Post <num> events from producer thread and poll them on main thread.\n"
+		"      --offscreen <num>         Compare serial and pipelined read back of <num> frame buffers.\n"
+		"      --offscreen-size <size>   Offscreen frame buffer size. Default is 128.\n"
+		"      --shader-pack <num>       Compare loading <num> shader pairs from files and from shader pack.\n"
+		"      --debugdraw <size>        Compare debug draw overlay of <size> grid drawn every frame and from display list.\n"
+		"      --transient <num>         Allocate <num> transient buffers per frame from 1, 2, 4 and 8 threads.\n"
+		"      --latency                 Report frame, sort, and render thread time at 1K to 64K draws.\n"
+		"      --sort <num>              Compare narrow and wide sort of <num> render item keys, 65535 for 64K draws.\n"
+		"      --topology-check <num>    Compare SIMD and scalar triangle sort keys of <num> random triangles.\n"
+		"      --bc <num>                Compare reference and optimized BC1-BC5, BC7 decoders on <num> random blocks.\n"
+		);
+}
+
+int _main_(int _argc, char** _argv)
+{
+	base::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return base::kExitSuccess;
+	}
+
+	Settings settings;
+	settings.numFrames    = 256;
+	settings.numWarmup    = 16;
+	settings.numDraws     = 10000;
+	settings.numViews     = 4;
+	settings.numThreads   = 1;
+	settings.numResources = 64;
+	settings.numUniforms  = 16;
+
+	cmdLine.hasArg(settings.numFrames,    'f', "frames");
+	cmdLine.hasArg(settings.numWarmup,    '\0', "warmup");
+	cmdLine.hasArg(settings.numDraws,     'n', "draws");
+	cmdLine.hasArg(settings.numViews,     'v', "views");
+	cmdLine.hasArg(settings.numThreads,   't', "threads");
+	cmdLine.hasArg(settings.numResources, '\0', "resources");
+	cmdLine.hasArg(settings.numUniforms,  '\0', "uniforms");
+
+	settings.numThreads   = base::clamp<uint32_t>(settings.numThreads,   1, BENCHMARK_MAX_THREADS);
+	settings.numResources = base::clamp<uint32_t>(settings.numResources, 1, BENCHMARK_MAX_RESOURCES);
+	settings.numUniforms  = base::clamp<uint32_t>(settings.numUniforms,  1, BENCHMARK_MAX_UNIFORMS);
+
+	uint32_t workloadBegin = 0;
+	uint32_t workloadEnd   = Workload::Count;
+
+	const char* workload = cmdLine.findOption('w', "workload");
+	if (NULL != workload
+	&&  0 == base::strCmp(workload, "none") )
+	{
+		workloadEnd = 0;
+	}
+	else if (NULL != workload
+	&&  0 != base::strCmp(workload, "all") )
+	{
+		for (workloadBegin = 0; workloadBegin < Workload::Count; ++workloadBegin)
+		{
+			if (0 == base::strCmp(workload, s_workloadName[workloadBegin]) )
+			{
+				break;
+			}
+		}
+
+		if (Workload::Count == workloadBegin)
+		{
+			help("Unknown workload.");
+			return base::kExitFailure;
+		}
+
+		workloadEnd = workloadBegin + 1;
+	}
+
+	graphics::Init init;
+	init.type = graphics::RendererType::Noop;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	init.resolution.reset  = GRAPHICS_RESET_NONE;
+	init.limits.maxEncoders = uint16_t(settings.numThreads + 1);
+
+	uint32_t numTransient = 0;
+	if (cmdLine.hasArg(numTransient, '\0', "transient")
+	&&  0 != numTransient)
+	{
+		// Contention sweep runs up to 8 encoders at once.
+		init.limits.maxEncoders = uint16_t(base::max<uint32_t>(settings.numThreads + 1, 8) );
+	}
+
+	const bool headless = cmdLine.hasArg("headless");
+
+	const char* renderer = cmdLine.findOption("renderer");
+	if (NULL != renderer
+	&&  0 == base::strCmp(renderer, "gl") )
+	{
+		// Uniform calls per draw are reported by GL renderer, run with LIBGL_ALWAYS_SOFTWARE=1 to
+		// measure on Mesa software driver.
+		init.type = graphics::RendererType::OpenGL;
+
+		if (!headless)
+		{
+			init.platformData.nwh = entry::getNativeWindowHandle(entry::kDefaultWindowHandle);
+			init.platformData.ndt = entry::getNativeDisplayHandle();
+		}
+	}
+
+	if (headless)
+	{
+		// There is no back buffer in headless mode, views drawing to it are discarded.
+		init.resolution.width  = 0;
+		init.resolution.height = 0;
+	}
+
+	if (cmdLine.hasArg("no-ubo") )
+	{
+		init.capabilities &= ~GRAPHICS_CAPS_UNIFORM_BUFFER;
+	}
+
+	if (!graphics::init(init) )
+	{
+		base::printf("Failed to initialize %s renderer.\n", NULL != renderer ? renderer : "noop");
+		return base::kExitFailure;
+	}
+
+	// Encoder threads are limited by GRAPHICS_CONFIG_MULTITHREADED and maxEncoders.
+	const graphics::Caps* caps = graphics::getCaps();
+	settings.numThreads = base::min<uint32_t>(settings.numThreads, caps->limits.maxEncoders);
+	settings.numViews   = base::clamp<uint32_t>(settings.numViews, 1, caps->limits.maxViews);
+
+	Benchmark* benchmark = BASE_NEW(entry::getAllocator(), Benchmark);
+	benchmark->init(settings);
+
+	Result result[Workload::Count];
+	uint32_t numResults = 0;
+
+	for (uint32_t ii = workloadBegin; ii < workloadEnd; ++ii)
+	{
+		benchmark->run(Workload::Enum(ii), result[numResults]);
+		printResult(settings, result[numResults]);
+		++numResults;
+	}
+
+	int32_t exitCode = base::kExitSuccess;
+
+	const char* jsonFilePath = cmdLine.findOption("json");
+	if (NULL != jsonFilePath
+	&&  !writeJson(jsonFilePath, settings, result, numResults) )
+	{
+		base::printf("Failed to write '%s'.\n", jsonFilePath);
+		exitCode = base::kExitFailure;
+	}
+
+	uint32_t streamSize = 0;
+	if (cmdLine.hasArg(streamSize, '\0', "stream")
+	&&  0 != streamSize)
+	{
+		uint32_t streamBudget = 1<<20;
+		cmdLine.hasArg(streamBudget, '\0', "stream-budget");
+
+		if (!runStream(base::min<uint32_t>(streamSize, caps->limits.maxTextureSize), streamBudget) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numKtx2 = 0;
+	if (cmdLine.hasArg(numKtx2, '\0', "ktx2")
+	&&  0 != numKtx2)
+	{
+		runKtx2(numKtx2, 2048);
+	}
+
+	uint32_t zlibCheckSize = 0;
+	if (cmdLine.hasArg(zlibCheckSize, '\0', "zlib-check")
+	&&  0 != zlibCheckSize)
+	{
+		if (!runZlibCheck(zlibCheckSize) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numInputFrames = 0;
+	if (cmdLine.hasArg(numInputFrames, '\0', "input")
+	&&  0 != numInputFrames)
+	{
+		runInput(numInputFrames);
+	}
+
+	uint32_t numEvents = 0;
+	if (cmdLine.hasArg(numEvents, '\0', "events")
+	&&  0 != numEvents)
+	{
+		if (!runEvents(numEvents) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numOffscreen = 0;
+	if (cmdLine.hasArg(numOffscreen, '\0', "offscreen")
+	&&  0 != numOffscreen)
+	{
+		uint32_t offscreenSize = 128;
+		cmdLine.hasArg(offscreenSize, '\0', "offscreen-size");
+
+		if (!runOffscreen(*benchmark, numOffscreen, base::clamp<uint32_t>(offscreenSize, 1, caps->limits.maxTextureSize), settings.numFrames) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numShaders = 0;
+	if (cmdLine.hasArg(numShaders, '\0', "shader-pack")
+	&&  0 != numShaders)
+	{
+		if (!runShaderPack(base::min<uint32_t>(numShaders, BENCHMARK_MAX_SHADERS) ) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t debugDrawSize = 0;
+	if (cmdLine.hasArg(debugDrawSize, '\0', "debugdraw")
+	&&  0 != debugDrawSize)
+	{
+		runDebugDraw(debugDrawSize, settings.numFrames);
+	}
+
+	if (0 != numTransient)
+	{
+		if (!runTransientContention(numTransient, settings.numFrames) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	if (cmdLine.hasArg("latency") )
+	{
+		runLatency(*benchmark, settings.numFrames);
+	}
+
+	uint32_t numSortKeys = 0;
+	if (cmdLine.hasArg(numSortKeys, '\0', "sort")
+	&&  0 != numSortKeys)
+	{
+		if (!runSort(numSortKeys, settings.numFrames) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numTopologyCheck = 0;
+	if (cmdLine.hasArg(numTopologyCheck, '\0', "topology-check")
+	&&  0 != numTopologyCheck)
+	{
+		if (!runTopologyCheck(numTopologyCheck) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	uint32_t numBlocks = 0;
+	if (cmdLine.hasArg(numBlocks, '\0', "bc")
+	&&  0 != numBlocks)
+	{
+		if (!runBlockDecode(numBlocks) )
+		{
+			exitCode = base::kExitFailure;
+		}
+	}
+
+	benchmark->shutdown();
+	base::deleteObject(entry::getAllocator(), benchmark);
+
+	graphics::frame();
+	graphics::shutdown();
+
+	return exitCode;
+}
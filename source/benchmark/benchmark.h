@@ -0,0 +1,211 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#ifndef GRAPHICS_BENCHMARK_H_HEADER_GUARD
+#define GRAPHICS_BENCHMARK_H_HEADER_GUARD
+
+#include <base/allocator.h>
+#include <base/math.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <base/timer.h>
+
+#include <graphics/graphics.h>
+
+#include "../src/entry_p.h"
+
+#define BENCHMARK_MAX_THREADS   16
+#define BENCHMARK_MAX_RESOURCES 1024
+#define BENCHMARK_MAX_UNIFORMS  256
+#define BENCHMARK_GRID_SIZE     256
+#define BENCHMARK_MAX_SHADERS    256
+#define BENCHMARK_MAX_SHADER_SIZE (1024+32)
+
+struct Workload
+{
+	enum Enum
+	{
+		Draw,                //!< Static vertex/index buffers.
+		Transient,           //!< Transient vertex/index buffers allocated per draw.
+		Uniform,             //!< Vec4 uniform array set per draw.
+		DynamicBuffer,       //!< Dynamic vertex buffers created, updated, and destroyed every frame.
+		Texture,             //!< Textures created and destroyed every frame.
+		Static,              //!< Static vertex/index buffers created and destroyed every frame, one call per buffer.
+		StaticBatch,         //!< Static vertex/index buffers created and destroyed every frame, in batches.
+		Topology,            //!< Large mesh triangles sorted every frame from scratch.
+		TopologyIncremental, //!< Large mesh triangles sorted every frame, reusing previous order.
+
+		Count
+	};
+};
+
+struct Phase
+{
+	enum Enum
+	{
+		Submit,       //!< API thread encoding, including resource churn.
+		Frame,        //!< API thread time spent in `graphics::frame`.
+		Swap,         //!< `Stats::cpuTimeSwap`.
+		Sort,         //!< `Stats::cpuTimeSort`.
+		ExecCommands, //!< `Stats::cpuTimeExecCommands`.
+		Render,       //!< `Stats::cpuTimeEnd - Stats::cpuTimeBegin`.
+
+		Count
+	};
+};
+
+struct Settings
+{
+	uint32_t numFrames;
+	uint32_t numWarmup;
+	uint32_t numDraws;
+	uint32_t numViews;
+	uint32_t numThreads;
+	uint32_t numResources;
+	uint32_t numUniforms;
+};
+
+struct PhaseResult
+{
+	void reset()
+	{
+		min = INT64_MAX;
+		max = 0;
+		sum = 0;
+	}
+
+	void add(int64_t _time)
+	{
+		min  = base::min(min, _time);
+		max  = base::max(max, _time);
+		sum += _time;
+	}
+
+	int64_t min;
+	int64_t max;
+	int64_t sum;
+};
+
+struct Result
+{
+	Workload::Enum workload;
+	uint32_t numFrames;
+	uint64_t numDraws;
+	uint64_t numUniformCalls;
+	uint64_t numMultiDraws;
+	uint64_t numMultiDrawBatches;
+	int64_t  totalTime;
+	PhaseResult phase[Phase::Count];
+};
+
+struct Benchmark;
+
+struct EncoderThread
+{
+	static int32_t threadFunc(base::Thread* _thread, void* _userData);
+
+	base::Thread    m_thread;
+	base::Semaphore m_start;
+	base::Semaphore m_done;
+	Benchmark*      m_benchmark;
+	uint32_t        m_begin;
+	uint32_t        m_end;
+	bool            m_exit;
+};
+
+struct Benchmark
+{
+	void init(const Settings& _settings);
+
+	void shutdown();
+
+	void initGrid();
+
+	void sortGrid(uint32_t _frame);
+
+	static uint32_t writeShader(uint8_t* _dst, uint32_t _magic, uint32_t _numUniforms);
+
+	static graphics::ShaderHandle createShader(uint32_t _magic, uint32_t _numUniforms);
+
+	void createResources();
+
+	void destroyResources();
+
+	void encode(graphics::Encoder* _encoder, uint32_t _begin, uint32_t _end);
+
+	void run(Workload::Enum _workload, Result& _result);
+
+	Settings m_settings;
+	Workload::Enum m_workload;
+	uint32_t m_frame;
+
+	float*    m_gridVertices;
+	uint32_t* m_gridIndices;
+	uint32_t* m_gridSorted;
+	uint32_t* m_gridOrder;
+	uint32_t  m_gridNumIndices;
+
+	graphics::VertexLayout m_layout;
+	graphics::VertexBufferHandle m_vbh;
+	graphics::IndexBufferHandle  m_ibh;
+	graphics::ProgramHandle m_program;
+	graphics::UniformHandle m_uniform;
+	graphics::UniformHandle m_sampler;
+
+	graphics::DynamicVertexBufferHandle m_dvbh[BENCHMARK_MAX_RESOURCES];
+	graphics::TextureHandle m_texture[BENCHMARK_MAX_RESOURCES];
+	graphics::VertexBufferHandle m_svbh[BENCHMARK_MAX_RESOURCES];
+	graphics::IndexBufferHandle  m_sibh[BENCHMARK_MAX_RESOURCES];
+
+	float m_uniformData[(BENCHMARK_MAX_UNIFORMS+4)*4];
+
+	EncoderThread m_thread[BENCHMARK_MAX_THREADS];
+};
+
+inline double toMs(int64_t _time)
+{
+	return double(_time)*1000.0/double(base::getHPFrequency() );
+}
+
+/// Compares full and streamed load of <_size>^2 texture.
+bool runStream(uint32_t _size, uint32_t _budget);
+
+/// Compares parsing <_num> uncompressed and supercompressed KTX2 textures.
+void runKtx2(uint32_t _num, uint32_t _size);
+
+/// Checks zlib and supercompressed KTX2 round trip of <_size> bytes.
+bool runZlibCheck(uint32_t _size);
+
+/// Compares reference and optimized block decoders on <_num> random blocks.
+bool runBlockDecode(uint32_t _num);
+
+/// Compares loading <_num> shader pairs from files and from shader pack.
+bool runShaderPack(uint32_t _num);
+
+/// Compares debug draw overlay drawn every frame and from display list.
+void runDebugDraw(uint32_t _size, uint32_t _numFrames);
+
+/// Compares polled and event driven input bindings over <_numFrames> frames.
+void runInput(uint32_t _numFrames);
+
+/// Posts <_num> events from producer thread and polls them on main thread.
+bool runEvents(uint32_t _num);
+
+/// Allocates <_num> transient buffers per frame from 1, 2, 4 and 8 encoder threads.
+bool runTransientContention(uint32_t _num, uint32_t _numFrames);
+
+/// Reports API thread frame, sort, and render thread time at 1K to 64K draws per frame.
+void runLatency(Benchmark& _benchmark, uint32_t _numFrames);
+
+/// Compares narrow and wide (GRAPHICS_CONFIG_SORT_KEY_WIDE) sort of <_num> render item keys.
+bool runSort(uint32_t _num, uint32_t _numFrames);
+
+/// Compares SIMD and scalar triangle sort keys of <_num> random triangles.
+bool runTopologyCheck(uint32_t _num);
+
+/// Compares serial and pipelined read back of <_num> frame buffers.
+bool runOffscreen(const Benchmark& _benchmark, uint32_t _num, uint32_t _size, uint32_t _numFrames);
+
+#endif // GRAPHICS_BENCHMARK_H_HEADER_GUARD
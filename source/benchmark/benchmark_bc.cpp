@@ -0,0 +1,104 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <bimg/bimg.h>
+
+#include "benchmark.h"
+
+// Compares reference and optimized block decoders on random blocks. Output of both must be
+// identical, any mismatch fails benchmark.
+bool runBlockDecode(uint32_t _num)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	const struct
+	{
+		bimg::TextureFormat::Enum format;
+		uint32_t blockSize;
+		const char* name;
+
+	} formats[] =
+	{
+		{ bimg::TextureFormat::BC1,  8, "BC1" },
+		{ bimg::TextureFormat::BC2, 16, "BC2" },
+		{ bimg::TextureFormat::BC3, 16, "BC3" },
+		{ bimg::TextureFormat::BC4,  8, "BC4" },
+		{ bimg::TextureFormat::BC5, 16, "BC5" },
+		{ bimg::TextureFormat::BC7, 16, "BC7" },
+	};
+
+	uint8_t* blocks = (uint8_t*)base::alloc(allocator, _num*16);
+	uint8_t* texels = (uint8_t*)base::alloc(allocator, _num*16*4*2);
+	uint8_t* ref = &texels[0];
+	uint8_t* opt = &texels[_num*16*4];
+
+	base::printf("\nbc: %d random blocks\n", _num);
+	base::printf("  %-6s %14s %14s %10s\n", "", "ref [MTex/s]", "opt [MTex/s]", "mismatch");
+
+	bool result = true;
+
+	for (uint32_t ii = 0; ii < BASE_COUNTOF(formats); ++ii)
+	{
+		const uint32_t blockSize = formats[ii].blockSize;
+
+		uint32_t seed = 1;
+		for (uint32_t jj = 0; jj < _num*blockSize; ++jj)
+		{
+			seed = seed*1664525 + 1013904223;
+			blocks[jj] = uint8_t(seed >> 24);
+		}
+
+		if (bimg::TextureFormat::BC7 == formats[ii].format)
+		{
+			// Spread blocks evenly across all modes, and reserved mode.
+			for (uint32_t jj = 0; jj < _num; ++jj)
+			{
+				const uint32_t mode = jj%9;
+				uint8_t& bits = blocks[jj*16];
+				bits = 8 == mode ? 0 : uint8_t( (bits & ~( (1<<mode)-1) ) | (1<<mode) );
+			}
+		}
+
+		// BC4 and BC5 don't write all channels.
+		base::memSet(texels, 0, _num*16*4*2);
+
+		int64_t time[2];
+
+		for (uint32_t kk = 0; kk < 2; ++kk)
+		{
+			uint8_t* dst = 0 == kk ? ref : opt;
+
+			const int64_t timeBegin = base::getHPCounter();
+
+			for (uint32_t jj = 0; jj < _num; ++jj)
+			{
+				bimg::imageDecodeBlockToBgra8(&dst[jj*16*4], &blocks[jj*blockSize], formats[ii].format, 0 == kk);
+			}
+
+			time[kk] = base::getHPCounter() - timeBegin;
+		}
+
+		uint32_t numMismatch = 0;
+		for (uint32_t jj = 0; jj < _num; ++jj)
+		{
+			numMismatch += 0 != base::memCmp(&ref[jj*16*4], &opt[jj*16*4], 16*4);
+		}
+
+		result &= 0 == numMismatch;
+
+		const double numTexels = double(_num)*16.0;
+		base::printf("  %-6s %14.2f %14.2f %10d\n"
+			, formats[ii].name
+			, numTexels/toMs(time[0])/1000.0
+			, numTexels/toMs(time[1])/1000.0
+			, numMismatch
+			);
+	}
+
+	base::free(allocator, texels);
+	base::free(allocator, blocks);
+
+	return result;
+}
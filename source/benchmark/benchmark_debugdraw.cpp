@@ -0,0 +1,139 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "../src/debugdraw/debugdraw.h"
+#include "benchmark.h"
+
+// Static overlay, grid of lines and height field triangle mesh standing in for navigation mesh.
+static void drawOverlay(DebugDrawEncoder& _dde, uint32_t _size, const DdVertex* _vertices, uint32_t _numVertices, const uint16_t* _indices, uint32_t _numIndices)
+{
+	_dde.push();
+		_dde.setColor(0xff808080);
+		_dde.drawGrid(graphics::Axis::Y, { 0.0f, 0.0f, 0.0f }, _size);
+	_dde.pop();
+
+	_dde.push();
+		_dde.setColor(0x8000ff00);
+		_dde.setWireframe(true);
+		_dde.drawTriList(_numVertices, _vertices, _numIndices, _indices);
+	_dde.pop();
+}
+
+// Compares debug draw overlay drawn every frame against the same overlay recorded once into
+// display list. Transient buffer usage is read from stats of last frame.
+void runDebugDraw(uint32_t _size, uint32_t _numFrames)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	const uint32_t meshSize    = base::min<uint32_t>(_size, 128);
+	const uint32_t numVertices = (meshSize+1)*(meshSize+1);
+	const uint32_t numIndices  = meshSize*meshSize*6;
+
+	DdVertex* vertices = (DdVertex*)base::alloc(allocator, numVertices*sizeof(DdVertex) );
+	uint16_t* indices  = (uint16_t*)base::alloc(allocator, numIndices*sizeof(uint16_t) );
+
+	for (uint32_t yy = 0; yy <= meshSize; ++yy)
+	{
+		for (uint32_t xx = 0; xx <= meshSize; ++xx)
+		{
+			DdVertex& vertex = vertices[yy*(meshSize+1) + xx];
+			vertex.x = float(xx) - float(meshSize/2);
+			vertex.y = base::sin(float(xx)*0.3f) * base::cos(float(yy)*0.3f);
+			vertex.z = float(yy) - float(meshSize/2);
+		}
+	}
+
+	for (uint32_t yy = 0, idx = 0; yy < meshSize; ++yy)
+	{
+		for (uint32_t xx = 0; xx < meshSize; ++xx)
+		{
+			const uint16_t v0 = uint16_t(yy*(meshSize+1) + xx);
+			const uint16_t v1 = uint16_t(v0 + meshSize+1);
+			indices[idx++] = v0;
+			indices[idx++] = v1;
+			indices[idx++] = v0+1;
+			indices[idx++] = v0+1;
+			indices[idx++] = v1;
+			indices[idx++] = v1+1;
+		}
+	}
+
+	ddInit(allocator);
+
+	DebugDrawEncoder* dde = BASE_NEW(allocator, DebugDrawEncoder);
+
+	float view[16];
+	float proj[16];
+	base::mtxLookAt(view, { 0.0f, float(_size), -float(_size) }, { 0.0f, 0.0f, 0.0f });
+	base::mtxProj(proj, 60.0f, 1.0f, 0.1f, 10000.0f, graphics::getCaps()->homogeneousDepth);
+	graphics::setViewTransform(0, view, proj);
+
+	int64_t frameTime[2];
+	uint32_t transientSize[2];
+
+	for (uint32_t ii = 0; ii < 2; ++ii)
+	{
+		DdDisplayListHandle displayList = GRAPHICS_INVALID_HANDLE;
+
+		if (1 == ii)
+		{
+			dde->begin(0);
+			dde->beginDisplayList();
+			drawOverlay(*dde, _size, vertices, numVertices, indices, numIndices);
+			displayList = dde->endDisplayList();
+			dde->end();
+
+			graphics::frame();
+		}
+
+		const int64_t timeBegin = base::getHPCounter();
+
+		for (uint32_t frame = 0; frame < _numFrames; ++frame)
+		{
+			float mtx[16];
+			base::mtxRotateY(mtx, float(frame)*0.01f);
+
+			dde->begin(0);
+
+			if (isValid(displayList) )
+			{
+				dde->drawDisplayList(displayList, mtx);
+			}
+			else
+			{
+				dde->pushTransform(mtx);
+				drawOverlay(*dde, _size, vertices, numVertices, indices, numIndices);
+				dde->popTransform();
+			}
+
+			dde->end();
+
+			graphics::frame();
+		}
+
+		frameTime[ii] = base::getHPCounter() - timeBegin;
+
+		const graphics::Stats* stats = graphics::getStats();
+		transientSize[ii] = stats->transientVbUsed + stats->transientIbUsed;
+
+		if (isValid(displayList) )
+		{
+			ddDestroy(displayList);
+		}
+	}
+
+	base::deleteObject(allocator, dde);
+	ddShutdown();
+
+	graphics::frame();
+
+	base::free(allocator, indices);
+	base::free(allocator, vertices);
+
+	base::printf("\ndebugdraw: %dx%d grid, %dx%d wireframe mesh, %d frames\n", _size, _size, meshSize, meshSize, _numFrames);
+	base::printf("  %-14s %14s %10s\n", "", "upload [KiB/f]", "frame [ms]");
+	base::printf("  %-14s %14.1f %10.4f\n", "immediate",    transientSize[0]/1024.0, toMs(frameTime[0])/base::max(_numFrames, 1u) );
+	base::printf("  %-14s %14.1f %10.4f\n", "display list", transientSize[1]/1024.0, toMs(frameTime[1])/base::max(_numFrames, 1u) );
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <base/string.h>
+
+#include <graphics/cmd.h>
+#include <graphics/input.h>
+
+#include "benchmark.h"
+
+#define BENCHMARK_INPUT_TABLES   16
+#define BENCHMARK_INPUT_BINDINGS 64
+
+static uint32_t s_inputCounter;
+
+static void inputCounterFn(const void* /*_userData*/)
+{
+	++s_inputCounter;
+}
+
+static int cmdInputCounter(CmdContext* /*_context*/, void* /*_userData*/, int _argc, char const* const* /*_argv*/)
+{
+	s_inputCounter += uint32_t(_argc);
+	return base::kExitSuccess;
+}
+
+void runInput(uint32_t _numFrames)
+{
+	// Many binding tables, as when several tools layer their own bindings, half of them
+	// console commands. Bindings are spread across keys and modifiers, so that every key
+	// event hits only few of them. Modifiers are not used by default entry bindings.
+	static const uint8_t s_modifiers[] =
+	{
+		entry::Modifier::LeftAlt,
+		entry::Modifier::RightShift,
+		entry::Modifier::LeftMeta,
+		entry::Modifier::RightMeta,
+	};
+
+	static InputBinding s_inputBindings[BENCHMARK_INPUT_TABLES][BENCHMARK_INPUT_BINDINGS+1];
+	char name[BENCHMARK_INPUT_TABLES][32];
+
+	for (uint32_t ii = 0; ii < BENCHMARK_INPUT_TABLES; ++ii)
+	{
+		for (uint32_t jj = 0; jj < BENCHMARK_INPUT_BINDINGS; ++jj)
+		{
+			const uint32_t idx = ii*BENCHMARK_INPUT_BINDINGS + jj;
+			const entry::Key::Enum key = entry::Key::Enum(1 + idx%(entry::Key::Count-1) );
+			const uint8_t modifiers = s_modifiers[(idx/(entry::Key::Count-1) )%BASE_COUNTOF(s_modifiers)];
+
+			if (0 == (jj & 1) )
+			{
+				s_inputBindings[ii][jj].set(key, modifiers, 1, inputCounterFn);
+			}
+			else
+			{
+				s_inputBindings[ii][jj].set(key, modifiers, 1, NULL, "benchmark-input 1 2 3");
+			}
+		}
+
+		s_inputBindings[ii][BENCHMARK_INPUT_BINDINGS].end();
+
+		base::snprintf(name[ii], BASE_COUNTOF(name[ii]), "benchmark-%d", ii);
+	}
+
+	cmdAdd("benchmark-input", cmdInputCounter);
+
+	// Polling reference, walks every table and checks every key each frame, and executes
+	// command strings.
+	bool once[entry::Key::Count];
+	base::memSet(once, 0xff, sizeof(once) );
+
+	int64_t time[2] = { 0, 0 };
+	uint32_t count[2];
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		s_inputCounter = 0;
+
+		if (1 == pass)
+		{
+			for (uint32_t ii = 0; ii < BENCHMARK_INPUT_TABLES; ++ii)
+			{
+				inputAddBindings(name[ii], s_inputBindings[ii]);
+			}
+
+			// Bindings are compiled on first process.
+			inputProcess();
+			s_inputCounter = 0;
+		}
+
+		for (uint32_t frame = 0; frame < _numFrames; ++frame)
+		{
+			// Press one key per frame, and release it next frame.
+			const entry::Key::Enum key = entry::Key::Enum(1 + (frame/2)%(entry::Key::Count-1) );
+			const uint8_t modifiers = s_modifiers[(frame/2)%BASE_COUNTOF(s_modifiers)];
+			const bool down = 0 == (frame & 1);
+			inputSetKeyState(key, modifiers, down);
+			once[key] = false;
+
+			const int64_t timeBegin = base::getHPCounter();
+
+			if (0 == pass)
+			{
+				for (uint32_t ii = 0; ii < BENCHMARK_INPUT_TABLES; ++ii)
+				{
+					for (const InputBinding* binding = s_inputBindings[ii]; binding->m_key != entry::Key::None; ++binding)
+					{
+						uint8_t keyModifiers;
+						if (!inputGetKeyState(binding->m_key, &keyModifiers) )
+						{
+							once[binding->m_key] = false;
+						}
+						else if (keyModifiers == binding->m_modifiers
+						     &&  !once[binding->m_key])
+						{
+							if (NULL == binding->m_fn)
+							{
+								cmdExec( (const char*)binding->m_userData);
+							}
+							else
+							{
+								binding->m_fn(binding->m_userData);
+							}
+
+							once[binding->m_key] = true;
+						}
+					}
+				}
+			}
+			else
+			{
+				inputProcess();
+			}
+
+			time[pass] += base::getHPCounter() - timeBegin;
+		}
+
+		count[pass] = s_inputCounter;
+	}
+
+	for (uint32_t ii = 0; ii < BENCHMARK_INPUT_TABLES; ++ii)
+	{
+		inputRemoveBindings(name[ii]);
+	}
+
+	// Same command executed from string, and precompiled.
+	const uint32_t numExec = _numFrames*16;
+	int64_t execTime[2];
+
+	CmdCompiled* compiled = cmdCompile("benchmark-input 1 2 3");
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		const int64_t timeBegin = base::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numExec; ++ii)
+		{
+			if (0 == pass)
+			{
+				cmdExec("benchmark-input 1 2 3");
+			}
+			else
+			{
+				cmdExecCompiled(compiled);
+			}
+		}
+
+		execTime[pass] = base::getHPCounter() - timeBegin;
+	}
+
+	cmdFree(compiled);
+	cmdRemove("benchmark-input");
+
+	base::printf("\ninput: %d frames, %d tables with %d bindings\n", _numFrames, BENCHMARK_INPUT_TABLES, BENCHMARK_INPUT_BINDINGS);
+	base::printf("  %-14s %10s %12s %10s\n", "", "total [ms]", "frame [us]", "triggered");
+	base::printf("  %-14s %10.4f %12.4f %10d\n", "poll",  toMs(time[0]), toMs(time[0])*1000.0/_numFrames, count[0]);
+	base::printf("  %-14s %10.4f %12.4f %10d\n", "event", toMs(time[1]), toMs(time[1])*1000.0/_numFrames, count[1]);
+
+	base::printf("\ncmd: %d executions\n", numExec);
+	base::printf("  %-14s %10s %12s\n", "", "total [ms]", "exec [us]");
+	base::printf("  %-14s %10.4f %12.4f\n", "string",   toMs(execTime[0]), toMs(execTime[0])*1000.0/numExec);
+	base::printf("  %-14s %10.4f %12.4f\n", "compiled", toMs(execTime[1]), toMs(execTime[1])*1000.0/numExec);
+}
+
+struct EventProducer
+{
+	static int32_t threadFunc(base::Thread* _thread, void* _userData);
+
+	entry::EventQueue* m_queue;
+	uint32_t m_num;
+	volatile uint32_t m_done;
+};
+
+int32_t EventProducer::threadFunc(base::Thread* _thread, void* _userData)
+{
+	BASE_UNUSED(_thread);
+
+	EventProducer* producer = (EventProducer*)_userData;
+	entry::EventQueue& queue = *producer->m_queue;
+
+	const entry::WindowHandle window = { 0 };
+	const entry::GamepadHandle gamepad = { 0 };
+	const uint8_t ch[4] = { 'a', 0, 0, 0 };
+
+	// Input mix dominated by mouse moves and gamepad axes, as with high polling rate devices.
+	for (uint32_t ii = 0; ii < producer->m_num; ++ii)
+	{
+		switch (ii%8)
+		{
+		case 0:
+		case 1:
+		case 2:
+		case 3: queue.postMouseEvent(window, int32_t(ii), int32_t(ii/2), 0);                                        break;
+		case 4: queue.postAxisEvent(window, gamepad, entry::GamepadAxis::LeftX, int32_t(ii) );                         break;
+		case 5: queue.postMouseEvent(window, int32_t(ii), int32_t(ii/2), 0, entry::MouseButton::Left, 0 == (ii&8) ); break;
+		case 6: queue.postKeyEvent(window, entry::Key::KeyA, 0, 0 == (ii&8) );                                         break;
+		default: queue.postCharEvent(window, 1, ch);                                                                   break;
+		}
+	}
+
+	base::atomicFetchAndAdd<uint32_t>(&producer->m_done, 1);
+
+	return base::kExitSuccess;
+}
+
+// Posts <num> events from producer thread while consumer polls and releases them, and checks
+// that every posted event is received exactly once.
+bool runEvents(uint32_t _num)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	entry::EventQueue* queue = BASE_NEW(allocator, entry::EventQueue);
+
+	EventProducer producer;
+	producer.m_queue = queue;
+	producer.m_num   = _num;
+	producer.m_done  = 0;
+
+	uint32_t numPolled = 0;
+	uint32_t numType[entry::Event::DropFile+1];
+	base::memSet(numType, 0, sizeof(numType) );
+
+	const int64_t timeBegin = base::getHPCounter();
+
+	base::Thread thread;
+	thread.init(EventProducer::threadFunc, &producer, 0, "graphics-benchmark-events");
+
+	for (bool done = false; !done;)
+	{
+		// Producer flag is read before polling, so that no event posted before it is missed.
+		done = 0 != base::atomicFetchAndAdd<uint32_t>(&producer.m_done, 0);
+
+		for (const entry::Event* ev = queue->poll(); NULL != ev; ev = queue->poll() )
+		{
+			++numType[ev->m_type];
+			++numPolled;
+			queue->release(ev);
+		}
+	}
+
+	const int64_t time = base::getHPCounter() - timeBegin;
+
+	thread.shutdown();
+
+	const entry::EventQueueStats stats = queue->getStats();
+	base::deleteObject(allocator, queue);
+
+	const bool result = true
+		&& numPolled == stats.m_numPosted
+		&& _num      == stats.m_numPosted + stats.m_numCoalesced + stats.m_numDropped
+		;
+
+	base::printf("\nevents: %d events, queue size %d\n", _num, ENTRY_CONFIG_EVENT_QUEUE_SIZE);
+	base::printf("  %-14s %10s %12s %10s %10s %10s %10s\n", "", "total [ms]", "Mevents/s", "posted", "coalesced", "dropped", "polled");
+	base::printf("  %-14s %10.4f %12.4f %10d %10d %10d %10d\n"
+		, "spsc"
+		, toMs(time)
+		, double(_num)/toMs(time)/1000.0
+		, stats.m_numPosted
+		, stats.m_numCoalesced
+		, stats.m_numDropped
+		, numPolled
+		);
+	base::printf("  mouse %d, axis %d, key %d, char %d\n"
+		, numType[entry::Event::Mouse]
+		, numType[entry::Event::Axis]
+		, numType[entry::Event::Key]
+		, numType[entry::Event::Char]
+		);
+
+	if (!result)
+	{
+		base::printf("  error: polled events don't match queue counters.\n");
+	}
+
+	return result;
+}
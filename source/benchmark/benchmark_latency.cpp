@@ -0,0 +1,45 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "benchmark.h"
+
+// Runs static draw workload at 1K, 4K, 16K and 64K (clamped to draw call limit) draws per frame. Render is render thread
+// time from start of frame to end of submit, sort is reported separately since it runs on API
+// thread inside `graphics::frame`, overlapped with render thread. Run same mode on revision
+// that sorts on render thread to get before and after numbers.
+void runLatency(Benchmark& _benchmark, uint32_t _numFrames)
+{
+	static const uint32_t s_numDraws[] = { 1<<10, 1<<12, 1<<14, 1<<16 };
+
+	const uint32_t maxDraws = graphics::getCaps()->limits.maxDrawCalls;
+
+	const uint32_t numDrawsSaved  = _benchmark.m_settings.numDraws;
+	const uint32_t numFramesSaved = _benchmark.m_settings.numFrames;
+	_benchmark.m_settings.numFrames = _numFrames;
+
+	base::printf("\nlatency: %d frames\n", _numFrames);
+	base::printf("  %-14s %12s %12s %12s %12s\n", "draws", "frame [ms]", "sort [ms]", "render [ms]", "render max");
+
+	for (uint32_t step = 0; step < BASE_COUNTOF(s_numDraws); ++step)
+	{
+		const uint32_t numDraws = base::min(s_numDraws[step], maxDraws);
+		_benchmark.m_settings.numDraws = numDraws;
+
+		Result result;
+		_benchmark.run(Workload::Draw, result);
+
+		const uint32_t numFrames = base::max(result.numFrames, 1u);
+		base::printf("  %-14d %12.4f %12.4f %12.4f %12.4f\n"
+			, numDraws
+			, toMs(result.phase[Phase::Frame ].sum)/numFrames
+			, toMs(result.phase[Phase::Sort  ].sum)/numFrames
+			, toMs(result.phase[Phase::Render].sum)/numFrames
+			, toMs(result.phase[Phase::Render].max)
+			);
+	}
+
+	_benchmark.m_settings.numDraws  = numDrawsSaved;
+	_benchmark.m_settings.numFrames = numFramesSaved;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "benchmark.h"
+
+#define BENCHMARK_MAX_OFFSCREEN  16
+#define BENCHMARK_OFFSCREEN_SLOTS 8
+
+struct OffscreenReadback
+{
+	uint8_t* data;
+	bool     pending;
+};
+
+static uint32_t s_offscreenCompleted;
+
+static void offscreenReadFn(graphics::TextureHandle /*_handle*/, void* /*_data*/, uint8_t /*_mip*/, void* _userData)
+{
+	OffscreenReadback* readback = (OffscreenReadback*)_userData;
+	readback->pending = false;
+	++s_offscreenCompleted;
+}
+
+// Renders many small frame buffers per frame and reads them back, as server rendering
+// thumbnails would. Serial waits for read backs before rendering next batch, pipelined keeps
+// rendering while read backs of previous frames are in flight.
+bool runOffscreen(const Benchmark& _benchmark, uint32_t _num, uint32_t _size, uint32_t _numFrames)
+{
+	const graphics::Caps* caps = graphics::getCaps();
+
+	if (0 == (caps->supported & GRAPHICS_CAPS_TEXTURE_BLIT)
+	||  0 == (caps->supported & GRAPHICS_CAPS_TEXTURE_READ_BACK) )
+	{
+		base::printf("\noffscreen: texture blit and read back are not supported by renderer.\n");
+		return false;
+	}
+
+	const uint32_t num      = base::min<uint32_t>(_num, base::min<uint32_t>(BENCHMARK_MAX_OFFSCREEN, caps->limits.maxViews-1) );
+	const uint32_t numSlots = base::min<uint32_t>(caps->limits.readTextureLatency+1, BENCHMARK_OFFSCREEN_SLOTS);
+	const uint32_t size     = _size*_size*4;
+	const graphics::ViewId blitView = graphics::ViewId(num);
+
+	graphics::FrameBufferHandle fbh[BENCHMARK_MAX_OFFSCREEN];
+	graphics::TextureHandle readbackTexture[BENCHMARK_MAX_OFFSCREEN];
+	OffscreenReadback readback[BENCHMARK_MAX_OFFSCREEN][BENCHMARK_OFFSCREEN_SLOTS];
+
+	uint8_t* data = (uint8_t*)base::alloc(entry::getAllocator(), num*numSlots*size);
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		graphics::TextureHandle texture[] =
+		{
+			graphics::createTexture2D(uint16_t(_size), uint16_t(_size), false, 1, graphics::TextureFormat::RGBA8, GRAPHICS_TEXTURE_RT),
+			graphics::createTexture2D(uint16_t(_size), uint16_t(_size), false, 1, graphics::TextureFormat::D24S8, GRAPHICS_TEXTURE_RT_WRITE_ONLY),
+		};
+
+		fbh[ii] = graphics::createFrameBuffer(BASE_COUNTOF(texture), texture, true);
+		readbackTexture[ii] = graphics::createTexture2D(uint16_t(_size), uint16_t(_size), false, 1, graphics::TextureFormat::RGBA8, 0
+			| GRAPHICS_TEXTURE_BLIT_DST
+			| GRAPHICS_TEXTURE_READ_BACK
+			);
+
+		for (uint32_t jj = 0; jj < numSlots; ++jj)
+		{
+			readback[ii][jj].data    = &data[(ii*numSlots + jj)*size];
+			readback[ii][jj].pending = false;
+		}
+
+		graphics::setViewFrameBuffer(graphics::ViewId(ii), fbh[ii]);
+		graphics::setViewRect(graphics::ViewId(ii), 0, 0, uint16_t(_size), uint16_t(_size) );
+		graphics::setViewClear(graphics::ViewId(ii), GRAPHICS_CLEAR_COLOR|GRAPHICS_CLEAR_DEPTH, 0x303030ff, 1.0f, 0);
+	}
+
+	float view[16];
+	float proj[16];
+	base::mtxLookAt(view, { 0.0f, 0.0f, -8.0f }, { 0.0f, 0.0f, 0.0f });
+	base::mtxProj(proj, 60.0f, 1.0f, 0.1f, 100.0f, caps->homogeneousDepth);
+
+	int64_t time[2];
+	uint32_t count[2];
+	uint32_t numSubmitted[2];
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		const bool pipelined = 1 == pass;
+
+		s_offscreenCompleted = 0;
+		numSubmitted[pass]   = 0;
+
+		const int64_t timeBegin = base::getHPCounter();
+
+		for (uint32_t frame = 0; frame < _numFrames; ++frame)
+		{
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const graphics::ViewId viewId = graphics::ViewId(ii);
+				graphics::setViewTransform(viewId, view, proj);
+
+				// Few rotating cubes per target, so that rasterization isn't trivial.
+				for (uint32_t jj = 0; jj < 16; ++jj)
+				{
+					float mtx[16];
+					base::mtxRotateXY(mtx, float(frame)*0.021f + float(jj), float(frame)*0.037f + float(ii) );
+					mtx[12] = float(jj%4)*1.5f - 2.25f;
+					mtx[13] = float(jj/4)*1.5f - 2.25f;
+					mtx[14] = 0.0f;
+
+					graphics::setTransform(mtx);
+					graphics::setVertexBuffer(0, _benchmark.m_vbh);
+					graphics::setIndexBuffer(_benchmark.m_ibh);
+					graphics::setState(GRAPHICS_STATE_DEFAULT);
+					graphics::submit(viewId, _benchmark.m_program);
+				}
+
+				graphics::blit(blitView, readbackTexture[ii], 0, 0, graphics::getTexture(fbh[ii]) );
+
+				// Read back into free slot, when all slots are in flight target is rendered
+				// but not read back this frame.
+				for (uint32_t jj = 0; jj < numSlots; ++jj)
+				{
+					OffscreenReadback& rb = readback[ii][jj];
+
+					if (!rb.pending)
+					{
+						rb.pending = true;
+						graphics::readTexture(readbackTexture[ii], rb.data, 0, offscreenReadFn, &rb);
+						++numSubmitted[pass];
+						break;
+					}
+				}
+			}
+
+			graphics::frame();
+
+			if (!pipelined)
+			{
+				while (s_offscreenCompleted != numSubmitted[pass])
+				{
+					graphics::frame();
+				}
+			}
+		}
+
+		while (s_offscreenCompleted != numSubmitted[pass])
+		{
+			graphics::frame();
+		}
+
+		time[pass]  = base::getHPCounter() - timeBegin;
+		count[pass] = s_offscreenCompleted;
+	}
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		graphics::setViewFrameBuffer(graphics::ViewId(ii), GRAPHICS_INVALID_HANDLE);
+		graphics::destroy(fbh[ii]);
+		graphics::destroy(readbackTexture[ii]);
+	}
+
+	graphics::frame();
+
+	base::free(entry::getAllocator(), data);
+
+	base::printf("\noffscreen: %d targets %dx%d RGBA8, %d frames, read back latency %d frames\n"
+		, num
+		, _size
+		, _size
+		, _numFrames
+		, caps->limits.readTextureLatency
+		);
+	base::printf("  %-14s %10s %10s %12s %10s\n", "", "total [ms]", "read backs", "images/sec", "MPix/sec");
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		const double sec = base::max(toMs(time[pass]), 0.001)/1000.0;
+		base::printf("  %-14s %10.4f %10d %12.1f %10.2f\n"
+			, 0 == pass ? "serial" : "pipelined"
+			, toMs(time[pass])
+			, count[pass]
+			, double(count[pass])/sec
+			, double(count[pass])*_size*_size/sec/1000000.0
+			);
+	}
+
+	return true;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <base/file.h>
+#include <base/string.h>
+
+#include "../src/shaderpack/shaderpack.h"
+#include "benchmark.h"
+
+static bool writeBinary(const char* _filePath, const void* _data, uint32_t _size)
+{
+	base::FileWriter writer;
+	base::Error err;
+	if (!base::open(&writer, _filePath, false, &err) )
+	{
+		return false;
+	}
+
+	base::write(&writer, _data, int32_t(_size), &err);
+	base::close(&writer);
+
+	return err.isOk();
+}
+
+// Compares loading shaders from individual binary files, one open and read per shader, and from
+// shader pack. Vertex shaders are all different, fragment shaders are identical, so that pack
+// stores them once.
+bool runShaderPack(uint32_t _num)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	const uint32_t rendererMask = spRendererMask(graphics::getRendererType() );
+	const uint32_t vsh = BASE_MAKEFOURCC('V', 'S', 'H', 11);
+	const uint32_t fsh = BASE_MAKEFOURCC('F', 'S', 'H', 11);
+
+	const char* packFilePath[2] =
+	{
+		"graphics-benchmark-shaders.pack",
+		"graphics-benchmark-shaders-zlib.pack",
+	};
+
+	ShaderPackWriter* packWriter = spWriterCreate(allocator);
+
+	bool result = true;
+	uint32_t filesSize = 0;
+
+	for (uint32_t ii = 0; ii < _num && result; ++ii)
+	{
+		for (uint32_t jj = 0; jj < 2 && result; ++jj)
+		{
+			uint8_t shader[BENCHMARK_MAX_SHADER_SIZE];
+			const uint32_t size = Benchmark::writeShader(shader, 0 == jj ? vsh : fsh, 1 + ii%BENCHMARK_MAX_UNIFORMS);
+
+			char name[64];
+			base::snprintf(name, sizeof(name), "%s_%d", 0 == jj ? "vs" : "fs", ii);
+
+			char filePath[64];
+			base::snprintf(filePath, sizeof(filePath), "graphics-benchmark-%s.bin", name);
+
+			result = writeBinary(filePath, shader, size);
+			spWriterAdd(packWriter, name, rendererMask, shader, size);
+			filesSize += size;
+		}
+	}
+
+	uint32_t packSize[2] = { 0, 0 };
+	for (uint32_t ii = 0; ii < 2 && result; ++ii)
+	{
+		base::FileWriter writer;
+		base::Error err;
+		if (base::open(&writer, packFilePath[ii], false, &err) )
+		{
+			packSize[ii] = uint32_t(spWriterWrite(packWriter, &writer, 1 == ii, &err) );
+			base::close(&writer);
+		}
+
+		result = err.isOk();
+	}
+
+	spWriterDestroy(packWriter);
+
+	graphics::ShaderHandle* shader = (graphics::ShaderHandle*)base::alloc(allocator, _num*2*sizeof(graphics::ShaderHandle) );
+
+	int64_t loadTime[3] = { 0, 0, 0 };
+
+	for (uint32_t ii = 0; ii < 3 && result; ++ii)
+	{
+		const int64_t timeBegin = base::getHPCounter();
+
+		ShaderPack* pack = 0 < ii ? spOpen(packFilePath[ii-1], allocator) : NULL;
+		result = 0 == ii || NULL != pack;
+
+		for (uint32_t jj = 0; jj < _num*2 && result; ++jj)
+		{
+			char name[64];
+			base::snprintf(name, sizeof(name), "%s_%d", 0 == jj%2 ? "vs" : "fs", jj/2);
+
+			if (NULL != pack)
+			{
+				shader[jj] = spCreateShader(pack, name);
+				continue;
+			}
+
+			char filePath[64];
+			base::snprintf(filePath, sizeof(filePath), "graphics-benchmark-%s.bin", name);
+
+			base::FileReader reader;
+			base::Error err;
+			base::open(&reader, filePath, &err);
+			const uint32_t size = uint32_t(base::getSize(&reader) );
+			const graphics::Memory* mem = graphics::alloc(size);
+			base::read(&reader, mem->data, size, &err);
+			base::close(&reader);
+
+			shader[jj] = graphics::createShader(mem);
+		}
+
+		if (NULL != pack)
+		{
+			spClose(pack);
+		}
+
+		graphics::frame();
+
+		loadTime[ii] = base::getHPCounter() - timeBegin;
+
+		for (uint32_t jj = 0; jj < _num*2 && result; ++jj)
+		{
+			graphics::destroy(shader[jj]);
+		}
+
+		graphics::frame();
+	}
+
+	base::free(allocator, shader);
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		for (uint32_t jj = 0; jj < 2; ++jj)
+		{
+			char filePath[64];
+			base::snprintf(filePath, sizeof(filePath), "graphics-benchmark-%s_%d.bin", 0 == jj ? "vs" : "fs", ii);
+
+			base::Error err;
+			base::remove(filePath, &err);
+		}
+	}
+
+	for (uint32_t ii = 0; ii < 2; ++ii)
+	{
+		base::Error err;
+		base::remove(packFilePath[ii], &err);
+	}
+
+	if (!result)
+	{
+		base::printf("Failed to write or read shader pack.\n");
+		return false;
+	}
+
+	base::printf("\nshader-pack: %d vertex and %d fragment shaders\n", _num, _num);
+	base::printf("  %-14s %10s %10s\n", "", "size [KiB]", "load [ms]");
+	base::printf("  %-14s %10d %10.4f (%d files)\n", "files", filesSize>>10, toMs(loadTime[0]), _num*2);
+	base::printf("  %-14s %10d %10.4f\n", "pack",      packSize[0]>>10, toMs(loadTime[1]) );
+	base::printf("  %-14s %10d %10.4f\n", "pack zlib", packSize[1]>>10, toMs(loadTime[2]) );
+
+	return true;
+}
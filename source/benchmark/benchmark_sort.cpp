@@ -0,0 +1,106 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <base/sort.h>
+
+#include "benchmark.h"
+
+// Sorts <num> random render item keys the same way `Frame::sort` does with and without
+// GRAPHICS_CONFIG_SORT_KEY_WIDE. Narrow is single radix sort of primary keys, wide is radix sort
+// of secondary keys, gather of primary keys in that order, and radix sort of primary keys. Both
+// run in same binary, so cost of wide keys is measured without rebuilding library.
+bool runSort(uint32_t _num, uint32_t _numFrames)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	uint64_t* keys       = (uint64_t*)base::alloc(allocator, _num*sizeof(uint64_t)*5);
+	uint64_t* keysWide   = &keys[_num];
+	uint64_t* srcKeys    = &keys[_num*2];
+	uint64_t* srcWide    = &keys[_num*3];
+	uint64_t* tempKeys   = &keys[_num*4];
+	uint32_t* values     = (uint32_t*)base::alloc(allocator, _num*sizeof(uint32_t)*2);
+	uint32_t* tempValues = &values[_num];
+
+	// Few programs and views in primary key, depth and material in secondary key.
+	uint32_t seed = 1;
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		seed = seed*1664525 + 1013904223;
+		srcKeys[ii] = uint64_t(seed >> 26) << 48 | uint64_t(seed & 0xff) << 32;
+
+		seed = seed*1664525 + 1013904223;
+		srcWide[ii] = uint64_t(seed) << 32 | uint64_t(seed >> 8);
+	}
+
+	base::printf("\nsort: %d keys, %d frames\n", _num, _numFrames);
+	base::printf("  %-14s %12s %12s\n", "keys", "sort [ms]", "max [ms]");
+
+	bool result = true;
+
+	for (uint32_t wide = 0; wide < 2; ++wide)
+	{
+		PhaseResult phase;
+		phase.reset();
+
+		for (uint32_t frame = 0; frame < _numFrames; ++frame)
+		{
+			base::memCopy(keys,     srcKeys, _num*sizeof(uint64_t) );
+			base::memCopy(keysWide, srcWide, _num*sizeof(uint64_t) );
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				values[ii] = ii;
+			}
+
+			const int64_t timeBegin = base::getHPCounter();
+
+			if (0 != wide)
+			{
+				base::radixSort(keysWide, tempKeys, values, tempValues, _num);
+
+				for (uint32_t ii = 0; ii < _num; ++ii)
+				{
+					keysWide[ii] = keys[values[ii] ];
+				}
+
+				base::memCopy(keys, keysWide, _num*sizeof(uint64_t) );
+			}
+
+			base::radixSort(keys, tempKeys, values, tempValues, _num);
+
+			phase.add(base::getHPCounter() - timeBegin);
+		}
+
+		// Sorted by primary key, and with wide keys ties are broken by secondary key.
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const uint32_t prev = values[ii-1];
+			const uint32_t curr = values[ii];
+
+			if (srcKeys[prev] > srcKeys[curr]
+			|| (0 != wide && srcKeys[prev] == srcKeys[curr] && srcWide[prev] > srcWide[curr]) )
+			{
+				result = false;
+				break;
+			}
+		}
+
+		base::printf("  %-14s %12.4f %12.4f\n"
+			, 0 == wide ? "narrow" : "wide"
+			, toMs(phase.sum)/base::max(_numFrames, 1u)
+			, toMs(phase.max)
+			);
+	}
+
+	base::free(allocator, values);
+	base::free(allocator, keys);
+
+	if (!result)
+	{
+		base::printf("  error: items are not sorted by full key.\n");
+	}
+
+	return result;
+}
@@ -0,0 +1,449 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include <base/file.h>
+#include <bimg/bimg.h>
+
+#include "../src/texturestream/texturestream.h"
+#include "benchmark.h"
+
+// Uncompressed RGBA8 KTX with full mip chain, used to compare full load against streaming.
+static bool writeStreamKtx(const char* _filePath, uint32_t _size)
+{
+	base::FileWriter writer;
+	base::Error err;
+
+	if (!base::open(&writer, _filePath, false, &err) )
+	{
+		return false;
+	}
+
+	const uint32_t numMips = 1 + uint32_t(base::floorLog2(_size) );
+
+	static const uint8_t identifier[12] = { 0xab, 'K', 'T', 'X', ' ', '1', '1', 0xbb, '\r', '\n', 0x1a, '\n' };
+	const uint32_t header[13] =
+	{
+		0x04030201, // endianness
+		0x1401,     // GL_UNSIGNED_BYTE
+		1,          // type size
+		0x1908,     // GL_RGBA
+		0x8058,     // GL_RGBA8
+		0x1908,     // GL_RGBA
+		_size,      // width
+		_size,      // height
+		0,          // depth
+		0,          // array elements
+		1,          // faces
+		numMips,
+		0,          // key value data size
+	};
+
+	base::write(&writer, identifier, sizeof(identifier), &err);
+	base::write(&writer, header,     sizeof(header),     &err);
+
+	uint32_t* row = (uint32_t*)base::alloc(entry::getAllocator(), _size*sizeof(uint32_t) );
+
+	for (uint32_t mip = 0; mip < numMips; ++mip)
+	{
+		const uint32_t size = base::max<uint32_t>(_size >> mip, 1);
+		const uint32_t imageSize = size*size*4;
+		base::write(&writer, &imageSize, sizeof(imageSize), &err);
+
+		for (uint32_t yy = 0; yy < size; ++yy)
+		{
+			for (uint32_t xx = 0; xx < size; ++xx)
+			{
+				row[xx] = ( (xx^yy) & 1) ? 0xffffffff : 0xff000000 | (mip*0x102030);
+			}
+
+			base::write(&writer, row, size*sizeof(uint32_t), &err);
+		}
+	}
+
+	base::free(entry::getAllocator(), row);
+	base::close(&writer);
+
+	return err.isOk();
+}
+
+// Compares time until texture can be sampled, and total load time, between reading whole file
+// and streaming it mip tail first.
+bool runStream(uint32_t _size, uint32_t _budget)
+{
+	const char* filePath = "graphics-benchmark-stream.ktx";
+
+	if (!writeStreamKtx(filePath, _size) )
+	{
+		base::printf("Failed to write '%s'.\n", filePath);
+		return false;
+	}
+
+	// Full load, file is read into memory and all mips are uploaded at once.
+	int64_t fullTime;
+	{
+		const int64_t timeBegin = base::getHPCounter();
+
+		base::FileReader reader;
+		base::Error err;
+		base::open(&reader, filePath, &err);
+		const uint32_t size = uint32_t(base::getSize(&reader) );
+		const graphics::Memory* mem = graphics::alloc(size);
+		base::read(&reader, mem->data, size, &err);
+		base::close(&reader);
+
+		graphics::TextureHandle texture = graphics::createTexture(mem);
+		graphics::frame();
+
+		fullTime = base::getHPCounter() - timeBegin;
+
+		graphics::destroy(texture);
+		graphics::frame();
+	}
+
+	// Streaming, mip tail is available after first frame, remaining mips arrive within budget.
+	int64_t firstTime;
+	int64_t streamTime;
+	uint32_t numFrames = 1;
+	{
+		tsInit(_budget, entry::getAllocator() );
+
+		const int64_t timeBegin = base::getHPCounter();
+
+		graphics::TextureHandle texture = tsCreateTexture(filePath);
+		tsUpdate();
+		graphics::frame();
+
+		firstTime = base::getHPCounter() - timeBegin;
+
+		while (0 != tsUpdate() )
+		{
+			graphics::frame();
+			++numFrames;
+		}
+
+		graphics::frame();
+
+		streamTime = base::getHPCounter() - timeBegin;
+
+		tsDestroy(texture);
+
+		// Mapped file is closed only after renderer consumed all updates referencing it.
+		while (0 != tsShutdown() )
+		{
+			graphics::frame();
+		}
+	}
+
+	base::Error err;
+	base::remove(filePath, &err);
+
+	base::printf("\nstream: %dx%d RGBA8, %d bytes per frame budget\n", _size, _size, _budget);
+	base::printf("  %-14s %10s %10s\n", "[ms]", "first", "total");
+	base::printf("  %-14s %10.4f %10.4f\n", "full",   toMs(fullTime),  toMs(fullTime) );
+	base::printf("  %-14s %10.4f %10.4f (%d frames)\n", "stream", toMs(firstTime), toMs(streamTime), numFrames);
+
+	return true;
+}
+
+// Compares parsing set of uncompressed and zlib supercompressed KTX2 containers. Containers are
+// kept in memory, so only decompression cost is measured, not I/O savings.
+void runKtx2(uint32_t _num, uint32_t _size)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	bimg::ImageContainer* image = bimg::imageAlloc(allocator
+		, bimg::TextureFormat::RGBA8
+		, uint16_t(_size)
+		, uint16_t(_size)
+		, 1
+		, 1
+		, false
+		, true
+		);
+
+	// Smooth gradient with noise, roughly as compressible as real color textures.
+	uint32_t seed = 1;
+	uint8_t* data = (uint8_t*)image->m_data;
+	for (uint32_t ii = 0; ii < image->m_size; ++ii)
+	{
+		seed = seed*1664525 + 1013904223;
+		data[ii] = uint8_t( (ii/(_size*4) + (ii/4)%_size)/8 + ( (seed >> 28) & 3) );
+	}
+
+	base::MemoryBlock raw(allocator);
+	base::MemoryBlock zlib(allocator);
+
+	int64_t writeTime[2];
+
+	for (uint32_t ii = 0; ii < 2; ++ii)
+	{
+		base::MemoryWriter writer(0 == ii ? &raw : &zlib);
+		const int64_t timeBegin = base::getHPCounter();
+		bimg::imageWriteKtx2(allocator, &writer, *image, image->m_data, image->m_size, 1 == ii);
+		writeTime[ii] = base::getHPCounter() - timeBegin;
+	}
+
+	bimg::imageFree(image);
+
+	base::MemoryBlock* block[2] = { &raw, &zlib };
+	int64_t parseTime[2];
+	uint32_t fileSize[2];
+
+	for (uint32_t ii = 0; ii < 2; ++ii)
+	{
+		fileSize[ii] = block[ii]->getSize();
+		const void* file = block[ii]->more(0);
+
+		const int64_t timeBegin = base::getHPCounter();
+
+		for (uint32_t jj = 0; jj < _num; ++jj)
+		{
+			bimg::ImageContainer* container = bimg::imageParseKtx(allocator, file, fileSize[ii], NULL);
+			bimg::imageFree(container);
+		}
+
+		parseTime[ii] = base::getHPCounter() - timeBegin;
+	}
+
+	base::printf("\nktx2: %d textures %dx%d RGBA8 with mips\n", _num, _size, _size);
+	base::printf("  %-14s %10s %10s %10s\n", "", "size [KiB]", "write [ms]", "parse [ms]");
+	base::printf("  %-14s %10d %10.4f %10.4f\n", "uncompressed", fileSize[0]>>10, toMs(writeTime[0]), toMs(parseTime[0]) );
+	base::printf("  %-14s %10d %10.4f %10.4f\n", "zlib",         fileSize[1]>>10, toMs(writeTime[1]), toMs(parseTime[1]) );
+}
+
+
+// Repeating lowercase text with short matches, same generator was used to write reference streams.
+static void zlibCheckData(uint8_t* _data, uint32_t _size)
+{
+	uint32_t seed = 1;
+	for (uint32_t ii = 0; ii < _size; ++ii)
+	{
+		seed = seed*1664525 + 1013904223;
+		_data[ii] = ii >= 64 && 0 != (seed >> 30)
+			? _data[ii - 64 + ( (seed >> 8) & 7)]
+			: uint8_t('a' + (seed >> 8) % 26)
+			;
+	}
+}
+
+// zlib streams of 512 bytes from zlibCheckData written by zlib, with fixed Huffman codes
+// (level 6, Z_FIXED), and with dynamic Huffman codes (level 9).
+static const uint8_t s_zlibFixed[] =
+{
+	0x78, 0x01, 0xcb, 0x49, 0x4a, 0xca, 0x2c, 0xaa, 0x48, 0xa9, 0x2a, 0x4e, 0xce, 0xad, 0x48, 0xc9,
+	0x4d, 0x2b, 0x4f, 0xce, 0x4e, 0x2b, 0xcc, 0x2b, 0x48, 0xcd, 0x2f, 0x49, 0xab, 0x2c, 0xcd, 0xa9,
+	0xcc, 0xae, 0x4a, 0x2d, 0x4a, 0xc9, 0x2b, 0x2f, 0x4b, 0x29, 0x2e, 0x29, 0x28, 0x2d, 0xcf, 0x2b,
+	0xae, 0x48, 0xca, 0x48, 0x2b, 0xcf, 0xc8, 0x4d, 0x2a, 0x4e, 0xaa, 0x2c, 0x2c, 0x2e, 0x48, 0x2a,
+	0x4c, 0x4a, 0x4e, 0xc9, 0xcc, 0x4f, 0xca, 0x4d, 0x49, 0x49, 0xae, 0x48, 0xcb, 0x4d, 0x49, 0x2b,
+	0x4b, 0xce, 0x2e, 0x48, 0x4b, 0xcd, 0x4c, 0x4d, 0xcd, 0x2f, 0xad, 0xac, 0xaa, 0xaa, 0xca, 0x49,
+	0xcd, 0xcb, 0x29, 0x2a, 0x4b, 0xc9, 0x2b, 0x2e, 0x4d, 0x2d, 0x2d, 0xad, 0x48, 0xcb, 0x2e, 0xac,
+	0x28, 0x2f, 0xce, 0xc8, 0x2d, 0xcf, 0x2d, 0x28, 0x2e, 0x4c, 0x2a, 0xa8, 0x4c, 0xce, 0x07, 0xca,
+	0xe5, 0x26, 0x25, 0xa7, 0xe5, 0x66, 0xa5, 0x00, 0xf5, 0xe6, 0xa6, 0xa5, 0x66, 0x27, 0x67, 0xa6,
+	0x66, 0x66, 0xa4, 0x65, 0x56, 0xe6, 0x65, 0xa6, 0x66, 0x57, 0xe5, 0xe4, 0xa5, 0x16, 0x55, 0x66,
+	0xa5, 0x96, 0x95, 0x56, 0x94, 0x26, 0x95, 0x96, 0x01, 0x35, 0x56, 0x64, 0x54, 0x14, 0xe7, 0x16,
+	0x03, 0x35, 0x16, 0x24, 0x17, 0xa4, 0x14, 0x55, 0x96, 0x26, 0x27, 0x26, 0x25, 0xa5, 0x24, 0xe7,
+	0xe6, 0xa6, 0xa5, 0x54, 0x25, 0x27, 0x67, 0xe6, 0x15, 0xe7, 0x65, 0x02, 0xb5, 0x67, 0xa6, 0xe5,
+	0x65, 0x54, 0xa5, 0x66, 0x66, 0x67, 0x65, 0x55, 0xa6, 0x66, 0x01, 0xdd, 0x51, 0x91, 0x54, 0x9a,
+	0x5a, 0x56, 0x91, 0x5b, 0x5c, 0x9a, 0x51, 0x5c, 0x51, 0x50, 0x5c, 0x9c, 0x5c, 0x51, 0x50, 0x54,
+	0x59, 0x90, 0x9c, 0x5c, 0x99, 0x04, 0xd4, 0x9b, 0x92, 0x9c, 0x96, 0x9c, 0x98, 0x9c, 0x99, 0x0c,
+	0xd4, 0x9d, 0x9e, 0x07, 0xd4, 0x5d, 0x9a, 0x0a, 0xb4, 0x38, 0xb3, 0x2a, 0xab, 0xb2, 0x30, 0xab,
+	0x32, 0x0b, 0xe8, 0xe6, 0x0a, 0x20, 0x48, 0x4a, 0x2a, 0x4b, 0xae, 0xa8, 0xc8, 0x2d, 0x2d, 0xce,
+	0xc8, 0xc8, 0x2a, 0x2a, 0x2e, 0x4f, 0xae, 0x48, 0xac, 0xac, 0xac, 0x4c, 0xa9, 0x4c, 0x49, 0x49,
+	0x4a, 0x4e, 0xcd, 0x4e, 0x4c, 0x03, 0x6a, 0x4e, 0xcf, 0x4f, 0x4f, 0xcf, 0xcc, 0xcc, 0x2b, 0xcc,
+	0x4c, 0xcd, 0xca, 0x2e, 0xa9, 0xaa, 0xca, 0xca, 0xca, 0x2a, 0xad, 0xac, 0xa8, 0x48, 0x4d, 0x4a,
+	0x4e, 0x02, 0xa2, 0x8a, 0x5c, 0x60, 0xd0, 0x54, 0x64, 0x65, 0x64, 0x25, 0xa7, 0x97, 0x57, 0x54,
+	0xa6, 0x03, 0xc3, 0x0b, 0x04, 0x52, 0x93, 0x33, 0x53, 0xd2, 0xca, 0x53, 0xd3, 0x0b, 0xd3, 0xd3,
+	0x93, 0xf3, 0x32, 0xf3, 0x81, 0x56, 0x67, 0x95, 0xa4, 0x96, 0xa4, 0x66, 0x55, 0x55, 0x55, 0x66,
+	0x02, 0xed, 0xaa, 0x4c, 0x4e, 0x29, 0x2a, 0x4a, 0x4a, 0xaa, 0x00, 0x52, 0x29, 0x69, 0xc9, 0xc9,
+	0xe5, 0x59, 0x40, 0x9d, 0xf9, 0xe9, 0x20, 0x97, 0x80, 0x34, 0x27, 0xa7, 0xe4, 0xa5, 0x16, 0xe6,
+	0xa6, 0x97, 0x17, 0x80, 0x35, 0x66, 0x02, 0x9d, 0x5c, 0x92, 0x55, 0x52, 0x95, 0x5a, 0x59, 0x55,
+	0x51, 0x05, 0x74, 0x5a, 0x51, 0x69, 0x65, 0x69, 0x4a, 0x51, 0x45, 0x66, 0x72, 0x41, 0x45, 0x4a,
+	0x72, 0x72, 0x4a, 0x79, 0x5a, 0x65, 0x7a, 0x51, 0x65, 0x59, 0x3a, 0xd0, 0xa2, 0x9c, 0x32, 0xa0,
+	0xc5, 0x79, 0x29, 0xa9, 0x29, 0x40, 0x8d, 0xe9, 0x05, 0x40, 0x9d, 0x20, 0xfd, 0x79, 0x00, 0xaa,
+	0xd3, 0xd8, 0xc1,
+};
+
+static const uint8_t s_zlibDynamic[] =
+{
+	0x78, 0xda, 0x1d, 0xd0, 0xdb, 0x8e, 0xc5, 0x20, 0x08, 0x05, 0xd0, 0x6f, 0x2d, 0x17, 0x15, 0x5b,
+	0xad, 0xd5, 0x5a, 0xc1, 0xaf, 0x1f, 0xce, 0x10, 0x13, 0x1f, 0xc8, 0xca, 0xde, 0xe1, 0x02, 0x90,
+	0xae, 0xb4, 0x07, 0x16, 0xa5, 0x12, 0x16, 0x9e, 0xe1, 0xa9, 0x8d, 0xef, 0x37, 0xd8, 0xbc, 0xec,
+	0xdc, 0xdc, 0xa9, 0xae, 0x8f, 0xc6, 0xdb, 0xe6, 0xaa, 0x43, 0x21, 0x85, 0x95, 0x0a, 0x0c, 0xb0,
+	0x67, 0x34, 0x78, 0x00, 0x49, 0x6e, 0x28, 0x44, 0xa8, 0xa1, 0x50, 0xf8, 0xf0, 0x6c, 0x81, 0x85,
+	0xf9, 0x9e, 0xb6, 0xf7, 0xbe, 0xb8, 0x5e, 0xfd, 0xa3, 0x3a, 0x26, 0xcf, 0xa9, 0xe1, 0x7c, 0x74,
+	0x8d, 0x54, 0x56, 0x69, 0xe3, 0x81, 0x66, 0x78, 0xfb, 0xae, 0x00, 0x86, 0x92, 0xc9, 0x6d, 0x09,
+	0x7c, 0xa2, 0xb0, 0xa4, 0x20, 0x56, 0x85, 0xcf, 0x7d, 0x55, 0xee, 0x96, 0xf9, 0x9b, 0x3a, 0x61,
+	0x7e, 0x0e, 0x35, 0xe9, 0x28, 0xc3, 0x61, 0xc3, 0x46, 0xdd, 0x26, 0x1e, 0x00, 0x84, 0xa5, 0x04,
+	0xda, 0x88, 0x52, 0x47, 0x15, 0xe7, 0x12, 0x6a, 0xda, 0x2c, 0x67, 0xce, 0xc6, 0xd9, 0x7b, 0x28,
+	0x4c, 0xfe, 0xb4, 0x8c, 0x99, 0x86, 0xb6, 0x31, 0x50, 0x5b, 0xb7, 0x86, 0x68, 0xe0, 0x96, 0x30,
+	0xe0, 0x81, 0x82, 0xae, 0x63, 0x75, 0x3d, 0xd9, 0x83, 0x65, 0x67, 0x7b, 0xb2, 0x65, 0xef, 0xac,
+	0x3e, 0x00, 0x1f, 0xaa, 0x96, 0x39, 0x52, 0xca, 0x7d, 0x2c, 0xd4, 0xc3, 0xcc, 0xc8, 0x88, 0x00,
+	0xf9, 0x3c, 0x82, 0xe3, 0x78, 0xc7, 0x28, 0x52, 0x1f, 0xe1, 0x7c, 0xbe, 0x7b, 0xe7, 0x9c, 0xa7,
+	0xa9, 0x32, 0x20, 0xf8, 0xd3, 0xe2, 0xa7, 0xd1, 0x9c, 0x32, 0xc6, 0xa5, 0x16, 0xfd, 0x5e, 0xbf,
+	0x61, 0x14, 0x0a, 0x8b, 0xe3, 0x13, 0x23, 0x56, 0xb9, 0x3d, 0x3a, 0xbf, 0xfc, 0x72, 0xde, 0xdb,
+	0xc4, 0xb3, 0x0c, 0xa9, 0x77, 0x00, 0xf5, 0x8f, 0x02, 0xe2, 0xca, 0x2e, 0xef, 0xf8, 0x6b, 0xf2,
+	0xc3, 0x48, 0x95, 0x9f, 0x12, 0x57, 0xfb, 0x87, 0xe2, 0x95, 0xdf, 0xfc, 0x6e, 0xb6, 0xad, 0xdb,
+	0xab, 0xf5, 0x69, 0x93, 0xba, 0x0a, 0x36, 0x25, 0x44, 0x5a, 0xc1, 0x62, 0xb7, 0x2f, 0x7a, 0xd0,
+	0xf5, 0x79, 0x70, 0x25, 0x26, 0x87, 0xb1, 0xb9, 0xfc, 0xf9, 0xfa, 0x07, 0xaa, 0xd3, 0xd8, 0xc1,
+};
+
+static bool zlibRoundTrip(base::AllocatorI* _allocator, const uint8_t* _data, uint32_t _size, uint32_t& _packedSize)
+{
+	const uint32_t bound = bimg::zlibDeflateBound(_size);
+	uint8_t* packed   = (uint8_t*)base::alloc(_allocator, bound + _size);
+	uint8_t* unpacked = &packed[bound];
+
+	_packedSize = bimg::zlibDeflate(_allocator, packed, bound, _data, _size);
+
+	const bool result = 0 != _packedSize
+		&& bimg::zlibInflate(unpacked, _size, packed, _packedSize)
+		&& 0 == base::memCmp(unpacked, _data, _size)
+		;
+
+	base::free(_allocator, packed);
+
+	return result;
+}
+
+// Writes zlib supercompressed KTX2 with <_numLayers> layers, parses it back, and compares every mip.
+static bool ktx2RoundTrip(base::AllocatorI* _allocator, uint16_t _numLayers)
+{
+	bimg::ImageContainer* image = bimg::imageAlloc(_allocator
+		, bimg::TextureFormat::RGBA8
+		, 64
+		, 64
+		, 1
+		, _numLayers
+		, false
+		, true
+		);
+
+	zlibCheckData( (uint8_t*)image->m_data, image->m_size);
+
+	base::MemoryBlock block(_allocator);
+	base::MemoryWriter writer(&block);
+	bimg::imageWriteKtx2(_allocator, &writer, *image, image->m_data, image->m_size, true);
+
+	const uint32_t size = block.getSize();
+	const void* file = block.more(0);
+
+	bimg::Ktx2Level level;
+	bool result = bimg::imageGetKtx2Level(file, size, 0, level)
+		&& 3 == level.m_scheme
+		;
+
+	bimg::ImageContainer* container = bimg::imageParseKtx(_allocator, file, size, NULL);
+	result &= NULL != container;
+
+	for (uint16_t side = 0; side < _numLayers && result; ++side)
+	{
+		for (uint8_t lod = 0; lod < image->m_numMips && result; ++lod)
+		{
+			bimg::ImageMip expected;
+			bimg::ImageMip mip;
+			result = bimg::imageGetRawData(*image, side, lod, image->m_data, image->m_size, expected)
+				&& bimg::imageGetRawData(*container, side, lod, container->m_data, container->m_size, mip)
+				&& expected.m_size == mip.m_size
+				&& 0 == base::memCmp(expected.m_data, mip.m_data, mip.m_size)
+				;
+		}
+	}
+
+	if (NULL != container)
+	{
+		bimg::imageFree(container);
+	}
+
+	bimg::imageFree(image);
+
+	return result;
+}
+
+// Checks inflate against streams written by zlib, deflate and inflate round trip on compressible,
+// incompressible and constant data, and zlib supercompressed KTX2 round trip with single side
+// (levels inflated directly into image) and with layers (container inflated and scattered).
+bool runZlibCheck(uint32_t _size)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	bool result = true;
+
+	base::printf("\nzlib: %d bytes\n", _size);
+	base::printf("  %-14s %10s %10s\n", "", "size", "result");
+
+	{
+		uint8_t expected[512];
+		uint8_t data[512];
+		zlibCheckData(expected, sizeof(expected) );
+
+		const struct { const char* name; const uint8_t* data; uint32_t size; } stream[] =
+		{
+			{ "zlib fixed",   s_zlibFixed,   sizeof(s_zlibFixed)   },
+			{ "zlib dynamic", s_zlibDynamic, sizeof(s_zlibDynamic) },
+		};
+
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(stream); ++ii)
+		{
+			// Truncated stream must be rejected.
+			const bool ok = bimg::zlibInflate(data, sizeof(data), stream[ii].data, stream[ii].size)
+				&& 0 == base::memCmp(data, expected, sizeof(data) )
+				&& !bimg::zlibInflate(data, sizeof(data), stream[ii].data, stream[ii].size-1)
+				;
+
+			base::printf("  %-14s %10d %10s\n", stream[ii].name, stream[ii].size, ok ? "ok" : "failed");
+			result &= ok;
+		}
+	}
+
+	{
+		uint8_t* data = (uint8_t*)base::alloc(allocator, _size);
+
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			static const char* s_name[] = { "text", "random", "constant" };
+
+			if (0 == ii)
+			{
+				zlibCheckData(data, _size);
+			}
+			else if (1 == ii)
+			{
+				uint32_t seed = 1;
+				for (uint32_t jj = 0; jj < _size; ++jj)
+				{
+					seed = seed*1664525 + 1013904223;
+					data[jj] = uint8_t(seed >> 24);
+				}
+			}
+			else
+			{
+				base::memSet(data, 0x5a, _size);
+			}
+
+			uint32_t packedSize = 0;
+			const bool ok = zlibRoundTrip(allocator, data, _size, packedSize);
+
+			base::printf("  %-14s %10d %10s\n", s_name[ii], packedSize, ok ? "ok" : "failed");
+			result &= ok;
+		}
+
+		base::free(allocator, data);
+	}
+
+	for (uint16_t numLayers = 1; numLayers <= 2; ++numLayers)
+	{
+		const bool ok = ktx2RoundTrip(allocator, numLayers);
+
+		base::printf("  %-14s %10d %10s\n", "ktx2 layers", numLayers, ok ? "ok" : "failed");
+		result &= ok;
+	}
+
+	if (!result)
+	{
+		base::printf("  error: zlib or KTX2 round trip doesn't match.\n");
+	}
+
+	return result;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "../src/topology.h"
+
+#include "benchmark.h"
+
+// Compares triangle sort keys computed with SIMD and scalar code for every sort mode, with 16-bit
+// and 32-bit indices. Keys must be bit identical, any mismatch fails check.
+bool runTopologyCheck(uint32_t _num)
+{
+	base::AllocatorI* allocator = entry::getAllocator();
+
+	// Odd number of triangles so that SIMD path also runs scalar remainder.
+	const uint32_t numTriangles = _num | 1;
+	const uint32_t numVertices  = base::min<uint32_t>(numTriangles*3, UINT16_MAX);
+	const uint32_t numIndices   = numTriangles*3;
+
+	float*    vertices  = (float*   )base::alloc(allocator, numVertices*3*sizeof(float) );
+	uint32_t* indices32 = (uint32_t*)base::alloc(allocator, numIndices*sizeof(uint32_t) );
+	uint16_t* indices16 = (uint16_t*)base::alloc(allocator, numIndices*sizeof(uint16_t) );
+	uint32_t* keys      = (uint32_t*)base::alloc(allocator, numTriangles*sizeof(uint32_t)*2);
+	uint32_t* keysRef   = &keys[numTriangles];
+
+	// Positions span both signs so that key flip is exercised for negative distances.
+	uint32_t seed = 1;
+	for (uint32_t ii = 0; ii < numVertices*3; ++ii)
+	{
+		seed = seed*1664525 + 1013904223;
+		vertices[ii] = (float(seed >> 8) / float(1<<24) - 0.5f) * 200.0f;
+	}
+
+	for (uint32_t ii = 0; ii < numIndices; ++ii)
+	{
+		seed = seed*1664525 + 1013904223;
+		indices32[ii] = (seed >> 8) % numVertices;
+		indices16[ii] = uint16_t(indices32[ii]);
+	}
+
+	const float dir[3] = { 0.267261f, 0.534522f, -0.801784f };
+	const float pos[3] = { 13.0f, -7.0f, 29.0f };
+
+	base::printf("\ntopology: %d triangles\n", numTriangles);
+	base::printf("  %-6s %10s %10s\n", "sort", "16-bit", "32-bit");
+
+	bool result = true;
+
+	for (uint32_t ii = 0; ii < graphics::TopologySort::Count; ++ii)
+	{
+		const graphics::TopologySort::Enum sort = graphics::TopologySort::Enum(ii);
+
+		uint32_t numMismatch[2] = { 0, 0 };
+
+		for (uint32_t index32 = 0; index32 < 2; ++index32)
+		{
+			const void* indices = 0 != index32 ? (const void*)indices32 : (const void*)indices16;
+
+			graphics::topologyCalcSortKeys(keys,    sort, dir, pos, vertices, 3*sizeof(float), indices, numIndices, 0 != index32, false, allocator);
+			graphics::topologyCalcSortKeys(keysRef, sort, dir, pos, vertices, 3*sizeof(float), indices, numIndices, 0 != index32, true,  allocator);
+
+			for (uint32_t jj = 0; jj < numTriangles; ++jj)
+			{
+				numMismatch[index32] += keys[jj] != keysRef[jj];
+			}
+		}
+
+		base::printf("  %-6d %10d %10d\n", ii, numMismatch[0], numMismatch[1]);
+
+		result &= 0 == numMismatch[0] && 0 == numMismatch[1];
+	}
+
+	base::free(allocator, keys);
+	base::free(allocator, indices16);
+	base::free(allocator, indices32);
+	base::free(allocator, vertices);
+
+	if (!result)
+	{
+		base::printf("  error: SIMD and scalar sort keys differ.\n");
+	}
+
+	return result;
+}
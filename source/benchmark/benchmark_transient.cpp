@@ -0,0 +1,185 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "benchmark.h"
+
+#define BENCHMARK_TRANSIENT_MAX_THREADS 8
+
+struct TransientThread
+{
+	static int32_t threadFunc(base::Thread* _thread, void* _userData);
+
+	base::Thread    m_thread;
+	base::Semaphore m_start;
+	base::Semaphore m_done;
+	const graphics::VertexLayout* m_layout;
+	uint32_t        m_num;
+	uint32_t        m_numFailed;
+	bool            m_exit;
+};
+
+// Small particle and UI sized allocations, quad with instance data, nothing is submitted.
+static void allocTransient(graphics::Encoder* _encoder, const graphics::VertexLayout& _layout, uint32_t _num, uint32_t& _numFailed)
+{
+	if (NULL == _encoder)
+	{
+		_numFailed += _num;
+		return;
+	}
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		graphics::TransientVertexBuffer tvb;
+		graphics::TransientIndexBuffer  tib;
+		graphics::InstanceDataBuffer    idb;
+
+		if (!_encoder->allocTransientBuffers(&tvb, _layout, 4, &tib, 6) )
+		{
+			++_numFailed;
+			continue;
+		}
+
+		_encoder->allocInstanceDataBuffer(&idb, 1, 64);
+	}
+}
+
+int32_t TransientThread::threadFunc(base::Thread* _thread, void* _userData)
+{
+	BASE_UNUSED(_thread);
+
+	TransientThread* tt = (TransientThread*)_userData;
+
+	for (;;)
+	{
+		tt->m_start.wait();
+
+		if (tt->m_exit)
+		{
+			break;
+		}
+
+		graphics::Encoder* encoder = graphics::begin(true);
+		allocTransient(encoder, *tt->m_layout, tt->m_num, tt->m_numFailed);
+		graphics::end(encoder);
+
+		tt->m_done.post();
+	}
+
+	return base::kExitSuccess;
+}
+
+// Allocates <num> transient buffers per frame spread across 1, 2, 4 and 8 threads, each
+// thread allocating through its own encoder. Total work per frame is the same for every
+// thread count, so time per frame shows how allocation scales under contention.
+bool runTransientContention(uint32_t _num, uint32_t _numFrames)
+{
+	static const uint32_t s_numThreads[] = { 1, 2, 4, 8 };
+
+	const uint32_t maxThreads = base::min<uint32_t>(BENCHMARK_TRANSIENT_MAX_THREADS, graphics::getCaps()->limits.maxEncoders);
+
+	graphics::VertexLayout layout;
+	layout
+		.begin()
+		.add(graphics::Attrib::Position, 3, graphics::AttribType::Float)
+		.add(graphics::Attrib::Color0,   4, graphics::AttribType::Uint8, true)
+		.end();
+
+	TransientThread thread[BENCHMARK_TRANSIENT_MAX_THREADS];
+
+	for (uint32_t ii = 1; ii < maxThreads; ++ii)
+	{
+		TransientThread& tt = thread[ii];
+		tt.m_layout = &layout;
+		tt.m_exit   = false;
+		tt.m_thread.init(TransientThread::threadFunc, &tt, 0, "graphics-benchmark-transient");
+	}
+
+	base::printf("\ntransient: %d allocations per frame, %d frames\n", _num, _numFrames);
+	base::printf("  %-14s %12s %12s %10s\n", "threads", "alloc [ms/f]", "Malloc/s", "failed");
+
+	bool result = true;
+
+	for (uint32_t step = 0; step < BASE_COUNTOF(s_numThreads); ++step)
+	{
+		const uint32_t numThreads = s_numThreads[step];
+
+		if (numThreads > maxThreads)
+		{
+			base::printf("  %-14d skipped, renderer supports %d encoders.\n", numThreads, maxThreads);
+			continue;
+		}
+
+		const uint32_t perThread = (_num + numThreads - 1)/numThreads;
+
+		int64_t time = 0;
+		uint32_t numFailed = 0;
+
+		// Layout lookup is cached per encoder and frame, first frame also creates layout.
+		for (uint32_t frame = 0, num = _numFrames + 1; frame < num; ++frame)
+		{
+			uint32_t numMainFailed = 0;
+
+			const int64_t timeBegin = base::getHPCounter();
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				TransientThread& tt = thread[ii];
+				const uint32_t begin = base::min(ii*perThread, _num);
+				tt.m_num       = base::min(begin+perThread, _num) - begin;
+				tt.m_numFailed = 0;
+				tt.m_start.post();
+			}
+
+			allocTransient(graphics::begin(), layout, base::min(perThread, _num), numMainFailed);
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				thread[ii].m_done.wait();
+			}
+
+			const int64_t timeEnd = base::getHPCounter();
+
+			graphics::frame();
+
+			if (0 == frame)
+			{
+				continue;
+			}
+
+			time += timeEnd - timeBegin;
+			numFailed += numMainFailed;
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				numFailed += thread[ii].m_numFailed;
+			}
+		}
+
+		result &= 0 == numFailed;
+
+		const double ms = base::max(toMs(time), 0.001);
+		base::printf("  %-14d %12.4f %12.2f %10d\n"
+			, numThreads
+			, ms/base::max(_numFrames, 1u)
+			, double(_num)*_numFrames/ms/1000.0
+			, numFailed
+			);
+	}
+
+	for (uint32_t ii = 1; ii < maxThreads; ++ii)
+	{
+		TransientThread& tt = thread[ii];
+		tt.m_exit = true;
+		tt.m_start.post();
+		tt.m_thread.shutdown();
+	}
+
+	if (!result)
+	{
+		base::printf("  error: transient buffers ran out, reduce number of allocations.\n");
+	}
+
+	return result;
+}
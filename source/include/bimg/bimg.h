@@ -206,6 +206,7 @@ namespace bimg
 		bool     m_cubeMap;
 		bool     m_ktx;
 		bool     m_ktxLE;
+		bool     m_ktx2;
 		bool     m_pvr3;
 		bool     m_srgb;
 	};
@@ -223,6 +224,19 @@ namespace bimg
 		const uint8_t* m_data;
 	};
 
+	/// KTX2 level as stored in container. Used to pass levels supercompressed with scheme bimg
+	/// can't decode (BasisLZ, Zstandard) to external transcoder.
+	struct Ktx2Level
+	{
+		uint32_t m_vkFormat;         //!< VkFormat, 0 for BasisLZ.
+		uint32_t m_scheme;           //!< KTX2 supercompression scheme: 0 none, 1 BasisLZ, 2 Zstandard, 3 zlib.
+		uint32_t m_size;             //!< Stored level size.
+		uint32_t m_uncompressedSize; //!< Uncompressed level size, 0 for BasisLZ.
+		uint32_t m_globalDataSize;   //!< Supercompression global data size.
+		const uint8_t* m_data;       //!< Stored level data, all layers and faces.
+		const uint8_t* m_globalData; //!< Supercompression global data (BasisLZ), or NULL.
+	};
+
 	struct ImageBlockInfo
 	{
 		uint8_t bitsPerPixel;
@@ -567,6 +581,110 @@ namespace bimg
 		, base::Error* _err = NULL
 		);
 
+	/// Write KTX2 container.
+	///
+	/// @param[in] _allocator Allocator used for temporary level data.
+	/// @param[in] _writer Writer.
+	/// @param[in] _imageContainer Image container.
+	/// @param[in] _data Image data.
+	/// @param[in] _size Image data size.
+	/// @param[in] _supercompress Compress each level with zlib. Levels are compressed in parallel.
+	/// @param[out] _err Error.
+	///
+	/// @returns Number of bytes written.
+	///
+	int32_t imageWriteKtx2(
+		  base::AllocatorI* _allocator
+		, base::WriterI* _writer
+		, ImageContainer& _imageContainer
+		, const void* _data
+		, uint32_t _size
+		, bool _supercompress
+		, base::Error* _err = NULL
+		);
+
+	/// Returns size of KTX2 container with supercompressed levels inflated, or 0 if data is not
+	/// zlib supercompressed KTX2 container.
+	///
+	uint32_t imageGetKtx2InflatedSize(
+		  const void* _src
+		, uint32_t _size
+		);
+
+	/// Inflate zlib supercompressed KTX2 container into KTX2 container without supercompression.
+	/// Levels are inflated in parallel directly into destination.
+	///
+	/// @param[in] _allocator Allocator.
+	/// @param[in] _dst Destination, must be at least `imageGetKtx2InflatedSize` bytes.
+	/// @param[in] _dstSize Destination size.
+	/// @param[in] _src Supercompressed KTX2 container.
+	/// @param[in] _srcSize Source size.
+	/// @param[out] _err Error.
+	///
+	bool imageInflateKtx2(
+		  base::AllocatorI* _allocator
+		, void* _dst
+		, uint32_t _dstSize
+		, const void* _src
+		, uint32_t _srcSize
+		, base::Error* _err = NULL
+		);
+
+	/// Get KTX2 level without decoding it. Unlike `imageParse`, accepts every supercompression
+	/// scheme, so that BasisLZ and Zstandard levels can be transcoded by caller.
+	///
+	/// @param[in] _src KTX2 container.
+	/// @param[in] _size Container size.
+	/// @param[in] _lod Level.
+	/// @param[out] _level Level.
+	///
+	/// @returns True if container is valid and has level `_lod`.
+	///
+	bool imageGetKtx2Level(
+		  const void* _src
+		, uint32_t _size
+		, uint8_t _lod
+		, Ktx2Level& _level
+		);
+
+	/// Returns maximum size of zlib stream written by `zlibDeflate` for `_size` bytes of input.
+	///
+	uint32_t zlibDeflateBound(uint32_t _size);
+
+	/// Compress data into zlib stream, with same compressor used for KTX2 supercompression.
+	///
+	/// @param[in] _allocator Allocator used for temporary match table.
+	/// @param[in] _dst Destination, must be at least `zlibDeflateBound` bytes.
+	/// @param[in] _dstSize Destination size.
+	/// @param[in] _src Source data.
+	/// @param[in] _srcSize Source size.
+	///
+	/// @returns Size of zlib stream.
+	///
+	uint32_t zlibDeflate(
+		  base::AllocatorI* _allocator
+		, void* _dst
+		, uint32_t _dstSize
+		, const void* _src
+		, uint32_t _srcSize
+		);
+
+	/// Decompress zlib stream.
+	///
+	/// @param[in] _dst Destination.
+	/// @param[in] _dstSize Destination size, must be size of uncompressed data.
+	/// @param[in] _src zlib stream.
+	/// @param[in] _srcSize zlib stream size.
+	///
+	/// @returns True if stream is valid.
+	///
+	bool zlibInflate(
+		  void* _dst
+		, uint32_t _dstSize
+		, const void* _src
+		, uint32_t _srcSize
+		);
+
 	///
 	bool imageParse(
 		  ImageContainer& _imageContainer
@@ -626,6 +744,18 @@ namespace bimg
 		, TextureFormat::Enum _srcFormat
 	);
 
+	/// Decodes single 4x4 block of BC1-BC5, or BC7 format into 16 BGRA8 texels. When `_ref` is
+	/// true, reference decoders are used instead of optimized ones. Both must produce identical
+	/// output. Returns false if format is not supported. BC6H has single decoder, which outputs
+	/// float texels, see `imageDecodeToRgba32f`.
+	///
+	bool imageDecodeBlockToBgra8(
+		  void* _dst
+		, const void* _src
+		, TextureFormat::Enum _format
+		, bool _ref = false
+		);
+
 	///
 	void imageDecodeToBgra8(
 		  base::AllocatorI* _allocator
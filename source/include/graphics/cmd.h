@@ -7,6 +7,7 @@
 #define CMD_H_HEADER_GUARD
 
 struct CmdContext;
+struct CmdCompiled;
 typedef int (*ConsoleFn)(CmdContext* _context, void* _userData, int _argc, char const* const* _argv);
 
 ///
@@ -24,4 +25,21 @@ void cmdRemove(const char* _name);
 ///
 void cmdExec(const char* _format, ...);
 
+/// Parse command line once into command lookup and argument list, so that it can be executed
+/// many times without tokenizing and hashing. Multiple commands are separated by new line.
+///
+/// @param[in] _cmd Command line.
+/// @returns Compiled command, or `NULL` if command line is empty. Must be released with `cmdFree`.
+///
+CmdCompiled* cmdCompile(const char* _cmd);
+
+/// Release command compiled with `cmdCompile`.
+///
+void cmdFree(CmdCompiled* _cmd);
+
+/// Execute command compiled with `cmdCompile`. Commands added or removed after compilation are
+/// resolved on the next execution.
+///
+void cmdExecCompiled(const CmdCompiled* _cmd);
+
 #endif // CMD_H_HEADER_GUARD
@@ -267,6 +267,16 @@
 #define GRAPHICS_DISCARD_VERTEX_STREAMS               UINT8_C(0x20) //!< Discard vertex streams.
 #define GRAPHICS_DISCARD_ALL                          UINT8_C(0xff) //!< Discard all states.
 
+/**
+ * View draw call merging rules. Consecutive draw calls in sorted view that share program, state,
+ * vertex and index buffers, and bindings are merged into single instanced draw call. Model matrix
+ * of each merged draw call is passed as instance data in `i_data0`-`i_data3`.
+ *
+ */
+#define GRAPHICS_MERGE_NONE                           UINT8_C(0x00) //!< Don't merge draw calls.
+#define GRAPHICS_MERGE_TRANSFORM                      UINT8_C(0x01) //!< Merge draw calls that differ only by transform.
+#define GRAPHICS_MERGE_UNIFORMS                       UINT8_C(0x02) //!< Merge draw calls that set the same per draw uniforms.
+
 #define GRAPHICS_DEBUG_NONE                           UINT32_C(0x00000000) //!< No debug.
 #define GRAPHICS_DEBUG_WIREFRAME                      UINT32_C(0x00000001) //!< Enable wireframe for all primitives.
 
@@ -492,6 +502,8 @@
 #define GRAPHICS_CAPS_VERTEX_ID                       UINT64_C(0x0000000008000000) //!< Rendering with VertexID only is supported.
 #define GRAPHICS_CAPS_VIEWPORT_LAYER_ARRAY            UINT64_C(0x0000000010000000) //!< Viewport layer is available in vertex shader.
 #define GRAPHICS_CAPS_DRAW_INDIRECT_COUNT             UINT64_C(0x0000000020000000) //!< Draw indirect with indirect count is supported.
+#define GRAPHICS_CAPS_UNIFORM_BUFFER                  UINT64_C(0x0000000040000000) //!< Uniforms are packed into uniform buffers.
+#define GRAPHICS_CAPS_TEXTURE_MIN_MIP                 UINT64_C(0x0000000080000000) //!< Texture sampling can be clamped to min mip.
 /// All texture compare modes are supported.
 #define GRAPHICS_CAPS_TEXTURE_COMPARE_ALL (0 \
 	| GRAPHICS_CAPS_TEXTURE_COMPARE_RESERVED \
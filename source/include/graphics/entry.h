@@ -255,6 +255,29 @@ namespace entry
 		int32_t m_axis[entry::GamepadAxis::Count];
 	};
 
+	/// Event queue counters, see `getEventQueueStats`.
+	///
+	/// Events are delivered through single producer, single consumer ring. Consumer must release
+	/// events in the same order it polled them, `processEvents` and `processWindowEvents` do so.
+	///
+	struct EventQueueStats
+	{
+		EventQueueStats()
+			: m_numPosted(0)
+			, m_numCoalesced(0)
+			, m_numDropped(0)
+		{
+		}
+
+		uint32_t m_numPosted;    //!< Number of events posted into event queue.
+		uint32_t m_numCoalesced; //!< Number of move/axis events merged into previously posted event.
+		uint32_t m_numDropped;   //!< Number of events dropped because event queue was full.
+	};
+
+	/// Returns snapshot of event queue counters. Can be called from any thread.
+	///
+	void getEventQueueStats(EventQueueStats& _stats);
+
 	///
 	bool processEvents(uint32_t& _width, uint32_t& _height, uint32_t& _debug, uint32_t& _reset, MouseState* _mouse = NULL);
 
@@ -652,7 +652,10 @@ namespace graphics
 
 		void* ndt;          //!< Native display type (*nix specific).
 		void* nwh;          //!< Native window handle. If `NULL`, graphics will create a headless
-		                    ///  context/device, provided the rendering API supports it.
+		                    ///  context/device, provided the rendering API supports it. With EGL,
+		                    ///  when `ndt` is also `NULL`, context is created on surfaceless or
+		                    ///  device platform without display server, and there is no back
+		                    ///  buffer, only frame buffers can be rendered to.
 		void* context;      //!< GL context, D3D device, or Vulkan device. If `NULL`, graphics
 		                    ///  will create context/device.
 		void* backBuffer;   //!< GL back-buffer, or D3D render target view. If `NULL` graphics will
@@ -727,8 +730,8 @@ namespace graphics
 
 			uint16_t maxEncoders;       //!< Maximum number of encoder threads.
 			uint32_t minResourceCbSize; //!< Minimum resource command buffer size.
-			uint32_t transientVbSize;   //!< Maximum transient vertex buffer size.
-			uint32_t transientIbSize;   //!< Maximum transient index buffer size.
+			uint32_t transientVbSize;   //!< Transient vertex buffer page size.
+			uint32_t transientIbSize;   //!< Transient index buffer page size.
 		};
 
 		Limits limits; //!< Configurable runtime limits.
@@ -827,8 +830,9 @@ namespace graphics
 			uint32_t maxOcclusionQueries;     //!< Maximum number of occlusion query handles.
 			uint32_t maxEncoders;             //!< Maximum number of encoder threads.
 			uint32_t minResourceCbSize;       //!< Minimum resource command buffer size.
-			uint32_t transientVbSize;         //!< Maximum transient vertex buffer size.
-			uint32_t transientIbSize;         //!< Maximum transient index buffer size.
+			uint32_t transientVbSize;         //!< Transient vertex buffer page size.
+			uint32_t transientIbSize;         //!< Transient index buffer page size.
+			uint32_t readTextureLatency;      //!< Number of frames until texture read back result is available.
 		};
 
 		Limits limits; //!< Renderer runtime limits.
@@ -998,6 +1002,33 @@ namespace graphics
 		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
 	};
 
+	/// View CPU cost counters.
+	///
+	/// @remarks Counters are accumulated by renderer while processing sorted draw and compute
+	///   calls. Previous state is reset at the beginning of each view.
+	///
+	struct ViewCostStats
+	{
+		ViewId   view;              //!< View id.
+		uint32_t numDraw;           //!< Number of draw calls submitted.
+		uint32_t numCompute;        //!< Number of compute calls submitted.
+		uint32_t numPrims;          //!< Number of primitives rendered.
+		uint32_t numStateChanges;   //!< Number of render state changes.
+		uint32_t numBindChanges;    //!< Number of texture/buffer binding changes.
+		uint32_t numProgramChanges; //!< Number of program switches.
+		uint32_t uniformBytes;      //!< Size of uniform data updated in bytes.
+	};
+
+	/// Program CPU cost counters.
+	///
+	struct ProgramStats
+	{
+		ProgramHandle program; //!< Program handle.
+		uint32_t numDraw;      //!< Number of draw calls submitted with program.
+		uint32_t numCompute;   //!< Number of compute calls submitted with program.
+		uint32_t numPrims;     //!< Number of primitives rendered with program.
+	};
+
 	/// Renderer statistics data.
 	///
 	/// @attention C99's equivalent binding is `graphics_stats_t`.
@@ -1019,11 +1050,28 @@ namespace graphics
 		                                    //!  draw commands to underlying graphics API.
 		int64_t waitSubmit;                 //!< Time spent waiting for submit thread to advance to next frame.
 
+		int64_t cpuTimeSort;                //!< API thread CPU time spent sorting and merging draw calls, while render thread
+		                                    //!  is still busy with previous frame.
+		int64_t cpuTimeExecCommands;        //!< Render thread CPU time spent executing resource commands.
+		int64_t cpuTimeSwap;                //!< API thread CPU time spent swapping submit and render frames.
+
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
 		uint32_t gpuFrameNum;               //<! Frame which generated gpuTimeBegin, gpuTimeEnd.
+		uint32_t numDescriptorSets;         //!< Number of descriptor sets allocated (Vulkan).
+		uint32_t numDescriptorSetsReused;   //!< Number of draw and compute calls that reused descriptor set
+		                                    //!  allocated earlier in frame, instead of allocating new one (Vulkan).
+		uint32_t numMergedDraws;            //!< Number of draw calls merged into instanced draw calls.
+		uint32_t numMergeBatches;           //!< Number of instanced draw calls created by merging.
+		uint32_t numUniformCalls;           //!< Number of renderer API calls issued to update uniforms, one per
+		                                    //!  uniform, or one per uniform buffer bind when uniforms are packed
+		                                    //!  into uniform buffers (OpenGL).
+		uint32_t numMultiDraws;             //!< Number of draw calls coalesced into multi-draw indirect calls by
+		                                    //!  renderer (OpenGL).
+		uint32_t numMultiDrawBatches;       //!< Number of multi-draw indirect calls issued for coalesced draw
+		                                    //!  calls (OpenGL).
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
 		uint16_t numDynamicVertexBuffers;   //!< Number of used dynamic vertex buffers.
@@ -1041,6 +1089,10 @@ namespace graphics
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t transientVbPeak;            //!< Peak per frame transient vertex buffer usage in recent frames.
+		int32_t transientIbPeak;            //!< Peak per frame transient index buffer usage in recent frames.
+		int32_t transientVbSize;            //!< Total size of transient vertex buffer pages.
+		int32_t transientIbSize;            //!< Total size of transient index buffer pages.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -1057,6 +1109,41 @@ namespace graphics
 
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
+
+		uint16_t       numViewCostStats;    //!< Number of view cost stats.
+		ViewCostStats* viewCostStats;       //!< Array of view cost stats, in order views were rendered.
+
+		uint16_t      numProgramStats;      //!< Number of program stats.
+		ProgramStats* programStats;         //!< Array of program stats, in order programs were first used.
+	};
+
+	struct VertexLayout;
+
+	/// Static vertex buffer descriptor, used with `graphics::createVertexBuffers`.
+	///
+	struct VertexBufferDesc
+	{
+		const Memory*       mem;    //!< Vertex buffer data.
+		const VertexLayout* layout; //!< Vertex layout.
+		uint16_t            flags;  //!< Buffer creation flags. See `GRAPHICS_BUFFER_*`.
+	};
+
+	/// Static index buffer descriptor, used with `graphics::createIndexBuffers`.
+	///
+	struct IndexBufferDesc
+	{
+		const Memory* mem;   //!< Index buffer data.
+		uint16_t      flags; //!< Buffer creation flags. See `GRAPHICS_BUFFER_*`.
+	};
+
+	/// Texture descriptor, used with `graphics::createTextures`.
+	///
+	struct TextureDesc
+	{
+		const Memory* mem;   //!< DDS, KTX or PVR texture data.
+		uint64_t      flags; //!< Texture creation and sampler flags. See `GRAPHICS_TEXTURE_*` and `GRAPHICS_SAMPLER_*`.
+		uint8_t       skip;  //!< Skip top level mips when parsing texture.
+		TextureInfo*  info;  //!< When non-`NULL` is specified it returns parsed texture information.
 	};
 
 	/// Encoders are used for submitting draw calls from multiple threads. Only one encoder
@@ -1107,6 +1194,15 @@ namespace graphics
 			, uint32_t _rgba = 0
 			);
 
+		/// Set material sort hint. Draw calls submitted to views in `ViewMode::Default`
+		/// and depth sorted views are grouped by material, so draws sharing textures
+		/// and uniforms end up next to each other.
+		///
+		/// @param[in] _material Material id. Only lower `GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL`
+		///   bits are used. Reset to 0 when state is discarded.
+		///
+		void setMaterial(uint32_t _material);
+
 		/// Set condition for rendering.
 		///
 		/// @param[in] _handle Occlusion query handle.
@@ -1465,6 +1561,80 @@ namespace graphics
 			, uint32_t _flags = UINT32_MAX
 			);
 
+		/// Allocate transient index buffer.
+		///
+		/// @param[out] _tib TransientIndexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of indices to allocate.
+		/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
+		///
+		/// @remarks
+		///   Allocation is lock-free, and can be called concurrently from multiple encoder threads.
+		///
+		void allocTransientIndexBuffer(
+			  TransientIndexBuffer* _tib
+			, uint32_t _num
+			, bool _index32 = false
+			);
+
+		/// Allocate transient vertex buffer.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of vertices to allocate.
+		/// @param[in] _layout Vertex layout.
+		///
+		/// @remarks
+		///   Allocation is lock-free. Vertex layout lookup takes resource lock only the first
+		///   time layout is used by this encoder during frame.
+		///
+		void allocTransientVertexBuffer(
+			  TransientVertexBuffer* _tvb
+			, uint32_t _num
+			, const VertexLayout& _layout
+			);
+
+		/// Check for required space and allocate transient vertex and index
+		/// buffers. If both space requirements are satisfied function returns
+		/// true.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _layout Vertex layout.
+		/// @param[in] _numVertices Number of vertices to allocate.
+		/// @param[out] _tib TransientIndexBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _numIndices Number of indices to allocate.
+		/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
+		///
+		/// @remarks
+		///   Allocation is lock-free, see `Encoder::allocTransientVertexBuffer`.
+		///
+		bool allocTransientBuffers(
+			  TransientVertexBuffer* _tvb
+			, const VertexLayout& _layout
+			, uint32_t _numVertices
+			, TransientIndexBuffer* _tib
+			, uint32_t _numIndices
+			, bool _index32 = false
+			);
+
+		/// Allocate instance data buffer.
+		///
+		/// @param[out] _idb InstanceDataBuffer structure will be filled, and will be valid
+		///   for the duration of frame, and can be reused for multiple draw calls.
+		/// @param[in] _num Number of instances.
+		/// @param[in] _stride Instance stride. Must be multiple of 16.
+		///
+		/// @remarks
+		///   Allocation is lock-free, and can be called concurrently from multiple encoder threads.
+		///
+		void allocInstanceDataBuffer(
+			  InstanceDataBuffer* _idb
+			, uint32_t _num
+			, uint16_t _stride
+			);
+
 		/// Submit an empty primitive for rendering. Uniforms and draw state
 		/// will be applied but no geometry will be submitted. Useful in cases
 		/// when no other draw/compute primitive is submitted to view, but it's
@@ -2013,6 +2183,40 @@ namespace graphics
 		, bool _index32
 		);
 
+	/// Sort indices, reusing triangle order from previous call.
+	///
+	/// Intended for meshes re-sorted every frame from slowly moving view. Sort keys are generated
+	/// in previous order, and when they are nearly sorted insertion sort is used instead of full
+	/// radix sort.
+	///
+	/// @param[in] _sort Sort order, see `TopologySort::Enum`.
+	/// @param[in] _dst Destination index buffer.
+	/// @param[in] _dstSize Destination index buffer in bytes.
+	/// @param[in] _dir Direction (vector must be normalized).
+	/// @param[in] _pos Position.
+	/// @param[in] _vertices Pointer to first vertex represented as float x, y, z.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices. Must be the same between calls sharing `_order`.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	/// @param[inout] _order Array of `_numIndices/3` triangle indices. Before first call set
+	///    `_order[0]` to `UINT32_MAX` to request full sort. On return it contains triangle order
+	///    written to `_dst`, which should be passed unmodified to next call.
+	///
+	void topologySortTriList(
+		  TopologySort::Enum _sort
+		, void* _dst
+		, uint32_t _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, uint32_t* _order
+		);
+
 	/// Returns supported backend API renderers.
 	///
 	/// @param[in] _max Maximum number of elements in _enum array.
@@ -2392,6 +2596,33 @@ namespace graphics
 	///
 	void destroy(IndexBufferHandle _handle);
 
+	/// Create multiple static index buffers at once.
+	///
+	/// Resource API lock is taken once for the whole batch, and creation is recorded as a single
+	/// command for the renderer.
+	///
+	/// @param[in] _num Number of index buffers.
+	/// @param[in] _desc Array of `_num` index buffer descriptors.
+	/// @param[out] _handles Array of `_num` handles. Entries for index buffers that couldn't be
+	///   created are set to invalid handle.
+	/// @returns Number of index buffers created.
+	///
+	uint16_t createIndexBuffers(
+		  uint16_t _num
+		, const IndexBufferDesc* _desc
+		, IndexBufferHandle* _handles
+		);
+
+	/// Destroy multiple static index buffers at once.
+	///
+	/// @param[in] _num Number of handles.
+	/// @param[in] _handles Array of `_num` static index buffer handles. Invalid handles are skipped.
+	///
+	void destroy(
+		  uint16_t _num
+		, const IndexBufferHandle* _handles
+		);
+
 	/// Create vertex layout.
 	///
 	/// @attention C99's equivalent binding is `graphics_create_vertex_layout`.
@@ -2453,6 +2684,33 @@ namespace graphics
 	///
 	void destroy(VertexBufferHandle _handle);
 
+	/// Create multiple static vertex buffers at once.
+	///
+	/// Resource API lock is taken once for the whole batch, and creation is recorded as a single
+	/// command for the renderer.
+	///
+	/// @param[in] _num Number of vertex buffers.
+	/// @param[in] _desc Array of `_num` vertex buffer descriptors.
+	/// @param[out] _handles Array of `_num` handles. Entries for vertex buffers that couldn't be
+	///   created are set to invalid handle.
+	/// @returns Number of vertex buffers created.
+	///
+	uint16_t createVertexBuffers(
+		  uint16_t _num
+		, const VertexBufferDesc* _desc
+		, VertexBufferHandle* _handles
+		);
+
+	/// Destroy multiple static vertex buffers at once.
+	///
+	/// @param[in] _num Number of handles.
+	/// @param[in] _handles Array of `_num` static vertex buffer handles. Invalid handles are skipped.
+	///
+	void destroy(
+		  uint16_t _num
+		, const VertexBufferHandle* _handles
+		);
+
 	/// Create empty dynamic index buffer.
 	///
 	/// @param[in] _num Number of indices.
@@ -2891,6 +3149,22 @@ namespace graphics
 		, TextureInfo* _info = NULL
 		);
 
+	/// Create multiple textures from memory buffers at once.
+	///
+	/// Resource API lock is taken once for the whole batch.
+	///
+	/// @param[in] _num Number of textures.
+	/// @param[in] _desc Array of `_num` texture descriptors.
+	/// @param[out] _handles Array of `_num` handles. Entries for textures that couldn't be parsed or
+	///   created are set to invalid handle.
+	/// @returns Number of textures created.
+	///
+	uint16_t createTextures(
+		  uint16_t _num
+		, const TextureDesc* _desc
+		, TextureHandle* _handles
+		);
+
 	/// Create 2D texture.
 	///
 	/// @param[in] _width Width.
@@ -3119,7 +3393,8 @@ namespace graphics
 	/// @param[in] _data Destination buffer.
 	/// @param[in] _mip Mip level.
 	///
-	/// @returns Frame number when the result will be available. See: `graphics::frame`.
+	/// @returns Frame number when the result will be available. See: `graphics::frame`, and
+	///   `Caps::Limits::readTextureLatency`.
 	///
 	/// @attention Texture must be created with `GRAPHICS_TEXTURE_READ_BACK` flag.
 	/// @attention Availability depends on: `GRAPHICS_CAPS_TEXTURE_READ_BACK`.
@@ -3131,6 +3406,39 @@ namespace graphics
 		, uint8_t _mip = 0
 		);
 
+	/// Texture read back completion callback.
+	///
+	/// param[in] _handle Texture handle.
+	/// param[in] _data Destination buffer, now containing texture content.
+	/// param[in] _mip Mip level.
+	/// param[in] _userData User defined data if needed.
+	///
+	typedef void (*ReadTextureFn)(TextureHandle _handle, void* _data, uint8_t _mip, void* _userData);
+
+	/// Read back texture content, and get notified when it's available.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @param[in] _data Destination buffer.
+	/// @param[in] _mip Mip level.
+	/// @param[in] _fn Callback function called from API thread, inside `graphics::frame`, once
+	///   destination buffer is written.
+	/// @param[in] _userData User data to be passed to callback function.
+	///
+	/// @returns Frame number when the result will be available. See: `graphics::frame`.
+	///   `UINT32_MAX` if `GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS` callbacks are already in
+	///   flight, in which case read back is not issued and callback is never called.
+	///
+	/// @attention Texture must be created with `GRAPHICS_TEXTURE_READ_BACK` flag.
+	/// @attention Availability depends on: `GRAPHICS_CAPS_TEXTURE_READ_BACK`.
+	///
+	uint32_t readTexture(
+		  TextureHandle _handle
+		, void* _data
+		, uint8_t _mip
+		, ReadTextureFn _fn
+		, void* _userData = NULL
+		);
+
 	/// Set texture debug name.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3146,6 +3454,19 @@ namespace graphics
 		, int32_t _len = INT32_MAX
 		);
 
+	/// Clamp sampling of texture to mips `[_mip, numMips)`. Used to stream mips in, mips below
+	///   `_mip` are never sampled even if they are not initialized yet.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @param[in] _mip Most detailed mip that can be sampled. 0 removes clamp.
+	///
+	/// @attention Availability depends on: `GRAPHICS_CAPS_TEXTURE_MIN_MIP`.
+	///
+	void setTextureMinMip(
+		  TextureHandle _handle
+		, uint8_t _mip
+		);
+
 	/// Returns texture direct access pointer.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3170,6 +3491,16 @@ namespace graphics
 	///
 	void destroy(TextureHandle _handle);
 
+	/// Destroy multiple textures at once.
+	///
+	/// @param[in] _num Number of handles.
+	/// @param[in] _handles Array of `_num` texture handles. Invalid handles are skipped.
+	///
+	void destroy(
+		  uint16_t _num
+		, const TextureHandle* _handles
+		);
+
 	/// Create frame buffer (simple).
 	///
 	/// @param[in] _width Texture width.
@@ -3343,6 +3674,9 @@ namespace graphics
 	///        model matrix from array is used.
 	///      - `u_modelViewProj mat4` - concatenated model view projection matrix.
 	///      - `u_alphaRef float` - alpha reference value for alpha test.
+	///      - `u_drawModel mat4[N]` - model matrix of each draw call in run coalesced into single
+	///        multi-draw call, indexed with `gl_DrawID` (OpenGL). Vertex shader that declares it
+	///        lets renderer coalesce draw calls that differ by transform.
 	///
 	/// @attention C99's equivalent binding is `graphics_create_uniform`.
 	///
@@ -3587,6 +3921,26 @@ namespace graphics
 		, ViewMode::Enum _mode = ViewMode::Default
 		);
 
+	/// Set view draw call merging rules. After sorting, runs of compatible draw calls
+	/// submitted to the view are merged into single instanced draw call.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _flags Merge rules. See: `GRAPHICS_MERGE_*`.
+	///
+	/// @remarks
+	///   1. Programs used in the view must read model matrix from instance data
+	///      (`i_data0`-`i_data3`), `u_model` holds transform of first draw call in run.
+	///   2. Draw calls with instance data, instance count, indirect buffer, or occlusion
+	///      query are never merged. Merging is disabled when `GRAPHICS_CAPS_INSTANCING`
+	///      is not supported.
+	///   3. Without `GRAPHICS_MERGE_UNIFORMS` only draw calls that don't set uniforms are
+	///      merged into run.
+	///
+	void setViewMerge(
+		  ViewId _id
+		, uint8_t _flags = GRAPHICS_MERGE_TRANSFORM
+		);
+
 	/// Set view frame buffer.
 	///
 	/// @param[in] _id View id.
@@ -3681,6 +4035,15 @@ namespace graphics
 		, uint32_t _rgba = 0
 		);
 
+	/// Set material sort hint. Draw calls submitted to views in `ViewMode::Default`
+	/// and depth sorted views are grouped by material, so draws sharing textures
+	/// and uniforms end up next to each other.
+	///
+	/// @param[in] _material Material id. Only lower `GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL`
+	///   bits are used. Reset to 0 when state is discarded.
+	///
+	void setMaterial(uint32_t _material);
+
 	/// Set condition for rendering.
 	///
 	/// @param[in] _handle Occlusion query handle.
@@ -4361,6 +4724,72 @@ namespace graphics
 		, const char* _filePath
 		);
 
+	/// Request capture of built-in CPU profiler events for next number of frames.
+	///
+	/// @param[in] _numFrames Number of frames to capture.
+	/// @param[in] _filePath Output file path. Capture is written in Chrome trace event format, and
+	///   it can be opened with `chrome://tracing` or Perfetto.
+	///
+	/// @remarks
+	///   Capture records all `GRAPHICS_PROFILER_*` scopes, including sort, command execution,
+	///   renderer submit, and each thread encoder, from all threads.
+	///
+	/// @attention Requires `GRAPHICS_CONFIG_PROFILER_CAPTURE=1`, which is disabled by default.
+	///
+	void requestProfilerCapture(
+		  uint32_t _numFrames
+		, const char* _filePath
+		);
+
+	/// Begin recording submitted frames into capture file.
+	///
+	/// @param[in] _filePath Output file path.
+	///
+	/// @returns True if capture file was created.
+	///
+	/// @remarks
+	///   Capture contains resource commands, sort keys, draw and compute items, bindings,
+	///   uniform data and transient buffer contents of every frame. Resources created before
+	///   capture started are not recorded, call this right after `graphics::init` to make
+	///   capture replayable.
+	///
+	/// @attention Capture file depends on build configuration, and can be replayed only by
+	///   library built with the same configuration.
+	///
+	bool beginFrameCapture(const char* _filePath);
+
+	/// End recording frames.
+	///
+	void endFrameCapture();
+
+	/// Open capture file recorded with `graphics::beginFrameCapture` for replay.
+	///
+	/// @param[in] _filePath Capture file path.
+	///
+	/// @returns True if capture file is compatible with current build and init limits.
+	///   False if capture creates window frame buffers, since native window handles can't
+	///   be replayed, or if any resource handle used by capture is already in use.
+	///
+	/// @remarks
+	///   Replay should be done right after `graphics::init` with the same limits, and
+	///   application must not create any resources or submit anything while replaying.
+	///   Any renderer type can be used, including `RendererType::Noop`.
+	///
+	bool beginFrameReplay(const char* _filePath);
+
+	/// Submit next recorded frame, in place of application's frame. Recorded frame goes
+	///   through the same sort and renderer submit path as `graphics::frame`.
+	///
+	/// @returns False when there are no more recorded frames, or when previous recorded
+	///   frame couldn't be replayed.
+	///
+	bool replayFrame();
+
+	/// Close capture file opened with `graphics::beginFrameReplay`, and destroy resources
+	///   created by replayed frames.
+	///
+	void endFrameReplay();
+
 } // namespace graphics
 
 #endif // GRAPHICS_H_HEADER_GUARD
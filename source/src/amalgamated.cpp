@@ -6,10 +6,12 @@
 #include "graphics.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
+#include "framecapture.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_wgl.cpp"
 #include "glcontext_html5.cpp"
 #include "nvapi.cpp"
+#include "profiler.cpp"
 #include "renderer_agc.cpp"
 #include "renderer_d3d11.cpp"
 #include "renderer_d3d12.cpp"
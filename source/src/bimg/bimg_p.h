@@ -123,6 +123,32 @@ namespace bimg
 		, base::Error* _err
 		);
 
+	///
+	bool imageParseKtx2(
+		  ImageContainer& _imageContainer
+		, base::ReaderSeekerI* _reader
+		, base::Error* _err
+		);
+
+	/// Parse zlib supercompressed KTX2 container, and inflate levels into image container.
+	///
+	ImageContainer* imageParseKtx2(
+		  base::AllocatorI* _allocator
+		, const void* _src
+		, uint32_t _size
+		, base::Error* _err
+		);
+
+	///
+	bool imageGetRawDataKtx2(
+		  const ImageContainer& _imageContainer
+		, uint16_t _side
+		, uint8_t _lod
+		, const void* _data
+		, uint32_t _size
+		, ImageMip& _mip
+		);
+
 } // namespace bimg
 
 #endif // BIMG_P_H_HEADER_GUARD
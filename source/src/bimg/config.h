@@ -56,4 +56,14 @@
 #	define BIMG_DECODE_ETC2 BIMG_DECODE_ENABLE
 #endif // BIMG_DECODE_ETC2
 
+/// Maximum number of threads used to inflate or deflate KTX2 supercompressed levels.
+#ifndef BIMG_CONFIG_KTX2_MAX_THREADS
+#	define BIMG_CONFIG_KTX2_MAX_THREADS 4
+#endif // BIMG_CONFIG_KTX2_MAX_THREADS
+
+/// Minimum amount of level data per thread, smaller containers are processed on calling thread.
+#ifndef BIMG_CONFIG_KTX2_MIN_SIZE_PER_THREAD
+#	define BIMG_CONFIG_KTX2_MIN_SIZE_PER_THREAD (256<<10)
+#endif // BIMG_CONFIG_KTX2_MIN_SIZE_PER_THREAD
+
 #endif // BIMG_CONFIG_H_HEADER_GUARD
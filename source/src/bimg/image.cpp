@@ -1378,7 +1378,7 @@ namespace bimg
 		return uint8_t(result);
 	}
 
-	static void decodeBlockDxt(uint8_t _dst[16*4], const uint8_t _src[8])
+	static void decodeBlockDxtRef(uint8_t _dst[16*4], const uint8_t _src[8])
 	{
 		if (!BASE_ENABLED(BIMG_DECODE_BC2 || BIMG_DECODE_BC3) )
 		{
@@ -1414,7 +1414,7 @@ namespace bimg
 		}
 	}
 
-	static void decodeBlockDxt1(uint8_t _dst[16*4], const uint8_t _src[8])
+	static void decodeBlockDxt1Ref(uint8_t _dst[16*4], const uint8_t _src[8])
 	{
 		if (!BASE_ENABLED(BIMG_DECODE_BC1 || BIMG_DECODE_BC2 || BIMG_DECODE_BC3) )
 		{
@@ -1529,6 +1529,88 @@ namespace bimg
 		}
 	}
 
+	// Color endpoints and interpolated colors are computed once per block into BGRA palette, and
+	// each texel is single 32-bit copy from palette.
+	static void decodeBlockDxtPalette(uint8_t _colors[4*4], const uint8_t _src[8], bool _alpha)
+	{
+		const uint32_t c0 = _src[0] | (_src[1] << 8);
+		const uint32_t c1 = _src[2] | (_src[3] << 8);
+
+		_colors[0] = bitRangeConvert( (c0>> 0)&0x1f, 5, 8);
+		_colors[1] = bitRangeConvert( (c0>> 5)&0x3f, 6, 8);
+		_colors[2] = bitRangeConvert( (c0>>11)&0x1f, 5, 8);
+		_colors[3] = 255;
+
+		_colors[4] = bitRangeConvert( (c1>> 0)&0x1f, 5, 8);
+		_colors[5] = bitRangeConvert( (c1>> 5)&0x3f, 6, 8);
+		_colors[6] = bitRangeConvert( (c1>>11)&0x1f, 5, 8);
+		_colors[7] = 255;
+
+		if (!_alpha
+		||  c0 > c1)
+		{
+			for (uint32_t ii = 0; ii < 3; ++ii)
+			{
+				_colors[ 8+ii] = uint8_t( (2*_colors[ii] +   _colors[4+ii]) / 3);
+				_colors[12+ii] = uint8_t( (  _colors[ii] + 2*_colors[4+ii]) / 3);
+			}
+
+			_colors[11] = 255;
+			_colors[15] = 255;
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < 3; ++ii)
+			{
+				_colors[ 8+ii] = uint8_t( (_colors[ii] + _colors[4+ii]) / 2);
+			}
+
+			_colors[11] = 255;
+			base::memSet(&_colors[12], 0, 4);
+		}
+	}
+
+	static void decodeBlockDxtIndices(uint8_t _dst[16*4], const uint8_t _colors[4*4], const uint8_t _src[8])
+	{
+		const uint32_t indices = 0
+			| (uint32_t(_src[4])      )
+			| (uint32_t(_src[5]) <<  8)
+			| (uint32_t(_src[6]) << 16)
+			| (uint32_t(_src[7]) << 24)
+			;
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			const uint32_t idx = (indices >> (ii*2) ) & 3;
+			base::memCopy(&_dst[ii*4], &_colors[idx*4], 4);
+		}
+	}
+
+	// Unlike decodeBlockDxtRef, alpha is written too (255), so alpha must be decoded after color.
+	static void decodeBlockDxt(uint8_t _dst[16*4], const uint8_t _src[8])
+	{
+		if (!BASE_ENABLED(BIMG_DECODE_BC2 || BIMG_DECODE_BC3) )
+		{
+			return;
+		}
+
+		uint8_t colors[4*4];
+		decodeBlockDxtPalette(colors, _src, false);
+		decodeBlockDxtIndices(_dst, colors, _src);
+	}
+
+	static void decodeBlockDxt1(uint8_t _dst[16*4], const uint8_t _src[8])
+	{
+		if (!BASE_ENABLED(BIMG_DECODE_BC1 || BIMG_DECODE_BC2 || BIMG_DECODE_BC3) )
+		{
+			return;
+		}
+
+		uint8_t colors[4*4];
+		decodeBlockDxtPalette(colors, _src, true);
+		decodeBlockDxtIndices(_dst, colors, _src);
+	}
+
 	// BC6H, BC7
 	//
 	// Reference(s):
@@ -2342,7 +2424,7 @@ namespace bimg
 		{ 2, 6, 0, 0, 5, 5, 1, 0, { 2, 0 } }, // 7
 	};
 
-	static void decodeBlockBc7(uint8_t _dst[16*4], const uint8_t _src[16])
+	static void decodeBlockBc7Ref(uint8_t _dst[16*4], const uint8_t _src[16])
 	{
 		if (!BASE_ENABLED(BIMG_DECODE_BC7) )
 		{
@@ -2534,6 +2616,219 @@ namespace bimg
 		}
 	}
 
+	// Reads BC7 block as 128-bit little endian bit stream.
+	struct Bc7BitReader
+	{
+		Bc7BitReader(const uint8_t _src[16])
+		{
+			base::memCopy(&m_lo, &_src[0], 8);
+			base::memCopy(&m_hi, &_src[8], 8);
+		}
+
+		uint32_t read(uint32_t _numBits)
+		{
+			if (0 == _numBits)
+			{
+				return 0;
+			}
+
+			const uint32_t result = uint32_t(m_lo & ( (UINT64_C(1) << _numBits) - 1) );
+			m_lo = (m_lo >> _numBits) | (m_hi << (64 - _numBits) );
+			m_hi =  m_hi >> _numBits;
+
+			return result;
+		}
+
+		uint64_t m_lo;
+		uint64_t m_hi;
+	};
+
+	// Mode is template argument, so that all field widths and loop counts from mode table are
+	// compile time constants. Instead of computing subset, anchor and weights per texel, index
+	// streams are read sequentially and texels are looked up from per subset palettes.
+	template<uint8_t ModeT>
+	static void decodeBlockBc7Mode(uint8_t _dst[16*4], const uint8_t _src[16])
+	{
+		const Bc7ModeInfo& mi = s_bp7ModeInfo[ModeT];
+		const uint8_t modePBits = 0 != mi.endpointPBits
+			? mi.endpointPBits
+			: mi.sharedPBits
+			;
+
+		Bc7BitReader bit(_src);
+		bit.read(ModeT+1);
+
+		const uint32_t partitionSetIdx    = bit.read(mi.partitionBits);
+		const uint32_t rotationMode       = bit.read(mi.rotationBits);
+		const uint32_t indexSelectionMode = bit.read(mi.indexSelectionBits);
+
+		uint8_t ep[4][6];
+
+		for (uint32_t comp = 0; comp < 3; ++comp)
+		{
+			for (uint32_t ii = 0; ii < mi.numSubsets*2u; ++ii)
+			{
+				ep[comp][ii] = uint8_t(bit.read(mi.colorBits) << modePBits);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < mi.numSubsets*2u; ++ii)
+		{
+			ep[3][ii] = 0 != mi.alphaBits
+				? uint8_t(bit.read(mi.alphaBits) << modePBits)
+				: uint8_t(0xff)
+				;
+		}
+
+		if (0 != modePBits)
+		{
+			for (uint32_t ii = 0; ii < mi.numSubsets; ++ii)
+			{
+				const uint8_t pda = uint8_t(                      bit.read(modePBits)      );
+				const uint8_t pdb = uint8_t(0 == mi.sharedPBits ? bit.read(modePBits) : pda);
+
+				for (uint32_t comp = 0; comp < 4; ++comp)
+				{
+					ep[comp][ii*2+0] |= pda;
+					ep[comp][ii*2+1] |= pdb;
+				}
+			}
+		}
+
+		for (uint32_t ii = 0; ii < mi.numSubsets*2u; ++ii)
+		{
+			for (uint32_t comp = 0; comp < 3; ++comp)
+			{
+				ep[comp][ii] = bitRangeConvert(ep[comp][ii], mi.colorBits + modePBits, 8);
+			}
+
+			if (0 != mi.alphaBits)
+			{
+				ep[3][ii] = bitRangeConvert(ep[3][ii], mi.alphaBits + modePBits, 8);
+			}
+		}
+
+		// With index selection, color uses second index stream, and alpha first one.
+		const bool    hasIndexBits1 = 0 != mi.indexBits[1];
+		const uint8_t colorIndexBits = mi.indexBits[hasIndexBits1 && 0 != indexSelectionMode ? 1 : 0];
+		const uint8_t alphaIndexBits = mi.indexBits[hasIndexBits1 && 0 == indexSelectionMode ? 1 : 0];
+		const uint8_t* colorFactors  = s_bptcFactors[colorIndexBits-2];
+		const uint8_t* alphaFactors  = s_bptcFactors[alphaIndexBits-2];
+
+		uint8_t colorPalette[3][16][4];
+		uint8_t alphaPalette[3][16];
+
+		for (uint32_t subset = 0; subset < mi.numSubsets; ++subset)
+		{
+			for (uint32_t ii = 0, num = 1<<colorIndexBits; ii < num; ++ii)
+			{
+				const uint32_t fb = colorFactors[ii];
+				const uint32_t fa = 64 - fb;
+
+				// Palette is stored as BGR, endpoints as RGB.
+				uint8_t* color = colorPalette[subset][ii];
+				for (uint32_t comp = 0; comp < 3; ++comp)
+				{
+					color[comp] = uint8_t( (ep[2-comp][subset*2]*fa + ep[2-comp][subset*2+1]*fb + 32) >> 6);
+				}
+			}
+
+			for (uint32_t ii = 0, num = 1<<alphaIndexBits; ii < num; ++ii)
+			{
+				const uint32_t fb = alphaFactors[ii];
+				const uint32_t fa = 64 - fb;
+				alphaPalette[subset][ii] = uint8_t( (ep[3][subset*2]*fa + ep[3][subset*2+1]*fb + 32) >> 6);
+			}
+		}
+
+		uint32_t anchor[3] = { 0, 0, 0 };
+		switch (mi.numSubsets)
+		{
+		case 2:
+			anchor[1] = s_bptcA2[partitionSetIdx];
+			break;
+
+		case 3:
+			anchor[1] = s_bptcA3[0][partitionSetIdx];
+			anchor[2] = s_bptcA3[1][partitionSetIdx];
+			break;
+
+		default:
+			break;
+		}
+
+		uint8_t subsetIndex[16];
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			switch (mi.numSubsets)
+			{
+			case 2:  subsetIndex[ii] = uint8_t( (s_bptcP2[partitionSetIdx] >> ii) & 1);      break;
+			case 3:  subsetIndex[ii] = uint8_t( (s_bptcP3[partitionSetIdx] >> (2*ii) ) & 3); break;
+			default: subsetIndex[ii] = 0;                                                     break;
+			}
+		}
+
+		uint8_t index[2][16];
+		for (uint32_t stream = 0; stream < (hasIndexBits1 ? 2u : 1u); ++stream)
+		{
+			for (uint32_t ii = 0; ii < 16; ++ii)
+			{
+				const uint32_t isAnchor = ii == anchor[subsetIndex[ii] ];
+				index[stream][ii] = uint8_t(bit.read(mi.indexBits[stream] - isAnchor) );
+			}
+		}
+
+		const uint8_t* colorIndex = index[hasIndexBits1 && 0 != indexSelectionMode ? 1 : 0];
+		const uint8_t* alphaIndex = index[hasIndexBits1 && 0 == indexSelectionMode ? 1 : 0];
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			const uint32_t subset = subsetIndex[ii];
+
+			uint8_t* bgra = &_dst[ii*4];
+			base::memCopy(bgra, colorPalette[subset][colorIndex[ii] ], 3);
+			bgra[3] = alphaPalette[subset][alphaIndex[ii] ];
+
+			switch (rotationMode)
+			{
+			case 1: base::swap(bgra[3], bgra[2]); break;
+			case 2: base::swap(bgra[3], bgra[1]); break;
+			case 3: base::swap(bgra[3], bgra[0]); break;
+			default:                            break;
+			};
+		}
+	}
+
+	static void decodeBlockBc7(uint8_t _dst[16*4], const uint8_t _src[16])
+	{
+		if (!BASE_ENABLED(BIMG_DECODE_BC7) )
+		{
+			return;
+		}
+
+		typedef void (*DecodeBlockFn)(uint8_t _dst[16*4], const uint8_t _src[16]);
+
+		static const DecodeBlockFn s_decodeBlockBc7Mode[] =
+		{
+			decodeBlockBc7Mode<0>,
+			decodeBlockBc7Mode<1>,
+			decodeBlockBc7Mode<2>,
+			decodeBlockBc7Mode<3>,
+			decodeBlockBc7Mode<4>,
+			decodeBlockBc7Mode<5>,
+			decodeBlockBc7Mode<6>,
+			decodeBlockBc7Mode<7>,
+		};
+
+		if (0 == _src[0])
+		{
+			base::memSet(_dst, 0, 16*4);
+			return;
+		}
+
+		s_decodeBlockBc7Mode[base::uint32_cnttz<uint32_t>(_src[0])](_dst, _src);
+	}
+
 	// ATC
 	//
 	static void decodeBlockATC(uint8_t _dst[16*4], const uint8_t _src[8])
@@ -3317,6 +3612,7 @@ namespace bimg
 		imageContainer->m_ktx         = false;
 		imageContainer->m_pvr3        = false;
 		imageContainer->m_ktxLE       = false;
+		imageContainer->m_ktx2        = false;
 		imageContainer->m_srgb        = false;
 
 		if (NULL != _data)
@@ -3799,6 +4095,7 @@ namespace bimg
 		_imageContainer.m_cubeMap     = cubeMap;
 		_imageContainer.m_ktx         = false;
 		_imageContainer.m_ktxLE       = false;
+		_imageContainer.m_ktx2        = false;
 		_imageContainer.m_pvr3        = false;
 		_imageContainer.m_srgb        = srgb;
 
@@ -4083,6 +4380,12 @@ namespace bimg
 		uint8_t identifier[8];
 		base::read(_reader, identifier, _err);
 
+		if (identifier[1] == '2'
+		&&  identifier[2] == '0')
+		{
+			return imageParseKtx2(_imageContainer, _reader, _err);
+		}
+
 		if (identifier[1] != '1'
 		&&  identifier[2] != '1')
 		{
@@ -4187,6 +4490,7 @@ namespace bimg
 		_imageContainer.m_cubeMap     = numFaces > 1;
 		_imageContainer.m_ktx         = true;
 		_imageContainer.m_ktxLE       = fromLittleEndian;
+		_imageContainer.m_ktx2        = false;
 		_imageContainer.m_pvr3        = false;
 		_imageContainer.m_srgb        = srgb;
 
@@ -4201,6 +4505,11 @@ namespace bimg
 
 	ImageContainer* imageParseKtx(base::AllocatorI* _allocator, const void* _src, uint32_t _size, base::Error* _err)
 	{
+		if (0 != imageGetKtx2InflatedSize(_src, _size) )
+		{
+			return imageParseKtx2(_allocator, _src, _size, _err);
+		}
+
 		return imageParseT<KTX_MAGIC, imageParseKtx>(_allocator, _src, _size, _err);
 	}
 
@@ -4364,6 +4673,7 @@ namespace bimg
 		_imageContainer.m_cubeMap     = numFaces > 1;
 		_imageContainer.m_ktx         = false;
 		_imageContainer.m_ktxLE       = false;
+		_imageContainer.m_ktx2        = false;
 		_imageContainer.m_pvr3        = true;
 		_imageContainer.m_srgb        = colorSpace > 0;
 
@@ -4426,6 +4736,7 @@ namespace bimg
 			_imageContainer.m_cubeMap   = tc.m_cubeMap;
 			_imageContainer.m_ktx       = false;
 			_imageContainer.m_ktxLE     = false;
+			_imageContainer.m_ktx2      = false;
 			_imageContainer.m_pvr3      = false;
 			_imageContainer.m_srgb      = false;
 
@@ -4471,6 +4782,77 @@ namespace bimg
 		}
 	}
 
+	bool imageDecodeBlockToBgra8(void* _dst, const void* _src, TextureFormat::Enum _format, bool _ref)
+	{
+		uint8_t* dst = (uint8_t*)_dst;
+		const uint8_t* src = (const uint8_t*)_src;
+
+		switch (_format)
+		{
+		case TextureFormat::BC1:
+			if (_ref)
+			{
+				decodeBlockDxt1Ref(dst, src);
+			}
+			else
+			{
+				decodeBlockDxt1(dst, src);
+			}
+			return true;
+
+		case TextureFormat::BC2:
+			if (_ref)
+			{
+				decodeBlockDxtRef(dst, src+8);
+			}
+			else
+			{
+				decodeBlockDxt(dst, src+8);
+			}
+
+			decodeBlockDxt23A(dst+3, src);
+			return true;
+
+		case TextureFormat::BC3:
+			if (_ref)
+			{
+				decodeBlockDxtRef(dst, src+8);
+			}
+			else
+			{
+				decodeBlockDxt(dst, src+8);
+			}
+
+			decodeBlockDxt45A(dst+3, src);
+			return true;
+
+		case TextureFormat::BC4:
+			decodeBlockDxt45A(dst, src);
+			return true;
+
+		case TextureFormat::BC5:
+			decodeBlockDxt45A(dst+2, src);
+			decodeBlockDxt45A(dst+1, src+8);
+			return true;
+
+		case TextureFormat::BC7:
+			if (_ref)
+			{
+				decodeBlockBc7Ref(dst, src);
+			}
+			else
+			{
+				decodeBlockBc7(dst, src);
+			}
+			return true;
+
+		default:
+			break;
+		}
+
+		return false;
+	}
+
 	void imageDecodeToBgra8(base::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
 	{
 		const uint8_t* src = (const uint8_t*)_src;
@@ -4515,10 +4897,9 @@ namespace bimg
 				{
 					for (uint32_t xx = 0; xx < width; ++xx)
 					{
+						decodeBlockDxt(temp, src+8);
 						decodeBlockDxt23A(temp+3, src);
-						src += 8;
-						decodeBlockDxt(temp, src);
-						src += 8;
+						src += 16;
 
 						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
 						base::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
@@ -4542,10 +4923,9 @@ namespace bimg
 				{
 					for (uint32_t xx = 0; xx < width; ++xx)
 					{
+						decodeBlockDxt(temp, src+8);
 						decodeBlockDxt45A(temp+3, src);
-						src += 8;
-						decodeBlockDxt(temp, src);
-						src += 8;
+						src += 16;
 
 						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
 						base::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
@@ -5117,6 +5497,11 @@ namespace bimg
 			_size = _imageContainer.m_size;
 		}
 
+		if (_imageContainer.m_ktx2)
+		{
+			return imageGetRawDataKtx2(_imageContainer, _side, _lod, _data, _size, _mip);
+		}
+
 		const uint8_t* data = (const uint8_t*)_data;
 		const uint16_t numSides = _imageContainer.m_numLayers * (_imageContainer.m_cubeMap ? 6 : 1);
 
@@ -0,0 +1,1666 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg/blob/master/LICENSE
+ */
+
+#include "bimg_p.h"
+#include <base/cpu.h>
+#include <base/thread.h>
+#include <base/uint32_t.h>
+
+// KTX2
+#define KTX2_HEADER_SIZE      80
+#define KTX2_LEVEL_INDEX_SIZE 24
+#define KTX2_MAX_LEVELS       32
+
+#define KTX2_SUPERCOMPRESSION_NONE    0
+#define KTX2_SUPERCOMPRESSION_BASISLZ 1
+#define KTX2_SUPERCOMPRESSION_ZSTD    2
+#define KTX2_SUPERCOMPRESSION_ZLIB    3
+
+#define KTX2_DF_MODEL_RGBSDA 1
+#define KTX2_DF_MODEL_BC1A   128
+#define KTX2_DF_MODEL_ETC1   160
+#define KTX2_DF_MODEL_ETC2   161
+#define KTX2_DF_MODEL_ASTC   162
+#define KTX2_DF_MODEL_PVRTC  164
+#define KTX2_DF_MODEL_PVRTC2 165
+
+namespace bimg
+{
+	struct Ktx2FormatInfo
+	{
+		uint32_t m_vkFormat;
+		uint32_t m_vkFormatSrgb;
+	};
+
+	static const Ktx2FormatInfo s_translateKtx2Format[] =
+	{
+		{ 133,        134        }, // BC1
+		{ 135,        136        }, // BC2
+		{ 137,        138        }, // BC3
+		{ 139,        0          }, // BC4
+		{ 141,        0          }, // BC5
+		{ 144,        0          }, // BC6H
+		{ 145,        146        }, // BC7
+		{ 0,          0          }, // ETC1
+		{ 147,        148        }, // ETC2
+		{ 151,        152        }, // ETC2A
+		{ 149,        150        }, // ETC2A1
+		{ 1000054000, 1000054004 }, // PTC12
+		{ 1000054001, 1000054005 }, // PTC14
+		{ 0,          0          }, // PTC12A
+		{ 0,          0          }, // PTC14A
+		{ 1000054002, 1000054006 }, // PTC22
+		{ 1000054003, 1000054007 }, // PTC24
+		{ 0,          0          }, // ATC
+		{ 0,          0          }, // ATCE
+		{ 0,          0          }, // ATCI
+		{ 157,        158        }, // ASTC4x4
+		{ 159,        160        }, // ASTC5x4
+		{ 161,        162        }, // ASTC5x5
+		{ 163,        164        }, // ASTC6x5
+		{ 165,        166        }, // ASTC6x6
+		{ 167,        168        }, // ASTC8x5
+		{ 169,        170        }, // ASTC8x6
+		{ 171,        172        }, // ASTC8x8
+		{ 173,        174        }, // ASTC10x5
+		{ 175,        176        }, // ASTC10x6
+		{ 177,        178        }, // ASTC10x8
+		{ 179,        180        }, // ASTC10x10
+		{ 181,        182        }, // ASTC12x10
+		{ 183,        184        }, // ASTC12x12
+		{ 0,          0          }, // Unknown
+		{ 0,          0          }, // R1
+		{ 0,          0          }, // A8
+		{ 9,          15         }, // R8
+		{ 14,         0          }, // R8I
+		{ 13,         0          }, // R8U
+		{ 10,         0          }, // R8S
+		{ 70,         0          }, // R16
+		{ 75,         0          }, // R16I
+		{ 74,         0          }, // R16U
+		{ 76,         0          }, // R16F
+		{ 71,         0          }, // R16S
+		{ 99,         0          }, // R32I
+		{ 98,         0          }, // R32U
+		{ 100,        0          }, // R32F
+		{ 16,         22         }, // RG8
+		{ 21,         0          }, // RG8I
+		{ 20,         0          }, // RG8U
+		{ 17,         0          }, // RG8S
+		{ 77,         0          }, // RG16
+		{ 82,         0          }, // RG16I
+		{ 81,         0          }, // RG16U
+		{ 83,         0          }, // RG16F
+		{ 78,         0          }, // RG16S
+		{ 102,        0          }, // RG32I
+		{ 101,        0          }, // RG32U
+		{ 103,        0          }, // RG32F
+		{ 23,         29         }, // RGB8
+		{ 28,         0          }, // RGB8I
+		{ 27,         0          }, // RGB8U
+		{ 24,         0          }, // RGB8S
+		{ 123,        0          }, // RGB9E5F
+		{ 44,         50         }, // BGRA8
+		{ 37,         43         }, // RGBA8
+		{ 42,         0          }, // RGBA8I
+		{ 41,         0          }, // RGBA8U
+		{ 38,         0          }, // RGBA8S
+		{ 91,         0          }, // RGBA16
+		{ 96,         0          }, // RGBA16I
+		{ 95,         0          }, // RGBA16U
+		{ 97,         0          }, // RGBA16F
+		{ 92,         0          }, // RGBA16S
+		{ 108,        0          }, // RGBA32I
+		{ 107,        0          }, // RGBA32U
+		{ 109,        0          }, // RGBA32F
+		{ 5,          0          }, // B5G6R5
+		{ 4,          0          }, // R5G6B5
+		{ 3,          0          }, // BGRA4
+		{ 2,          0          }, // RGBA4
+		{ 7,          0          }, // BGR5A1
+		{ 6,          0          }, // RGB5A1
+		{ 64,         0          }, // RGB10A2
+		{ 122,        0          }, // RG11B10F
+	};
+	BASE_STATIC_ASSERT(TextureFormat::UnknownDepth == BASE_COUNTOF(s_translateKtx2Format) );
+
+	static TextureFormat::Enum ktx2TranslateFormat(uint32_t _vkFormat, bool& _srgb)
+	{
+		_srgb = false;
+
+		if (0 == _vkFormat)
+		{
+			return TextureFormat::Unknown;
+		}
+
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(s_translateKtx2Format); ++ii)
+		{
+			if (s_translateKtx2Format[ii].m_vkFormat == _vkFormat)
+			{
+				return TextureFormat::Enum(ii);
+			}
+
+			if (s_translateKtx2Format[ii].m_vkFormatSrgb == _vkFormat)
+			{
+				_srgb = true;
+				return TextureFormat::Enum(ii);
+			}
+		}
+
+		// Alternative encodings of formats above.
+		if (143 == _vkFormat) // VK_FORMAT_BC6H_UFLOAT_BLOCK
+		{
+			return TextureFormat::BC6H;
+		}
+
+		return TextureFormat::Unknown;
+	}
+
+	static uint8_t ktx2GetColorModel(TextureFormat::Enum _format)
+	{
+		if (_format <= TextureFormat::BC7)
+		{
+			return uint8_t(KTX2_DF_MODEL_BC1A + _format - TextureFormat::BC1);
+		}
+
+		switch (_format)
+		{
+		case TextureFormat::ETC1:   return KTX2_DF_MODEL_ETC1;
+		case TextureFormat::ETC2:
+		case TextureFormat::ETC2A:
+		case TextureFormat::ETC2A1: return KTX2_DF_MODEL_ETC2;
+		case TextureFormat::PTC12:
+		case TextureFormat::PTC14:
+		case TextureFormat::PTC12A:
+		case TextureFormat::PTC14A: return KTX2_DF_MODEL_PVRTC;
+		case TextureFormat::PTC22:
+		case TextureFormat::PTC24:  return KTX2_DF_MODEL_PVRTC2;
+		default: break;
+		}
+
+		if (_format >= TextureFormat::ASTC4x4
+		&&  _format <= TextureFormat::ASTC12x12)
+		{
+			return KTX2_DF_MODEL_ASTC;
+		}
+
+		return KTX2_DF_MODEL_RGBSDA;
+	}
+
+	// Level data must be aligned to least common multiple of texel block size and 4.
+	static uint32_t ktx2GetLevelAlignment(TextureFormat::Enum _format)
+	{
+		return base::uint32_lcm(getBlockInfo(_format).blockSize, 4);
+	}
+
+	// Alignment is not necessarily power of two.
+	template<typename Ty>
+	inline Ty ktx2AlignUp(Ty _value, uint32_t _align)
+	{
+		return (_value + _align - 1) / _align * _align;
+	}
+
+	// Size of data type used for endianness conversion.
+	static uint32_t ktx2GetTypeSize(TextureFormat::Enum _format)
+	{
+		if (isCompressed(_format) )
+		{
+			return 1;
+		}
+
+		const ImageBlockInfo& blockInfo = getBlockInfo(_format);
+		return 0 == blockInfo.rBits % 8
+			? base::max<uint32_t>(blockInfo.rBits / 8, 1)
+			: blockInfo.blockSize
+			;
+	}
+
+	template<typename Ty>
+	inline Ty ktx2Read(const uint8_t* _data)
+	{
+		Ty value;
+		base::memCopy(&value, _data, sizeof(Ty) );
+		return base::toHostEndian(value, true);
+	}
+
+	template<typename Ty>
+	inline void ktx2Write(uint8_t* _data, Ty _value)
+	{
+		_value = base::toLittleEndian(_value);
+		base::memCopy(_data, &_value, sizeof(Ty) );
+	}
+
+	struct Ktx2Header
+	{
+		bool read(const void* _data, uint32_t _size)
+		{
+			const uint8_t* data = (const uint8_t*)_data;
+
+			if (KTX2_HEADER_SIZE > _size
+			||  0 != base::memCmp(data, "\xabKTX 20\xbb\r\n\x1a\n", 12) )
+			{
+				return false;
+			}
+
+			m_vkFormat    = ktx2Read<uint32_t>(&data[12]);
+			m_numLevels   = base::max<uint32_t>(ktx2Read<uint32_t>(&data[40]), 1);
+			m_scheme      = ktx2Read<uint32_t>(&data[44]);
+			m_sgdOffset   = ktx2Read<uint64_t>(&data[64]);
+			m_sgdLength   = ktx2Read<uint64_t>(&data[72]);
+			m_levelIndex  = &data[KTX2_HEADER_SIZE];
+			m_format      = ktx2TranslateFormat(m_vkFormat, m_srgb);
+
+			if (KTX2_MAX_LEVELS < m_numLevels
+			||  KTX2_HEADER_SIZE + m_numLevels*KTX2_LEVEL_INDEX_SIZE > _size)
+			{
+				return false;
+			}
+
+			if (m_sgdOffset > _size
+			||  m_sgdLength > _size - m_sgdOffset)
+			{
+				return false;
+			}
+
+			const uint32_t levelIndexEnd = KTX2_HEADER_SIZE + m_numLevels*KTX2_LEVEL_INDEX_SIZE;
+			m_dataOffset = _size;
+
+			for (uint32_t lod = 0; lod < m_numLevels; ++lod)
+			{
+				const uint64_t offset = getLevelOffset(lod);
+				const uint64_t length = getLevelLength(lod);
+
+				if (offset + length > _size
+				||  UINT32_MAX < getLevelUncompressedLength(lod) )
+				{
+					return false;
+				}
+
+				m_dataOffset = base::min(m_dataOffset, uint32_t(offset) );
+			}
+
+			return m_dataOffset >= levelIndexEnd;
+		}
+
+		uint64_t getLevelOffset(uint32_t _lod) const
+		{
+			return ktx2Read<uint64_t>(&m_levelIndex[_lod*KTX2_LEVEL_INDEX_SIZE]);
+		}
+
+		uint64_t getLevelLength(uint32_t _lod) const
+		{
+			return ktx2Read<uint64_t>(&m_levelIndex[_lod*KTX2_LEVEL_INDEX_SIZE + 8]);
+		}
+
+		uint64_t getLevelUncompressedLength(uint32_t _lod) const
+		{
+			return ktx2Read<uint64_t>(&m_levelIndex[_lod*KTX2_LEVEL_INDEX_SIZE + 16]);
+		}
+
+		const uint8_t* m_levelIndex;
+		uint64_t m_sgdOffset;
+		uint64_t m_sgdLength;
+		TextureFormat::Enum m_format;
+		uint32_t m_vkFormat;
+		uint32_t m_numLevels;
+		uint32_t m_scheme;
+		uint32_t m_dataOffset;
+		bool m_srgb;
+	};
+
+	static uint32_t adler32(const uint8_t* _data, uint32_t _size)
+	{
+		uint32_t aa = 1;
+		uint32_t bb = 0;
+
+		while (0 < _size)
+		{
+			// Largest block for which bb doesn't overflow before modulo.
+			const uint32_t num = base::min<uint32_t>(_size, 5552);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				aa += _data[ii];
+				bb += aa;
+			}
+
+			aa %= 65521;
+			bb %= 65521;
+
+			_data += num;
+			_size -= num;
+		}
+
+		return (bb << 16) | aa;
+	}
+
+	static const uint16_t s_deflateLengthBase[29] =
+	{
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+	};
+
+	static const uint8_t s_deflateLengthExtra[29] =
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+	};
+
+	static const uint16_t s_deflateDistBase[30] =
+	{
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+	};
+
+	static const uint8_t s_deflateDistExtra[30] =
+	{
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+	};
+
+	static const uint8_t s_deflateCodeLengthOrder[19] =
+	{
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+	};
+
+	inline uint32_t bitReverse16(uint32_t _value)
+	{
+		_value = ( (_value & 0xaaaa) >> 1) | ( (_value & 0x5555) << 1);
+		_value = ( (_value & 0xcccc) >> 2) | ( (_value & 0x3333) << 2);
+		_value = ( (_value & 0xf0f0) >> 4) | ( (_value & 0x0f0f) << 4);
+		_value = ( (_value & 0xff00) >> 8) | ( (_value & 0x00ff) << 8);
+		return _value;
+	}
+
+	inline uint32_t bitReverse(uint32_t _value, uint32_t _numBits)
+	{
+		return bitReverse16(_value) >> (16 - _numBits);
+	}
+
+#define INFLATE_FAST_BITS 10
+
+	// Canonical Huffman decoder, codes up to INFLATE_FAST_BITS long are decoded with single table
+	// lookup, longer codes are resolved by comparing against per length max code.
+	struct InflateHuffman
+	{
+		bool init(const uint8_t* _lengths, uint32_t _num)
+		{
+			uint32_t sizes[17] = {};
+
+			base::memSet(m_fast, 0, sizeof(m_fast) );
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				++sizes[_lengths[ii] ];
+			}
+
+			sizes[0] = 0;
+
+			uint32_t nextCode[16];
+			uint32_t code   = 0;
+			uint32_t symbol = 0;
+
+			for (uint32_t ii = 1; ii < 16; ++ii)
+			{
+				if (sizes[ii] > (1u << ii) )
+				{
+					return false;
+				}
+
+				nextCode[ii]      = code;
+				m_firstCode[ii]   = uint16_t(code);
+				m_firstSymbol[ii] = uint16_t(symbol);
+
+				code += sizes[ii];
+
+				if (0 != sizes[ii]
+				&&  code - 1 >= (1u << ii) )
+				{
+					return false;
+				}
+
+				m_maxCode[ii] = code << (16 - ii);
+
+				code  <<= 1;
+				symbol += sizes[ii];
+			}
+
+			m_maxCode[16] = 0x10000;
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const uint32_t len = _lengths[ii];
+
+				if (0 != len)
+				{
+					const uint32_t idx = nextCode[len] - m_firstCode[len] + m_firstSymbol[len];
+					m_size[idx]  = uint8_t(len);
+					m_value[idx] = uint16_t(ii);
+
+					if (len <= INFLATE_FAST_BITS)
+					{
+						for (uint32_t jj = bitReverse(nextCode[len], len); jj < (1u << INFLATE_FAST_BITS); jj += 1u << len)
+						{
+							m_fast[jj] = uint16_t( (len << 9) | ii);
+						}
+					}
+
+					++nextCode[len];
+				}
+			}
+
+			return true;
+		}
+
+		uint16_t m_fast[1 << INFLATE_FAST_BITS];
+		uint16_t m_firstCode[16];
+		uint32_t m_maxCode[17];
+		uint16_t m_firstSymbol[16];
+		uint8_t  m_size[288];
+		uint16_t m_value[288];
+	};
+
+	struct Inflate
+	{
+		Inflate(const void* _src, uint32_t _srcSize, void* _dst, uint32_t _dstSize)
+			: m_src( (const uint8_t*)_src)
+			, m_srcEnd( (const uint8_t*)_src + _srcSize)
+			, m_dst( (uint8_t*)_dst)
+			, m_dstBegin( (uint8_t*)_dst)
+			, m_dstEnd( (uint8_t*)_dst + _dstSize)
+			, m_bits(0)
+			, m_numBits(0)
+			, m_numPadding(0)
+		{
+		}
+
+		void refill()
+		{
+			while (m_numBits <= 56)
+			{
+				uint64_t byte = 0;
+
+				if (m_src < m_srcEnd)
+				{
+					byte = *m_src++;
+				}
+				else
+				{
+					// Past end of input is zero filled, and it's detected when it's consumed.
+					++m_numPadding;
+				}
+
+				m_bits    |= byte << m_numBits;
+				m_numBits += 8;
+			}
+		}
+
+		uint32_t getBits(uint32_t _num)
+		{
+			if (m_numBits < _num)
+			{
+				refill();
+			}
+
+			const uint32_t value = uint32_t(m_bits & ( (UINT64_C(1) << _num) - 1) );
+			m_bits    >>= _num;
+			m_numBits  -= _num;
+
+			return value;
+		}
+
+		bool isOverrun() const
+		{
+			return m_numPadding*8 > m_numBits;
+		}
+
+		int32_t decode(const InflateHuffman& _huffman)
+		{
+			if (m_numBits < 16)
+			{
+				refill();
+			}
+
+			const uint32_t fast = _huffman.m_fast[m_bits & ( (1 << INFLATE_FAST_BITS) - 1)];
+
+			if (0 != fast)
+			{
+				const uint32_t len = fast >> 9;
+				m_bits    >>= len;
+				m_numBits  -= len;
+				return int32_t(fast & 511);
+			}
+
+			const uint32_t code = bitReverse16(uint32_t(m_bits & 0xffff) );
+
+			uint32_t len = INFLATE_FAST_BITS + 1;
+			for (; code >= _huffman.m_maxCode[len]; ++len)
+			{
+			}
+
+			if (16 <= len)
+			{
+				return -1;
+			}
+
+			const uint32_t idx = (code >> (16 - len) ) - _huffman.m_firstCode[len] + _huffman.m_firstSymbol[len];
+
+			if (288 <= idx
+			||  _huffman.m_size[idx] != len)
+			{
+				return -1;
+			}
+
+			m_bits    >>= len;
+			m_numBits  -= len;
+
+			return _huffman.m_value[idx];
+		}
+
+		bool stored()
+		{
+			// Discard bits up to byte boundary.
+			getBits(m_numBits & 7);
+
+			const uint32_t len  = getBits(16);
+			const uint32_t nlen = getBits(16);
+
+			if (len != (~nlen & 0xffff)
+			||  len > uint32_t(m_dstEnd - m_dst) )
+			{
+				return false;
+			}
+
+			// Drain bits already fetched, then copy directly from input.
+			uint32_t num = 0;
+			for (; num < len && 0 < m_numBits; ++num)
+			{
+				*m_dst++ = uint8_t(getBits(8) );
+			}
+
+			const uint32_t remaining = len - num;
+			if (remaining > uint32_t(m_srcEnd - m_src) )
+			{
+				return false;
+			}
+
+			base::memCopy(m_dst, m_src, remaining);
+			m_dst += remaining;
+			m_src += remaining;
+
+			return !isOverrun();
+		}
+
+		bool dynamic()
+		{
+			const uint32_t numLitLen  = getBits(5) + 257;
+			const uint32_t numDist    = getBits(5) + 1;
+			const uint32_t numCodeLen = getBits(4) + 4;
+
+			uint8_t codeLen[19] = {};
+			for (uint32_t ii = 0; ii < numCodeLen; ++ii)
+			{
+				codeLen[s_deflateCodeLengthOrder[ii] ] = uint8_t(getBits(3) );
+			}
+
+			if (!m_codeLen.init(codeLen, BASE_COUNTOF(codeLen) ) )
+			{
+				return false;
+			}
+
+			uint8_t lengths[288+32];
+			uint32_t num = 0;
+
+			while (num < numLitLen + numDist)
+			{
+				const int32_t sym = decode(m_codeLen);
+
+				if (0 > sym)
+				{
+					return false;
+				}
+
+				uint32_t repeat = 1;
+				uint8_t  value  = uint8_t(sym);
+
+				if (16 == sym)
+				{
+					if (0 == num)
+					{
+						return false;
+					}
+
+					repeat = getBits(2) + 3;
+					value  = lengths[num-1];
+				}
+				else if (17 == sym)
+				{
+					repeat = getBits(3) + 3;
+					value  = 0;
+				}
+				else if (18 == sym)
+				{
+					repeat = getBits(7) + 11;
+					value  = 0;
+				}
+
+				if (num + repeat > numLitLen + numDist)
+				{
+					return false;
+				}
+
+				base::memSet(&lengths[num], value, repeat);
+				num += repeat;
+			}
+
+			return m_litLen.init(lengths, numLitLen)
+				&& m_dist.init(&lengths[numLitLen], numDist)
+				;
+		}
+
+		void fixed()
+		{
+			uint8_t lengths[288+32];
+			base::memSet(&lengths[  0], 8, 144);
+			base::memSet(&lengths[144], 9, 112);
+			base::memSet(&lengths[256], 7,  24);
+			base::memSet(&lengths[280], 8,   8);
+			base::memSet(&lengths[288], 5,  32);
+
+			m_litLen.init(lengths, 288);
+			m_dist.init(&lengths[288], 32);
+		}
+
+		bool block()
+		{
+			for (;;)
+			{
+				int32_t sym = decode(m_litLen);
+
+				if (256 > sym)
+				{
+					if (0 > sym
+					||  m_dst == m_dstEnd)
+					{
+						return false;
+					}
+
+					*m_dst++ = uint8_t(sym);
+					continue;
+				}
+
+				if (256 == sym)
+				{
+					return !isOverrun();
+				}
+
+				sym -= 257;
+				if (29 <= sym)
+				{
+					return false;
+				}
+
+				const uint32_t len = s_deflateLengthBase[sym] + getBits(s_deflateLengthExtra[sym]);
+
+				const int32_t distSym = decode(m_dist);
+				if (0 > distSym
+				||  30 <= distSym)
+				{
+					return false;
+				}
+
+				const uint32_t dist = s_deflateDistBase[distSym] + getBits(s_deflateDistExtra[distSym]);
+
+				if (dist > uint32_t(m_dst - m_dstBegin)
+				||  len  > uint32_t(m_dstEnd - m_dst)
+				||  isOverrun() )
+				{
+					return false;
+				}
+
+				const uint8_t* from = m_dst - dist;
+
+				if (dist >= len)
+				{
+					base::memCopy(m_dst, from, len);
+				}
+				else if (1 == dist)
+				{
+					base::memSet(m_dst, *from, len);
+				}
+				else
+				{
+					// Overlapping copy repeats pattern.
+					for (uint32_t ii = 0; ii < len; ++ii)
+					{
+						m_dst[ii] = from[ii];
+					}
+				}
+
+				m_dst += len;
+			}
+		}
+
+		bool zlib()
+		{
+			if (2 > m_srcEnd - m_src)
+			{
+				return false;
+			}
+
+			const uint32_t cmf = m_src[0];
+			const uint32_t flg = m_src[1];
+			m_src += 2;
+
+			if (0 != (cmf*256 + flg) % 31
+			||  8 != (cmf & 0xf)
+			||  0 != (flg & 0x20) )
+			{
+				return false;
+			}
+
+			bool final = false;
+
+			while (!final)
+			{
+				final = 0 != getBits(1);
+
+				bool ok = false;
+
+				switch (getBits(2) )
+				{
+				case 0: ok = stored(); break;
+				case 1: fixed(); ok = block(); break;
+				case 2: ok = dynamic() && block(); break;
+				default: break;
+				}
+
+				if (!ok)
+				{
+					return false;
+				}
+			}
+
+			getBits(m_numBits & 7);
+
+			uint32_t adler = 0;
+			for (uint32_t ii = 0; ii < 4; ++ii)
+			{
+				adler = (adler << 8) | getBits(8);
+			}
+
+			return !isOverrun()
+				&& m_dst == m_dstEnd
+				&& adler == adler32(m_dstBegin, uint32_t(m_dst - m_dstBegin) )
+				;
+		}
+
+		const uint8_t* m_src;
+		const uint8_t* m_srcEnd;
+		uint8_t* m_dst;
+		uint8_t* m_dstBegin;
+		uint8_t* m_dstEnd;
+		uint64_t m_bits;
+		uint32_t m_numBits;
+		uint32_t m_numPadding;
+
+		InflateHuffman m_litLen;
+		InflateHuffman m_dist;
+		InflateHuffman m_codeLen;
+	};
+
+#define DEFLATE_HASH_BITS   15
+#define DEFLATE_WINDOW_SIZE 32768
+
+	// Single pass LZ77 with greedy matching and fixed Huffman codes. Ratio is lower than zlib's,
+	// but output is standard zlib stream that any inflater can read.
+	struct Deflate
+	{
+		Deflate(uint8_t* _dst, uint32_t _dstSize)
+			: m_dst(_dst)
+			, m_dstBegin(_dst)
+			, m_dstEnd(_dst + _dstSize)
+			, m_bits(0)
+			, m_numBits(0)
+		{
+		}
+
+		void putBits(uint32_t _value, uint32_t _num)
+		{
+			m_bits    |= uint64_t(_value) << m_numBits;
+			m_numBits += _num;
+
+			while (8 <= m_numBits)
+			{
+				if (m_dst < m_dstEnd)
+				{
+					*m_dst = uint8_t(m_bits);
+				}
+
+				++m_dst;
+				m_bits    >>= 8;
+				m_numBits  -= 8;
+			}
+		}
+
+		void flush()
+		{
+			if (0 != m_numBits)
+			{
+				putBits(0, 8 - m_numBits);
+			}
+		}
+
+		void putLiteral(uint32_t _sym)
+		{
+			if (_sym < 144)
+			{
+				putBits(bitReverse(0x30 + _sym, 8), 8);
+			}
+			else if (_sym < 256)
+			{
+				putBits(bitReverse(0x190 + _sym - 144, 9), 9);
+			}
+			else if (_sym < 280)
+			{
+				putBits(bitReverse(_sym - 256, 7), 7);
+			}
+			else
+			{
+				putBits(bitReverse(0xc0 + _sym - 280, 8), 8);
+			}
+		}
+
+		void putMatch(uint32_t _len, uint32_t _dist)
+		{
+			uint32_t lenSym = 28;
+			while (s_deflateLengthBase[lenSym] > _len)
+			{
+				--lenSym;
+			}
+
+			putLiteral(257 + lenSym);
+			putBits(_len - s_deflateLengthBase[lenSym], s_deflateLengthExtra[lenSym]);
+
+			uint32_t distSym = 29;
+			while (s_deflateDistBase[distSym] > _dist)
+			{
+				--distSym;
+			}
+
+			putBits(bitReverse(distSym, 5), 5);
+			putBits(_dist - s_deflateDistBase[distSym], s_deflateDistExtra[distSym]);
+		}
+
+		static uint32_t hash(const uint8_t* _data)
+		{
+			const uint32_t value = _data[0] | (_data[1] << 8) | (_data[2] << 16);
+			return (value * 2654435761u) >> (32 - DEFLATE_HASH_BITS);
+		}
+
+		void fixed(const uint8_t* _src, uint32_t _size, int32_t* _head)
+		{
+			for (uint32_t ii = 0; ii < (1 << DEFLATE_HASH_BITS); ++ii)
+			{
+				_head[ii] = -1;
+			}
+
+			putBits(1, 1); // final
+			putBits(1, 2); // fixed Huffman
+
+			uint32_t pos = 0;
+
+			while (pos < _size)
+			{
+				if (pos + 3 <= _size)
+				{
+					const uint32_t hh = hash(&_src[pos]);
+					const int32_t candidate = _head[hh];
+					_head[hh] = int32_t(pos);
+
+					if (0 <= candidate
+					&&  pos - uint32_t(candidate) <= DEFLATE_WINDOW_SIZE)
+					{
+						const uint8_t* ref = &_src[candidate];
+						const uint32_t max = base::min<uint32_t>(258, _size - pos);
+
+						uint32_t len = 0;
+						while (len < max
+						&&     ref[len] == _src[pos + len])
+						{
+							++len;
+						}
+
+						if (3 <= len)
+						{
+							putMatch(len, pos - uint32_t(candidate) );
+
+							// Only few positions inside match are hashed, long runs would otherwise
+							// dominate compression time.
+							const uint32_t end = pos + len;
+							for (uint32_t ii = pos + 1, num = base::min(end, pos + 4); ii < num && ii + 3 <= _size; ++ii)
+							{
+								_head[hash(&_src[ii])] = int32_t(ii);
+							}
+
+							pos = end;
+							continue;
+						}
+					}
+				}
+
+				putLiteral(_src[pos]);
+				++pos;
+			}
+
+			putLiteral(256);
+			flush();
+		}
+
+		void stored(const uint8_t* _src, uint32_t _size)
+		{
+			uint32_t pos = 0;
+
+			do
+			{
+				const uint32_t len = base::min<uint32_t>(_size - pos, 65535);
+
+				putBits(pos + len == _size ? 1 : 0, 1);
+				putBits(0, 2);
+				flush();
+				putBits(len, 16);
+				putBits(~len & 0xffff, 16);
+
+				for (uint32_t ii = 0; ii < len; ++ii)
+				{
+					putBits(_src[pos + ii], 8);
+				}
+
+				pos += len;
+			}
+			while (pos < _size);
+		}
+
+		uint32_t zlib(const uint8_t* _src, uint32_t _size, int32_t* _head)
+		{
+			putBits(0x78, 8);
+			putBits(0x01, 8);
+
+			fixed(_src, _size, _head);
+
+			// Incompressible data is stored instead.
+			if (m_dst > m_dstEnd - 4
+			||  uint32_t(m_dst - m_dstBegin) > getStoredSize(_size) )
+			{
+				m_dst     = m_dstBegin + 2;
+				m_bits    = 0;
+				m_numBits = 0;
+				stored(_src, _size);
+			}
+
+			const uint32_t adler = adler32(_src, _size);
+			putBits(adler >> 24, 8);
+			putBits( (adler >> 16) & 0xff, 8);
+			putBits( (adler >>  8) & 0xff, 8);
+			putBits(adler & 0xff, 8);
+
+			return uint32_t(m_dst - m_dstBegin);
+		}
+
+		static uint32_t getStoredSize(uint32_t _size)
+		{
+			return 2 + _size + (_size/65535 + 1)*5;
+		}
+
+		static uint32_t getBound(uint32_t _size)
+		{
+			return getStoredSize(_size) + 4;
+		}
+
+		uint8_t* m_dst;
+		uint8_t* m_dstBegin;
+		uint8_t* m_dstEnd;
+		uint64_t m_bits;
+		uint32_t m_numBits;
+	};
+
+	struct Ktx2Job
+	{
+		const uint8_t* m_src;
+		uint8_t*       m_dst;
+		uint32_t       m_srcSize;
+		uint32_t       m_dstSize;
+	};
+
+	typedef bool (*Ktx2JobFn)(Ktx2Job& _job, base::AllocatorI* _allocator);
+
+	static bool ktx2InflateJob(Ktx2Job& _job, base::AllocatorI* _allocator)
+	{
+		BASE_UNUSED(_allocator);
+
+		Inflate inflate(_job.m_src, _job.m_srcSize, _job.m_dst, _job.m_dstSize);
+		return inflate.zlib();
+	}
+
+	static bool ktx2DeflateJob(Ktx2Job& _job, base::AllocatorI* _allocator)
+	{
+		int32_t* head = (int32_t*)base::alloc(_allocator, sizeof(int32_t) << DEFLATE_HASH_BITS);
+
+		Deflate deflate(_job.m_dst, _job.m_dstSize);
+		_job.m_dstSize = deflate.zlib(_job.m_src, _job.m_srcSize, head);
+
+		base::free(_allocator, head);
+
+		return true;
+	}
+
+	struct Ktx2JobQueue
+	{
+		static int32_t threadFunc(base::Thread* _thread, void* _userData)
+		{
+			BASE_UNUSED(_thread);
+
+			Ktx2JobQueue* queue = (Ktx2JobQueue*)_userData;
+			queue->process();
+
+			return 0;
+		}
+
+		void process()
+		{
+			for (;;)
+			{
+				const int32_t idx = base::atomicFetchAndAdd<int32_t>(&m_next, 1);
+
+				if (idx >= int32_t(m_num) )
+				{
+					break;
+				}
+
+				if (!m_fn(m_job[idx], m_allocator) )
+				{
+					base::atomicFetchAndAdd<int32_t>(&m_numFailed, 1);
+				}
+			}
+		}
+
+		// Jobs are processed in order, caller should put largest levels first.
+		bool run(Ktx2JobFn _fn, Ktx2Job* _job, uint32_t _num, base::AllocatorI* _allocator)
+		{
+			m_fn        = _fn;
+			m_job       = _job;
+			m_num       = _num;
+			m_allocator = _allocator;
+			m_next      = 0;
+			m_numFailed = 0;
+
+			uint32_t total = 0;
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				total += _job[ii].m_srcSize;
+			}
+
+			const uint32_t numThreads = total >= BIMG_CONFIG_KTX2_MIN_SIZE_PER_THREAD
+				? base::min<uint32_t>(_num, BIMG_CONFIG_KTX2_MAX_THREADS, total/BIMG_CONFIG_KTX2_MIN_SIZE_PER_THREAD)
+				: 1
+				;
+
+			base::Thread thread[BIMG_CONFIG_KTX2_MAX_THREADS];
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				thread[ii].init(threadFunc, this, 0, "bimg-ktx2");
+			}
+
+			process();
+
+			for (uint32_t ii = 1; ii < numThreads; ++ii)
+			{
+				thread[ii].shutdown();
+			}
+
+			return 0 == m_numFailed;
+		}
+
+		Ktx2JobFn m_fn;
+		Ktx2Job*  m_job;
+		uint32_t  m_num;
+		base::AllocatorI* m_allocator;
+		int32_t   m_next;
+		int32_t   m_numFailed;
+	};
+
+	bool imageParseKtx2(ImageContainer& _imageContainer, base::ReaderSeekerI* _reader, base::Error* _err)
+	{
+		BASE_ERROR_SCOPE(_err);
+
+		uint32_t vkFormat;
+		base::read(_reader, vkFormat, _err);
+
+		uint32_t typeSize;
+		base::read(_reader, typeSize, _err);
+
+		uint32_t width;
+		base::read(_reader, width, _err);
+
+		uint32_t height;
+		base::read(_reader, height, _err);
+
+		uint32_t depth;
+		base::read(_reader, depth, _err);
+
+		uint32_t numLayers;
+		base::read(_reader, numLayers, _err);
+
+		uint32_t numFaces;
+		base::read(_reader, numFaces, _err);
+
+		uint32_t numMips;
+		base::read(_reader, numMips, _err);
+
+		uint32_t scheme;
+		base::read(_reader, scheme, _err);
+
+		// DFD, KVD, and SGD offsets and sizes.
+		uint8_t index[32];
+		base::read(_reader, index, sizeof(index), _err);
+
+		if (!_err->isOk() )
+		{
+			return false;
+		}
+
+		BASE_UNUSED(typeSize, index);
+
+		// Level index follows header.
+		const int64_t offset = base::seek(_reader);
+
+		bool srgb = false;
+		const TextureFormat::Enum format = ktx2TranslateFormat(vkFormat, srgb);
+
+		_imageContainer.m_allocator   = NULL;
+		_imageContainer.m_data        = NULL;
+		_imageContainer.m_size        = 0;
+		_imageContainer.m_offset      = (uint32_t)offset;
+		_imageContainer.m_width       = width;
+		_imageContainer.m_height      = base::max<uint32_t>(height, 1);
+		_imageContainer.m_depth       = depth;
+		_imageContainer.m_format      = format;
+		_imageContainer.m_orientation = Orientation::R0;
+		_imageContainer.m_numLayers   = uint16_t(base::max<uint32_t>(numLayers, 1) );
+		_imageContainer.m_numMips     = uint8_t(base::max<uint32_t>(numMips, 1) );
+		_imageContainer.m_hasAlpha    = false;
+		_imageContainer.m_cubeMap     = numFaces > 1;
+		_imageContainer.m_ktx         = false;
+		_imageContainer.m_ktxLE       = false;
+		_imageContainer.m_ktx2        = true;
+		_imageContainer.m_pvr3        = false;
+		_imageContainer.m_srgb        = srgb;
+
+		if (KTX2_SUPERCOMPRESSION_NONE != scheme
+		&&  KTX2_SUPERCOMPRESSION_ZLIB != scheme)
+		{
+			// BasisLZ and Zstandard levels are only accessible through `imageGetKtx2Level`.
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Unsupported supercompression scheme, use imageGetKtx2Level.");
+			return false;
+		}
+
+		if (TextureFormat::Unknown == format)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Unrecognized image format.");
+			return false;
+		}
+
+		if (KTX2_MAX_LEVELS < numMips)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Too many levels.");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool imageGetRawDataKtx2(const ImageContainer& _imageContainer, uint16_t _side, uint8_t _lod, const void* _data, uint32_t _size, ImageMip& _mip)
+	{
+		const uint8_t* data = (const uint8_t*)_data;
+
+		// Supercompressed levels must be inflated first, see `imageInflateKtx2`.
+		if (KTX2_HEADER_SIZE > _size
+		||  KTX2_SUPERCOMPRESSION_NONE != ktx2Read<uint32_t>(&data[44])
+		||  _lod >= _imageContainer.m_numMips)
+		{
+			return false;
+		}
+
+		const TextureFormat::Enum format = TextureFormat::Enum(_imageContainer.m_format);
+		const ImageBlockInfo& blockInfo = getBlockInfo(format);
+		const uint32_t blockWidth  = blockInfo.blockWidth;
+		const uint32_t blockHeight = blockInfo.blockHeight;
+		const uint32_t blockSize   = blockInfo.blockSize;
+
+		uint32_t width  = base::max<uint32_t>(1, _imageContainer.m_width  >> _lod);
+		uint32_t height = base::max<uint32_t>(1, _imageContainer.m_height >> _lod);
+		uint32_t depth  = base::max<uint32_t>(1, _imageContainer.m_depth  >> _lod);
+
+		width  = base::max<uint32_t>(blockWidth  * blockInfo.minBlockX, ( (width  + blockWidth  - 1) / blockWidth )*blockWidth);
+		height = base::max<uint32_t>(blockHeight * blockInfo.minBlockY, ( (height + blockHeight - 1) / blockHeight)*blockHeight);
+
+		const uint32_t mipSize = width/blockWidth * height/blockHeight * depth * blockSize;
+
+		const uint32_t levelIndex = _imageContainer.m_offset + _lod*KTX2_LEVEL_INDEX_SIZE;
+		if (levelIndex + KTX2_LEVEL_INDEX_SIZE > _size)
+		{
+			return false;
+		}
+
+		// Level contains all layers and faces of mip.
+		const uint64_t offset = ktx2Read<uint64_t>(&data[levelIndex]) + uint64_t(_side)*mipSize;
+		if (offset + mipSize > _size)
+		{
+			return false;
+		}
+
+		_mip.m_width     = width;
+		_mip.m_height    = height;
+		_mip.m_depth     = depth;
+		_mip.m_blockSize = blockSize;
+		_mip.m_size      = mipSize;
+		_mip.m_data      = &data[offset];
+		_mip.m_bpp       = blockInfo.bitsPerPixel;
+		_mip.m_format    = format;
+		_mip.m_hasAlpha  = _imageContainer.m_hasAlpha;
+
+		return true;
+	}
+
+	uint32_t imageGetKtx2InflatedSize(const void* _src, uint32_t _size)
+	{
+		Ktx2Header header;
+		if (!header.read(_src, _size)
+		||  KTX2_SUPERCOMPRESSION_ZLIB != header.m_scheme
+		||  TextureFormat::Unknown == header.m_format)
+		{
+			return 0;
+		}
+
+		const uint32_t align = ktx2GetLevelAlignment(header.m_format);
+
+		// Levels are stored from smallest to largest.
+		uint64_t offset = header.m_dataOffset;
+		for (uint32_t lod = header.m_numLevels; lod > 0; --lod)
+		{
+			offset  = ktx2AlignUp(offset, align);
+			offset += header.getLevelUncompressedLength(lod-1);
+		}
+
+		return offset > UINT32_MAX ? 0 : uint32_t(offset);
+	}
+
+	bool imageInflateKtx2(base::AllocatorI* _allocator, void* _dst, uint32_t _dstSize, const void* _src, uint32_t _srcSize, base::Error* _err)
+	{
+		BASE_ERROR_SCOPE(_err);
+
+		const uint32_t size = imageGetKtx2InflatedSize(_src, _srcSize);
+		if (0 == size
+		||  size > _dstSize)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Not supercompressed, or destination is too small.");
+			return false;
+		}
+
+		Ktx2Header header;
+		header.read(_src, _srcSize);
+
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		// Header, level index, DFD and KVD are kept, and level index is patched to point at
+		// inflated levels.
+		base::memCopy(dst, src, header.m_dataOffset);
+		ktx2Write<uint32_t>(&dst[44], KTX2_SUPERCOMPRESSION_NONE);
+		ktx2Write<uint64_t>(&dst[64], 0); // sgdByteOffset
+		ktx2Write<uint64_t>(&dst[72], 0); // sgdByteLength
+
+		const uint32_t align = ktx2GetLevelAlignment(header.m_format);
+
+		Ktx2Job job[KTX2_MAX_LEVELS];
+
+		uint32_t offset = header.m_dataOffset;
+		for (uint32_t lod = header.m_numLevels; lod > 0; --lod)
+		{
+			const uint32_t aligned = ktx2AlignUp(offset, align);
+			base::memSet(&dst[offset], 0, aligned - offset);
+			offset = aligned;
+
+			const uint32_t length = uint32_t(header.getLevelUncompressedLength(lod-1) );
+
+			uint8_t* levelIndex = &dst[KTX2_HEADER_SIZE + (lod-1)*KTX2_LEVEL_INDEX_SIZE];
+			ktx2Write<uint64_t>(&levelIndex[ 0], offset);
+			ktx2Write<uint64_t>(&levelIndex[ 8], length);
+			ktx2Write<uint64_t>(&levelIndex[16], length);
+
+			Ktx2Job& jj = job[lod-1];
+			jj.m_src     = &src[header.getLevelOffset(lod-1)];
+			jj.m_srcSize = uint32_t(header.getLevelLength(lod-1) );
+			jj.m_dst     = &dst[offset];
+			jj.m_dstSize = length;
+
+			offset += length;
+		}
+
+		Ktx2JobQueue queue;
+		if (!queue.run(ktx2InflateJob, job, header.m_numLevels, _allocator) )
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Failed to inflate level.");
+			return false;
+		}
+
+		return true;
+	}
+
+	ImageContainer* imageParseKtx2(base::AllocatorI* _allocator, const void* _src, uint32_t _size, base::Error* _err)
+	{
+		BASE_ERROR_SCOPE(_err);
+
+		const uint32_t inflatedSize = imageGetKtx2InflatedSize(_src, _size);
+		if (0 == inflatedSize)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Not supercompressed.");
+			return NULL;
+		}
+
+		ImageContainer imageContainer;
+		if (!imageParse(imageContainer, _src, _size, _err) )
+		{
+			return NULL;
+		}
+
+		ImageContainer* output = imageAlloc(_allocator
+			, imageContainer.m_format
+			, uint16_t(imageContainer.m_width)
+			, uint16_t(imageContainer.m_height)
+			, uint16_t(imageContainer.m_depth)
+			, imageContainer.m_numLayers
+			, imageContainer.m_cubeMap
+			, 1 < imageContainer.m_numMips
+			);
+
+		output->m_hasAlpha = imageContainer.m_hasAlpha;
+		output->m_srgb     = imageContainer.m_srgb;
+
+		const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+
+		Ktx2Header header;
+		header.read(_src, _size);
+
+		const uint8_t* src = (const uint8_t*)_src;
+
+		Ktx2Job job[KTX2_MAX_LEVELS];
+
+		// Output has mips of single side stored next to each other, so levels are inflated
+		// directly into output when level sizes match.
+		bool direct = 1 == numSides
+			&& output->m_numMips == imageContainer.m_numMips
+			;
+
+		for (uint8_t lod = 0; lod < imageContainer.m_numMips && direct; ++lod)
+		{
+			ImageMip dstMip;
+			imageGetRawData(*output, 0, lod, output->m_data, output->m_size, dstMip);
+
+			Ktx2Job& jj = job[lod];
+			jj.m_src     = &src[header.getLevelOffset(lod)];
+			jj.m_srcSize = uint32_t(header.getLevelLength(lod) );
+			jj.m_dst     = const_cast<uint8_t*>(dstMip.m_data);
+			jj.m_dstSize = dstMip.m_size;
+
+			direct = dstMip.m_size == header.getLevelUncompressedLength(lod);
+		}
+
+		if (direct)
+		{
+			Ktx2JobQueue queue;
+			if (!queue.run(ktx2InflateJob, job, imageContainer.m_numMips, _allocator) )
+			{
+				BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Failed to inflate level.");
+				imageFree(output);
+				return NULL;
+			}
+
+			return output;
+		}
+
+		// Levels interleave layers and faces, inflate whole container first and then scatter sides.
+		void* temp = base::alloc(_allocator, inflatedSize);
+
+		if (!imageInflateKtx2(_allocator, temp, inflatedSize, _src, _size, _err) )
+		{
+			base::free(_allocator, temp);
+			imageFree(output);
+			return NULL;
+		}
+
+		for (uint16_t side = 0; side < numSides; ++side)
+		{
+			for (uint8_t lod = 0, num = imageContainer.m_numMips; lod < num; ++lod)
+			{
+				ImageMip dstMip;
+				if (imageGetRawData(*output, side, lod, output->m_data, output->m_size, dstMip) )
+				{
+					ImageMip mip;
+					if (imageGetRawData(imageContainer, side, lod, temp, inflatedSize, mip) )
+					{
+						base::memCopy(const_cast<uint8_t*>(dstMip.m_data), mip.m_data, base::min(mip.m_size, dstMip.m_size) );
+					}
+				}
+			}
+		}
+
+		base::free(_allocator, temp);
+
+		return output;
+	}
+
+	int32_t imageWriteKtx2(base::AllocatorI* _allocator, base::WriterI* _writer, ImageContainer& _imageContainer, const void* _data, uint32_t _size, bool _supercompress, base::Error* _err)
+	{
+		BASE_ERROR_SCOPE(_err);
+
+		const TextureFormat::Enum format = TextureFormat::Enum(_imageContainer.m_format);
+
+		const uint32_t vkFormat = _imageContainer.m_srgb && 0 != s_translateKtx2Format[format].m_vkFormatSrgb
+			? s_translateKtx2Format[format].m_vkFormatSrgb
+			: s_translateKtx2Format[format].m_vkFormat
+			;
+
+		if (0 == vkFormat)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Unsupported image format.");
+			return 0;
+		}
+
+		const uint32_t numMips   = _imageContainer.m_numMips;
+		const uint32_t numLayers = _imageContainer.m_numLayers;
+		const uint32_t numFaces  = _imageContainer.m_cubeMap ? 6 : 1;
+		const uint32_t numSides  = numLayers * numFaces;
+
+		if (KTX2_MAX_LEVELS < numMips)
+		{
+			BASE_ERROR_SET(_err, BIMG_ERROR, "KTX2: Too many levels.");
+			return 0;
+		}
+
+		// Level contains all layers and faces of mip. Single side levels are referenced directly
+		// from source.
+		Ktx2Job job[KTX2_MAX_LEVELS];
+		uint8_t* levelData[KTX2_MAX_LEVELS] = {};
+
+		for (uint8_t lod = 0; lod < numMips; ++lod)
+		{
+			ImageMip mip;
+			imageGetRawData(_imageContainer, 0, lod, _data, _size, mip);
+
+			Ktx2Job& jj = job[lod];
+			jj.m_srcSize = mip.m_size * numSides;
+
+			if (1 == numSides)
+			{
+				jj.m_src = mip.m_data;
+			}
+			else
+			{
+				levelData[lod] = (uint8_t*)base::alloc(_allocator, jj.m_srcSize);
+
+				for (uint16_t side = 0; side < numSides; ++side)
+				{
+					imageGetRawData(_imageContainer, side, lod, _data, _size, mip);
+					base::memCopy(&levelData[lod][side*mip.m_size], mip.m_data, mip.m_size);
+				}
+
+				jj.m_src = levelData[lod];
+			}
+
+			jj.m_dst     = NULL;
+			jj.m_dstSize = jj.m_srcSize;
+		}
+
+		if (_supercompress)
+		{
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				Ktx2Job& jj = job[lod];
+				jj.m_dstSize = Deflate::getBound(jj.m_srcSize);
+				jj.m_dst     = (uint8_t*)base::alloc(_allocator, jj.m_dstSize);
+			}
+
+			Ktx2JobQueue queue;
+			queue.run(ktx2DeflateJob, job, numMips, _allocator);
+		}
+
+		const ImageBlockInfo& blockInfo = getBlockInfo(format);
+
+		const uint32_t dfdOffset = KTX2_HEADER_SIZE + numMips*KTX2_LEVEL_INDEX_SIZE;
+		const uint32_t dfdSize   = 28;
+		const uint32_t align     = _supercompress ? 1 : ktx2GetLevelAlignment(format);
+
+		uint64_t levelOffset[KTX2_MAX_LEVELS];
+
+		uint64_t offset = dfdOffset + dfdSize;
+		for (uint32_t lod = numMips; lod > 0; --lod)
+		{
+			offset = ktx2AlignUp(offset, align);
+			levelOffset[lod-1] = offset;
+			offset += job[lod-1].m_dstSize;
+		}
+
+		int32_t total = 0;
+		total += base::write(_writer, "\xabKTX 20\xbb\r\n\x1a\n", 12, _err);
+		total += base::write(_writer, vkFormat, _err);
+		total += base::write(_writer, ktx2GetTypeSize(format), _err);
+		total += base::write(_writer, _imageContainer.m_width, _err);
+		total += base::write(_writer, _imageContainer.m_height, _err);
+		total += base::write(_writer, _imageContainer.m_depth > 1 ? _imageContainer.m_depth : 0, _err);
+		total += base::write(_writer, numLayers > 1 ? numLayers : 0, _err);
+		total += base::write(_writer, numFaces, _err);
+		total += base::write(_writer, numMips, _err);
+		total += base::write(_writer, uint32_t(_supercompress ? KTX2_SUPERCOMPRESSION_ZLIB : KTX2_SUPERCOMPRESSION_NONE), _err);
+		total += base::write(_writer, dfdOffset, _err);
+		total += base::write(_writer, dfdSize, _err);
+		total += base::write(_writer, uint32_t(0), _err); // kvdByteOffset
+		total += base::write(_writer, uint32_t(0), _err); // kvdByteLength
+		total += base::write(_writer, uint64_t(0), _err); // sgdByteOffset
+		total += base::write(_writer, uint64_t(0), _err); // sgdByteLength
+
+		for (uint32_t lod = 0; lod < numMips; ++lod)
+		{
+			total += base::write(_writer, levelOffset[lod], _err);
+			total += base::write(_writer, uint64_t(job[lod].m_dstSize), _err);
+			total += base::write(_writer, uint64_t(job[lod].m_srcSize), _err);
+		}
+
+		// Basic data format descriptor without samples, readers are expected to use vkFormat.
+		const uint32_t dfd[7] =
+		{
+			dfdSize,
+			0,                                      // vendorId, descriptorType
+			2 | (24 << 16),                         // versionNumber, descriptorBlockSize
+			uint32_t(ktx2GetColorModel(format) )
+				| (1 << 8)                          // BT709 primaries
+				| ( (_imageContainer.m_srgb ? 2 : 1) << 16), // transfer function
+			uint32_t(blockInfo.blockWidth - 1) | (uint32_t(blockInfo.blockHeight - 1) << 8),
+			_supercompress ? 0 : uint32_t(blockInfo.blockSize),
+			0,
+		};
+		total += base::write(_writer, dfd, sizeof(dfd), _err);
+
+		uint64_t pos = dfdOffset + dfdSize;
+		for (uint32_t lod = numMips; lod > 0 && _err->isOk(); --lod)
+		{
+			static const uint8_t padding[16] = {};
+			total += base::write(_writer, padding, int32_t(levelOffset[lod-1] - pos), _err);
+
+			const Ktx2Job& jj = job[lod-1];
+			total += base::write(_writer, _supercompress ? jj.m_dst : jj.m_src, int32_t(jj.m_dstSize), _err);
+
+			pos = levelOffset[lod-1] + jj.m_dstSize;
+		}
+
+		for (uint32_t lod = 0; lod < numMips; ++lod)
+		{
+			if (_supercompress)
+			{
+				base::free(_allocator, job[lod].m_dst);
+			}
+
+			if (NULL != levelData[lod])
+			{
+				base::free(_allocator, levelData[lod]);
+			}
+		}
+
+		return total;
+	}
+
+	bool imageGetKtx2Level(const void* _src, uint32_t _size, uint8_t _lod, Ktx2Level& _level)
+	{
+		Ktx2Header header;
+		if (!header.read(_src, _size)
+		||  _lod >= header.m_numLevels)
+		{
+			return false;
+		}
+
+		const uint8_t* data = (const uint8_t*)_src;
+
+		_level.m_vkFormat         = header.m_vkFormat;
+		_level.m_scheme           = header.m_scheme;
+		_level.m_size             = uint32_t(header.getLevelLength(_lod) );
+		_level.m_uncompressedSize = uint32_t(header.getLevelUncompressedLength(_lod) );
+		_level.m_globalDataSize   = uint32_t(header.m_sgdLength);
+		_level.m_data             = &data[header.getLevelOffset(_lod)];
+		_level.m_globalData       = 0 != header.m_sgdLength ? &data[header.m_sgdOffset] : NULL;
+
+		return true;
+	}
+
+	uint32_t zlibDeflateBound(uint32_t _size)
+	{
+		return Deflate::getBound(_size);
+	}
+
+	uint32_t zlibDeflate(base::AllocatorI* _allocator, void* _dst, uint32_t _dstSize, const void* _src, uint32_t _srcSize)
+	{
+		Ktx2Job job;
+		job.m_src     = (const uint8_t*)_src;
+		job.m_dst     = (uint8_t*)_dst;
+		job.m_srcSize = _srcSize;
+		job.m_dstSize = _dstSize;
+		ktx2DeflateJob(job, _allocator);
+
+		return job.m_dstSize;
+	}
+
+	bool zlibInflate(void* _dst, uint32_t _dstSize, const void* _src, uint32_t _srcSize)
+	{
+		Inflate inflate(_src, _srcSize, _dst, _dstSize);
+		return inflate.zlib();
+	}
+
+} // namespace bimg
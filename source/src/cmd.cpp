@@ -16,9 +16,33 @@
 #include <string>
 #include <unordered_map>
 
+struct CmdFunc
+{
+	ConsoleFn m_fn;
+	void* m_userData;
+};
+
+struct CmdLine
+{
+	uint32_t m_hash;
+	int m_argc;
+	char** m_argv;
+	const char* m_text;
+
+	mutable uint32_t m_generation;
+	mutable CmdFunc m_func;
+};
+
+struct CmdCompiled
+{
+	uint32_t m_num;
+	CmdLine* m_line;
+};
+
 struct CmdContext
 {
 	CmdContext()
+		: m_generation(1)
 	{
 	}
 
@@ -31,8 +55,9 @@ struct CmdContext
 		const uint32_t cmd = base::hash<base::HashMurmur2A>(_name, (uint32_t)base::strLen(_name) );
 		BASE_ASSERT(m_lookup.end() == m_lookup.find(cmd), "Command \"%s\" already exist.", _name);
 
-		Func fn = { _fn, _userData };
+		CmdFunc fn = { _fn, _userData };
 		m_lookup.insert(std::make_pair(cmd, fn) );
+		++m_generation;
 	}
 
 	void remove(const char* _name)
@@ -43,6 +68,24 @@ struct CmdContext
 		if (it != m_lookup.end() )
 		{
 			m_lookup.erase(it);
+			++m_generation;
+		}
+	}
+
+	static void report(int _err, const char* _cmd)
+	{
+		switch (_err)
+		{
+		case 0:
+			break;
+
+		case -1:
+			DBG("Command '%s' doesn't exist.", _cmd);
+			break;
+
+		default:
+			DBG("Failed '%s' err: %d.", _cmd, _err);
+			break;
 		}
 	}
 
@@ -62,41 +105,56 @@ struct CmdContext
 				CmdLookup::iterator it = m_lookup.find(cmd);
 				if (it != m_lookup.end() )
 				{
-					Func& fn = it->second;
+					CmdFunc& fn = it->second;
 					err = fn.m_fn(this, fn.m_userData, argc, argv);
 				}
 
-				switch (err)
+				if (0 != err)
 				{
-				case 0:
-					break;
-
-				case -1:
-					{
-						std::string tmp(_cmd, next.getPtr()-_cmd - (next.isEmpty() ? 0 : 1) );
-						DBG("Command '%s' doesn't exist.", tmp.c_str() );
-					}
-					break;
-
-				default:
-					{
-						std::string tmp(_cmd, next.getPtr()-_cmd - (next.isEmpty() ? 0 : 1) );
-						DBG("Failed '%s' err: %d.", tmp.c_str(), err);
-					}
-					break;
+					std::string tmp(_cmd, next.getPtr()-_cmd - (next.isEmpty() ? 0 : 1) );
+					report(err, tmp.c_str() );
 				}
 			}
 		}
 	}
 
-	struct Func
+	void exec(const CmdCompiled* _cmd)
 	{
-		ConsoleFn m_fn;
-		void* m_userData;
-	};
+		for (uint32_t ii = 0; ii < _cmd->m_num; ++ii)
+		{
+			const CmdLine& line = _cmd->m_line[ii];
+
+			// Lookup is cached in compiled command, and redone only when commands were added or
+			// removed since it was last executed.
+			if (line.m_generation != m_generation)
+			{
+				CmdLookup::const_iterator it = m_lookup.find(line.m_hash);
+				if (it != m_lookup.end() )
+				{
+					line.m_func = it->second;
+				}
+				else
+				{
+					line.m_func.m_fn       = NULL;
+					line.m_func.m_userData = NULL;
+				}
+
+				line.m_generation = m_generation;
+			}
 
-	typedef std::unordered_map<uint32_t, Func> CmdLookup;
+			int err = -1;
+			if (NULL != line.m_func.m_fn)
+			{
+				err = line.m_func.m_fn(this, line.m_func.m_userData, line.m_argc, line.m_argv);
+			}
+
+			report(err, line.m_text);
+		}
+	}
+
+	typedef std::unordered_map<uint32_t, CmdFunc> CmdLookup;
 	CmdLookup m_lookup;
+	uint32_t m_generation;
 };
 
 static CmdContext* s_cmdContext;
@@ -132,3 +190,109 @@ void cmdExec(const char* _format, ...)
 
 	s_cmdContext->exec(tmp);
 }
+
+CmdCompiled* cmdCompile(const char* _cmd)
+{
+	if (NULL == _cmd)
+	{
+		return NULL;
+	}
+
+	char commandLine[1024];
+	char* argv[64];
+
+	// First pass counts lines, arguments, and characters, so that everything fits into single
+	// allocation.
+	uint32_t num     = 0;
+	uint32_t numArgs = 0;
+	uint32_t numChar = 0;
+
+	for (const char* cmd = _cmd, *end = cmd; '\0' != *cmd; cmd = end)
+	{
+		uint32_t size = sizeof(commandLine);
+		int argc;
+		base::StringView next = base::tokenizeCommandLine(cmd, commandLine, size, argc, argv, BASE_COUNTOF(argv), '\n');
+		end = next.isEmpty() ? cmd + base::strLen(cmd) : next.getPtr();
+
+		if (argc > 0)
+		{
+			++num;
+			numArgs += argc;
+			numChar += size + uint32_t(end - cmd) + 1;
+		}
+	}
+
+	if (0 == num)
+	{
+		return NULL;
+	}
+
+	const uint32_t total = 0
+		+ sizeof(CmdCompiled)
+		+ sizeof(CmdLine)*num
+		+ sizeof(char*)*numArgs
+		+ numChar
+		;
+
+	uint8_t* data = (uint8_t*)BASE_ALLOC(entry::getAllocator(), total);
+
+	CmdCompiled* compiled = (CmdCompiled*)data;
+	compiled->m_num  = num;
+	compiled->m_line = (CmdLine*)&compiled[1];
+
+	char** args = (char**)&compiled->m_line[num];
+	char*  text = (char*)&args[numArgs];
+
+	uint32_t idx = 0;
+	for (const char* cmd = _cmd, *end = cmd; '\0' != *cmd; cmd = end)
+	{
+		uint32_t size = sizeof(commandLine);
+		int argc;
+		base::StringView next = base::tokenizeCommandLine(cmd, commandLine, size, argc, argv, BASE_COUNTOF(argv), '\n');
+		end = next.isEmpty() ? cmd + base::strLen(cmd) : next.getPtr();
+
+		if (argc > 0)
+		{
+			CmdLine& line = compiled->m_line[idx++];
+			line.m_hash = base::hash<base::HashMurmur2A>(argv[0], (uint32_t)base::strLen(argv[0]) );
+			line.m_argc = argc;
+			line.m_argv = args;
+			line.m_generation = 0;
+			line.m_func.m_fn       = NULL;
+			line.m_func.m_userData = NULL;
+
+			base::memCopy(text, commandLine, size);
+			for (int ii = 0; ii < argc; ++ii)
+			{
+				args[ii] = text + (argv[ii] - commandLine);
+			}
+
+			args += argc;
+			text += size;
+
+			const uint32_t len = uint32_t(end - cmd) - (next.isEmpty() ? 0 : 1);
+			base::memCopy(text, cmd, len);
+			text[len] = '\0';
+			line.m_text = text;
+			text += uint32_t(end - cmd) + 1;
+		}
+	}
+
+	return compiled;
+}
+
+void cmdFree(CmdCompiled* _cmd)
+{
+	if (NULL != _cmd)
+	{
+		BASE_FREE(entry::getAllocator(), _cmd);
+	}
+}
+
+void cmdExecCompiled(const CmdCompiled* _cmd)
+{
+	if (NULL != _cmd)
+	{
+		s_cmdContext->exec(_cmd);
+	}
+}
@@ -243,6 +243,14 @@
 #	define GRAPHICS_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  GRAPHICS_CONFIG_MAX_RECT_CACHE
 
+/// Enable wide sort keys. Each render item gets secondary 64-bit sort key
+/// (sorted as less significant part of 128-bit key) which holds depth for
+/// program sorted views and full 32-bit material for program and depth
+/// sorted views. This frees bits in primary key for more programs and views.
+#ifndef GRAPHICS_CONFIG_SORT_KEY_WIDE
+#	define GRAPHICS_CONFIG_SORT_KEY_WIDE 0
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+
 #ifndef GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH
 #	define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH 32
 #endif // GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH
@@ -252,15 +260,36 @@
 #endif // GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_SEQ
 
 #ifndef GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
-#	define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM 9
+#	if GRAPHICS_CONFIG_SORT_KEY_WIDE
+#		define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM 14
+#	else
+#		define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM 9
+#	endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
 #endif // GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
 
+/// Maximum number of material bits used to group draws with identical bindings
+/// inside program and depth sorted views. With narrow sort keys material is
+/// additionally limited to bits left unused in 64-bit sort key.
+#ifndef GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+#	if GRAPHICS_CONFIG_SORT_KEY_WIDE
+#		define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL 32
+#	else
+#		define GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL 8
+#	endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+#endif // GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+
 // Cannot be configured via compiler options.
 #define GRAPHICS_CONFIG_MAX_PROGRAMS (1<<GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM)
 BASE_STATIC_ASSERT(base::isPowerOf2(GRAPHICS_CONFIG_MAX_PROGRAMS), "GRAPHICS_CONFIG_MAX_PROGRAMS must be power of 2.");
+BASE_STATIC_ASSERT(GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM <= 15, "Program handle must fit into uint16_t.");
+BASE_STATIC_ASSERT(GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL <= 32, "Material is 32-bit.");
 
 #ifndef GRAPHICS_CONFIG_MAX_VIEWS
-#	define GRAPHICS_CONFIG_MAX_VIEWS 256
+#	if GRAPHICS_CONFIG_SORT_KEY_WIDE
+#		define GRAPHICS_CONFIG_MAX_VIEWS 1024
+#	else
+#		define GRAPHICS_CONFIG_MAX_VIEWS 256
+#	endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
 #endif // GRAPHICS_CONFIG_MAX_VIEWS
 BASE_STATIC_ASSERT(base::isPowerOf2(GRAPHICS_CONFIG_MAX_VIEWS), "GRAPHICS_CONFIG_MAX_VIEWS must be power of 2.");
 
@@ -342,6 +371,47 @@ BASE_STATIC_ASSERT(base::isPowerOf2(GRAPHICS_CONFIG_MAX_VIEWS), "GRAPHICS_CONFIG
 #	define GRAPHICS_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // GRAPHICS_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Maximum number of pages transient vertex and index buffers can grow to per frame. Each page
+/// is at least transientVbSize/transientIbSize bytes.
+#ifndef GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES
+#	define GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES 16
+#endif // GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES
+
+/// Number of consecutive frames transient usage must stay below half of capacity before a
+/// trailing page is released. Also length of the peak usage tracking window.
+#ifndef GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES
+#	define GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES 240
+#endif // GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES
+
+/// Back transient vertex and index buffer pages with persistently mapped GPU memory where renderer
+/// supports it (OpenGL and Vulkan). Page memory stays owned by API thread, render thread copies used
+/// part of each page into mapped ring slot, instead of uploading it through driver or staging
+/// buffer. Off by default, not validated on Mesa llvmpipe and lavapipe drivers yet.
+#ifndef GRAPHICS_CONFIG_TRANSIENT_PERSISTENT_MAP
+#	define GRAPHICS_CONFIG_TRANSIENT_PERSISTENT_MAP 0
+#endif // GRAPHICS_CONFIG_TRANSIENT_PERSISTENT_MAP
+
+/// Pack uniforms into uniform buffers where renderer supports it (OpenGL), instead of setting each
+/// uniform separately. Shader source is rewritten to declare uniforms inside std140 blocks. Off by
+/// default, rewrite is not validated against shaders produced by all shaderc profiles yet.
+#ifndef GRAPHICS_CONFIG_UNIFORM_BUFFER
+#	define GRAPHICS_CONFIG_UNIFORM_BUFFER 0
+#endif // GRAPHICS_CONFIG_UNIFORM_BUFFER
+
+/// Coalesce runs of sorted draw calls that differ only by draw range into single multi-draw
+/// indirect call where renderer supports it (OpenGL). Off by default until coalescing is exercised
+/// on real drivers, where multi-draw indirect support is known to vary in quality.
+#ifndef GRAPHICS_CONFIG_MULTI_DRAW
+#	define GRAPHICS_CONFIG_MULTI_DRAW 0
+#endif // GRAPHICS_CONFIG_MULTI_DRAW
+
+/// Let driver compile shaders and link programs on its own worker threads where renderer supports
+/// it (OpenGL KHR/ARB_parallel_shader_compile). Compile and link status are queried lazily, just
+/// before the first frame that could use the program is rendered.
+#ifndef GRAPHICS_CONFIG_PARALLEL_SHADER_COMPILE
+#	define GRAPHICS_CONFIG_PARALLEL_SHADER_COMPILE 1
+#endif // GRAPHICS_CONFIG_PARALLEL_SHADER_COMPILE
+
 #ifndef GRAPHICS_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define GRAPHICS_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // GRAPHICS_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -356,6 +426,28 @@ BASE_STATIC_ASSERT(base::isPowerOf2(GRAPHICS_CONFIG_MAX_VIEWS), "GRAPHICS_CONFIG
 #	define GRAPHICS_CONFIG_PROFILER 0
 #endif // GRAPHICS_CONFIG_PROFILER
 
+/// Enable built-in CPU profiler capture. Captured frames are written in Chrome trace event
+/// format, and can be inspected with chrome://tracing or Perfetto. Disabled by default, since it
+/// compiles every `GRAPHICS_PROFILER_*` scope in.
+#ifndef GRAPHICS_CONFIG_PROFILER_CAPTURE
+#	define GRAPHICS_CONFIG_PROFILER_CAPTURE 0
+#endif // GRAPHICS_CONFIG_PROFILER_CAPTURE
+
+/// Maximum number of profiler events recorded per thread during capture.
+#ifndef GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_EVENTS
+#	define GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_EVENTS (16<<10)
+#endif // GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_EVENTS
+
+/// Maximum number of threads recorded during profiler capture.
+#ifndef GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS
+#	define GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS 16
+#endif // GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS
+
+/// Per thread storage for non-literal profiler event names.
+#ifndef GRAPHICS_CONFIG_PROFILER_CAPTURE_NAME_BUFFER_SIZE
+#	define GRAPHICS_CONFIG_PROFILER_CAPTURE_NAME_BUFFER_SIZE (64<<10)
+#endif // GRAPHICS_CONFIG_PROFILER_CAPTURE_NAME_BUFFER_SIZE
+
 #ifndef GRAPHICS_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define GRAPHICS_CONFIG_RENDERDOC_LOG_FILEPATH "temp/graphics"
 #endif // GRAPHICS_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -394,6 +486,30 @@ BASE_STATIC_ASSERT(base::isPowerOf2(GRAPHICS_CONFIG_MAX_VIEWS), "GRAPHICS_CONFIG
 #	define GRAPHICS_CONFIG_MAX_SCREENSHOTS 4
 #endif // GRAPHICS_CONFIG_MAX_SCREENSHOTS
 
+/// Maximum number of texture read backs with completion callback, or staging buffers in flight on
+/// renderers that read back asynchronously.
+#ifndef GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS
+#	define GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS 64
+#endif // GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS
+
+/// Number of worker threads used to generate triangle sort keys in `topologySortTriList`. When 0,
+/// keys are generated on calling thread.
+#ifndef GRAPHICS_CONFIG_TOPOLOGY_SORT_NUM_THREADS
+#	define GRAPHICS_CONFIG_TOPOLOGY_SORT_NUM_THREADS 0
+#endif // GRAPHICS_CONFIG_TOPOLOGY_SORT_NUM_THREADS
+
+/// Minimum number of triangles per thread before key generation is split across topology sort
+/// worker threads.
+#ifndef GRAPHICS_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD
+#	define GRAPHICS_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD (16<<10)
+#endif // GRAPHICS_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD
+
+/// Incremental `topologySortTriList` falls back to radix sort when insertion sort moves more than
+/// this many elements per triangle on average.
+#ifndef GRAPHICS_CONFIG_TOPOLOGY_SORT_MAX_MOVES_PER_TRIANGLE
+#	define GRAPHICS_CONFIG_TOPOLOGY_SORT_MAX_MOVES_PER_TRIANGLE 4
+#endif // GRAPHICS_CONFIG_TOPOLOGY_SORT_MAX_MOVES_PER_TRIANGLE
+
 #ifndef GRAPHICS_CONFIG_ENCODER_API_ONLY
 #	define GRAPHICS_CONFIG_ENCODER_API_ONLY 0
 #endif // GRAPHICS_CONFIG_ENCODER_API_ONLY
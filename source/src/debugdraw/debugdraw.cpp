@@ -337,6 +337,10 @@ static const graphics::EmbeddedShader s_embeddedShaders[] =
 
 #define SPRITE_TEXTURE_SIZE 1024
 
+#ifndef DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS
+#	define DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS 256
+#endif // DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS
+
 struct Attrib
 {
 	uint64_t m_state;
@@ -365,6 +369,95 @@ struct Program
 	};
 };
 
+template<typename Ty>
+struct DisplayListArray
+{
+	DisplayListArray()
+		: m_data(NULL)
+		, m_num(0)
+		, m_max(0)
+	{
+	}
+
+	Ty* alloc(base::AllocatorI* _allocator, uint32_t _num)
+	{
+		if (m_num + _num > m_max)
+		{
+			m_max  = base::max(m_max*2, m_num + _num, 256u);
+			m_data = (Ty*)base::realloc(_allocator, m_data, m_max*sizeof(Ty) );
+		}
+
+		Ty* result = &m_data[m_num];
+		m_num += _num;
+		return result;
+	}
+
+	void free(base::AllocatorI* _allocator)
+	{
+		base::free(_allocator, m_data);
+		m_data = NULL;
+		m_num  = 0;
+		m_max  = 0;
+	}
+
+	Ty*      m_data;
+	uint32_t m_num;
+	uint32_t m_max;
+};
+
+struct DisplayListBatch
+{
+	enum Enum
+	{
+		Lines, // Line segments from moveTo/lineTo, in display list line vertex buffer.
+		Mesh,  // drawLineList/drawTriList, in display list mesh vertex buffer.
+		Shape, // Instance of shared shape mesh, with recorded transforms.
+
+		Count
+	};
+
+	Attrib   m_attrib;
+	uint32_t m_startVertex;
+	uint32_t m_numVertices;
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+	uint32_t m_mtx;
+	uint16_t m_numMtx;
+	uint8_t  m_type;
+	uint8_t  m_program;
+	uint8_t  m_mesh;
+	bool     m_wireframe;
+};
+
+struct DisplayListRecorder
+{
+	void shutdown(base::AllocatorI* _allocator)
+	{
+		m_lineVertices.free(_allocator);
+		m_meshVertices.free(_allocator);
+		m_indices.free(_allocator);
+		m_batches.free(_allocator);
+		m_mtx.free(_allocator);
+	}
+
+	DisplayListArray<DebugVertex>      m_lineVertices;
+	DisplayListArray<DebugMeshVertex>  m_meshVertices;
+	DisplayListArray<uint16_t>         m_indices;
+	DisplayListArray<DisplayListBatch> m_batches;
+	DisplayListArray<float>            m_mtx;
+};
+
+struct DisplayList
+{
+	DisplayListBatch* m_batch;
+	float*            m_mtx;
+	uint32_t          m_numBatches;
+
+	graphics::VertexBufferHandle m_lineVbh;
+	graphics::VertexBufferHandle m_meshVbh;
+	graphics::IndexBufferHandle  m_ibh;
+};
+
 struct DebugMesh
 {
 	enum Enum
@@ -798,6 +891,12 @@ struct DebugDrawShared
 
 	void shutdown()
 	{
+		while (0 < m_displayListHandle.getNumHandles() )
+		{
+			const DdDisplayListHandle handle = { m_displayListHandle.getHandleAt(0) };
+			destroyDisplayList(handle);
+		}
+
 		graphics::destroy(m_ibh);
 		graphics::destroy(m_vbh);
 		for (uint32_t ii = 0; ii < Program::Count; ++ii)
@@ -809,6 +908,89 @@ struct DebugDrawShared
 		graphics::destroy(m_texture);
 	}
 
+	template<typename Ty>
+	const graphics::Memory* copy(const DisplayListArray<Ty>& _array)
+	{
+		return graphics::copy(_array.m_data, _array.m_num*sizeof(Ty) );
+	}
+
+	DdDisplayListHandle createDisplayList(const DisplayListRecorder& _recorder)
+	{
+		base::MutexScope lock(m_displayListLock);
+
+		DdDisplayListHandle handle = { m_displayListHandle.alloc() };
+		if (!isValid(handle) )
+		{
+			BASE_TRACE("Failed to allocate display list handle (DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS, max: %d)."
+				, DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS
+				);
+			return handle;
+		}
+
+		DisplayList& dl = m_displayList[handle.idx];
+
+		dl.m_lineVbh.idx = graphics::kInvalidHandle;
+		dl.m_meshVbh.idx = graphics::kInvalidHandle;
+		dl.m_ibh.idx     = graphics::kInvalidHandle;
+
+		if (0 != _recorder.m_lineVertices.m_num)
+		{
+			dl.m_lineVbh = graphics::createVertexBuffer(copy(_recorder.m_lineVertices), DebugVertex::ms_layout);
+		}
+
+		if (0 != _recorder.m_meshVertices.m_num)
+		{
+			dl.m_meshVbh = graphics::createVertexBuffer(copy(_recorder.m_meshVertices), DebugMeshVertex::ms_layout);
+		}
+
+		if (0 != _recorder.m_indices.m_num)
+		{
+			dl.m_ibh = graphics::createIndexBuffer(copy(_recorder.m_indices) );
+		}
+
+		dl.m_numBatches = _recorder.m_batches.m_num;
+		dl.m_batch = (DisplayListBatch*)base::alloc(m_allocator, dl.m_numBatches*sizeof(DisplayListBatch) );
+		base::memCopy(dl.m_batch, _recorder.m_batches.m_data, dl.m_numBatches*sizeof(DisplayListBatch) );
+
+		dl.m_mtx = NULL;
+		if (0 != _recorder.m_mtx.m_num)
+		{
+			dl.m_mtx = (float*)base::alloc(m_allocator, _recorder.m_mtx.m_num*sizeof(float) );
+			base::memCopy(dl.m_mtx, _recorder.m_mtx.m_data, _recorder.m_mtx.m_num*sizeof(float) );
+		}
+
+		return handle;
+	}
+
+	void destroyDisplayList(DdDisplayListHandle _handle)
+	{
+		base::MutexScope lock(m_displayListLock);
+
+		BASE_ASSERT(m_displayListHandle.isValid(_handle.idx), "Invalid display list handle %d.", _handle.idx);
+
+		DisplayList& dl = m_displayList[_handle.idx];
+
+		if (isValid(dl.m_lineVbh) )
+		{
+			graphics::destroy(dl.m_lineVbh);
+		}
+
+		if (isValid(dl.m_meshVbh) )
+		{
+			graphics::destroy(dl.m_meshVbh);
+		}
+
+		if (isValid(dl.m_ibh) )
+		{
+			graphics::destroy(dl.m_ibh);
+		}
+
+		base::free(m_allocator, dl.m_batch);
+		base::free(m_allocator, dl.m_mtx);
+
+		m_displayListHandle.free(_handle.idx);
+	}
+
 	base::AllocatorI* m_allocator;
 
 	DebugMesh m_mesh[DebugMesh::Count];
@@ -820,6 +1002,10 @@ struct DebugDrawShared
 
 	graphics::VertexBufferHandle m_vbh;
 	graphics::IndexBufferHandle  m_ibh;
+
+	base::Mutex m_displayListLock;
+	base::HandleAllocT<DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS> m_displayListHandle;
+	DisplayList m_displayList[DEBUG_DRAW_CONFIG_MAX_DISPLAY_LISTS];
 };
 
 static DebugDrawShared s_dds;
@@ -830,13 +1016,15 @@ struct DebugDrawEncoderImpl
 		: m_depthTestLess(true)
 		, m_state(State::Count)
 		, m_defaultEncoder(NULL)
+		, m_recorder(NULL)
 	{
 	}
 
 	void init(graphics::Encoder* _encoder)
 	{
 		m_defaultEncoder = _encoder;
-		m_state = State::Count;
+		m_state    = State::Count;
+		m_recorder = NULL;
 	}
 
 	void shutdown()
@@ -880,6 +1068,7 @@ struct DebugDrawEncoderImpl
 	void end()
 	{
 		BASE_ASSERT(0 == m_stack, "Invalid stack %d.", m_stack);
+		BASE_ASSERT(NULL == m_recorder, "Display list recording is not finished.");
 
 		flushQuad();
 		flush();
@@ -1372,6 +1561,12 @@ struct DebugDrawEncoderImpl
 	{
 		flush();
 
+		if (NULL != m_recorder)
+		{
+			recordMesh(_lineList, _numVertices, _vertices, _numIndices, _indices);
+			return;
+		}
+
 		if (_numVertices == graphics::getAvailTransientVertexBuffer(_numVertices, DebugMeshVertex::ms_layout) )
 		{
 			graphics::TransientVertexBuffer tvb;
@@ -1824,8 +2019,22 @@ struct DebugDrawEncoderImpl
 
 	void draw(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
 	{
+		if (NULL != m_recorder)
+		{
+			recordShape(_mesh, _mtx, _num, _wireframe);
+			return;
+		}
+
 		pushTransform(_mtx, _num, false /* flush */);
 
+		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
+		submit(_mesh, m_attrib[m_stack], stack.mtx, stack.num, _wireframe);
+
+		popTransform(false /* flush */);
+	}
+
+	void submit(DebugMesh::Enum _mesh, const Attrib& _attrib, uint32_t _mtx, uint16_t _num, bool _wireframe)
+	{
 		const DebugMesh& mesh = s_dds.m_mesh[_mesh];
 
 		if (0 != mesh.m_numIndices[_wireframe])
@@ -1836,16 +2045,290 @@ struct DebugDrawEncoderImpl
 				);
 		}
 
-		const Attrib& attrib = m_attrib[m_stack];
-		setUParams(attrib, _wireframe);
+		setUParams(_attrib, _wireframe);
 
-		MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
-		m_encoder->setTransform(stack.mtx, stack.num);
+		m_encoder->setTransform(_mtx, _num);
 
 		m_encoder->setVertexBuffer(0, s_dds.m_vbh, mesh.m_startVertex, mesh.m_numVertices);
 		m_encoder->submit(m_viewId, s_dds.m_program[_wireframe ? Program::Fill : Program::FillLit]);
+	}
 
-		popTransform(false /* flush */);
+	void beginDisplayList()
+	{
+		BASE_ASSERT(State::Count != m_state, "");
+		BASE_ASSERT(NULL == m_recorder, "Display list recording already started.");
+
+		flushQuad();
+		flush();
+
+		m_recorder = BASE_NEW(s_dds.m_allocator, DisplayListRecorder);
+	}
+
+	DdDisplayListHandle endDisplayList()
+	{
+		BASE_ASSERT(NULL != m_recorder, "Display list recording is not started.");
+
+		flush();
+
+		DisplayListRecorder* recorder = m_recorder;
+		m_recorder = NULL;
+
+		DdDisplayListHandle handle = { graphics::kInvalidHandle };
+		if (0 != recorder->m_batches.m_num)
+		{
+			handle = s_dds.createDisplayList(*recorder);
+		}
+
+		recorder->shutdown(s_dds.m_allocator);
+		base::deleteObject(s_dds.m_allocator, recorder);
+
+		return handle;
+	}
+
+	// Geometry is recorded in space of transform that's current while recording, so that display
+	// list can be submitted with a single transform.
+	void recordVertices(float* _dst, uint32_t _dstStride, const float* _src, uint32_t _srcStride, uint32_t _num)
+	{
+		const float* mtx = m_mtxStack[m_mtxStackCurrent].data;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			base::Vec3 pos = base::load<base::Vec3>(_src);
+			if (NULL != mtx)
+			{
+				pos = base::mul(pos, mtx);
+			}
+
+			base::store(_dst, pos);
+
+			_dst = (float*)( (uint8_t*)_dst + _dstStride);
+			_src = (const float*)( (const uint8_t*)_src + _srcStride);
+		}
+	}
+
+	void recordLines()
+	{
+		DisplayListRecorder& recorder = *m_recorder;
+		base::AllocatorI* allocator = s_dds.m_allocator;
+
+		const Attrib& attrib = m_attrib[m_stack];
+
+		Attrib state = attrib;
+		state.m_state = 0
+			| GRAPHICS_STATE_WRITE_RGB
+			| GRAPHICS_STATE_PT_LINES
+			| attrib.m_state
+			| GRAPHICS_STATE_LINEAA
+			| GRAPHICS_STATE_BLEND_ALPHA
+			;
+		const uint8_t program = uint8_t(attrib.m_stipple ? Program::LinesStipple : Program::Lines);
+
+		// Cache is flushed whenever it's full, or state changes. Consecutive flushes with same state
+		// are merged into single batch, as long as 16-bit indices can address it.
+		DisplayListBatch* batch = 0 != recorder.m_batches.m_num
+			? &recorder.m_batches.m_data[recorder.m_batches.m_num-1]
+			: NULL
+			;
+
+		if (NULL == batch
+		||  DisplayListBatch::Lines != batch->m_type
+		||  state.m_state != batch->m_attrib.m_state
+		||  program       != batch->m_program
+		||  batch->m_numVertices + m_pos > UINT16_MAX)
+		{
+			batch = recorder.m_batches.alloc(allocator, 1);
+			batch->m_attrib      = state;
+			batch->m_startVertex = recorder.m_lineVertices.m_num;
+			batch->m_numVertices = 0;
+			batch->m_startIndex  = recorder.m_indices.m_num;
+			batch->m_numIndices  = 0;
+			batch->m_mtx         = 0;
+			batch->m_numMtx      = 0;
+			batch->m_type        = DisplayListBatch::Lines;
+			batch->m_program     = program;
+			batch->m_mesh        = 0;
+			batch->m_wireframe   = false;
+		}
+
+		DebugVertex* vertices = recorder.m_lineVertices.alloc(allocator, m_pos);
+		base::memCopy(vertices, m_cache, m_pos*sizeof(DebugVertex) );
+		recordVertices(&vertices[0].m_x, sizeof(DebugVertex), &m_cache[0].m_x, sizeof(DebugVertex), m_pos);
+
+		uint16_t* indices = recorder.m_indices.alloc(allocator, m_indexPos);
+		for (uint32_t ii = 0; ii < m_indexPos; ++ii)
+		{
+			indices[ii] = uint16_t(batch->m_numVertices + m_indices[ii]);
+		}
+
+		batch->m_numVertices += m_pos;
+		batch->m_numIndices  += m_indexPos;
+	}
+
+	void recordMesh(bool _lineList, uint32_t _numVertices, const DdVertex* _vertices, uint32_t _numIndices, const uint16_t* _indices)
+	{
+		DisplayListRecorder& recorder = *m_recorder;
+		base::AllocatorI* allocator = s_dds.m_allocator;
+
+		const Attrib& attrib = m_attrib[m_stack];
+		const bool wireframe = _lineList || attrib.m_wireframe;
+
+		DisplayListBatch* batch = recorder.m_batches.alloc(allocator, 1);
+		batch->m_attrib      = attrib;
+		batch->m_startVertex = recorder.m_meshVertices.m_num;
+		batch->m_numVertices = _numVertices;
+		batch->m_startIndex  = recorder.m_indices.m_num;
+		batch->m_numIndices  = 0;
+		batch->m_mtx         = 0;
+		batch->m_numMtx      = 0;
+		batch->m_type        = DisplayListBatch::Mesh;
+		batch->m_program     = uint8_t(wireframe ? Program::FillMesh : Program::FillLitMesh);
+		batch->m_mesh        = 0;
+		batch->m_wireframe   = wireframe;
+
+		DebugMeshVertex* vertices = recorder.m_meshVertices.alloc(allocator, _numVertices);
+		recordVertices(&vertices[0].m_x, sizeof(DebugMeshVertex), &_vertices[0].x, sizeof(DdVertex), _numVertices);
+
+		if (0 < _numIndices)
+		{
+			if (!_lineList && wireframe)
+			{
+				batch->m_numIndices = graphics::topologyConvert(
+					  graphics::TopologyConvert::TriListToLineList
+					, NULL
+					, 0
+					, _indices
+					, _numIndices
+					, false
+					);
+
+				uint16_t* indices = recorder.m_indices.alloc(allocator, batch->m_numIndices);
+				graphics::topologyConvert(
+					  graphics::TopologyConvert::TriListToLineList
+					, indices
+					, batch->m_numIndices * sizeof(uint16_t)
+					, _indices
+					, _numIndices
+					, false
+					);
+			}
+			else
+			{
+				batch->m_numIndices = _numIndices;
+
+				uint16_t* indices = recorder.m_indices.alloc(allocator, _numIndices);
+				base::memCopy(indices, _indices, _numIndices * sizeof(uint16_t) );
+			}
+		}
+	}
+
+	void recordShape(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
+	{
+		DisplayListRecorder& recorder = *m_recorder;
+		base::AllocatorI* allocator = s_dds.m_allocator;
+
+		DisplayListBatch* batch = recorder.m_batches.alloc(allocator, 1);
+		batch->m_attrib      = m_attrib[m_stack];
+		batch->m_startVertex = 0;
+		batch->m_numVertices = 0;
+		batch->m_startIndex  = 0;
+		batch->m_numIndices  = 0;
+		batch->m_mtx         = recorder.m_mtx.m_num;
+		batch->m_numMtx      = _num;
+		batch->m_type        = DisplayListBatch::Shape;
+		batch->m_program     = uint8_t(_wireframe ? Program::Fill : Program::FillLit);
+		batch->m_mesh        = uint8_t(_mesh);
+		batch->m_wireframe   = _wireframe;
+
+		const float* stack = m_mtxStack[m_mtxStackCurrent].data;
+
+		float* mtx = recorder.m_mtx.alloc(allocator, _num*16);
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			if (NULL != stack)
+			{
+				base::mtxMul(&mtx[ii*16], &_mtx[ii*16], stack);
+			}
+			else
+			{
+				base::memCopy(&mtx[ii*16], &_mtx[ii*16], 64);
+			}
+		}
+	}
+
+	void drawDisplayList(DdDisplayListHandle _handle, const void* _mtx)
+	{
+		BASE_ASSERT(State::Count != m_state, "");
+		BASE_ASSERT(NULL == m_recorder, "Display list can't be drawn while recording.");
+		BASE_ASSERT(s_dds.m_displayListHandle.isValid(_handle.idx), "Invalid display list handle %d.", _handle.idx);
+
+		flushQuad();
+		flush();
+
+		if (NULL != _mtx)
+		{
+			pushTransform(_mtx, 1, false /* flush */);
+		}
+
+		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
+		const DisplayList& dl = s_dds.m_displayList[_handle.idx];
+
+		for (uint32_t ii = 0; ii < dl.m_numBatches; ++ii)
+		{
+			const DisplayListBatch& batch = dl.m_batch[ii];
+
+			switch (batch.m_type)
+			{
+			case DisplayListBatch::Lines:
+				m_encoder->setVertexBuffer(0, dl.m_lineVbh, batch.m_startVertex, batch.m_numVertices);
+				m_encoder->setIndexBuffer(dl.m_ibh, batch.m_startIndex, batch.m_numIndices);
+				m_encoder->setState(batch.m_attrib.m_state);
+				m_encoder->setTransform(stack.mtx);
+				m_encoder->submit(m_viewId, s_dds.m_program[batch.m_program]);
+				break;
+
+			case DisplayListBatch::Mesh:
+				m_encoder->setVertexBuffer(0, dl.m_meshVbh, batch.m_startVertex, batch.m_numVertices);
+				if (0 != batch.m_numIndices)
+				{
+					m_encoder->setIndexBuffer(dl.m_ibh, batch.m_startIndex, batch.m_numIndices);
+				}
+
+				setUParams(batch.m_attrib, batch.m_wireframe);
+				m_encoder->setTransform(stack.mtx);
+				m_encoder->submit(m_viewId, s_dds.m_program[batch.m_program]);
+				break;
+
+			case DisplayListBatch::Shape:
+				{
+					graphics::Transform transform;
+					const uint32_t mtx = m_encoder->allocTransform(&transform, batch.m_numMtx);
+
+					for (uint16_t jj = 0; jj < batch.m_numMtx; ++jj)
+					{
+						const float* src = &dl.m_mtx[batch.m_mtx + jj*16];
+						if (NULL != stack.data)
+						{
+							base::mtxMul(&transform.data[jj*16], src, stack.data);
+						}
+						else
+						{
+							base::memCopy(&transform.data[jj*16], src, 64);
+						}
+					}
+
+					submit(DebugMesh::Enum(batch.m_mesh), batch.m_attrib, mtx, batch.m_numMtx, batch.m_wireframe);
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		if (NULL != _mtx)
+		{
+			popTransform(false /* flush */);
+		}
 	}
 
 	void softFlush()
@@ -1860,7 +2343,11 @@ struct DebugDrawEncoderImpl
 	{
 		if (0 != m_pos)
 		{
-			if (checkAvailTransientBuffers(m_pos, DebugVertex::ms_layout, m_indexPos) )
+			if (NULL != m_recorder)
+			{
+				recordLines();
+			}
+			else if (checkAvailTransientBuffers(m_pos, DebugVertex::ms_layout, m_indexPos) )
 			{
 				graphics::TransientVertexBuffer tvb;
 				graphics::allocTransientVertexBuffer(&tvb, m_pos, DebugVertex::ms_layout);
@@ -1994,6 +2481,8 @@ struct DebugDrawEncoderImpl
 
 	graphics::Encoder* m_encoder;
 	graphics::Encoder* m_defaultEncoder;
+
+	DisplayListRecorder* m_recorder;
 };
 
 static DebugDrawEncoderImpl s_dde;
@@ -2011,6 +2500,11 @@ void ddShutdown()
 	s_dds.shutdown();
 }
 
+void ddDestroy(DdDisplayListHandle _handle)
+{
+	s_dds.destroyDisplayList(_handle);
+}
+
 #define DEBUG_DRAW_ENCODER(_func) reinterpret_cast<DebugDrawEncoderImpl*>(this)->_func
 
 DebugDrawEncoder::DebugDrawEncoder()
@@ -2233,6 +2727,21 @@ void DebugDrawEncoder::drawOrb(float _x, float _y, float _z, float _radius, grap
 	DEBUG_DRAW_ENCODER(drawOrb(_x, _y, _z, _radius, _highlight) );
 }
 
+void DebugDrawEncoder::beginDisplayList()
+{
+	DEBUG_DRAW_ENCODER(beginDisplayList() );
+}
+
+DdDisplayListHandle DebugDrawEncoder::endDisplayList()
+{
+	return DEBUG_DRAW_ENCODER(endDisplayList() );
+}
+
+void DebugDrawEncoder::drawDisplayList(DdDisplayListHandle _handle, const void* _mtx)
+{
+	DEBUG_DRAW_ENCODER(drawDisplayList(_handle, _mtx) );
+}
+
 DebugDrawEncoderScopePush::DebugDrawEncoderScopePush(DebugDrawEncoder& _dde)
 	: m_dde(_dde)
 {
@@ -15,12 +15,18 @@ struct DdVertex
 	float x, y, z;
 };
 
+GRAPHICS_HANDLE(DdDisplayListHandle)
+
 ///
 void ddInit(base::AllocatorI* _allocator = NULL);
 
 ///
 void ddShutdown();
 
+/// Destroy display list recorded with `DebugDrawEncoder::endDisplayList`.
+///
+void ddDestroy(DdDisplayListHandle _handle);
+
 ///
 struct DebugDrawEncoder
 {
@@ -156,6 +162,25 @@ struct DebugDrawEncoder
 	///
 	void drawOrb(float _x, float _y, float _z, float _radius, graphics::Axis::Enum _highlight = graphics::Axis::Count);
 
+	/// Start recording display list. Lines, meshes and shapes drawn until `endDisplayList` are
+	/// not submitted, but stored into static vertex and index buffers. Must be called between
+	/// `begin` and `end`.
+	void beginDisplayList();
+
+	/// Stop recording display list.
+	///
+	/// @returns Display list handle, or invalid handle if nothing was drawn.
+	///
+	DdDisplayListHandle endDisplayList();
+
+	/// Submit display list, without uploading its geometry again.
+	///
+	/// @param[in] _handle Display list handle.
+	/// @param[in] _mtx Transform applied on top of current transform. Recorded geometry is in
+	///   space of transform that was current while recording.
+	///
+	void drawDisplayList(DdDisplayListHandle _handle, const void* _mtx = NULL);
+
 	BASE_ALIGN_DECL_CACHE_LINE(uint8_t) m_internal[50<<10];
 };
 
@@ -493,6 +493,11 @@ namespace entry
 		s_ctx.m_eventQueue.release(_event);
 	}
 
+	void getEventQueueStats(EventQueueStats& _stats)
+	{
+		_stats = s_ctx.m_eventQueue.getStats();
+	}
+
 	WindowHandle createWindow(int32_t _x, int32_t _y, uint32_t _width, uint32_t _height, uint32_t _flags, const char* _title)
 	{
 		BASE_UNUSED(_x, _y, _width, _height, _flags, _title);
@@ -25,6 +25,11 @@ namespace entry
 		BASE_UNUSED(_event);
 	}
 
+	void getEventQueueStats(EventQueueStats& _stats)
+	{
+		_stats = EventQueueStats();
+	}
+
 	WindowHandle createWindow(int32_t _x, int32_t _y, uint32_t _width, uint32_t _height, uint32_t _flags, const char* _title)
 	{
 		BASE_UNUSED(_x, _y, _width, _height, _flags, _title);
@@ -8,7 +8,7 @@
 
 #define TINYSTL_ALLOCATOR graphics::TinyStlAllocator
 
-#include <base/spscqueue.h>
+#include <base/cpu.h>
 #include <base/filepath.h>
 
 #include "graphics/entry.h"
@@ -42,6 +42,14 @@
 #	define ENTRY_CONFIG_MAX_WINDOWS 8
 #endif // ENTRY_CONFIG_MAX_WINDOWS
 
+#ifndef ENTRY_CONFIG_EVENT_QUEUE_SIZE
+#	define ENTRY_CONFIG_EVENT_QUEUE_SIZE 1024
+#endif // ENTRY_CONFIG_EVENT_QUEUE_SIZE
+
+#ifndef ENTRY_CONFIG_EVENT_QUEUE_COALESCE
+#	define ENTRY_CONFIG_EVENT_QUEUE_COALESCE 1
+#endif // ENTRY_CONFIG_EVENT_QUEUE_COALESCE
+
 #ifndef ENTRY_CONFIG_MAX_GAMEPADS
 #	define ENTRY_CONFIG_MAX_GAMEPADS 4
 #endif // ENTRY_CONFIG_MAX_GAMEPADS
@@ -183,16 +191,79 @@ namespace entry
 		base::FilePath m_filePath;
 	};
 
+	/// Returns next event, or NULL if queue is empty. Returned event must be passed to `release`.
 	const Event* poll();
+
+	/// Returns next event if it belongs to window `_handle`, otherwise NULL.
 	const Event* poll(WindowHandle _handle);
+
+	/// Returns event slot to queue. Events must be released in the same order they were polled,
+	/// since slots are recycled in ring order.
 	void release(const Event* _event);
 
+	/// Single producer, single consumer event queue.
+	///
+	/// Events are constructed in place inside a fixed size ring of slots, so posting an event
+	/// doesn't allocate (with exception of rare `DropFileEvent`). Consecutive mouse move events
+	/// for the same window, and consecutive axis events for the same gamepad axis, are coalesced
+	/// into the last posted slot as long as consumer didn't poll it yet. When the ring is full
+	/// new input events are dropped and counted. Few slots are reserved for window and exit
+	/// events, so that they are never dropped due to input flood. Events must be released in the
+	/// same order they were polled.
+	///
 	class EventQueue
 	{
+		struct SlotState
+		{
+			enum Enum
+			{
+				Free,
+				Ready,
+				Busy,
+				Polled,
+			};
+		};
+
+		union EventStorage
+		{
+			uint8_t m_axis[sizeof(AxisEvent)];
+			uint8_t m_char[sizeof(CharEvent)];
+			uint8_t m_gamepad[sizeof(GamepadEvent)];
+			uint8_t m_key[sizeof(KeyEvent)];
+			uint8_t m_mouse[sizeof(MouseEvent)];
+			uint8_t m_size[sizeof(SizeEvent)];
+			uint8_t m_window[sizeof(WindowEvent)];
+			uint8_t m_suspend[sizeof(SuspendEvent)];
+			uint64_t m_align;
+		};
+
+		struct Slot
+		{
+			EventStorage m_storage;
+			Event* m_event;
+			volatile uint32_t m_state;
+		};
+
+		static constexpr uint32_t kNumSlots = ENTRY_CONFIG_EVENT_QUEUE_SIZE;
+		static constexpr uint32_t kSlotMask = kNumSlots-1;
+		static constexpr uint32_t kNumReservedSlots = 16;
+		BASE_STATIC_ASSERT(base::isPowerOf2(kNumSlots), "ENTRY_CONFIG_EVENT_QUEUE_SIZE must be power of 2.");
+		BASE_STATIC_ASSERT(kNumSlots > kNumReservedSlots, "ENTRY_CONFIG_EVENT_QUEUE_SIZE is too small.");
+
 	public:
 		EventQueue()
-			: m_queue(getAllocator() )
+			: m_write(0)
+			, m_numPosted(0)
+			, m_numCoalesced(0)
+			, m_numDropped(0)
+			, m_read(0)
+			, m_poll(0)
 		{
+			for (uint32_t ii = 0; ii < kNumSlots; ++ii)
+			{
+				m_slots[ii].m_event = NULL;
+				m_slots[ii].m_state = SlotState::Free;
+			}
 		}
 
 		~EventQueue()
@@ -205,109 +276,199 @@ namespace entry
 
 		void postAxisEvent(WindowHandle _handle, GamepadHandle _gamepad, GamepadAxis::Enum _axis, int32_t _value)
 		{
-			AxisEvent* ev = BASE_NEW(getAllocator(), AxisEvent)(_handle);
-			ev->m_gamepad = _gamepad;
-			ev->m_axis    = _axis;
-			ev->m_value   = _value;
-			m_queue.push(ev);
+			AxisEvent* last = static_cast<AxisEvent*>(beginCoalesce(Event::Axis, _handle) );
+			if (NULL != last)
+			{
+				if (last->m_gamepad.idx == _gamepad.idx
+				&&  last->m_axis        == _axis)
+				{
+					last->m_value = _value;
+					endCoalesce(true);
+					return;
+				}
+
+				endCoalesce(false);
+			}
+
+			AxisEvent* ev = alloc<AxisEvent>(_handle, true);
+			if (NULL != ev)
+			{
+				ev->m_gamepad = _gamepad;
+				ev->m_axis    = _axis;
+				ev->m_value   = _value;
+				push();
+			}
 		}
 
 		void postCharEvent(WindowHandle _handle, uint8_t _len, const uint8_t _char[4])
 		{
-			CharEvent* ev = BASE_NEW(getAllocator(), CharEvent)(_handle);
-			ev->m_len = _len;
-			base::memCopy(ev->m_char, _char, 4);
-			m_queue.push(ev);
+			CharEvent* ev = alloc<CharEvent>(_handle, true);
+			if (NULL != ev)
+			{
+				ev->m_len = _len;
+				base::memCopy(ev->m_char, _char, 4);
+				push();
+			}
 		}
 
 		void postExitEvent()
 		{
-			Event* ev = BASE_NEW(getAllocator(), Event)(Event::Exit);
-			m_queue.push(ev);
+			Event* ev = alloc<Event>(Event::Exit);
+			if (NULL != ev)
+			{
+				push();
+			}
 		}
 
 		void postGamepadEvent(WindowHandle _handle, GamepadHandle _gamepad, bool _connected)
 		{
-			GamepadEvent* ev = BASE_NEW(getAllocator(), GamepadEvent)(_handle);
-			ev->m_gamepad   = _gamepad;
-			ev->m_connected = _connected;
-			m_queue.push(ev);
+			GamepadEvent* ev = alloc<GamepadEvent>(_handle, false);
+			if (NULL != ev)
+			{
+				ev->m_gamepad   = _gamepad;
+				ev->m_connected = _connected;
+				push();
+			}
 		}
 
 		void postKeyEvent(WindowHandle _handle, Key::Enum _key, uint8_t _modifiers, bool _down)
 		{
-			KeyEvent* ev = BASE_NEW(getAllocator(), KeyEvent)(_handle);
-			ev->m_key       = _key;
-			ev->m_modifiers = _modifiers;
-			ev->m_down      = _down;
-			m_queue.push(ev);
+			KeyEvent* ev = alloc<KeyEvent>(_handle, true);
+			if (NULL != ev)
+			{
+				ev->m_key       = _key;
+				ev->m_modifiers = _modifiers;
+				ev->m_down      = _down;
+				push();
+			}
 		}
 
 		void postMouseEvent(WindowHandle _handle, int32_t _mx, int32_t _my, int32_t _mz)
 		{
-			MouseEvent* ev = BASE_NEW(getAllocator(), MouseEvent)(_handle);
-			ev->m_mx     = _mx;
-			ev->m_my     = _my;
-			ev->m_mz     = _mz;
-			ev->m_button = MouseButton::None;
-			ev->m_down   = false;
-			ev->m_move   = true;
-			m_queue.push(ev);
+			MouseEvent* last = static_cast<MouseEvent*>(beginCoalesce(Event::Mouse, _handle) );
+			if (NULL != last)
+			{
+				if (last->m_move)
+				{
+					last->m_mx = _mx;
+					last->m_my = _my;
+					last->m_mz = _mz;
+					endCoalesce(true);
+					return;
+				}
+
+				endCoalesce(false);
+			}
+
+			MouseEvent* ev = alloc<MouseEvent>(_handle, true);
+			if (NULL != ev)
+			{
+				ev->m_mx     = _mx;
+				ev->m_my     = _my;
+				ev->m_mz     = _mz;
+				ev->m_button = MouseButton::None;
+				ev->m_down   = false;
+				ev->m_move   = true;
+				push();
+			}
 		}
 
 		void postMouseEvent(WindowHandle _handle, int32_t _mx, int32_t _my, int32_t _mz, MouseButton::Enum _button, bool _down)
 		{
-			MouseEvent* ev = BASE_NEW(getAllocator(), MouseEvent)(_handle);
-			ev->m_mx     = _mx;
-			ev->m_my     = _my;
-			ev->m_mz     = _mz;
-			ev->m_button = _button;
-			ev->m_down   = _down;
-			ev->m_move   = false;
-			m_queue.push(ev);
+			MouseEvent* ev = alloc<MouseEvent>(_handle, true);
+			if (NULL != ev)
+			{
+				ev->m_mx     = _mx;
+				ev->m_my     = _my;
+				ev->m_mz     = _mz;
+				ev->m_button = _button;
+				ev->m_down   = _down;
+				ev->m_move   = false;
+				push();
+			}
 		}
 
 		void postSizeEvent(WindowHandle _handle, uint32_t _width, uint32_t _height)
 		{
-			SizeEvent* ev = BASE_NEW(getAllocator(), SizeEvent)(_handle);
-			ev->m_width  = _width;
-			ev->m_height = _height;
-			m_queue.push(ev);
+			SizeEvent* ev = alloc<SizeEvent>(_handle, false);
+			if (NULL != ev)
+			{
+				ev->m_width  = _width;
+				ev->m_height = _height;
+				push();
+			}
 		}
 
 		void postWindowEvent(WindowHandle _handle, void* _nwh = NULL)
 		{
-			WindowEvent* ev = BASE_NEW(getAllocator(), WindowEvent)(_handle);
-			ev->m_nwh = _nwh;
-			m_queue.push(ev);
+			WindowEvent* ev = alloc<WindowEvent>(_handle, false);
+			if (NULL != ev)
+			{
+				ev->m_nwh = _nwh;
+				push();
+			}
 		}
 
 		void postSuspendEvent(WindowHandle _handle, Suspend::Enum _state)
 		{
-			SuspendEvent* ev = BASE_NEW(getAllocator(), SuspendEvent)(_handle);
-			ev->m_state = _state;
-			m_queue.push(ev);
+			SuspendEvent* ev = alloc<SuspendEvent>(_handle, false);
+			if (NULL != ev)
+			{
+				ev->m_state = _state;
+				push();
+			}
 		}
 
 		void postDropFileEvent(WindowHandle _handle, const base::FilePath& _filePath)
 		{
+			if (isFull(false) )
+			{
+				base::atomicFetchAndAdd<uint32_t>(&m_numDropped, 1);
+				return;
+			}
+
+			// Drop file event carries full path, and it's too big to be stored inline.
 			DropFileEvent* ev = BASE_NEW(getAllocator(), DropFileEvent)(_handle);
 			ev->m_filePath = _filePath;
-			m_queue.push(ev);
+
+			Slot& slot = m_slots[m_write & kSlotMask];
+			slot.m_event = ev;
+			push();
 		}
 
 		const Event* poll()
 		{
-			return m_queue.pop();
+			base::memoryBarrier();
+			if (m_poll == m_write)
+			{
+				return NULL;
+			}
+
+			Slot& slot = m_slots[m_poll & kSlotMask];
+
+			// Producer might be in the middle of coalescing event into this slot. It's only couple
+			// of stores, so just spin until it's done.
+			while (SlotState::Ready != base::atomicCompareAndSwap<uint32_t>(&slot.m_state, SlotState::Ready, SlotState::Polled) )
+			{
+			}
+
+			++m_poll;
+
+			return slot.m_event;
 		}
 
 		const Event* poll(WindowHandle _handle)
 		{
 			if (isValid(_handle) )
 			{
-				Event* ev = m_queue.peek();
-				if (NULL == ev
-				||  ev->m_handle.idx != _handle.idx)
+				base::memoryBarrier();
+				if (m_poll == m_write)
+				{
+					return NULL;
+				}
+
+				const Event* ev = m_slots[m_poll & kSlotMask].m_event;
+				if (ev->m_handle.idx != _handle.idx)
 				{
 					return NULL;
 				}
@@ -316,13 +477,131 @@ namespace entry
 			return poll();
 		}
 
-		void release(const Event* _event) const
+		void release(const Event* _event)
+		{
+			Slot& slot = m_slots[m_read & kSlotMask];
+			BASE_ASSERT(slot.m_event == _event, "Events must be released in the same order they were polled.");
+
+			if (Event::DropFile == _event->m_type)
+			{
+				base::deleteObject(getAllocator(), const_cast<Event*>(_event) );
+			}
+
+			slot.m_event = NULL;
+			slot.m_state = SlotState::Free;
+
+			base::memoryBarrier();
+			++m_read;
+		}
+
+		/// Can be called from any thread.
+		EventQueueStats getStats()
 		{
-			base::deleteObject(getAllocator(), const_cast<Event*>(_event) );
+			EventQueueStats stats;
+			stats.m_numPosted    = base::atomicFetchAndAdd<uint32_t>(&m_numPosted,    0);
+			stats.m_numCoalesced = base::atomicFetchAndAdd<uint32_t>(&m_numCoalesced, 0);
+			stats.m_numDropped   = base::atomicFetchAndAdd<uint32_t>(&m_numDropped,   0);
+			return stats;
 		}
 
 	private:
-		base::SpScUnboundedQueueT<Event> m_queue;
+		bool isFull(bool _input)
+		{
+			base::memoryBarrier();
+			const uint32_t max = _input ? kNumSlots-kNumReservedSlots : kNumSlots;
+			return m_write - m_read >= max;
+		}
+
+		template<typename Ty>
+		Ty* alloc(WindowHandle _handle, bool _input)
+		{
+			if (isFull(_input) )
+			{
+				base::atomicFetchAndAdd<uint32_t>(&m_numDropped, 1);
+				return NULL;
+			}
+
+			Slot& slot = m_slots[m_write & kSlotMask];
+			Ty* ev = BASE_PLACEMENT_NEW(&slot.m_storage, Ty)(_handle);
+			slot.m_event = ev;
+			return ev;
+		}
+
+		template<typename Ty>
+		Ty* alloc(Event::Enum _type)
+		{
+			if (isFull(false) )
+			{
+				base::atomicFetchAndAdd<uint32_t>(&m_numDropped, 1);
+				return NULL;
+			}
+
+			Slot& slot = m_slots[m_write & kSlotMask];
+			Ty* ev = BASE_PLACEMENT_NEW(&slot.m_storage, Ty)(_type);
+			slot.m_event = ev;
+			return ev;
+		}
+
+		void push()
+		{
+			Slot& slot = m_slots[m_write & kSlotMask];
+			slot.m_state = SlotState::Ready;
+
+			base::memoryBarrier();
+			++m_write;
+			base::atomicFetchAndAdd<uint32_t>(&m_numPosted, 1);
+		}
+
+		Event* beginCoalesce(Event::Enum _type, WindowHandle _handle)
+		{
+#if ENTRY_CONFIG_EVENT_QUEUE_COALESCE
+			Slot& slot = m_slots[(m_write-1) & kSlotMask];
+
+			// Slot can be modified only while consumer didn't poll it yet.
+			if (SlotState::Ready == base::atomicCompareAndSwap<uint32_t>(&slot.m_state, SlotState::Ready, SlotState::Busy) )
+			{
+				Event* ev = slot.m_event;
+				if (ev->m_type       == _type
+				&&  ev->m_handle.idx == _handle.idx)
+				{
+					return ev;
+				}
+
+				slot.m_state = SlotState::Ready;
+			}
+#else
+			BASE_UNUSED(_type, _handle);
+#endif // ENTRY_CONFIG_EVENT_QUEUE_COALESCE
+
+			return NULL;
+		}
+
+		void endCoalesce(bool _coalesced)
+		{
+			Slot& slot = m_slots[(m_write-1) & kSlotMask];
+
+			base::memoryBarrier();
+			slot.m_state = SlotState::Ready;
+
+			if (_coalesced)
+			{
+				base::atomicFetchAndAdd<uint32_t>(&m_numCoalesced, 1);
+			}
+		}
+
+		Slot m_slots[kNumSlots];
+
+		// Producer owned.
+		volatile uint32_t m_write;
+
+		// Written by producer, read by any thread with `getStats`.
+		volatile uint32_t m_numPosted;
+		volatile uint32_t m_numCoalesced;
+		volatile uint32_t m_numDropped;
+
+		// Consumer owned.
+		volatile uint32_t m_read;
+		uint32_t m_poll;
 	};
 
 } // namespace graphics
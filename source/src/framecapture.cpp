@@ -0,0 +1,1414 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "graphics_p.h"
+
+namespace graphics
+{
+	constexpr uint32_t kFrameCaptureMagic   = BASE_MAKEFOURCC('G', 'F', 'C', 0x0);
+	constexpr uint32_t kFrameCaptureVersion = 6;
+
+	// Capture file is header followed by frame chunks (uint32_t size, chunk data). Structures are
+	// stored as raw memory, so capture can be replayed only by build with matching layout.
+	//
+	// Frame chunk:
+	//   resource handles created or destroyed by frame (uint32_t num, handle ops),
+	//   resolution, debug flags, view remap, color palette,
+	//   changed views (uint16_t num, { ViewId, View }),
+	//   matrix and rect cache,
+	//   render items (uint32_t num, sort keys, secondary sort keys with GRAPHICS_CONFIG_SORT_KEY_WIDE,
+	//     sort values, render items, render binds),
+	//   blit items (uint16_t num, blit keys, blit items),
+	//   uniform buffers (uint16_t num, { uint32_t size, data }),
+	//   transient index and vertex buffer pages (uint16_t num, { uint16_t handle, uint32_t size, data }),
+	//   pre and post resource command buffers (uint32_t size, data, uint32_t num fixups, fixups).
+	//
+	struct FrameCaptureHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t maxViews;
+		uint32_t maxDrawCalls;
+		uint32_t maxEncoders;
+		uint32_t transientVbSize;
+		uint32_t transientIbSize;
+		uint32_t sortKeyLayout;
+		uint16_t sizeView;
+		uint16_t sizeRenderItem;
+		uint16_t sizeRenderBind;
+		uint16_t sizeBlitItem;
+	};
+
+	static void initHeader(FrameCaptureHeader& _header)
+	{
+		base::memSet(&_header, 0, sizeof(_header) );
+		_header.magic           = kFrameCaptureMagic;
+		_header.version         = kFrameCaptureVersion;
+		_header.maxViews        = GRAPHICS_CONFIG_MAX_VIEWS;
+		_header.maxDrawCalls    = GRAPHICS_CONFIG_MAX_DRAW_CALLS;
+		_header.maxEncoders     = g_caps.limits.maxEncoders;
+		_header.transientVbSize = g_caps.limits.transientVbSize;
+		_header.transientIbSize = g_caps.limits.transientIbSize;
+		_header.sortKeyLayout   = 0
+			| (GRAPHICS_CONFIG_SORT_KEY_WIDE                  <<  0)
+			| (GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM      <<  1)
+			| (GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_SEQ          <<  6)
+			| (GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH        << 12)
+			| (GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL     << 18)
+			| (uint32_t(kSortKeyMaterialNumBits)              << 24)
+			;
+		_header.sizeView        = uint16_t(sizeof(View) );
+		_header.sizeRenderItem  = uint16_t(sizeof(RenderItem) );
+		_header.sizeRenderBind  = uint16_t(sizeof(RenderBind) );
+		_header.sizeBlitItem    = uint16_t(sizeof(BlitItem) );
+	}
+
+	// Resource command buffers contain pointers to memory which is owned by the frame. Their
+	// position is recorded, and referenced data is stored inline after command buffer.
+	struct CommandFixup
+	{
+		enum Enum
+		{
+			Memory,        //!< `const Memory*`.
+			TextureMemory, //!< `const Memory*` with texture chunk, which holds another `const Memory*`.
+			ReadBack,      //!< Texture read back destination, replaced with memory owned by replay.
+
+			Count
+		};
+
+		uint32_t m_pos;
+		uint16_t m_handle;
+		uint8_t  m_type;
+	};
+
+	typedef stl::vector<CommandFixup> CommandFixupArray;
+
+	// Replayed commands use recorded handles, replay reserves them in context's handle
+	// allocators before any recorded frame is loaded.
+	struct HandleOp
+	{
+		enum Enum
+		{
+			Create,
+			CreateWindow, //!< Frame buffer with native window handle, can't be replayed.
+			Destroy,
+
+			Count
+		};
+
+		uint16_t m_idx;
+		uint8_t  m_type;    //!< `Handle::Enum`.
+		uint8_t  m_op;      //!< `HandleOp::Enum`.
+		uint8_t  m_destroy; //!< Command destroying created resource.
+	};
+
+	typedef stl::vector<HandleOp> HandleOpArray;
+
+	static void addHandleOp(HandleOpArray* _ops, uint8_t _cmd, uint16_t _idx, HandleOp::Enum _op)
+	{
+		if (NULL == _ops)
+		{
+			return;
+		}
+
+		HandleOp op;
+		op.m_idx     = _idx;
+		op.m_op      = uint8_t(_op);
+		op.m_destroy = CommandBuffer::End;
+
+		switch (_cmd)
+		{
+		case CommandBuffer::CreateVertexLayout:        op.m_destroy = CommandBuffer::DestroyVertexLayout;        BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyVertexLayout:       op.m_type = Handle::VertexLayout; break;
+
+		case CommandBuffer::CreateIndexBuffer:
+		case CommandBuffer::CreateIndexBuffers:        op.m_destroy = CommandBuffer::DestroyIndexBuffer;         BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyIndexBuffer:
+		case CommandBuffer::DestroyIndexBuffers:       op.m_type = Handle::IndexBuffer; break;
+
+		case CommandBuffer::CreateDynamicIndexBuffer:  op.m_destroy = CommandBuffer::DestroyDynamicIndexBuffer;  BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyDynamicIndexBuffer: op.m_type = Handle::IndexBuffer; break;
+
+		case CommandBuffer::CreateVertexBuffer:
+		case CommandBuffer::CreateVertexBuffers:       op.m_destroy = CommandBuffer::DestroyVertexBuffer;        BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyVertexBuffer:
+		case CommandBuffer::DestroyVertexBuffers:      op.m_type = Handle::VertexBuffer; break;
+
+		case CommandBuffer::CreateDynamicVertexBuffer: op.m_destroy = CommandBuffer::DestroyDynamicVertexBuffer; BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyDynamicVertexBuffer:op.m_type = Handle::VertexBuffer; break;
+
+		case CommandBuffer::CreateShader:              op.m_destroy = CommandBuffer::DestroyShader;              BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyShader:             op.m_type = Handle::Shader; break;
+
+		case CommandBuffer::CreateProgram:             op.m_destroy = CommandBuffer::DestroyProgram;             BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyProgram:            op.m_type = Handle::Program; break;
+
+		case CommandBuffer::CreateTexture:             op.m_destroy = CommandBuffer::DestroyTexture;             BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyTexture:            op.m_type = Handle::Texture; break;
+
+		case CommandBuffer::CreateFrameBuffer:         op.m_destroy = CommandBuffer::DestroyFrameBuffer;         BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyFrameBuffer:        op.m_type = Handle::FrameBuffer; break;
+
+		case CommandBuffer::CreateUniform:             op.m_destroy = CommandBuffer::DestroyUniform;             BASE_FALLTHROUGH;
+		case CommandBuffer::DestroyUniform:            op.m_type = Handle::Uniform; break;
+
+		default:
+			BASE_ASSERT(false, "Command %d doesn't create or destroy resource.", _cmd);
+			return;
+		}
+
+		_ops->push_back(op);
+	}
+
+	template<typename Ty>
+	static void readHandle(CommandBuffer& _cmdbuf, HandleOpArray* _ops, uint8_t _cmd)
+	{
+		Ty handle;
+		_cmdbuf.read(handle);
+		addHandleOp(_ops, _cmd, handle.idx, _cmd < CommandBuffer::End ? HandleOp::Create : HandleOp::Destroy);
+	}
+
+	static void addFixup(CommandFixupArray& _fixups, CommandBuffer& _cmdbuf, CommandFixup::Enum _type, uint16_t _handle = kInvalidHandle)
+	{
+		_cmdbuf.align(BASE_ALIGNOF(void*) );
+
+		CommandFixup fixup;
+		fixup.m_pos    = _cmdbuf.m_pos;
+		fixup.m_handle = _handle;
+		fixup.m_type   = uint8_t(_type);
+		_fixups.push_back(fixup);
+
+		_cmdbuf.skip(sizeof(void*) );
+	}
+
+	// Walks command buffer the same way as `Context::rendererExecCommands` does, without
+	// executing anything. Handles created and destroyed by commands are added to `_ops`.
+	static void findFixups(CommandBuffer& _cmdbuf, CommandFixupArray& _fixups, HandleOpArray* _ops = NULL)
+	{
+		_fixups.clear();
+		_cmdbuf.reset();
+
+		bool end = false;
+
+		do
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			switch (command)
+			{
+			case CommandBuffer::RendererInit:
+				_cmdbuf.skip<Init>();
+				break;
+
+			case CommandBuffer::RendererShutdownBegin:
+				break;
+
+			case CommandBuffer::RendererShutdownEnd:
+			case CommandBuffer::End:
+				end = true;
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				readHandle<IndexBufferHandle>(_cmdbuf, _ops, command);
+				addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+				_cmdbuf.skip<uint16_t>();
+				break;
+
+			case CommandBuffer::CreateIndexBuffers:
+				{
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						readHandle<IndexBufferHandle>(_cmdbuf, _ops, command);
+						addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+						_cmdbuf.skip<uint16_t>();
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateVertexLayout:
+				readHandle<VertexLayoutHandle>(_cmdbuf, _ops, command);
+				_cmdbuf.skip<VertexLayout>();
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				readHandle<VertexBufferHandle>(_cmdbuf, _ops, command);
+				addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+				_cmdbuf.skip<VertexLayoutHandle>();
+				_cmdbuf.skip<uint16_t>();
+				break;
+
+			case CommandBuffer::CreateVertexBuffers:
+				{
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						readHandle<VertexBufferHandle>(_cmdbuf, _ops, command);
+						addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+						_cmdbuf.skip<VertexLayoutHandle>();
+						_cmdbuf.skip<uint16_t>();
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				readHandle<IndexBufferHandle>(_cmdbuf, _ops, command);
+				_cmdbuf.skip<uint32_t>();
+				_cmdbuf.skip<uint16_t>();
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				_cmdbuf.skip<IndexBufferHandle>();
+				_cmdbuf.skip<uint32_t>();
+				_cmdbuf.skip<uint32_t>();
+				addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+				break;
+
+			case CommandBuffer::CreateShader:
+				readHandle<ShaderHandle>(_cmdbuf, _ops, command);
+				addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+				break;
+
+			case CommandBuffer::CreateProgram:
+				readHandle<ProgramHandle>(_cmdbuf, _ops, command);
+				_cmdbuf.skip<ShaderHandle>();
+				_cmdbuf.skip<ShaderHandle>();
+				break;
+
+			case CommandBuffer::CreateTexture:
+				readHandle<TextureHandle>(_cmdbuf, _ops, command);
+				addFixup(_fixups, _cmdbuf, CommandFixup::TextureMemory);
+				_cmdbuf.skip<uint64_t>();
+				_cmdbuf.skip<uint8_t>();
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				_cmdbuf.skip<TextureHandle>();
+				_cmdbuf.skip<uint8_t>();
+				_cmdbuf.skip<uint8_t>();
+				_cmdbuf.skip<Rect>();
+				_cmdbuf.skip<uint16_t>();
+				_cmdbuf.skip<uint16_t>();
+				_cmdbuf.skip<uint16_t>();
+				addFixup(_fixups, _cmdbuf, CommandFixup::Memory);
+				break;
+
+			case CommandBuffer::ReadTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+					addFixup(_fixups, _cmdbuf, CommandFixup::ReadBack, handle.idx);
+					_cmdbuf.skip<uint8_t>();
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				_cmdbuf.skip<TextureHandle>();
+				_cmdbuf.skip<uint16_t>();
+				_cmdbuf.skip<uint16_t>();
+				_cmdbuf.skip<uint8_t>();
+				_cmdbuf.skip<uint16_t>();
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					bool window;
+					_cmdbuf.read(window);
+
+					addHandleOp(_ops, command, handle.idx, window ? HandleOp::CreateWindow : HandleOp::Create);
+
+					if (window)
+					{
+						_cmdbuf.skip<void*>();
+						_cmdbuf.skip<uint16_t>();
+						_cmdbuf.skip<uint16_t>();
+						_cmdbuf.skip<TextureFormat::Enum>();
+						_cmdbuf.skip<TextureFormat::Enum>();
+					}
+					else
+					{
+						uint8_t num;
+						_cmdbuf.read(num);
+						_cmdbuf.skip(sizeof(Attachment) * num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					readHandle<UniformHandle>(_cmdbuf, _ops, command);
+					_cmdbuf.skip<UniformType::Enum>();
+					_cmdbuf.skip<uint16_t>();
+
+					uint8_t len;
+					_cmdbuf.read(len);
+					_cmdbuf.skip(len);
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					_cmdbuf.skip<ViewId>();
+
+					uint16_t len;
+					_cmdbuf.read(len);
+					_cmdbuf.skip(len);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					_cmdbuf.skip<Handle>();
+
+					uint16_t len;
+					_cmdbuf.read(len);
+					_cmdbuf.skip(len);
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				_cmdbuf.skip<OcclusionQueryHandle>();
+				break;
+
+			case CommandBuffer::SetTextureMinMip:
+				_cmdbuf.skip<TextureHandle>();
+				_cmdbuf.skip<uint8_t>();
+				break;
+
+			case CommandBuffer::DestroyVertexLayout:
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+			case CommandBuffer::DestroyShader:
+			case CommandBuffer::DestroyProgram:
+			case CommandBuffer::DestroyTexture:
+			case CommandBuffer::DestroyFrameBuffer:
+			case CommandBuffer::DestroyUniform:
+				{
+					// All resource handles are 16-bit.
+					uint16_t idx;
+					_cmdbuf.read(idx);
+					addHandleOp(_ops, command, idx, HandleOp::Destroy);
+				}
+				break;
+
+			case CommandBuffer::DestroyIndexBuffers:
+			case CommandBuffer::DestroyVertexBuffers:
+				{
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						uint16_t idx;
+						_cmdbuf.read(idx);
+						addHandleOp(_ops, command, idx, HandleOp::Destroy);
+					}
+				}
+				break;
+
+			default:
+				BASE_ASSERT(false, "Invalid command: %d", command);
+				end = true;
+				break;
+			}
+		} while (!end);
+
+		_cmdbuf.reset();
+	}
+
+	template<typename Ty>
+	static Ty* getPtr(CommandBuffer& _cmdbuf, const CommandFixup& _fixup)
+	{
+		Ty* ptr;
+		base::memCopy(&ptr, &_cmdbuf.m_buffer[_fixup.m_pos], sizeof(ptr) );
+		return ptr;
+	}
+
+	template<typename Ty>
+	static void setPtr(CommandBuffer& _cmdbuf, const CommandFixup& _fixup, Ty* _ptr)
+	{
+		base::memCopy(&_cmdbuf.m_buffer[_fixup.m_pos], &_ptr, sizeof(_ptr) );
+	}
+
+	static constexpr uint32_t kTextureCreateMemOffset = sizeof(uint32_t) + BASE_OFFSETOF(TextureCreate, m_mem);
+
+	static const Memory* getTextureCreateMem(const Memory* _mem)
+	{
+		uint32_t magic = 0;
+		if (sizeof(uint32_t) <= _mem->size)
+		{
+			base::memCopy(&magic, _mem->data, sizeof(uint32_t) );
+		}
+
+		if (GRAPHICS_CHUNK_MAGIC_TEX != magic
+		||  sizeof(uint32_t) + sizeof(TextureCreate) > _mem->size)
+		{
+			return NULL;
+		}
+
+		const Memory* mem;
+		base::memCopy(&mem, &_mem->data[kTextureCreateMemOffset], sizeof(mem) );
+		return mem;
+	}
+
+	struct FrameCapture
+	{
+		FrameCapture()
+			: m_mb(g_allocator)
+			, m_numFrames(0)
+		{
+			base::memSet(m_view, 0xff, sizeof(m_view) );
+		}
+
+		base::FileWriter  m_writer;
+		base::MemoryBlock m_mb;
+		CommandFixupArray m_fixups;
+		HandleOpArray     m_handleOps;
+		stl::vector<uint32_t> m_uniformSize;
+		uint8_t  m_view[GRAPHICS_CONFIG_MAX_VIEWS][sizeof(View)];
+		uint32_t m_numFrames;
+	};
+
+	FrameCapture* frameCaptureCreate(const char* _filePath)
+	{
+		FrameCapture* capture = BASE_NEW(g_allocator, FrameCapture);
+
+		base::Error err;
+		if (!base::open(&capture->m_writer, _filePath, false, &err) )
+		{
+			BASE_TRACE("Failed to open frame capture file '%s'.", _filePath);
+			base::deleteObject(g_allocator, capture);
+			return NULL;
+		}
+
+		FrameCaptureHeader header;
+		initHeader(header);
+		base::write(&capture->m_writer, header, &err);
+
+		BASE_TRACE("Frame capture started '%s'.", _filePath);
+
+		return capture;
+	}
+
+	void frameCaptureDestroy(FrameCapture* _capture)
+	{
+		BASE_TRACE("Frame capture finished, %d frames captured.", _capture->m_numFrames);
+
+		base::close(&_capture->m_writer);
+		base::deleteObject(g_allocator, _capture);
+	}
+
+	static void writeCommandBuffer(base::WriterI* _writer, CommandBuffer& _cmdbuf, CommandFixupArray& _fixups, const TextureRef* _textureRef, base::Error* _err)
+	{
+		findFixups(_cmdbuf, _fixups);
+
+		base::write(_writer, _cmdbuf.m_size, _err);
+		base::write(_writer, _cmdbuf.m_buffer, _cmdbuf.m_size, _err);
+
+		base::write(_writer, uint32_t(_fixups.size() ), _err);
+
+		for (uint32_t ii = 0, num = uint32_t(_fixups.size() ); ii < num; ++ii)
+		{
+			const CommandFixup& fixup = _fixups[ii];
+			base::write(_writer, fixup.m_pos, _err);
+			base::write(_writer, fixup.m_type, _err);
+
+			switch (fixup.m_type)
+			{
+			case CommandFixup::Memory:
+			case CommandFixup::TextureMemory:
+				{
+					const Memory* mem = getPtr<const Memory>(_cmdbuf, fixup);
+					base::write(_writer, mem->size, _err);
+					base::write(_writer, mem->data, mem->size, _err);
+
+					if (CommandFixup::TextureMemory == fixup.m_type)
+					{
+						const Memory* texMem = getTextureCreateMem(mem);
+						if (NULL == texMem)
+						{
+							base::write(_writer, UINT32_MAX, _err);
+						}
+						else
+						{
+							base::write(_writer, texMem->size, _err);
+							base::write(_writer, texMem->data, texMem->size, _err);
+						}
+					}
+				}
+				break;
+
+			case CommandFixup::ReadBack:
+				base::write(_writer, fixup.m_handle, _err);
+				base::write(_writer, _textureRef[fixup.m_handle].m_storageSize, _err);
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	template<typename Ty>
+	static void writeTransientPages(base::WriterI* _writer, const TransientPages<Ty>& _pages, base::Error* _err)
+	{
+		const uint16_t numPages = uint16_t(_pages.m_num);
+		base::write(_writer, numPages, _err);
+
+		for (uint16_t ii = 0; ii < numPages; ++ii)
+		{
+			const Ty* page = _pages.m_page[ii];
+			base::write(_writer, page->handle.idx, _err);
+			base::write(_writer, _pages.m_used[ii], _err);
+			base::write(_writer, page->data, _pages.m_used[ii], _err);
+		}
+	}
+
+	void frameCaptureWrite(FrameCapture* _capture, Frame* _frame, const TextureRef* _textureRef)
+	{
+		base::Error err;
+		base::MemoryWriter writer(&_capture->m_mb);
+
+		HandleOpArray& handleOps = _capture->m_handleOps;
+		handleOps.clear();
+		findFixups(_frame->m_cmdPre,  _capture->m_fixups, &handleOps);
+		findFixups(_frame->m_cmdPost, _capture->m_fixups, &handleOps);
+
+		base::write(&writer, uint32_t(handleOps.size() ), &err);
+		for (uint32_t ii = 0, num = uint32_t(handleOps.size() ); ii < num; ++ii)
+		{
+			const HandleOp& op = handleOps[ii];
+			base::write(&writer, op.m_idx, &err);
+			base::write(&writer, op.m_type, &err);
+			base::write(&writer, op.m_op, &err);
+			base::write(&writer, op.m_destroy, &err);
+		}
+
+		base::write(&writer, _frame->m_resolution, &err);
+		base::write(&writer, _frame->m_debug, &err);
+		base::write(&writer, _frame->m_viewRemap, sizeof(_frame->m_viewRemap), &err);
+		base::write(&writer, _frame->m_colorPalette, sizeof(_frame->m_colorPalette), &err);
+
+		// Only views that changed since previous frame are stored.
+		uint16_t numViews = 0;
+		for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_MAX_VIEWS; ++ii)
+		{
+			numViews += 0 != base::memCmp(_capture->m_view[ii], &_frame->m_view[ii], sizeof(View) );
+		}
+
+		base::write(&writer, numViews, &err);
+		for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_MAX_VIEWS; ++ii)
+		{
+			if (0 != base::memCmp(_capture->m_view[ii], &_frame->m_view[ii], sizeof(View) ) )
+			{
+				base::memCopy(_capture->m_view[ii], &_frame->m_view[ii], sizeof(View) );
+				base::write(&writer, ViewId(ii), &err);
+				base::write(&writer, &_frame->m_view[ii], sizeof(View), &err);
+			}
+		}
+
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		const uint32_t numMatrices = base::min<uint32_t>(matrixCache.m_num, GRAPHICS_CONFIG_MAX_MATRIX_CACHE);
+		base::write(&writer, numMatrices, &err);
+		base::write(&writer, matrixCache.m_cache, sizeof(Matrix4)*numMatrices, &err);
+
+		const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		const uint32_t numRects = base::min<uint32_t>(rectCache.m_num, GRAPHICS_CONFIG_MAX_RECT_CACHE);
+		base::write(&writer, numRects, &err);
+		base::write(&writer, rectCache.m_cache, sizeof(Rect)*numRects, &err);
+
+		const uint32_t numRenderItems = base::min<uint32_t>(_frame->m_numRenderItems, GRAPHICS_CONFIG_MAX_DRAW_CALLS);
+		base::write(&writer, numRenderItems, &err);
+		base::write(&writer, _frame->m_sortKeys,       sizeof(uint64_t)*numRenderItems,        &err);
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		base::write(&writer, _frame->m_sortKeysWide,   sizeof(uint64_t)*numRenderItems,        &err);
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+		base::write(&writer, _frame->m_sortValues,     sizeof(RenderItemCount)*numRenderItems, &err);
+		base::write(&writer, _frame->m_renderItem,     sizeof(RenderItem)*numRenderItems,      &err);
+		base::write(&writer, _frame->m_renderItemBind, sizeof(RenderBind)*numRenderItems,      &err);
+
+		const uint16_t numBlitItems = _frame->m_numBlitItems;
+		base::write(&writer, numBlitItems, &err);
+		base::write(&writer, _frame->m_blitKeys, sizeof(uint32_t)*numBlitItems, &err);
+		base::write(&writer, _frame->m_blitItem, sizeof(BlitItem)*numBlitItems, &err);
+
+		// Uniform buffers are finished at this point, used size is found from uniform ranges
+		// referenced by render items.
+		stl::vector<uint32_t>& uniformSize = _capture->m_uniformSize;
+		uniformSize.clear();
+		uniformSize.resize(g_caps.limits.maxEncoders, 0);
+
+		uint16_t numUniformBuffers = 0;
+
+		SortKey key;
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			const bool isCompute = key.decode(_frame->m_sortKeys[ii], _frame->m_viewRemap);
+			const RenderItem& renderItem = _frame->m_renderItem[_frame->m_sortValues[ii] ];
+
+			const uint8_t  idx = isCompute ? renderItem.compute.m_uniformIdx : renderItem.draw.m_uniformIdx;
+			const uint32_t end = isCompute ? renderItem.compute.m_uniformEnd : renderItem.draw.m_uniformEnd;
+
+			if (UINT8_MAX != idx)
+			{
+				uniformSize[idx]  = base::max(uniformSize[idx], end);
+				numUniformBuffers = base::max<uint16_t>(numUniformBuffers, idx+1);
+			}
+		}
+
+		base::write(&writer, numUniformBuffers, &err);
+		for (uint16_t ii = 0; ii < numUniformBuffers; ++ii)
+		{
+			UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+
+			base::write(&writer, uniformSize[ii], &err);
+			base::write(&writer, uniformBuffer->read(uniformSize[ii]), uniformSize[ii], &err);
+
+			uniformBuffer->reset();
+		}
+
+		writeTransientPages(&writer, _frame->m_transientIb, &err);
+		writeTransientPages(&writer, _frame->m_transientVb, &err);
+
+		writeCommandBuffer(&writer, _frame->m_cmdPre,  _capture->m_fixups, _textureRef, &err);
+		writeCommandBuffer(&writer, _frame->m_cmdPost, _capture->m_fixups, _textureRef, &err);
+
+		const uint32_t size = uint32_t(base::seek(&writer) );
+		base::write(&_capture->m_writer, size, &err);
+		base::write(&_capture->m_writer, _capture->m_mb.more(0), size, &err);
+
+		if (!err.isOk() )
+		{
+			BASE_TRACE("Failed to write frame capture: %.*s", err.getMessage().getLength(), err.getMessage().getPtr() );
+		}
+
+		++_capture->m_numFrames;
+	}
+
+	// Read back destination can be written by renderer for `readTextureLatency` frames after
+	// replay stopped using it, such memory is kept in retired list until then.
+	struct ReadBackMemory
+	{
+		uint8_t* getData()
+		{
+			return (uint8_t*)this + sizeof(ReadBackMemory);
+		}
+
+		ReadBackMemory* m_next;
+		uint32_t m_frameNum; //!< Last frame in which renderer can write to memory.
+		uint32_t m_size;
+	};
+
+	static ReadBackMemory* s_readBackRetired = NULL;
+
+	static void retireReadBack(ReadBackMemory* _mem, uint32_t _frameNum)
+	{
+		if (NULL != _mem)
+		{
+			_mem->m_frameNum  = _frameNum + g_caps.limits.readTextureLatency;
+			_mem->m_next      = s_readBackRetired;
+			s_readBackRetired = _mem;
+		}
+	}
+
+	void frameReplayReleaseMemory(uint32_t _frameNum)
+	{
+		ReadBackMemory** next = &s_readBackRetired;
+		for (ReadBackMemory* mem = *next; NULL != mem; mem = *next)
+		{
+			if (mem->m_frameNum <= _frameNum)
+			{
+				*next = mem->m_next;
+				base::free(g_allocator, mem);
+			}
+			else
+			{
+				next = &mem->m_next;
+			}
+		}
+	}
+
+	struct ReplayHandle
+	{
+		uint8_t m_destroy; //!< Command destroying resource.
+		bool    m_alive;   //!< Resource was created by replayed frame, and not destroyed yet.
+	};
+
+	typedef stl::unordered_map<uint32_t, ReplayHandle> ReplayHandleMap;
+
+	static uint32_t toHandleKey(uint8_t _type, uint16_t _idx)
+	{
+		return (uint32_t(_type)<<16) | _idx;
+	}
+
+	static base::HandleAlloc* getHandleAlloc(Context* _ctx, uint8_t _type)
+	{
+		switch (_type)
+		{
+		case Handle::FrameBuffer:  return &_ctx->m_frameBufferHandle;
+		case Handle::IndexBuffer:  return &_ctx->m_indexBufferHandle;
+		case Handle::Program:      return &_ctx->m_programHandle;
+		case Handle::Shader:       return &_ctx->m_shaderHandle;
+		case Handle::Texture:      return &_ctx->m_textureHandle;
+		case Handle::Uniform:      return &_ctx->m_uniformHandle;
+		case Handle::VertexBuffer: return &_ctx->m_vertexBufferHandle;
+		case Handle::VertexLayout: return &_ctx->m_layoutHandle;
+		default:                   break;
+		}
+
+		return NULL;
+	}
+
+	// Queue handle to be freed at the end of the frame, the same way destroy API functions do.
+	static void freeHandle(Frame* _frame, uint8_t _type, uint16_t _idx)
+	{
+		switch (_type)
+		{
+		case Handle::FrameBuffer:  { FrameBufferHandle  handle = { _idx }; _frame->free(handle); } break;
+		case Handle::IndexBuffer:  { IndexBufferHandle  handle = { _idx }; _frame->free(handle); } break;
+		case Handle::Program:      { ProgramHandle      handle = { _idx }; _frame->free(handle); } break;
+		case Handle::Shader:       { ShaderHandle       handle = { _idx }; _frame->free(handle); } break;
+		case Handle::Texture:      { TextureHandle      handle = { _idx }; _frame->free(handle); } break;
+		case Handle::Uniform:      { UniformHandle      handle = { _idx }; _frame->free(handle); } break;
+		case Handle::VertexBuffer: { VertexBufferHandle handle = { _idx }; _frame->free(handle); } break;
+		case Handle::VertexLayout: { VertexLayoutHandle handle = { _idx }; _frame->free(handle); } break;
+		default:                   break;
+		}
+	}
+
+	static constexpr uint32_t kHandleOpSize = sizeof(uint16_t) + 3*sizeof(uint8_t);
+
+	static void readHandleOp(base::ReaderI* _reader, HandleOp& _op, base::Error* _err)
+	{
+		base::read(_reader, _op.m_idx, _err);
+		base::read(_reader, _op.m_type, _err);
+		base::read(_reader, _op.m_op, _err);
+		base::read(_reader, _op.m_destroy, _err);
+	}
+
+	struct FrameReplay
+	{
+		FrameReplay()
+			: m_data(NULL)
+			, m_size(0)
+			, m_capacity(0)
+			, m_numFrames(0)
+			, m_failed(false)
+		{
+			base::memSet(m_view, 0, sizeof(m_view) );
+			base::memSet(m_readBack, 0, sizeof(m_readBack) );
+		}
+
+		~FrameReplay()
+		{
+			base::free(g_allocator, m_data);
+		}
+
+		base::FileReader  m_reader;
+		CommandFixupArray m_fixups;
+		ReplayHandleMap   m_handles;
+		stl::vector<uint16_t> m_temp;
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_capacity;
+		uint32_t m_numFrames;
+		bool     m_failed;
+		uint8_t  m_view[GRAPHICS_CONFIG_MAX_VIEWS][sizeof(View)];
+		ReadBackMemory* m_readBack[GRAPHICS_CONFIG_MAX_TEXTURES];
+		uint16_t m_ibRemap[GRAPHICS_CONFIG_MAX_INDEX_BUFFERS];
+		uint16_t m_vbRemap[GRAPHICS_CONFIG_MAX_VERTEX_BUFFERS];
+	};
+
+	// Recorded commands create resources with recorded handles. All handles created by any
+	// recorded frame are reserved in context's handle allocators before first frame is loaded,
+	// so that context can't allocate them for its own resources while replay is in progress.
+	static bool reserveHandles(FrameReplay* _replay, Context* _ctx, const char* _filePath)
+	{
+		ReplayHandleMap& handles = _replay->m_handles;
+
+		for (;;)
+		{
+			base::Error err;
+
+			uint32_t size;
+			base::read(&_replay->m_reader, size, &err);
+
+			if (!err.isOk() )
+			{
+				break;
+			}
+
+			uint32_t numOps;
+			base::read(&_replay->m_reader, numOps, &err);
+
+			for (uint32_t ii = 0; ii < numOps && err.isOk(); ++ii)
+			{
+				HandleOp op;
+				readHandleOp(&_replay->m_reader, op, &err);
+
+				if (HandleOp::CreateWindow == op.m_op)
+				{
+					BASE_TRACE("Frame capture file '%s' creates window frame buffer, native window handle can't be replayed.", _filePath);
+					return false;
+				}
+
+				if (HandleOp::Create == op.m_op)
+				{
+					ReplayHandle handle;
+					handle.m_destroy = op.m_destroy;
+					handle.m_alive   = false;
+					handles.insert(stl::make_pair(toHandleKey(op.m_type, op.m_idx), handle) );
+				}
+			}
+
+			base::seek(&_replay->m_reader, int64_t(size) - sizeof(uint32_t) - numOps*kHandleOpSize, base::Whence::Current);
+		}
+
+		base::seek(&_replay->m_reader, sizeof(FrameCaptureHeader), base::Whence::Begin);
+
+		for (ReplayHandleMap::const_iterator it = handles.begin(), itEnd = handles.end(); it != itEnd; ++it)
+		{
+			const uint8_t  type = uint8_t(it->first>>16);
+			const uint16_t idx  = uint16_t(it->first);
+
+			const base::HandleAlloc* alloc = getHandleAlloc(_ctx, type);
+			if (NULL == alloc
+			||  idx >= alloc->getMaxHandles()
+			||  alloc->isValid(idx) )
+			{
+				BASE_TRACE("Frame capture file '%s' uses %s handle %d, which is already in use."
+					, _filePath
+					, Handle::getTypeName(Handle::Enum(type) ).fullName
+					, idx
+					);
+				return false;
+			}
+		}
+
+		// Handles can't be allocated by index, allocate until all recorded ones are taken and
+		// release the rest.
+		stl::vector<uint16_t>& temp = _replay->m_temp;
+
+		for (uint8_t type = 0; type < Handle::Count; ++type)
+		{
+			base::HandleAlloc* alloc = getHandleAlloc(_ctx, type);
+			if (NULL == alloc)
+			{
+				continue;
+			}
+
+			uint32_t numReserve = 0;
+			for (ReplayHandleMap::const_iterator it = handles.begin(), itEnd = handles.end(); it != itEnd; ++it)
+			{
+				numReserve += type == uint8_t(it->first>>16);
+			}
+
+			temp.clear();
+
+			while (0 < numReserve)
+			{
+				const uint16_t idx = alloc->alloc();
+				BASE_ASSERT(kInvalidHandle != idx, "Recorded handle is free, but it was not allocated.");
+
+				if (handles.end() != handles.find(toHandleKey(type, idx) ) )
+				{
+					--numReserve;
+				}
+				else
+				{
+					temp.push_back(idx);
+				}
+			}
+
+			for (uint32_t ii = 0, num = uint32_t(temp.size() ); ii < num; ++ii)
+			{
+				alloc->free(temp[ii]);
+			}
+		}
+
+		return true;
+	}
+
+	FrameReplay* frameReplayCreate(const char* _filePath, Context* _ctx)
+	{
+		FrameReplay* replay = BASE_NEW(g_allocator, FrameReplay);
+
+		base::Error err;
+		if (!base::open(&replay->m_reader, _filePath, &err) )
+		{
+			BASE_TRACE("Failed to open frame capture file '%s'.", _filePath);
+			base::deleteObject(g_allocator, replay);
+			return NULL;
+		}
+
+		FrameCaptureHeader header;
+		base::read(&replay->m_reader, header, &err);
+
+		FrameCaptureHeader expected;
+		initHeader(expected);
+
+		if (!err.isOk()
+		||  header.magic           != expected.magic
+		||  header.version         != expected.version
+		||  header.maxViews        != expected.maxViews
+		||  header.maxDrawCalls     > expected.maxDrawCalls
+		||  header.maxEncoders      > expected.maxEncoders
+		||  header.sortKeyLayout   != expected.sortKeyLayout
+		||  header.sizeView        != expected.sizeView
+		||  header.sizeRenderItem  != expected.sizeRenderItem
+		||  header.sizeRenderBind  != expected.sizeRenderBind
+		||  header.sizeBlitItem    != expected.sizeBlitItem)
+		{
+			BASE_TRACE("Frame capture file '%s' is not compatible with this build or init limits.", _filePath);
+			base::close(&replay->m_reader);
+			base::deleteObject(g_allocator, replay);
+			return NULL;
+		}
+
+		if (!reserveHandles(replay, _ctx, _filePath) )
+		{
+			base::close(&replay->m_reader);
+			base::deleteObject(g_allocator, replay);
+			return NULL;
+		}
+
+		return replay;
+	}
+
+	void frameReplayDestroy(FrameReplay* _replay, Context* _ctx)
+	{
+		BASE_TRACE("Frame replay finished, %d frames replayed.", _replay->m_numFrames);
+
+		Frame* frame = _ctx->m_submit;
+
+		// Resources created by replay are destroyed, and reserved handles are released, as if
+		// application destroyed them.
+		const ReplayHandleMap& handles = _replay->m_handles;
+		for (ReplayHandleMap::const_iterator it = handles.begin(), itEnd = handles.end(); it != itEnd; ++it)
+		{
+			const uint8_t  type = uint8_t(it->first>>16);
+			const uint16_t idx  = uint16_t(it->first);
+
+			if (it->second.m_alive)
+			{
+				if (Handle::VertexLayout == type)
+				{
+					base::atomicFetchAndAdd<uint32_t>(&_ctx->m_layoutGeneration, 1);
+				}
+
+				CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::Enum(it->second.m_destroy) );
+				cmdbuf.write(idx);
+			}
+
+			freeHandle(frame, type, idx);
+		}
+
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(_replay->m_readBack); ++ii)
+		{
+			retireReadBack(_replay->m_readBack[ii], frame->m_frameNum);
+		}
+
+		base::close(&_replay->m_reader);
+		base::deleteObject(g_allocator, _replay);
+	}
+
+	bool frameReplayRead(FrameReplay* _replay)
+	{
+		if (_replay->m_failed)
+		{
+			return false;
+		}
+
+		base::Error err;
+
+		uint32_t size;
+		base::read(&_replay->m_reader, size, &err);
+
+		if (!err.isOk() )
+		{
+			return false;
+		}
+
+		if (size > _replay->m_capacity)
+		{
+			_replay->m_capacity = base::alignUp(size, 64<<10);
+			_replay->m_data = (uint8_t*)base::realloc(g_allocator, _replay->m_data, _replay->m_capacity);
+		}
+
+		_replay->m_size = size;
+		base::read(&_replay->m_reader, _replay->m_data, size, &err);
+
+		return err.isOk();
+	}
+
+	static const void* readPtr(base::MemoryReader& _reader, uint32_t _size)
+	{
+		const void* ptr = _reader.getDataPtr();
+		_reader.seek(_size, base::Whence::Current);
+		return ptr;
+	}
+
+	static void loadCommandBuffer(FrameReplay* _replay, base::MemoryReader& _reader, CommandBuffer& _cmdbuf, uint32_t _frameNum, base::Error* _err)
+	{
+		// Commands submitted since last frame are replaced by recorded ones, memory referenced by
+		// them must be released here since they will never be executed.
+		findFixups(_cmdbuf, _replay->m_fixups);
+
+		for (uint32_t ii = 0, num = uint32_t(_replay->m_fixups.size() ); ii < num; ++ii)
+		{
+			const CommandFixup& fixup = _replay->m_fixups[ii];
+
+			if (CommandFixup::Memory        == fixup.m_type
+			||  CommandFixup::TextureMemory == fixup.m_type)
+			{
+				const Memory* mem = getPtr<const Memory>(_cmdbuf, fixup);
+
+				if (CommandFixup::TextureMemory == fixup.m_type)
+				{
+					const Memory* texMem = getTextureCreateMem(mem);
+					if (NULL != texMem)
+					{
+						release(texMem);
+					}
+				}
+
+				release(mem);
+			}
+		}
+
+		uint32_t size;
+		base::read(&_reader, size, _err);
+
+		if (size > _cmdbuf.m_capacity)
+		{
+			_cmdbuf.resize(size);
+		}
+
+		base::read(&_reader, _cmdbuf.m_buffer, size, _err);
+		_cmdbuf.m_size = size;
+		_cmdbuf.m_pos  = 0;
+
+		uint32_t numFixups;
+		base::read(&_reader, numFixups, _err);
+
+		for (uint32_t ii = 0; ii < numFixups; ++ii)
+		{
+			CommandFixup fixup;
+			base::read(&_reader, fixup.m_pos, _err);
+			base::read(&_reader, fixup.m_type, _err);
+
+			switch (fixup.m_type)
+			{
+			case CommandFixup::Memory:
+			case CommandFixup::TextureMemory:
+				{
+					uint32_t memSize;
+					base::read(&_reader, memSize, _err);
+
+					const Memory* mem = alloc(memSize);
+					base::read(&_reader, mem->data, memSize, _err);
+					setPtr(_cmdbuf, fixup, mem);
+
+					if (CommandFixup::TextureMemory == fixup.m_type)
+					{
+						uint32_t texMemSize;
+						base::read(&_reader, texMemSize, _err);
+
+						if (UINT32_MAX != texMemSize)
+						{
+							const Memory* texMem = alloc(texMemSize);
+							base::read(&_reader, texMem->data, texMemSize, _err);
+							base::memCopy(&mem->data[kTextureCreateMemOffset], &texMem, sizeof(texMem) );
+						}
+					}
+				}
+				break;
+
+			case CommandFixup::ReadBack:
+				{
+					uint16_t handle;
+					base::read(&_reader, handle, _err);
+
+					uint32_t readBackSize;
+					base::read(&_reader, readBackSize, _err);
+
+					// Memory is owned by replay and only grows. Read backs into previous memory
+					// can still be in flight, it's retired instead of reallocated.
+					ReadBackMemory*& mem = _replay->m_readBack[handle];
+					if (NULL == mem
+					||  readBackSize > mem->m_size)
+					{
+						retireReadBack(mem, _frameNum);
+
+						mem = (ReadBackMemory*)base::alloc(g_allocator, sizeof(ReadBackMemory) + readBackSize);
+						mem->m_next     = NULL;
+						mem->m_frameNum = 0;
+						mem->m_size     = readBackSize;
+					}
+
+					setPtr(_cmdbuf, fixup, mem->getData() );
+				}
+				break;
+
+			default:
+				BASE_ASSERT(false, "Invalid command fixup: %d", fixup.m_type);
+				break;
+			}
+		}
+	}
+
+	struct TransientPageLoad
+	{
+		const void* m_data;
+		uint32_t m_used;
+		uint16_t m_handle;
+	};
+
+	template<typename Ty>
+	static void copyTransientPage(TransientPages<Ty>& _pages, uint32_t _idx, const TransientPageLoad& _load, uint16_t* _remap)
+	{
+		Ty* page = _pages.m_page[_idx];
+		BASE_ASSERT(_load.m_used <= page->size, "Transient page %d is too small for replay (%d < %d).", _idx, page->size, _load.m_used);
+
+		base::memCopy(page->data, _load.m_data, _load.m_used);
+
+		_pages.m_used[_idx]    = _load.m_used;
+		_remap[_load.m_handle] = page->handle.idx;
+	}
+
+	// Transient pages are allocated on demand, replaying frame might have different number of
+	// pages, or pages with different handles and sizes than captured frame. Captured page handles
+	// are mapped to replay frame page handles. Pages that don't exist or are too small are returned
+	// in `_missing`, and must be added with `addTransientPages` once recorded command buffers are
+	// loaded. Returns false if recorded frame has more pages than replay frame can hold.
+	template<typename Ty>
+	static bool loadTransientPages(base::MemoryReader& _reader, TransientPages<Ty>& _pages, uint16_t* _remap, TransientPageLoad* _missing, uint32_t& _numMissing, base::Error* _err)
+	{
+		uint16_t numPages;
+		base::read(&_reader, numPages, _err);
+
+		_numMissing = 0;
+		bool result = true;
+
+		for (uint16_t ii = 0; ii < numPages; ++ii)
+		{
+			TransientPageLoad load;
+			base::read(&_reader, load.m_handle, _err);
+			base::read(&_reader, load.m_used, _err);
+			load.m_data = readPtr(_reader, load.m_used);
+
+			if (ii < _pages.m_num
+			&&  load.m_used <= _pages.m_page[ii]->size)
+			{
+				copyTransientPage(_pages, ii, load, _remap);
+			}
+			else if (_numMissing < GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES)
+			{
+				_missing[_numMissing++] = load;
+			}
+			else
+			{
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	// Pages are created by commands appended to recorded pre command buffer, since commands written
+	// before replay was loaded are replaced by recorded ones. New page is at least as large as
+	// recorded data. Returns false if page can't be added.
+	template<typename Ty, typename AddPageFn>
+	static bool addTransientPages(TransientPages<Ty>& _pages, const TransientPageLoad* _missing, uint32_t _num, uint16_t* _remap, AddPageFn _addPage)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint32_t idx = _pages.m_num;
+			if (GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES <= idx
+			||  !_addPage(idx, _missing[ii].m_used)
+			||  idx == _pages.m_num)
+			{
+				return false;
+			}
+
+			copyTransientPage(_pages, idx, _missing[ii], _remap);
+		}
+
+		return true;
+	}
+
+	void frameReplayLoad(FrameReplay* _replay, Context* _ctx, Frame* _frame)
+	{
+		BASE_ASSERT(_ctx->m_submit == _frame, "Replay must be loaded into submit frame.");
+
+		base::Error err;
+		base::MemoryReader reader(_replay->m_data, _replay->m_size);
+
+		// Handles are already reserved by `frameReplayCreate`, only track which resources exist.
+		uint32_t numOps;
+		base::read(&reader, numOps, &err);
+		for (uint32_t ii = 0; ii < numOps; ++ii)
+		{
+			HandleOp op;
+			readHandleOp(&reader, op, &err);
+
+			ReplayHandleMap::iterator it = _replay->m_handles.find(toHandleKey(op.m_type, op.m_idx) );
+			if (_replay->m_handles.end() == it)
+			{
+				continue;
+			}
+
+			if (HandleOp::Destroy == op.m_op)
+			{
+				it->second.m_alive = false;
+			}
+			else
+			{
+				it->second.m_alive   = true;
+				it->second.m_destroy = op.m_destroy;
+			}
+		}
+
+		base::read(&reader, _frame->m_resolution, &err);
+		base::read(&reader, _frame->m_debug, &err);
+		base::read(&reader, _frame->m_viewRemap, sizeof(_frame->m_viewRemap), &err);
+		base::read(&reader, _frame->m_colorPalette, sizeof(_frame->m_colorPalette), &err);
+
+		uint16_t numViews;
+		base::read(&reader, numViews, &err);
+		for (uint16_t ii = 0; ii < numViews; ++ii)
+		{
+			ViewId id;
+			base::read(&reader, id, &err);
+			base::read(&reader, _replay->m_view[id], sizeof(View), &err);
+		}
+
+		base::memCopy(_frame->m_view, _replay->m_view, sizeof(_frame->m_view) );
+
+		MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		base::read(&reader, matrixCache.m_num, &err);
+		base::read(&reader, matrixCache.m_cache, sizeof(Matrix4)*matrixCache.m_num, &err);
+
+		RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		base::read(&reader, rectCache.m_num, &err);
+		base::read(&reader, rectCache.m_cache, sizeof(Rect)*rectCache.m_num, &err);
+
+		uint32_t numRenderItems;
+		base::read(&reader, numRenderItems, &err);
+		_frame->m_numRenderItems = numRenderItems;
+		base::read(&reader, _frame->m_sortKeys,       sizeof(uint64_t)*numRenderItems,        &err);
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		base::read(&reader, _frame->m_sortKeysWide,   sizeof(uint64_t)*numRenderItems,        &err);
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+		base::read(&reader, _frame->m_sortValues,     sizeof(RenderItemCount)*numRenderItems, &err);
+		base::read(&reader, _frame->m_renderItem,     sizeof(RenderItem)*numRenderItems,      &err);
+		base::read(&reader, _frame->m_renderItemBind, sizeof(RenderBind)*numRenderItems,      &err);
+
+		uint16_t numBlitItems;
+		base::read(&reader, numBlitItems, &err);
+		_frame->m_numBlitItems = numBlitItems;
+		base::read(&reader, _frame->m_blitKeys, sizeof(uint32_t)*numBlitItems, &err);
+		base::read(&reader, _frame->m_blitItem, sizeof(BlitItem)*numBlitItems, &err);
+
+		uint16_t numUniformBuffers;
+		base::read(&reader, numUniformBuffers, &err);
+		for (uint16_t ii = 0; ii < numUniformBuffers; ++ii)
+		{
+			uint32_t size;
+			base::read(&reader, size, &err);
+
+			UniformBuffer::update(&_frame->m_uniformBuffer[ii], size + (64<<10), size + (64<<10) );
+
+			UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+			uniformBuffer->write(readPtr(reader, size), size);
+			uniformBuffer->finish();
+		}
+
+		uint16_t* ibRemap = _replay->m_ibRemap;
+		uint16_t* vbRemap = _replay->m_vbRemap;
+		base::memSet(ibRemap, 0xff, sizeof(_replay->m_ibRemap) );
+		base::memSet(vbRemap, 0xff, sizeof(_replay->m_vbRemap) );
+
+		TransientPageLoad ibMissing[GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES];
+		TransientPageLoad vbMissing[GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES];
+		uint32_t numIbMissing;
+		uint32_t numVbMissing;
+		bool transientOk = true;
+		transientOk &= loadTransientPages(reader, _frame->m_transientIb, ibRemap, ibMissing, numIbMissing, &err);
+		transientOk &= loadTransientPages(reader, _frame->m_transientVb, vbRemap, vbMissing, numVbMissing, &err);
+
+		loadCommandBuffer(_replay, reader, _frame->m_cmdPre,  _frame->m_frameNum, &err);
+		loadCommandBuffer(_replay, reader, _frame->m_cmdPost, _frame->m_frameNum, &err);
+
+		if (0 != numIbMissing
+		||  0 != numVbMissing)
+		{
+			// Replay is loaded from `Context::frame`, which already holds resource API lock.
+			_frame->m_cmdPre.reopen();
+
+			transientOk = transientOk
+				&& addTransientPages(_frame->m_transientIb, ibMissing, numIbMissing, ibRemap
+					, [_ctx](uint32_t _numPages, uint32_t _size) { return _ctx->addTransientIndexPageLocked(_numPages, _size); }
+					)
+				&& addTransientPages(_frame->m_transientVb, vbMissing, numVbMissing, vbRemap
+					, [_ctx](uint32_t _numPages, uint32_t _size) { return _ctx->addTransientVertexPageLocked(_numPages, _size); }
+					)
+				;
+
+			_frame->m_cmdPre.finish();
+		}
+
+		if (!transientOk)
+		{
+			// Draws would read transient data that wasn't loaded. Resource commands are still
+			// executed, so that resource state matches handles reserved by replay.
+			BASE_TRACE("Frame replay stopped, transient buffers of recorded frame %d don't fit in replay frame.", _replay->m_numFrames);
+			_frame->m_numRenderItems = 0;
+			_replay->m_failed = true;
+		}
+
+		SortKey key;
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			if (key.decode(_frame->m_sortKeys[ii], _frame->m_viewRemap) )
+			{
+				continue;
+			}
+
+			RenderDraw& draw = _frame->m_renderItem[_frame->m_sortValues[ii] ].draw;
+
+			for (uint32_t stream = 0; stream < GRAPHICS_CONFIG_MAX_VERTEX_STREAMS; ++stream)
+			{
+				uint16_t& idx = draw.m_stream[stream].m_handle.idx;
+				idx = isValid(draw.m_stream[stream].m_handle) && kInvalidHandle != vbRemap[idx] ? vbRemap[idx] : idx;
+			}
+
+			uint16_t& ibIdx = draw.m_indexBuffer.idx;
+			ibIdx = isValid(draw.m_indexBuffer) && kInvalidHandle != ibRemap[ibIdx] ? ibRemap[ibIdx] : ibIdx;
+
+			uint16_t& idbIdx = draw.m_instanceDataBuffer.idx;
+			idbIdx = isValid(draw.m_instanceDataBuffer) && kInvalidHandle != vbRemap[idbIdx] ? vbRemap[idbIdx] : idbIdx;
+		}
+
+		BASE_ASSERT(err.isOk(), "Frame capture is corrupted.");
+
+		++_replay->m_numFrames;
+	}
+
+} // namespace graphics
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#ifndef GRAPHICS_FRAMECAPTURE_H_HEADER_GUARD
+#define GRAPHICS_FRAMECAPTURE_H_HEADER_GUARD
+
+namespace graphics
+{
+	struct Context;
+	struct Frame;
+	struct TextureRef;
+	struct FrameCapture;
+	struct FrameReplay;
+
+	/// Open capture file. Every frame passed to `frameCaptureWrite` is appended to it.
+	FrameCapture* frameCaptureCreate(const char* _filePath);
+
+	/// Close capture file.
+	void frameCaptureDestroy(FrameCapture* _capture);
+
+	/// Serialize frame. Must be called after `Frame::finish`, and before frame is handed to
+	/// render thread, while all memory referenced by resource command buffers is still alive.
+	void frameCaptureWrite(FrameCapture* _capture, Frame* _frame, const TextureRef* _textureRef);
+
+	/// Open capture file for replay, and reserve all resource handles used by recorded frames in
+	/// context's handle allocators. Fails if capture can't be replayed with this context. Caller
+	/// must hold context's resource API lock.
+	FrameReplay* frameReplayCreate(const char* _filePath, Context* _ctx);
+
+	/// Close replay file, destroy resources created by replayed frames, and release reserved
+	/// handles. Read back memory is retired, see `frameReplayReleaseMemory`. Caller must hold
+	/// context's resource API lock.
+	void frameReplayDestroy(FrameReplay* _replay, Context* _ctx);
+
+	/// Free read back memory of replays that renderer can't write to anymore. `_frameNum` is
+	/// the last frame renderer has finished, `UINT32_MAX` once renderer is shut down.
+	void frameReplayReleaseMemory(uint32_t _frameNum);
+
+	/// Read next recorded frame from file. Returns false when there are no more frames, or
+	/// when previous frame couldn't be replayed.
+	bool frameReplayRead(FrameReplay* _replay);
+
+	/// Replace contents of finished submit frame with recorded frame read by `frameReplayRead`.
+	/// Context is used to add transient pages when recorded frame used more than replaying one,
+	/// caller must hold context's resource API lock. If recorded transient data doesn't fit,
+	/// frame's render items are dropped and replay stops.
+	void frameReplayLoad(FrameReplay* _replay, Context* _ctx, Frame* _frame);
+
+} // namespace graphics
+
+#endif // GRAPHICS_FRAMECAPTURE_H_HEADER_GUARD
@@ -192,6 +192,67 @@ EGL_IMPORT
 	static EGL_DISPMANX_WINDOW_T s_dispmanWindow;
 #	endif // BASE_PLATFORM_RPI
 
+	static EGLDisplay getHeadlessDisplay()
+	{
+#	if GRAPHICS_GL_CONFIG_EGL_SURFACELESS
+		// Client extensions are queried without display, NULL is returned when
+		// EGL_EXT_client_extensions is not supported.
+		const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+		if (NULL == clientExtensions)
+		{
+			eglGetError();
+			return EGL_NO_DISPLAY;
+		}
+
+		BASE_TRACE("Supported EGL client extensions:");
+		dumpExtensions(clientExtensions);
+
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT") );
+
+		if (NULL == getPlatformDisplay)
+		{
+			return EGL_NO_DISPLAY;
+		}
+
+		// Mesa surfaceless platform works without display server and GPU, with llvmpipe.
+		if (!base::findIdentifierMatch(clientExtensions, "EGL_MESA_platform_surfaceless").isEmpty() )
+		{
+			EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+			if (EGL_NO_DISPLAY != display)
+			{
+				BASE_TRACE("Using EGL surfaceless platform.");
+				return display;
+			}
+		}
+
+		// Device platform, used by drivers without surfaceless platform to expose headless GPUs.
+		if (!base::findIdentifierMatch(clientExtensions, "EGL_EXT_platform_device").isEmpty() )
+		{
+			PFNEGLQUERYDEVICESEXTPROC queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT") );
+
+			EGLDeviceEXT devices[8];
+			EGLint numDevices = 0;
+
+			if (NULL != queryDevices
+			&&  queryDevices(BASE_COUNTOF(devices), devices, &numDevices)
+			&&  0 < numDevices)
+			{
+				EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[0], NULL);
+
+				if (EGL_NO_DISPLAY != display)
+				{
+					BASE_TRACE("Using EGL device platform (%d devices).", numDevices);
+					return display;
+				}
+			}
+		}
+#	endif // GRAPHICS_GL_CONFIG_EGL_SURFACELESS
+
+		return EGL_NO_DISPLAY;
+	}
+
 	void GlContext::create(uint32_t _width, uint32_t _height, uint32_t _flags)
 	{
 		BASE_UNUSED(_flags);
@@ -219,7 +280,18 @@ EGL_IMPORT
 			}
 #	endif // BASE_PLATFORM_WINDOWS
 
-            m_display = eglGetDisplay(NULL == ndt ? EGL_DEFAULT_DISPLAY : ndt);
+			const bool headless = EGLNativeWindowType(0) == nwh;
+
+			m_display = headless && NULL == ndt
+				? getHeadlessDisplay()
+				: EGL_NO_DISPLAY
+				;
+
+			if (EGL_NO_DISPLAY == m_display)
+			{
+				m_display = eglGetDisplay(NULL == ndt ? EGL_DEFAULT_DISPLAY : ndt);
+			}
+
 			GRAPHICS_FATAL(m_display != EGL_NO_DISPLAY, Fatal::UnableToInitialize, "Failed to create display %p", m_display);
 
 			EGLint major = 0;
@@ -249,6 +321,13 @@ EGL_IMPORT
 
 			const bool hasEglAndroidRecordable = !base::findIdentifierMatch(extensions, "EGL_ANDROID_recordable").isEmpty();
 
+			// Headless context is made current without surface, and renders only to frame buffers.
+			const bool surfaceless = true
+				&& BASE_ENABLED(GRAPHICS_GL_CONFIG_EGL_SURFACELESS)
+				&& headless
+				&& !base::findIdentifierMatch(extensions, "EGL_KHR_surfaceless_context").isEmpty()
+				;
+
 			const uint32_t glVersion = !!GRAPHICS_CONFIG_RENDERER_OPENGL
 				? GRAPHICS_CONFIG_RENDERER_OPENGL
 				: GRAPHICS_CONFIG_RENDERER_OPENGLES
@@ -260,8 +339,6 @@ EGL_IMPORT
 			m_msaaContext = true;
 #endif // BASE_PLATFORM_ANDROID
 
-			const bool headless = EGLNativeWindowType(0) == nwh;
-
 			EGLint attrs[] =
 			{
 				EGL_RENDERABLE_TYPE, !!GRAPHICS_CONFIG_RENDERER_OPENGL
@@ -269,7 +346,7 @@ EGL_IMPORT
 					: (glVersion >= 30) ? EGL_OPENGL_ES3_BIT_KHR : EGL_OPENGL_ES2_BIT
 					,
 
-				EGL_SURFACE_TYPE, headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
+				EGL_SURFACE_TYPE, surfaceless ? 0 : headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
 
 				EGL_BLUE_SIZE,  8,
 				EGL_GREEN_SIZE, 8,
@@ -328,7 +405,12 @@ EGL_IMPORT
 			vc_dispmanx_update_submit_sync(dispmanUpdate);
 #	endif // BASE_PLATFORM_ANDROID
 
-			if (headless)
+			if (surfaceless)
+			{
+				BASE_TRACE("Creating surfaceless context.");
+				m_surface = EGL_NO_SURFACE;
+			}
+			else if (headless)
 			{
 				EGLint pbAttribs[] =
 				{
@@ -345,7 +427,7 @@ EGL_IMPORT
 				m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
 			}
 
-			GRAPHICS_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			GRAPHICS_FATAL(surfaceless || m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
 
 			const bool hasEglKhrCreateContext = !base::findIdentifierMatch(extensions, "EGL_KHR_create_context").isEmpty();
 			const bool hasEglKhrNoError       = !base::findIdentifierMatch(extensions, "EGL_KHR_create_context_no_error").isEmpty();
@@ -414,7 +496,10 @@ EGL_IMPORT
 			GRAPHICS_FATAL(success, Fatal::UnableToInitialize, "Failed to set context.");
 			m_current = NULL;
 
-			eglSwapInterval(m_display, 0);
+			if (!surfaceless)
+			{
+				eglSwapInterval(m_display, 0);
+			}
 		}
 
 		import();
@@ -428,7 +513,12 @@ EGL_IMPORT
 		{
 			EGL_CHECK(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) );
 			EGL_CHECK(eglDestroyContext(m_display, m_context) );
-			EGL_CHECK(eglDestroySurface(m_display, m_surface) );
+
+			if (EGL_NO_SURFACE != m_surface)
+			{
+				EGL_CHECK(eglDestroySurface(m_display, m_surface) );
+			}
+
 			EGL_CHECK(eglTerminate(m_display) );
 			m_context = NULL;
 		}
@@ -463,7 +553,8 @@ EGL_IMPORT
 		BASE_UNUSED(_width, _height);
 #	endif // BASE_PLATFORM_*
 
-		if (NULL != m_display)
+		if (NULL != m_display
+		&&  EGL_NO_SURFACE != m_surface)
 		{
 			bool vsync = !!(_flags&GRAPHICS_RESET_VSYNC);
 			EGL_CHECK(eglSwapInterval(m_display, vsync ? 1 : 0) );
@@ -498,7 +589,8 @@ EGL_IMPORT
 
 		if (NULL == _swapChain)
 		{
-			if (NULL != m_display)
+			if (NULL != m_display
+			&&  EGL_NO_SURFACE != m_surface)
 			{
 				EGL_CHECK(eglSwapBuffers(m_display, m_surface) );
 			}
@@ -1287,6 +1287,9 @@ namespace graphics
 
 		m_frame->m_sortKeys[renderItemIdx]   = key;
 		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		m_frame->m_sortKeysWide[renderItemIdx] = m_key.encodeDrawWide(type);
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
@@ -1326,7 +1329,8 @@ namespace graphics
 		m_bind.clear(_flags);
 		if (_flags & GRAPHICS_DISCARD_STATE)
 		{
-			m_uniformBegin = m_uniformEnd;
+			m_uniformBegin   = m_uniformEnd;
+			m_key.m_material = 0;
 		}
 	}
 
@@ -1370,6 +1374,9 @@ namespace graphics
 		uint64_t key = m_key.encodeCompute();
 		m_frame->m_sortKeys[renderItemIdx]   = key;
 		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		m_frame->m_sortKeysWide[renderItemIdx] = 0;
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
 
 		m_compute.m_uniformIdx   = m_uniformIdx;
 		m_compute.m_uniformBegin = m_uniformBegin;
@@ -1414,10 +1421,47 @@ namespace graphics
 		}
 	}
 
+	VertexLayoutHandle EncoderImpl::findOrCreateVertexLayout(const VertexLayout& _layout)
+	{
+		// Released layout handle stays allocated until the end of frame, but its hash is already
+		// removed from lookup, so cached handle must not be used after any layout is released.
+		const uint32_t generation = base::atomicFetchAndAdd<uint32_t>(&s_ctx->m_layoutGeneration, 0);
+		if (generation != m_layoutCacheGeneration)
+		{
+			base::memSet(m_layoutCacheValid, 0, sizeof(m_layoutCacheValid) );
+			m_layoutCacheGeneration = generation;
+		}
+
+		const uint32_t slot = _layout.m_hash % kLayoutCacheSize;
+
+		if (m_layoutCacheValid[slot]
+		&&  _layout.m_hash == m_layoutCacheHash[slot])
+		{
+			return m_layoutCacheHandle[slot];
+		}
+
+		VertexLayoutHandle layoutHandle;
+		{
+			GRAPHICS_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			layoutHandle = s_ctx->findOrCreateVertexLayout(_layout, true);
+		}
+
+		if (isValid(layoutHandle) )
+		{
+			m_layoutCacheHash[slot]   = _layout.m_hash;
+			m_layoutCacheHandle[slot] = layoutHandle;
+			m_layoutCacheValid[slot]  = true;
+		}
+
+		return layoutHandle;
+	}
+
 	void Frame::sort()
 	{
 		GRAPHICS_PROFILER_SCOPE("graphics/Sort", 0xff2040ff);
 
+		const int64_t timeBegin = base::getHPCounter();
+
 		ViewId viewRemap[GRAPHICS_CONFIG_MAX_VIEWS];
 		for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_MAX_VIEWS; ++ii)
 		{
@@ -1458,14 +1502,216 @@ namespace graphics
 			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
 		}
 
-		base::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		// LSD radix sort is stable, sorting by secondary key first and then by primary key
+		// results in items sorted by 128-bit key. After first pass sort values hold original
+		// item indices in secondary key order, primary keys are gathered in that order.
+		base::radixSort(m_sortKeysWide, m_tempKeys, m_sortValues, m_tempValues, m_numRenderItems);
+
+		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		{
+			m_sortKeysWide[ii] = m_sortKeys[m_sortValues[ii] ];
+		}
+
+		base::memCopy(m_sortKeys, m_sortKeysWide, m_numRenderItems*sizeof(uint64_t) );
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+
+		base::radixSort(m_sortKeys, m_tempKeys, m_sortValues, m_tempValues, m_numRenderItems);
+
+		mergeDraws();
 
 		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
 		{
 			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
 		}
 
-		base::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+		base::radixSort(m_blitKeys, (uint32_t*)m_tempKeys, m_numBlitItems);
+
+		m_perfStats.cpuTimeSort = base::getHPCounter() - timeBegin;
+	}
+
+	static bool isMergeable(const RenderDraw& _draw)
+	{
+		return true
+			&& 1 == _draw.m_numMatrices
+			&& 1 == _draw.m_numInstances
+			&& !isValid(_draw.m_instanceDataBuffer)
+			&& !isValid(_draw.m_indirectBuffer)
+			&& !isValid(_draw.m_occlusionQuery)
+			;
+	}
+
+	static bool isMergeable(const RenderDraw& _first, const RenderBind& _firstBind, const RenderDraw& _draw, const RenderBind& _bind)
+	{
+		if (!isMergeable(_draw)
+		||  _first.m_stateFlags  != _draw.m_stateFlags
+		||  _first.m_stencil     != _draw.m_stencil
+		||  _first.m_rgba        != _draw.m_rgba
+		||  _first.m_scissor     != _draw.m_scissor
+		||  _first.m_submitFlags != _draw.m_submitFlags
+		||  _first.m_streamMask  != _draw.m_streamMask
+		||  _first.m_numVertices != _draw.m_numVertices
+		||  _first.m_indexBuffer.idx != _draw.m_indexBuffer.idx
+		||  _first.m_startIndex  != _draw.m_startIndex
+		||  _first.m_numIndices  != _draw.m_numIndices)
+		{
+			return false;
+		}
+
+		for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = base::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const Stream& first  = _first.m_stream[idx];
+			const Stream& stream = _draw.m_stream[idx];
+
+			if (first.m_handle.idx       != stream.m_handle.idx
+			||  first.m_layoutHandle.idx != stream.m_layoutHandle.idx
+			||  first.m_startVertex      != stream.m_startVertex)
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t stage = 0; stage < GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const Binding& first = _firstBind.m_bind[stage];
+			const Binding& bind  = _bind.m_bind[stage];
+
+			if (first.m_idx != bind.m_idx)
+			{
+				return false;
+			}
+
+			if (kInvalidHandle != bind.m_idx
+			&& (first.m_type         != bind.m_type
+			||  first.m_samplerFlags != bind.m_samplerFlags
+			||  first.m_format       != bind.m_format
+			||  first.m_access       != bind.m_access
+			||  first.m_mip          != bind.m_mip) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Frame::mergeDraws()
+	{
+		m_perfStats.numMergedDraws  = 0;
+		m_perfStats.numMergeBatches = 0;
+
+		if (0 == (g_caps.supported & GRAPHICS_CAPS_INSTANCING) )
+		{
+			return;
+		}
+
+		const MatrixCache& matrixCache = m_frameCache.m_matrixCache;
+		const uint16_t stride = uint16_t(sizeof(Matrix4) );
+
+		SortKey key;
+		SortKey next;
+		uint32_t numItems = 0;
+
+		for (uint32_t item = 0, num = m_numRenderItems; item < num;)
+		{
+			const bool isCompute = key.decode(m_sortKeys[item], m_viewRemap);
+			const uint8_t merge = isCompute ? GRAPHICS_MERGE_NONE : m_view[key.m_view].m_merge;
+
+			uint32_t end = item + 1;
+
+			const uint32_t firstIdx = m_sortValues[item];
+			RenderDraw&       first     = m_renderItem[firstIdx].draw;
+			const RenderBind& firstBind = m_renderItemBind[firstIdx];
+
+			if (0 != (merge & GRAPHICS_MERGE_TRANSFORM)
+			&&  isMergeable(first) )
+			{
+				const uint32_t firstUniformSize = first.m_uniformEnd - first.m_uniformBegin;
+				const char*    firstUniform     = UINT8_MAX != first.m_uniformIdx
+					? m_uniformBuffer[first.m_uniformIdx]->getData(first.m_uniformBegin)
+					: NULL
+					;
+
+				for (; end < num; ++end)
+				{
+					if (next.decode(m_sortKeys[end], m_viewRemap)
+					||  next.m_view        != key.m_view
+					||  next.m_program.idx != key.m_program.idx)
+					{
+						break;
+					}
+
+					const uint32_t itemIdx = m_sortValues[end];
+					const RenderDraw& draw = m_renderItem[itemIdx].draw;
+
+					if (!isMergeable(first, firstBind, draw, m_renderItemBind[itemIdx]) )
+					{
+						break;
+					}
+
+					// Draw call without uniforms inherits uniforms of previous one. Otherwise, it
+					// must set exactly the same uniforms as first draw call in run.
+					const uint32_t uniformSize = draw.m_uniformEnd - draw.m_uniformBegin;
+					if (0 != uniformSize
+					&& (0 == (merge & GRAPHICS_MERGE_UNIFORMS)
+					||  uniformSize != firstUniformSize
+					||  0 != base::memCmp(firstUniform, m_uniformBuffer[draw.m_uniformIdx]->getData(draw.m_uniformBegin), uniformSize) ) )
+					{
+						break;
+					}
+				}
+			}
+
+			uint32_t numInstances = end - item;
+			if (1 < numInstances)
+			{
+				// Transient buffers can't grow here since resource command buffer is already
+				// finished, run is left unmerged when there is no space left.
+				uint32_t page;
+				uint32_t offset;
+				if (m_transientVb.alloc(numInstances, stride, true, false, page, offset) )
+				{
+					const TransientVertexBuffer& dvb = *m_transientVb.m_page[page];
+					uint8_t* data = &dvb.data[offset];
+
+					for (uint32_t ii = item; ii < end; ++ii, data += stride)
+					{
+						const RenderDraw& draw = m_renderItem[m_sortValues[ii] ].draw;
+						base::memCopy(data, &matrixCache.m_cache[draw.m_startMatrix], stride);
+					}
+
+					first.m_instanceDataBuffer = dvb.handle;
+					first.m_instanceDataOffset = offset;
+					first.m_instanceDataStride = stride;
+					first.m_numInstances       = numInstances;
+
+					m_perfStats.numMergedDraws  += numInstances;
+					m_perfStats.numMergeBatches += 1;
+
+					m_sortKeys[numItems]   = m_sortKeys[item];
+					m_sortValues[numItems] = m_sortValues[item];
+					++numItems;
+
+					item = end;
+					continue;
+				}
+			}
+
+			for (; item < end; ++item, ++numItems)
+			{
+				m_sortKeys[numItems]   = m_sortKeys[item];
+				m_sortValues[numItems] = m_sortValues[item];
+			}
+		}
+
+		m_numRenderItems = numItems;
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1569,7 +1815,9 @@ namespace graphics
 		CAPS_FLAGS(GRAPHICS_CAPS_TEXTURE_COMPARE_LEQUAL),
 		CAPS_FLAGS(GRAPHICS_CAPS_TEXTURE_CUBE_ARRAY),
 		CAPS_FLAGS(GRAPHICS_CAPS_TEXTURE_DIRECT_ACCESS),
+		CAPS_FLAGS(GRAPHICS_CAPS_TEXTURE_MIN_MIP),
 		CAPS_FLAGS(GRAPHICS_CAPS_TEXTURE_READ_BACK),
+		CAPS_FLAGS(GRAPHICS_CAPS_UNIFORM_BUFFER),
 		CAPS_FLAGS(GRAPHICS_CAPS_VERTEX_ATTRIB_HALF),
 		CAPS_FLAGS(GRAPHICS_CAPS_VERTEX_ATTRIB_UINT10),
 		CAPS_FLAGS(GRAPHICS_CAPS_VERTEX_ID),
@@ -1625,12 +1873,14 @@ namespace graphics
 		BASE_TRACE("");
 		BASE_TRACE("\tD0 Blend    %016" PRIx64, kSortKeyDraw0BlendMask);
 		BASE_TRACE("\tD0 Program  %016" PRIx64, kSortKeyDraw0ProgramMask);
+		BASE_TRACE("\tD0 Material %016" PRIx64, kSortKeyDraw0MaterialMask);
 		BASE_TRACE("\tD0 Depth    %016" PRIx64, kSortKeyDraw0DepthMask);
 
 		BASE_TRACE("");
 		BASE_TRACE("\tD1 Depth    %016" PRIx64, kSortKeyDraw1DepthMask);
 		BASE_TRACE("\tD1 Blend    %016" PRIx64, kSortKeyDraw1BlendMask);
 		BASE_TRACE("\tD1 Program  %016" PRIx64, kSortKeyDraw1ProgramMask);
+		BASE_TRACE("\tD1 Material %016" PRIx64, kSortKeyDraw1MaterialMask);
 
 		BASE_TRACE("");
 		BASE_TRACE("\tD2 Seq      %016" PRIx64, kSortKeyDraw2SeqMask);
@@ -1926,6 +2176,9 @@ namespace graphics
 		m_flipped = true;
 		m_debug   = GRAPHICS_DEBUG_NONE;
 		m_frameTimeLast = base::getHPCounter();
+		m_swapTime      = 0;
+		base::memSet(m_transientVbPeak, 0, sizeof(m_transientVbPeak) );
+		base::memSet(m_transientIbPeak, 0, sizeof(m_transientIbPeak) );
 		m_flipAfterRender = !!(m_init.resolution.reset & GRAPHICS_RESET_FLIP_AFTER_RENDER);
 
 		m_submit->create(_init.limits.minResourceCbSize);
@@ -1956,6 +2209,7 @@ namespace graphics
 		BASE_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
 
 		s_threadIndex = GRAPHICS_API_THREAD_MAGIC;
+		GRAPHICS_PROFILER_SET_CURRENT_THREAD_NAME("graphics - API Thread");
 
 		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_viewRemap); ++ii)
 		{
@@ -2045,14 +2299,14 @@ namespace graphics
 		m_textVideoMemBlitter.init(m_init.resolution.debugTextScale);
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+		m_submit->m_transientVb.add(createTransientVertexBuffer(_init.limits.transientVbSize) );
+		m_submit->m_transientIb.add(createTransientIndexBuffer(_init.limits.transientIbSize) );
 		frame();
 
 		if (BASE_ENABLED(GRAPHICS_CONFIG_MULTITHREADED) )
 		{
-			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+			m_submit->m_transientVb.add(createTransientVertexBuffer(_init.limits.transientVbSize) );
+			m_submit->m_transientIb.add(createTransientIndexBuffer(_init.limits.transientIbSize) );
 			frame();
 		}
 
@@ -2065,19 +2319,20 @@ namespace graphics
 
 	void Context::shutdown()
 	{
+		endFrameCapture();
+		endFrameReplay();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
-		destroyTransientVertexBuffer(m_submit->m_transientVb);
-		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		destroyTransientPages();
 		m_textVideoMemBlitter.shutdown();
 		m_clearQuad.shutdown();
 		frame();
 
 		if (BASE_ENABLED(GRAPHICS_CONFIG_MULTITHREADED) )
 		{
-			destroyTransientVertexBuffer(m_submit->m_transientVb);
-			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			destroyTransientPages();
 			frame();
 		}
 
@@ -2126,6 +2381,9 @@ namespace graphics
 		m_render->destroy();
 #endif // GRAPHICS_CONFIG_MULTITHREADED
 
+		frameReplayReleaseMemory(UINT32_MAX);
+		profilerCaptureShutdown();
+
 		base::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
@@ -2291,6 +2549,8 @@ namespace graphics
 
 			encoder = &m_encoder[idx];
 			encoder->begin(m_submit, uint8_t(idx) );
+
+			GRAPHICS_PROFILER_BEGIN_LITERAL("graphics/Encoder", 0xff2040ff);
 		}
 #else
 		BASE_UNUSED(_forThread);
@@ -2305,6 +2565,8 @@ namespace graphics
 		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
 		if (encoder != &m_encoder[0])
 		{
+			GRAPHICS_PROFILER_END();
+
 			encoder->end(true);
 			m_encoderEndSem.post();
 		}
@@ -2331,9 +2593,24 @@ namespace graphics
 		uint32_t frameNum = m_submit->m_frameNum;
 
 		GRAPHICS_PROFILER_SCOPE("graphics/API thread frame", 0xff2040ff);
+
+		// Submit frame is owned by API thread, finish and sort it while render thread is still
+		// busy with previous frame.
+		finishSubmit();
+
 		// wait for render thread to finish
 		renderSemWait();
-		frameNoRenderWait();
+
+		// render thread and encoders are idle, it's safe to start or write profiler capture.
+		profilerCaptureFrame(frameNum);
+
+		// Read backs of finished frame replays into replay memory are done up to rendered frame.
+		frameReplayReleaseMemory(m_render->m_frameNum);
+
+		swap();
+
+		// release render thread
+		apiSemPost();
 
 		m_encoder[0].begin(m_submit, 0);
 
@@ -2342,14 +2619,17 @@ namespace graphics
 
 	void Context::frameNoRenderWait()
 	{
+		finishSubmit();
 		swap();
 
 		// release render thread
 		apiSemPost();
 	}
 
-	void Context::swap()
+	void Context::finishSubmit()
 	{
+		const int64_t timeBegin = base::getHPCounter();
+
 		freeDynamicBuffers();
 		m_submit->m_resolution = m_init.resolution;
 		m_init.resolution.reset &= ~GRAPHICS_RESET_INTERNAL_FORCE;
@@ -2370,6 +2650,32 @@ namespace graphics
 
 		m_submit->finish();
 
+		if (m_frameReplayPending)
+		{
+			m_frameReplayPending = false;
+			frameReplayLoad(m_frameReplay, this, m_submit);
+		}
+
+		if (NULL != m_frameCapture)
+		{
+			frameCaptureWrite(m_frameCapture, m_submit, m_textureRef);
+		}
+
+		m_swapTime = base::getHPCounter() - timeBegin;
+
+		// Sort after capture, recorded frame must hold unsorted keys and original view remap, since
+		// replayed frame is sorted again.
+		m_submit->sort();
+
+		// Peak includes instance data of merged draw calls.
+		m_transientVbPeak[1] = base::max(m_transientVbPeak[1], m_submit->m_transientVb.getUsed() );
+		m_transientIbPeak[1] = base::max(m_transientIbPeak[1], m_submit->m_transientIb.getUsed() );
+	}
+
+	void Context::swap()
+	{
+		const int64_t timeBegin = base::getHPCounter();
+
 		base::swap(m_render, m_submit);
 
 		base::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
@@ -2383,6 +2689,22 @@ namespace graphics
 		uint32_t nextFrameNum = m_render->m_frameNum + 1;
 		m_submit->start(nextFrameNum);
 
+		if (0 == nextFrameNum % GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES)
+		{
+			m_transientVbPeak[0] = m_transientVbPeak[1];
+			m_transientIbPeak[0] = m_transientIbPeak[1];
+			m_transientVbPeak[1] = 0;
+			m_transientIbPeak[1] = 0;
+		}
+
+		shrinkTransientPages();
+
+		Stats& perfStats = m_submit->m_perfStats;
+		perfStats.transientVbPeak = base::max(m_transientVbPeak[0], m_transientVbPeak[1]);
+		perfStats.transientIbPeak = base::max(m_transientIbPeak[0], m_transientIbPeak[1]);
+		perfStats.transientVbSize = m_submit->m_transientVb.getSize();
+		perfStats.transientIbSize = m_submit->m_transientIb.getSize();
+
 		base::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize(
@@ -2393,6 +2715,7 @@ namespace graphics
 
 		int64_t now = base::getHPCounter();
 		m_submit->m_perfStats.cpuTimeFrame = now - m_frameTimeLast;
+		m_submit->m_perfStats.cpuTimeSwap  = now - timeBegin + m_swapTime;
 		m_frameTimeLast = now;
 	}
 
@@ -2459,11 +2782,15 @@ namespace graphics
 
 		if (apiSemWait(_msecs) )
 		{
+			int64_t timeExecCommands = base::getHPCounter();
+
 			{
 				GRAPHICS_PROFILER_SCOPE("graphics/Exec commands pre", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPre);
 			}
 
+			timeExecCommands = base::getHPCounter() - timeExecCommands;
+
 			if (m_rendererInitialized)
 			{
 				{
@@ -2484,9 +2811,13 @@ namespace graphics
 
 			{
 				GRAPHICS_PROFILER_SCOPE("graphics/Exec commands post", 0xff2040ff);
+				const int64_t timeBegin = base::getHPCounter();
 				rendererExecCommands(m_render->m_cmdPost);
+				timeExecCommands += base::getHPCounter() - timeBegin;
 			}
 
+			m_render->m_perfStats.cpuTimeExecCommands = timeExecCommands;
+
 			renderSemPost();
 
 			if (m_flipAfterRender)
@@ -2901,6 +3232,48 @@ namespace graphics
 				}
 				break;
 
+			case CommandBuffer::CreateIndexBuffers:
+				{
+					GRAPHICS_PROFILER_SCOPE("CreateIndexBuffers", 0xff2040ff);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						IndexBufferHandle handle;
+						_cmdbuf.read(handle);
+
+						const Memory* mem;
+						_cmdbuf.read(mem);
+
+						uint16_t flags;
+						_cmdbuf.read(flags);
+
+						m_renderCtx->createIndexBuffer(handle, mem, flags);
+
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::DestroyIndexBuffers:
+				{
+					GRAPHICS_PROFILER_SCOPE("DestroyIndexBuffers", 0xff2040ff);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						IndexBufferHandle handle;
+						_cmdbuf.read(handle);
+
+						m_renderCtx->destroyIndexBuffer(handle);
+					}
+				}
+				break;
+
 			case CommandBuffer::CreateVertexLayout:
 				{
 					GRAPHICS_PROFILER_SCOPE("CreateVertexLayout", 0xff2040ff);
@@ -2959,6 +3332,51 @@ namespace graphics
 				}
 				break;
 
+			case CommandBuffer::CreateVertexBuffers:
+				{
+					GRAPHICS_PROFILER_SCOPE("CreateVertexBuffers", 0xff2040ff);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						VertexBufferHandle handle;
+						_cmdbuf.read(handle);
+
+						const Memory* mem;
+						_cmdbuf.read(mem);
+
+						VertexLayoutHandle layoutHandle;
+						_cmdbuf.read(layoutHandle);
+
+						uint16_t flags;
+						_cmdbuf.read(flags);
+
+						m_renderCtx->createVertexBuffer(handle, mem, layoutHandle, flags);
+
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexBuffers:
+				{
+					GRAPHICS_PROFILER_SCOPE("DestroyVertexBuffers", 0xff2040ff);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						VertexBufferHandle handle;
+						_cmdbuf.read(handle);
+
+						m_renderCtx->destroyVertexBuffer(handle);
+					}
+				}
+				break;
+
 			case CommandBuffer::CreateDynamicIndexBuffer:
 				{
 					GRAPHICS_PROFILER_SCOPE("CreateDynamicIndexBuffer", 0xff2040ff);
@@ -3372,6 +3790,20 @@ namespace graphics
 				}
 				break;
 
+			case CommandBuffer::SetTextureMinMip:
+				{
+					GRAPHICS_PROFILER_SCOPE("SetTextureMinMip", 0xff2040ff);
+
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					m_renderCtx->setTextureMinMip(handle, mip);
+				}
+				break;
+
 			default:
 				BASE_ASSERT(false, "Invalid command: %d", command);
 				break;
@@ -3396,6 +3828,12 @@ namespace graphics
 		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator);
 	}
 
+	void topologySortTriList(TopologySort::Enum _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, uint32_t* _order)
+	{
+		BASE_ASSERT(NULL != _order, "_order can't be NULL");
+		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator, _order);
+	}
+
 	uint8_t getSupportedRenderers(uint8_t _max, RendererType::Enum* _enum)
 	{
 		_enum = _max == 0 ? NULL : _enum;
@@ -3552,6 +3990,7 @@ namespace graphics
 		g_caps.limits.minResourceCbSize       = init.limits.minResourceCbSize;
 		g_caps.limits.transientVbSize         = init.limits.transientVbSize;
 		g_caps.limits.transientIbSize         = init.limits.transientIbSize;
+		g_caps.limits.readTextureLatency      = 2;
 
 		g_caps.vendorId = init.vendorId;
 		g_caps.deviceId = init.deviceId;
@@ -3570,6 +4009,8 @@ namespace graphics
 		s_ctx = BASE_ALIGNED_NEW(g_allocator, Context, Context::kAlignment);
 		if (s_ctx->init(init) )
 		{
+			topologySortInit(GRAPHICS_CONFIG_TOPOLOGY_SORT_NUM_THREADS, g_allocator);
+
 			BASE_TRACE("Init complete.");
 			return true;
 		}
@@ -3611,6 +4052,9 @@ namespace graphics
 		BASE_TRACE("Shutdown...");
 
 		GRAPHICS_CHECK_API_THREAD();
+
+		topologySortShutdown();
+
 		Context* ctx = s_ctx; // it's going to be NULLd inside shutdown.
 		ctx->shutdown();
 		BASE_ASSERT(NULL == s_ctx, "graphics is should be uninitialized here.");
@@ -3667,6 +4111,11 @@ namespace graphics
 		GRAPHICS_ENCODER(setState(_state, _rgba) );
 	}
 
+	void Encoder::setMaterial(uint32_t _material)
+	{
+		GRAPHICS_ENCODER(setMaterial(_material) );
+	}
+
 	void Encoder::setCondition(OcclusionQueryHandle _handle, bool _visible)
 	{
 		GRAPHICS_CHECK_CAPS(GRAPHICS_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
@@ -3863,6 +4312,74 @@ namespace graphics
 		GRAPHICS_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
+	void Encoder::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
+	{
+		BASE_ASSERT(NULL != _tib, "_tib can't be NULL");
+		BASE_ASSERT(0 < _num, "Requesting 0 indices.");
+		BASE_ASSERT(
+			  !_index32 || 0 != (g_caps.supported & GRAPHICS_CAPS_INDEX32)
+			, "32-bit indices are not supported. Use graphics::getCaps to check GRAPHICS_CAPS_INDEX32 backend renderer capabilities."
+			);
+
+		s_ctx->allocTransientIndexBuffer(_tib, _num, _index32);
+
+		const uint32_t indexSize = _tib->isIndex16 ? 2 : 4;
+		BASE_ASSERT(_num == _tib->size/indexSize
+			, "Failed to allocate transient index buffer (requested %d, available %d). "
+			  "Use graphics::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tib->size/indexSize
+			);
+		BASE_UNUSED(indexSize);
+	}
+
+	void Encoder::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout)
+	{
+		BASE_ASSERT(NULL != _tvb, "_tvb can't be NULL");
+		BASE_ASSERT(0 < _num, "Requesting 0 vertices.");
+		BASE_ASSERT(isValid(_layout), "Invalid VertexLayout.");
+
+		VertexLayoutHandle layoutHandle = GRAPHICS_ENCODER(findOrCreateVertexLayout(_layout) );
+		BASE_ASSERT(isValid(layoutHandle), "Failed to allocate vertex layout handle (GRAPHICS_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", GRAPHICS_CONFIG_MAX_VERTEX_LAYOUTS);
+
+		s_ctx->allocTransientVertexBuffer(_tvb, _num, layoutHandle, _layout.m_stride);
+
+		BASE_ASSERT(_num == _tvb->size / _layout.m_stride
+			, "Failed to allocate transient vertex buffer (requested %d, available %d). "
+			  "Use graphics::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tvb->size / _layout.m_stride
+			);
+	}
+
+	bool Encoder::allocTransientBuffers(TransientVertexBuffer* _tvb, const VertexLayout& _layout, uint32_t _numVertices, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32)
+	{
+		BASE_ASSERT(NULL != _tvb && NULL != _tib, "_tvb and _tib can't be NULL");
+		BASE_ASSERT(isValid(_layout), "Invalid VertexLayout.");
+
+		VertexLayoutHandle layoutHandle = GRAPHICS_ENCODER(findOrCreateVertexLayout(_layout) );
+		if (!isValid(layoutHandle) )
+		{
+			return false;
+		}
+
+		return s_ctx->allocTransientBuffers(_tvb, _numVertices, layoutHandle, _layout.m_stride, _tib, _numIndices, _index32);
+	}
+
+	void Encoder::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		GRAPHICS_CHECK_CAPS(GRAPHICS_CAPS_INSTANCING, "Instancing is not supported!");
+		BASE_ASSERT(base::isAligned(_stride, 16), "Stride must be multiple of 16.");
+		BASE_ASSERT(0 < _num, "Requesting 0 instanced data vertices.");
+		s_ctx->allocInstanceDataBuffer(_idb, _num, _stride);
+		BASE_ASSERT(_num == _idb->size / _stride
+			, "Failed to allocate instance data buffer (requested %d, available %d). "
+			  "Use graphics::getAvailTransient* functions to ensure availability."
+			, _num
+			, _idb->size / _stride
+			);
+	}
+
 	void Encoder::touch(ViewId _id)
 	{
 		discard();
@@ -4061,7 +4578,9 @@ namespace graphics
 	uint32_t frame(bool _capture)
 	{
 		GRAPHICS_CHECK_API_THREAD();
-		return s_ctx->frame(_capture);
+		const uint32_t frameNum = s_ctx->frame(_capture);
+		s_ctx->readTextureCallback(frameNum);
+		return frameNum;
 	}
 
 	const Caps* getCaps()
@@ -4258,6 +4777,27 @@ namespace graphics
 		s_ctx->destroyIndexBuffer(_handle);
 	}
 
+	uint16_t createIndexBuffers(uint16_t _num, const IndexBufferDesc* _desc, IndexBufferHandle* _handles)
+	{
+		BASE_ASSERT(0 == _num || (NULL != _desc && NULL != _handles), "_desc and _handles can't be NULL");
+
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			BASE_ASSERT(
+				  0 == (_desc[ii].flags & GRAPHICS_BUFFER_INDEX32) || 0 != (g_caps.supported & GRAPHICS_CAPS_INDEX32)
+				, "32-bit indices are not supported. Use graphics::getCaps to check GRAPHICS_CAPS_INDEX32 backend renderer capabilities."
+				);
+			BASE_ASSERT(NULL != _desc[ii].mem, "_desc[%d].mem can't be NULL", ii);
+		}
+
+		return s_ctx->createIndexBuffers(_num, _desc, _handles);
+	}
+
+	void destroy(uint16_t _num, const IndexBufferHandle* _handles)
+	{
+		s_ctx->destroyIndexBuffers(_num, _handles);
+	}
+
 	VertexLayoutHandle createVertexLayout(const VertexLayout& _layout)
 	{
 		return s_ctx->createVertexLayout(_layout);
@@ -4285,6 +4825,24 @@ namespace graphics
 		s_ctx->destroyVertexBuffer(_handle);
 	}
 
+	uint16_t createVertexBuffers(uint16_t _num, const VertexBufferDesc* _desc, VertexBufferHandle* _handles)
+	{
+		BASE_ASSERT(0 == _num || (NULL != _desc && NULL != _handles), "_desc and _handles can't be NULL");
+
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			BASE_ASSERT(NULL != _desc[ii].mem, "_desc[%d].mem can't be NULL", ii);
+			BASE_ASSERT(NULL != _desc[ii].layout && isValid(*_desc[ii].layout), "_desc[%d].layout is invalid.", ii);
+		}
+
+		return s_ctx->createVertexBuffers(_num, _desc, _handles);
+	}
+
+	void destroy(uint16_t _num, const VertexBufferHandle* _handles)
+	{
+		s_ctx->destroyVertexBuffers(_num, _handles);
+	}
+
 	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags)
 	{
 		return s_ctx->createDynamicIndexBuffer(_num, _flags);
@@ -4400,17 +4958,21 @@ namespace graphics
 
 	bool allocTransientBuffers(graphics::TransientVertexBuffer* _tvb, const graphics::VertexLayout& _layout, uint32_t _numVertices, graphics::TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32)
 	{
-		GRAPHICS_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+		BASE_ASSERT(NULL != _tvb && NULL != _tib, "_tvb and _tib can't be NULL");
+		BASE_ASSERT(isValid(_layout), "Invalid VertexLayout.");
 
-		if (_numVertices == getAvailTransientVertexBuffer(_numVertices, _layout)
-		&&  _numIndices  == getAvailTransientIndexBuffer(_numIndices, _index32) )
+		VertexLayoutHandle layoutHandle;
 		{
-			allocTransientVertexBuffer(_tvb, _numVertices, _layout);
-			allocTransientIndexBuffer(_tib, _numIndices, _index32);
-			return true;
+			GRAPHICS_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			layoutHandle = s_ctx->findOrCreateVertexLayout(_layout, true);
 		}
 
-		return false;
+		if (!isValid(layoutHandle) )
+		{
+			return false;
+		}
+
+		return s_ctx->allocTransientBuffers(_tvb, _numVertices, layoutHandle, _layout.m_stride, _tib, _numIndices, _index32);
 	}
 
 	void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
@@ -4893,10 +5455,72 @@ namespace graphics
 		bimg::imageGetSize( (bimg::TextureInfo*)&_info, _width, _height, _depth, _cubeMap, _hasMips, _numLayers, bimg::TextureFormat::Enum(_format) );
 	}
 
+	// Renderers upload levels straight from texture memory, supercompressed KTX2 levels are
+	// inflated on caller thread before texture is created.
+	static const Memory* inflateTexture(const Memory* _mem)
+	{
+		const uint32_t size = bimg::imageGetKtx2InflatedSize(_mem->data, _mem->size);
+
+		if (0 == size)
+		{
+			return _mem;
+		}
+
+		const Memory* mem = alloc(size);
+
+		base::Error err;
+		if (!bimg::imageInflateKtx2(g_allocator, mem->data, mem->size, _mem->data, _mem->size, &err) )
+		{
+			BASE_TRACE("Failed to inflate KTX2 texture: %.*s", err.getMessage().getLength(), err.getMessage().getPtr() );
+			release(mem);
+			return _mem;
+		}
+
+		release(_mem);
+
+		return mem;
+	}
+
 	TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info)
 	{
 		BASE_ASSERT(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count, false);
+		return s_ctx->createTexture(inflateTexture(_mem), _flags, _skip, _info, BackbufferRatio::Count, false);
+	}
+
+	uint16_t createTextures(uint16_t _num, const TextureDesc* _desc, TextureHandle* _handles)
+	{
+		BASE_ASSERT(0 == _num || (NULL != _desc && NULL != _handles), "_desc and _handles can't be NULL");
+
+		TextureDesc* desc = NULL;
+
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			BASE_ASSERT(NULL != _desc[ii].mem, "_desc[%d].mem can't be NULL", ii);
+
+			const Memory* mem = inflateTexture(_desc[ii].mem);
+
+			if (mem != _desc[ii].mem)
+			{
+				// Descriptors are copied only when some texture memory is replaced.
+				if (NULL == desc)
+				{
+					desc = (TextureDesc*)base::alloc(g_allocator, _num*sizeof(TextureDesc) );
+					base::memCopy(desc, _desc, _num*sizeof(TextureDesc) );
+				}
+
+				desc[ii].mem = mem;
+			}
+		}
+
+		if (NULL == desc)
+		{
+			return s_ctx->createTextures(_num, _desc, _handles);
+		}
+
+		const uint16_t numCreated = s_ctx->createTextures(_num, desc, _handles);
+		base::free(g_allocator, desc);
+
+		return numCreated;
 	}
 
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height)
@@ -5078,6 +5702,12 @@ namespace graphics
 		s_ctx->setName(_handle, base::StringView(_name, _len) );
 	}
 
+	void setTextureMinMip(TextureHandle _handle, uint8_t _mip)
+	{
+		GRAPHICS_CHECK_CAPS(GRAPHICS_CAPS_TEXTURE_MIN_MIP, "Texture min mip is not supported!");
+		s_ctx->setTextureMinMip(_handle, _mip);
+	}
+
 	void* getDirectAccessPtr(TextureHandle _handle)
 	{
 		return s_ctx->getDirectAccessPtr(_handle);
@@ -5088,6 +5718,11 @@ namespace graphics
 		s_ctx->destroyTexture(_handle);
 	}
 
+	void destroy(uint16_t _num, const TextureHandle* _handles)
+	{
+		s_ctx->destroyTextures(_num, _handles);
+	}
+
 	void updateTexture2D(TextureHandle _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
 	{
 		BASE_ASSERT(NULL != _mem, "_mem can't be NULL");
@@ -5141,6 +5776,14 @@ namespace graphics
 		return s_ctx->readTexture(_handle, _data, _mip);
 	}
 
+	uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip, ReadTextureFn _fn, void* _userData)
+	{
+		BASE_ASSERT(NULL != _data, "_data can't be NULL");
+		BASE_ASSERT(NULL != _fn, "_fn can't be NULL");
+		GRAPHICS_CHECK_CAPS(GRAPHICS_CAPS_TEXTURE_READ_BACK, "Texture read-back is not supported!");
+		return s_ctx->readTexture(_handle, _data, _mip, _fn, _userData);
+	}
+
 	FrameBufferHandle createFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint64_t _textureFlags)
 	{
 		_textureFlags |= _textureFlags&GRAPHICS_TEXTURE_RT_MSAA_MASK ? 0 : GRAPHICS_TEXTURE_RT;
@@ -5334,6 +5977,12 @@ namespace graphics
 		s_ctx->setViewMode(_id, _mode);
 	}
 
+	void setViewMerge(ViewId _id, uint8_t _flags)
+	{
+		BASE_ASSERT(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewMerge(_id, _flags);
+	}
+
 	void setViewFrameBuffer(ViewId _id, FrameBufferHandle _handle)
 	{
 		BASE_ASSERT(checkView(_id), "Invalid view id: %d", _id);
@@ -5375,6 +6024,12 @@ namespace graphics
 		s_ctx->m_encoder0->setState(_state, _rgba);
 	}
 
+	void setMaterial(uint32_t _material)
+	{
+		GRAPHICS_CHECK_ENCODER0();
+		s_ctx->m_encoder0->setMaterial(_material);
+	}
+
 	void setCondition(OcclusionQueryHandle _handle, bool _visible)
 	{
 		GRAPHICS_CHECK_ENCODER0();
@@ -5657,6 +6312,42 @@ namespace graphics
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
 
+	void requestProfilerCapture(uint32_t _numFrames, const char* _filePath)
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		s_ctx->requestProfilerCapture(_numFrames, _filePath);
+	}
+
+	bool beginFrameCapture(const char* _filePath)
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		return s_ctx->beginFrameCapture(_filePath);
+	}
+
+	void endFrameCapture()
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		s_ctx->endFrameCapture();
+	}
+
+	bool beginFrameReplay(const char* _filePath)
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		return s_ctx->beginFrameReplay(_filePath);
+	}
+
+	bool replayFrame()
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		return s_ctx->replayFrame();
+	}
+
+	void endFrameReplay()
+	{
+		GRAPHICS_CHECK_API_THREAD();
+		s_ctx->endFrameReplay();
+	}
+
 #undef GRAPHICS_CHECK_ENCODER0
 
 } // namespace graphics
@@ -51,12 +51,12 @@
 #	define GRAPHICS_MUTEX_SCOPE(_mutex) BASE_NOOP()
 #endif // GRAPHICS_CONFIG_MULTITHREADED
 
-#if GRAPHICS_CONFIG_PROFILER
+#if GRAPHICS_CONFIG_PROFILER || GRAPHICS_CONFIG_PROFILER_CAPTURE
 #	define GRAPHICS_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BASE_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define GRAPHICS_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define GRAPHICS_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define GRAPHICS_PROFILER_END()                          g_callback->profilerEnd()
-#	define GRAPHICS_PROFILER_SET_CURRENT_THREAD_NAME(_name) BASE_NOOP()
+#	define GRAPHICS_PROFILER_BEGIN(_name, _abgr)            profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#	define GRAPHICS_PROFILER_BEGIN_LITERAL(_name, _abgr)    profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#	define GRAPHICS_PROFILER_END()                          profilerEnd()
+#	define GRAPHICS_PROFILER_SET_CURRENT_THREAD_NAME(_name) profilerCaptureSetThreadName(_name)
 #else
 #	define GRAPHICS_PROFILER_SCOPE(_name, _abgr)            BASE_NOOP()
 #	define GRAPHICS_PROFILER_BEGIN(_name, _abgr)            BASE_NOOP()
@@ -146,6 +146,8 @@ namespace graphics
 #include <graphics/platform.h>
 #include <bimg/bimg.h>
 #include "shader.h"
+#include "framecapture.h"
+#include "profiler.h"
 #include "shaderc.h"
 #include "vertexlayout.h"
 #include "version.h"
@@ -575,16 +577,55 @@ namespace graphics
 
 	typedef base::StringT<&g_allocator> String;
 
+	inline void profilerBegin(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+	{
+		if (BASE_ENABLED(GRAPHICS_CONFIG_PROFILER) )
+		{
+			g_callback->profilerBegin(_name, _abgr, _filePath, _line);
+		}
+
+		if (g_profilerCaptureActive)
+		{
+			profilerCaptureBegin(_name, _abgr, true);
+		}
+	}
+
+	inline void profilerBeginLiteral(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+	{
+		if (BASE_ENABLED(GRAPHICS_CONFIG_PROFILER) )
+		{
+			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+		}
+
+		if (g_profilerCaptureActive)
+		{
+			profilerCaptureBegin(_name, _abgr, false);
+		}
+	}
+
+	inline void profilerEnd()
+	{
+		if (BASE_ENABLED(GRAPHICS_CONFIG_PROFILER) )
+		{
+			g_callback->profilerEnd();
+		}
+
+		if (g_profilerCaptureActive)
+		{
+			profilerCaptureEnd();
+		}
+	}
+
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
-			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			profilerBeginLiteral(_name, _abgr, _filePath, _line);
 		}
 
 		~ProfilerScope()
 		{
-			g_callback->profilerEnd();
+			profilerEnd();
 		}
 	};
 
@@ -905,7 +946,9 @@ namespace graphics
 			RendererShutdownBegin,
 			CreateVertexLayout,
 			CreateIndexBuffer,
+			CreateIndexBuffers,
 			CreateVertexBuffer,
+			CreateVertexBuffers,
 			CreateDynamicIndexBuffer,
 			UpdateDynamicIndexBuffer,
 			CreateDynamicVertexBuffer,
@@ -920,11 +963,14 @@ namespace graphics
 			UpdateViewName,
 			InvalidateOcclusionQuery,
 			SetName,
+			SetTextureMinMip,
 			End,
 			RendererShutdownEnd,
 			DestroyVertexLayout,
 			DestroyIndexBuffer,
+			DestroyIndexBuffers,
 			DestroyVertexBuffer,
+			DestroyVertexBuffers,
 			DestroyDynamicIndexBuffer,
 			DestroyDynamicVertexBuffer,
 			DestroyShader,
@@ -1031,6 +1077,14 @@ namespace graphics
 			}
 		}
 
+		/// Reopen finished command buffer, so that more commands can be written before `End`.
+		void reopen()
+		{
+			BASE_ASSERT(0 != m_size, "Command buffer is not finished.");
+			m_pos  = m_size - 1;
+			m_size = 0;
+		}
+
 		uint8_t* m_buffer;
 		uint32_t m_pos;
 		uint32_t m_size;
@@ -1058,14 +1112,34 @@ namespace graphics
 	//
 	constexpr uint8_t  kSortKeyTransNumBits        = 2;
 
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+	constexpr uint8_t  kSortKeyDraw0DepthNumBits   = 0; // Depth is stored in secondary key.
+	constexpr uint8_t  kSortKeyMaterialNumBits     = 0; // Material is stored in secondary key.
+#else
+	constexpr uint8_t  kSortKeyDraw0DepthNumBits   = GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH;
+	constexpr uint8_t  kSortKeyMaterialNumBits     = uint8_t(base::min<int32_t>(GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL, 0
+		+ kSortKeyDrawBitShift
+		- kSortKeyDrawTypeNumBits
+		- kSortKeyTransNumBits
+		- GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
+		- GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH
+		) );
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
+
+	constexpr uint64_t kSortKeyMaterialMask        = (uint64_t(1)<<kSortKeyMaterialNumBits)-1;
+
+	//
 	constexpr uint8_t  kSortKeyDraw0BlendShift     = kSortKeyDrawTypeBitShift - kSortKeyTransNumBits;
 	constexpr uint64_t kSortKeyDraw0BlendMask      = uint64_t(0x3)<<kSortKeyDraw0BlendShift;
 
 	constexpr uint8_t  kSortKeyDraw0ProgramShift   = kSortKeyDraw0BlendShift - GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 	constexpr uint64_t kSortKeyDraw0ProgramMask    = uint64_t(GRAPHICS_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw0ProgramShift;
 
-	constexpr uint8_t  kSortKeyDraw0DepthShift     = kSortKeyDraw0ProgramShift - GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH;
-	constexpr uint64_t kSortKeyDraw0DepthMask      = ( (uint64_t(1)<<GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH)-1)<<kSortKeyDraw0DepthShift;
+	constexpr uint8_t  kSortKeyDraw0MaterialShift  = kSortKeyDraw0ProgramShift - kSortKeyMaterialNumBits;
+	constexpr uint64_t kSortKeyDraw0MaterialMask   = kSortKeyMaterialMask<<kSortKeyDraw0MaterialShift;
+
+	constexpr uint8_t  kSortKeyDraw0DepthShift     = kSortKeyDraw0MaterialShift - kSortKeyDraw0DepthNumBits;
+	constexpr uint64_t kSortKeyDraw0DepthMask      = ( (uint64_t(1)<<kSortKeyDraw0DepthNumBits)-1)<<kSortKeyDraw0DepthShift;
 
 	//
 	constexpr uint8_t  kSortKeyDraw1DepthShift     = kSortKeyDrawTypeBitShift - GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH;
@@ -1077,6 +1151,9 @@ namespace graphics
 	constexpr uint8_t  kSortKeyDraw1ProgramShift   = kSortKeyDraw1BlendShift - GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 	constexpr uint64_t kSortKeyDraw1ProgramMask    = uint64_t(GRAPHICS_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw1ProgramShift;
 
+	constexpr uint8_t  kSortKeyDraw1MaterialShift  = kSortKeyDraw1ProgramShift - kSortKeyMaterialNumBits;
+	constexpr uint64_t kSortKeyDraw1MaterialMask   = kSortKeyMaterialMask<<kSortKeyDraw1MaterialShift;
+
 	//
 	constexpr uint8_t  kSortKeyDraw2SeqShift       = kSortKeyDrawTypeBitShift - GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_SEQ;
 	constexpr uint64_t kSortKeyDraw2SeqMask        = ( (uint64_t(1)<<GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_SEQ)-1)<<kSortKeyDraw2SeqShift;
@@ -1096,12 +1173,32 @@ namespace graphics
 
 	BASE_STATIC_ASSERT(GRAPHICS_CONFIG_MAX_VIEWS <= (1<<kSortKeyViewNumBits) );
 	BASE_STATIC_ASSERT( (GRAPHICS_CONFIG_MAX_PROGRAMS & (GRAPHICS_CONFIG_MAX_PROGRAMS-1) ) == 0); // Must be power of 2.
+	BASE_STATIC_ASSERT(64 >= 0 // Render key must fit into 64 bits.
+		+ kSortKeyViewNumBits
+		+ 1
+		+ kSortKeyDrawTypeNumBits
+		+ kSortKeyTransNumBits
+		+ GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
+		+ kSortKeyMaterialNumBits
+		+ GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH
+		, "Sort key overflow, reduce number of views, program, or depth bits."
+		);
+	BASE_STATIC_ASSERT(64 >= 0 // Render key must fit into 64 bits.
+		+ kSortKeyViewNumBits
+		+ 1
+		+ kSortKeyDrawTypeNumBits
+		+ kSortKeyTransNumBits
+		+ GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
+		+ GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_SEQ
+		, "Sort key overflow, reduce number of views, program, or sequence bits."
+		);
 	BASE_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
 		| kSortKeyViewMask
 		| kSortKeyDrawBit
 		| kSortKeyDrawTypeMask
 		| kSortKeyDraw0BlendMask
 		| kSortKeyDraw0ProgramMask
+		| kSortKeyDraw0MaterialMask
 		| kSortKeyDraw0DepthMask
 		) == (0
 		^ kSortKeyViewMask
@@ -1109,6 +1206,7 @@ namespace graphics
 		^ kSortKeyDrawTypeMask
 		^ kSortKeyDraw0BlendMask
 		^ kSortKeyDraw0ProgramMask
+		^ kSortKeyDraw0MaterialMask
 		^ kSortKeyDraw0DepthMask
 		) );
 	BASE_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
@@ -1118,6 +1216,7 @@ namespace graphics
 		| kSortKeyDraw1DepthMask
 		| kSortKeyDraw1BlendMask
 		| kSortKeyDraw1ProgramMask
+		| kSortKeyDraw1MaterialMask
 		) == (0
 		^ kSortKeyViewMask
 		^ kSortKeyDrawBit
@@ -1125,6 +1224,7 @@ namespace graphics
 		^ kSortKeyDraw1DepthMask
 		^ kSortKeyDraw1BlendMask
 		^ kSortKeyDraw1ProgramMask
+		^ kSortKeyDraw1MaterialMask
 		) );
 	BASE_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
 		| kSortKeyViewMask
@@ -1144,12 +1244,12 @@ namespace graphics
 	BASE_STATIC_ASSERT( (0 // Compute key mask shouldn't overlap.
 		| kSortKeyViewMask
 		| kSortKeyDrawBit
-		| kSortKeyComputeSeqShift
+		| kSortKeyComputeSeqMask
 		| kSortKeyComputeProgramMask
 		) == (0
 		^ kSortKeyViewMask
 		^ kSortKeyDrawBit
-		^ kSortKeyComputeSeqShift
+		^ kSortKeyComputeSeqMask
 		^ kSortKeyComputeProgramMask
 		) );
 
@@ -1161,16 +1261,17 @@ namespace graphics
 	// |  view-+|                                                       |
 	// |        +-draw                                                  |
 	// |----------------------------------------------------------------| Draw Key 0 - Sort by program
-	// |        |kkttpppppppppdddddddddddddddddddddddddddddddd          |
-	// |        | ^ ^        ^                               ^          |
-	// |        | | |        |                               |          |
-	// |        | | +-blend  +-program                 depth-+          |
-	// |        | +-key type                                            |
+	// |        |kkttpppppppppmmmmmmmmdddddddddddddddddddddddddddddddd  |
+	// |        | ^ ^        ^       ^                               ^  |
+	// |        | | |        |       |                               |  |
+	// |        | | +-blend  +-program                         depth-+  |
+	// |        | +-key type         +-material                         |
 	// |----------------------------------------------------------------| Draw Key 1 - Sort by depth
-	// |        |kkddddddddddddddddddddddddddddddddttppppppppp          |
-	// |        | ^                               ^ ^        ^          |
-	// |        | |                               | +-blend  |          |
-	// |        | +-key type                depth-+  program-+          |
+	// |        |kkddddddddddddddddddddddddddddddddttpppppppppmmmmmmmm  |
+	// |        | ^                               ^ ^        ^       ^  |
+	// |        | |                               | +-blend  |       |  |
+	// |        | +-key type                depth-+  program-+       |  |
+	// |        |                                           material-+  |
 	// |        |                                                       |
 	// |----------------------------------------------------------------| Draw Key 2 - Sequential
 	// |        |kkssssssssssssssssssssttppppppppp                      |
@@ -1186,6 +1287,27 @@ namespace graphics
 	// |        |                                                       |
 	// |--------+-------------------------------------------------------|
 	//
+	// Material field width is GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL, limited to bits left
+	// unused by other fields.
+	//
+	// With GRAPHICS_CONFIG_SORT_KEY_WIDE depth and material are moved out of draw key 0, and
+	// material is moved out of draw key 1, into secondary key which is sorted as less
+	// significant part of 128-bit key. Secondary key of sequential and compute keys is zero.
+	//
+	// |               3               2               1               0|
+	// |fedcba9876543210fedcba9876543210fedcba9876543210fedcba9876543210|
+	// |----------------------------------------------------------------| Draw Key 0 - Secondary
+	// |mmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmdddddddddddddddddddddddddddddddd|
+	// |                               ^                               ^|
+	// |                               |                               ||
+	// |                      material-+                         depth-+|
+	// |----------------------------------------------------------------| Draw Key 1 - Secondary
+	// |mmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmm                                |
+	// |                               ^                                |
+	// |                               |                                |
+	// |                      material-+                                |
+	// |----------------------------------------------------------------|
+	//
 	struct SortKey
 	{
 		enum Enum
@@ -1201,11 +1323,12 @@ namespace graphics
 			{
 			case SortProgram:
 				{
-					const uint64_t depth   = (uint64_t(m_depth      ) << kSortKeyDraw0DepthShift  ) & kSortKeyDraw0DepthMask;
-					const uint64_t program = (uint64_t(m_program.idx) << kSortKeyDraw0ProgramShift) & kSortKeyDraw0ProgramMask;
-					const uint64_t blend   = (uint64_t(m_blend      ) << kSortKeyDraw0BlendShift  ) & kSortKeyDraw0BlendMask;
-					const uint64_t view    = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
-					const uint64_t key     = view|kSortKeyDrawBit|kSortKeyDrawTypeProgram|blend|program|depth;
+					const uint64_t depth    = ( (uint64_t(m_depth) >> (32-kSortKeyDraw0DepthNumBits) ) << kSortKeyDraw0DepthShift) & kSortKeyDraw0DepthMask;
+					const uint64_t material = ( (uint64_t(m_material) & kSortKeyMaterialMask) << kSortKeyDraw0MaterialShift) & kSortKeyDraw0MaterialMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw0ProgramShift) & kSortKeyDraw0ProgramMask;
+					const uint64_t blend    = (uint64_t(m_blend      ) << kSortKeyDraw0BlendShift  ) & kSortKeyDraw0BlendMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeProgram|blend|program|material|depth;
 
 					return key;
 				}
@@ -1213,11 +1336,12 @@ namespace graphics
 
 			case SortDepth:
 				{
-					const uint64_t depth   = (uint64_t(m_depth      ) << kSortKeyDraw1DepthShift  ) & kSortKeyDraw1DepthMask;
-					const uint64_t program = (uint64_t(m_program.idx) << kSortKeyDraw1ProgramShift) & kSortKeyDraw1ProgramMask;
-					const uint64_t blend   = (uint64_t(m_blend      ) << kSortKeyDraw1BlendShift) & kSortKeyDraw1BlendMask;
-					const uint64_t view    = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
-					const uint64_t key     = view|kSortKeyDrawBit|kSortKeyDrawTypeDepth|depth|blend|program;
+					const uint64_t depth    = ( (uint64_t(m_depth) >> (32-GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_DEPTH) ) << kSortKeyDraw1DepthShift) & kSortKeyDraw1DepthMask;
+					const uint64_t material = ( (uint64_t(m_material) & kSortKeyMaterialMask) << kSortKeyDraw1MaterialShift) & kSortKeyDraw1MaterialMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw1ProgramShift) & kSortKeyDraw1ProgramMask;
+					const uint64_t blend    = (uint64_t(m_blend      ) << kSortKeyDraw1BlendShift  ) & kSortKeyDraw1BlendMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeDepth|depth|blend|program|material;
 					return key;
 				}
 				break;
@@ -1244,6 +1368,23 @@ namespace graphics
 			return 0;
 		}
 
+		/// Returns secondary key, sorted as less significant part of 128-bit
+		/// key when GRAPHICS_CONFIG_SORT_KEY_WIDE is enabled.
+		uint64_t encodeDrawWide(Enum _type) const
+		{
+			const uint64_t material = uint64_t(m_material) & ( (uint64_t(1)<<GRAPHICS_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)-1);
+
+			switch (_type)
+			{
+			case SortProgram:  return (material<<32) | m_depth;
+			case SortDepth:    return (material<<32);
+			case SortSequence: return 0;
+			}
+
+			BASE_ASSERT(false, "You should not be here.");
+			return 0;
+		}
+
 		uint64_t encodeCompute()
 		{
 			const uint64_t program = (uint64_t(m_program.idx) << kSortKeyComputeProgramShift) & kSortKeyComputeProgramMask;
@@ -1303,15 +1444,17 @@ namespace graphics
 
 		void reset()
 		{
-			m_depth   = 0;
-			m_seq     = 0;
-			m_program = {0};
-			m_view    = 0;
-			m_blend   = 0;
+			m_depth    = 0;
+			m_seq      = 0;
+			m_material = 0;
+			m_program  = {0};
+			m_view     = 0;
+			m_blend    = 0;
 		}
 
 		uint32_t      m_depth;
 		uint32_t      m_seq;
+		uint32_t      m_material;
 		ProgramHandle m_program;
 		ViewId        m_view;
 		uint8_t       m_blend;
@@ -1576,6 +1719,11 @@ namespace graphics
 			return m_pos;
 		}
 
+		const char* getData(uint32_t _pos) const
+		{
+			return &m_buffer[_pos];
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -2057,6 +2205,7 @@ namespace graphics
 			setScissor(0, 0, 0, 0);
 			setClear(GRAPHICS_CLEAR_NONE, 0, 0.0f, 0);
 			setMode(ViewMode::Default);
+			setMerge(GRAPHICS_MERGE_NONE);
 			setFrameBuffer(GRAPHICS_INVALID_HANDLE);
 			setTransform(NULL, NULL);
 		}
@@ -2092,6 +2241,11 @@ namespace graphics
 			m_mode = uint8_t(_mode);
 		}
 
+		void setMerge(uint8_t _flags)
+		{
+			m_merge = _flags;
+		}
+
 		void setFrameBuffer(FrameBufferHandle _handle)
 		{
 			m_fbh = _handle;
@@ -2125,6 +2279,7 @@ namespace graphics
 		Matrix4 m_proj;
 		FrameBufferHandle m_fbh;
 		uint8_t m_mode;
+		uint8_t m_merge;
 	};
 
 	struct FrameCache
@@ -2151,6 +2306,195 @@ namespace graphics
 		RectCache m_rectCache;
 	};
 
+	/// Transient vertex or index buffer storage. Allocations bump offset in current page
+	/// lock-free, new page is added by Context under resource API lock when all pages are full.
+	template<typename Ty>
+	struct TransientPages
+	{
+		TransientPages()
+			: m_num(0)
+			, m_current(0)
+			, m_numLowFrames(0)
+		{
+		}
+
+		void reset()
+		{
+			base::memSet(m_used, 0, sizeof(m_used) );
+			m_current = 0;
+		}
+
+		void add(Ty* _page)
+		{
+			const uint32_t idx = m_num;
+			m_page[idx] = _page;
+			m_used[idx] = 0;
+
+			// Publish page after it's fully written.
+			base::atomicFetchAndAdd<uint32_t>(&m_num, 1);
+		}
+
+		Ty* remove()
+		{
+			--m_num;
+			return m_page[m_num];
+		}
+
+		uint32_t getUsed() const
+		{
+			uint32_t used = 0;
+			for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
+			{
+				used += m_used[ii];
+			}
+
+			return used;
+		}
+
+		uint32_t getSize() const
+		{
+			uint32_t size = 0;
+			for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
+			{
+				size += m_page[ii]->size;
+			}
+
+			return size;
+		}
+
+		uint32_t getAvail(uint32_t _num, uint16_t _stride) const
+		{
+			if (GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES > m_num)
+			{
+				return _num;
+			}
+
+			const uint32_t current = m_current;
+			return getAvail(m_used[current], m_page[current]->size, _num, _stride);
+		}
+
+		/// Allocate `_num` elements from current page, moving on to next page when current one
+		/// is full. Returns false when all pages are full and more can be added, in which case
+		/// `_page` is number of pages observed. When `_canGrow` is false, or page limit is
+		/// reached, allocation is trimmed to what fits (nothing when `_exact` is set).
+		bool alloc(uint32_t& _num, uint16_t _stride, bool _exact, bool _canGrow, uint32_t& _page, uint32_t& _offset)
+		{
+			for (;;)
+			{
+				const uint32_t numPages = m_num;
+				const uint32_t current  = m_current;
+
+				if (current >= numPages)
+				{
+					_page = numPages;
+					return false;
+				}
+
+				uint32_t num = _num;
+				const uint32_t offset = alloc(&m_used[current], m_page[current]->size, num, _stride, true);
+
+				if (0 != num)
+				{
+					_page   = current;
+					_offset = offset;
+					return true;
+				}
+
+				if (current+1 >= numPages)
+				{
+					if (_canGrow
+					&&  GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES > numPages)
+					{
+						_page = numPages;
+						return false;
+					}
+
+					_page   = current;
+					_offset = alloc(&m_used[current], m_page[current]->size, _num, _stride, _exact);
+					return true;
+				}
+
+				base::atomicCompareAndSwap<uint32_t>(&m_current, current, current+1);
+			}
+		}
+
+		/// Returns true when trailing page can be released. Usage must stay below low-water mark
+		/// (half of capacity) for `GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES` consecutive frames this
+		/// page set was submitted with, and `_peak` must still fit without the page. Counter
+		/// restarts after each release, so at most one page is dropped per low period.
+		bool shouldShrink(uint32_t _peak)
+		{
+			const uint32_t size = getSize();
+			if (1 >= m_num
+			||  _peak >= size/2)
+			{
+				m_numLowFrames = 0;
+				return false;
+			}
+
+			if (++m_numLowFrames < GRAPHICS_CONFIG_TRANSIENT_SHRINK_FRAMES
+			||  size - m_page[m_num-1]->size < _peak)
+			{
+				return false;
+			}
+
+			m_numLowFrames = 0;
+			return true;
+		}
+
+		/// Return allocation. Succeeds only if nothing was allocated after it in the same page,
+		/// otherwise space stays used until the end of frame.
+		void free(uint32_t _page, uint32_t _offset, uint32_t _size)
+		{
+			base::atomicCompareAndSwap<uint32_t>(&m_used[_page], _offset + _size, _offset);
+		}
+
+		static uint32_t getAvail(uint32_t _offset, uint32_t _max, uint32_t _num, uint16_t _stride)
+		{
+			const uint32_t offset = base::strideAlign(_offset, _stride);
+			if (offset >= _max)
+			{
+				return 0;
+			}
+
+			return base::min<uint32_t>(_num, (_max - offset)/_stride);
+		}
+
+		static uint32_t alloc(volatile uint32_t* _offset, uint32_t _max, uint32_t& _num, uint16_t _stride, bool _exact)
+		{
+			uint32_t current = *_offset;
+
+			for (;;)
+			{
+				const uint32_t offset = base::strideAlign(current, _stride);
+
+				uint32_t num = getAvail(current, _max, _num, _stride);
+				num = _exact && num != _num ? 0 : num;
+
+				if (0 == num)
+				{
+					_num = 0;
+					return base::min(offset, _max);
+				}
+
+				const uint32_t prev = base::atomicCompareAndSwap<uint32_t>(_offset, current, offset + num*_stride);
+				if (prev == current)
+				{
+					_num = num;
+					return offset;
+				}
+
+				current = prev;
+			}
+		}
+
+		Ty*      m_page[GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES];
+		uint32_t m_used[GRAPHICS_CONFIG_MAX_TRANSIENT_PAGES]; //!< Bytes used in each page.
+		volatile uint32_t m_num;                              //!< Number of pages.
+		volatile uint32_t m_current;                          //!< Page allocations are made from.
+		uint32_t m_numLowFrames;                              //!< Consecutive frames usage stayed below low-water mark.
+	};
+
 	struct ScreenShot
 	{
 		base::FilePath filePath;
@@ -2173,6 +2517,18 @@ namespace graphics
 			base::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
 			m_perfStats.viewStats = m_viewStats;
+			m_perfStats.numDescriptorSets       = 0;
+			m_perfStats.numDescriptorSetsReused = 0;
+			m_perfStats.numMergedDraws          = 0;
+			m_perfStats.numMergeBatches         = 0;
+			m_perfStats.numUniformCalls         = 0;
+			m_perfStats.numMultiDraws           = 0;
+			m_perfStats.numMultiDrawBatches     = 0;
+			m_perfStats.numViewCostStats = 0;
+			m_perfStats.viewCostStats    = m_viewCostStats;
+			m_perfStats.numProgramStats  = 0;
+			m_perfStats.programStats     = m_programStats;
+			base::memSet(m_programStatsIdx, 0xff, sizeof(m_programStatsIdx) );
 		}
 
 		~Frame()
@@ -2220,14 +2576,14 @@ namespace graphics
 
 		void start(uint32_t frameNum)
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.transientVbUsed = m_transientVb.getUsed();
+			m_perfStats.transientIbUsed = m_transientIb.getUsed();
 
 			m_frameCache.reset();
 			m_numRenderItems = 0;
 			m_numBlitItems   = 0;
-			m_iboffset = 0;
-			m_vboffset = 0;
+			m_transientIb.reset();
+			m_transientVb.reset();
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
@@ -2243,43 +2599,9 @@ namespace graphics
 
 		void sort();
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
-		{
-			const uint32_t offset = base::strideAlign(m_iboffset, _indexSize);
-			uint32_t iboffset = offset + _num*_indexSize;
-			iboffset = base::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			const uint32_t num = (iboffset-offset)/_indexSize;
-			return num;
-		}
-
-		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
-		{
-			uint32_t offset = base::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
-			m_iboffset = offset + num*_indexSize;
-			_num = num;
-
-			return offset;
-		}
-
-		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
-		{
-			uint32_t offset   = base::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = base::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
-		}
-
-		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
-		{
-			uint32_t offset = base::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
-
-			return offset;
-		}
+		/// Merge runs of compatible sorted draw calls into instanced draw calls, in views
+		/// with merging enabled. Must be called after `sort`.
+		void mergeDraws();
 
 		bool free(IndexBufferHandle _handle)
 		{
@@ -2341,6 +2663,9 @@ namespace graphics
 		int32_t m_occlusion[GRAPHICS_CONFIG_MAX_OCCLUSION_QUERIES];
 
 		uint64_t m_sortKeys[GRAPHICS_CONFIG_MAX_DRAW_CALLS+1];
+#if GRAPHICS_CONFIG_SORT_KEY_WIDE
+		uint64_t m_sortKeysWide[GRAPHICS_CONFIG_MAX_DRAW_CALLS];
+#endif // GRAPHICS_CONFIG_SORT_KEY_WIDE
 		RenderItemCount m_sortValues[GRAPHICS_CONFIG_MAX_DRAW_CALLS+1];
 		RenderItem m_renderItem[GRAPHICS_CONFIG_MAX_DRAW_CALLS+1];
 		RenderBind m_renderItemBind[GRAPHICS_CONFIG_MAX_DRAW_CALLS + 1];
@@ -2348,16 +2673,17 @@ namespace graphics
 		uint32_t m_blitKeys[GRAPHICS_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[GRAPHICS_CONFIG_MAX_BLIT_ITEMS+1];
 
+		uint64_t m_tempKeys[GRAPHICS_CONFIG_MAX_DRAW_CALLS];          //!< Radix sort scratch, owned by frame since sort runs on API thread.
+		RenderItemCount m_tempValues[GRAPHICS_CONFIG_MAX_DRAW_CALLS]; //!< Radix sort scratch.
+
 		FrameCache m_frameCache;
 		UniformBuffer** m_uniformBuffer;
 
 		uint32_t m_numRenderItems;
 		uint16_t m_numBlitItems;
 
-		uint32_t m_iboffset;
-		uint32_t m_vboffset;
-		TransientIndexBuffer* m_transientIb;
-		TransientVertexBuffer* m_transientVb;
+		TransientPages<TransientIndexBuffer>  m_transientIb;
+		TransientPages<TransientVertexBuffer> m_transientVb;
 
 		Resolution m_resolution;
 		uint32_t m_debug;
@@ -2438,6 +2764,10 @@ namespace graphics
 		Stats     m_perfStats;
 		ViewStats m_viewStats[GRAPHICS_CONFIG_MAX_VIEWS];
 
+		ViewCostStats m_viewCostStats[GRAPHICS_CONFIG_MAX_VIEWS];
+		ProgramStats  m_programStats[GRAPHICS_CONFIG_MAX_PROGRAMS];
+		uint16_t      m_programStatsIdx[GRAPHICS_CONFIG_MAX_PROGRAMS];
+
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
 
@@ -2468,6 +2798,9 @@ namespace graphics
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			base::memSet(m_layoutCacheValid, 0, sizeof(m_layoutCacheValid) );
+			m_layoutCacheGeneration = UINT32_MAX;
 		}
 
 		void end(bool _finalize)
@@ -2543,6 +2876,11 @@ namespace graphics
 			m_draw.m_rgba       = _rgba;
 		}
 
+		void setMaterial(uint32_t _material)
+		{
+			m_key.m_material = _material;
+		}
+
 		void setCondition(OcclusionQueryHandle _handle, bool _visible)
 		{
 			m_draw.m_occlusionQuery = _handle;
@@ -2779,6 +3117,11 @@ namespace graphics
 			m_draw.clear(_flags);
 			m_compute.clear(_flags);
 			m_bind.clear(_flags);
+
+			if (_flags & GRAPHICS_DISCARD_STATE)
+			{
+				m_key.m_material = 0;
+			}
 		}
 
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags);
@@ -2811,6 +3154,13 @@ namespace graphics
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		/// Vertex layout lookup for transient buffers. Takes resource API lock only when layout
+		/// was not already used by this encoder during current frame, and no vertex layout was
+		/// released since.
+		VertexLayoutHandle findOrCreateVertexLayout(const VertexLayout& _layout);
+
+		static constexpr uint32_t kLayoutCacheSize = 4;
+
 		Frame* m_frame;
 
 		SortKey m_key;
@@ -2834,6 +3184,11 @@ namespace graphics
 
 		int64_t m_cpuTimeBegin;
 		int64_t m_cpuTimeEnd;
+
+		uint32_t           m_layoutCacheHash[kLayoutCacheSize];
+		VertexLayoutHandle m_layoutCacheHandle[kLayoutCacheSize];
+		bool               m_layoutCacheValid[kLayoutCacheSize]; //!< Slot is in use, any hash value including 0 can be cached.
+		uint32_t           m_layoutCacheGeneration;
 	};
 
 	struct VertexLayoutRef
@@ -3101,6 +3456,7 @@ namespace graphics
 		virtual void invalidateOcclusionQuery(OcclusionQueryHandle _handle) = 0;
 		virtual void setMarker(const char* _marker, uint16_t _len) = 0;
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) = 0;
+		virtual void setTextureMinMip(TextureHandle _handle, uint8_t _mip) = 0;
 		virtual void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) = 0;
 		virtual void blitSetup(TextVideoMemBlitter& _blitter) = 0;
 		virtual void blitRender(TextVideoMemBlitter& _blitter, uint32_t _numIndices) = 0;
@@ -3139,6 +3495,11 @@ namespace graphics
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_frameCapture(NULL)
+			, m_frameReplay(NULL)
+			, m_frameReplayPending(false)
+			, m_layoutGeneration(0)
+			, m_numReadTexture(0)
 		{
 		}
 
@@ -3515,6 +3876,91 @@ namespace graphics
 			cmdbuf.write(_handle);
 		}
 
+		GRAPHICS_API_FUNC(uint16_t createIndexBuffers(uint16_t _num, const IndexBufferDesc* _desc, IndexBufferHandle* _handles) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			uint16_t numCreated = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const IndexBufferDesc& desc = _desc[ii];
+
+				IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
+				_handles[ii] = handle;
+
+				if (isValid(handle) )
+				{
+					IndexBuffer& ib = m_indexBuffers[handle.idx];
+					ib.m_size  = desc.mem->size;
+					ib.m_flags = desc.flags;
+
+					setDebugNameForHandle(handle);
+					++numCreated;
+				}
+				else
+				{
+					release(desc.mem);
+				}
+			}
+
+			BASE_WARN(numCreated == _num, "Failed to allocate %d index buffer handle(s).", _num - numCreated);
+
+			if (0 < numCreated)
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffers);
+				cmdbuf.write(numCreated);
+
+				for (uint16_t ii = 0; ii < _num; ++ii)
+				{
+					if (isValid(_handles[ii]) )
+					{
+						cmdbuf.write(_handles[ii]);
+						cmdbuf.write(_desc[ii].mem);
+						cmdbuf.write(_desc[ii].flags);
+					}
+				}
+			}
+
+			return numCreated;
+		}
+
+		GRAPHICS_API_FUNC(void destroyIndexBuffers(uint16_t _num, const IndexBufferHandle* _handles) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			uint16_t numDestroyed = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const IndexBufferHandle handle = _handles[ii];
+
+				if (isValid(handle) )
+				{
+					GRAPHICS_CHECK_HANDLE("destroyIndexBuffers", m_indexBufferHandle, handle);
+					bool ok = m_submit->free(handle); BASE_UNUSED(ok);
+					BASE_ASSERT(ok, "Index buffer handle %d is already destroyed!", handle.idx);
+
+					m_indexBuffers[handle.idx].m_name.clear();
+					++numDestroyed;
+				}
+			}
+
+			if (0 < numDestroyed)
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyIndexBuffers);
+				cmdbuf.write(numDestroyed);
+
+				for (uint16_t ii = 0; ii < _num; ++ii)
+				{
+					if (isValid(_handles[ii]) )
+					{
+						cmdbuf.write(_handles[ii]);
+					}
+				}
+			}
+		}
+
 		VertexLayoutHandle findOrCreateVertexLayout(const VertexLayout& _layout, bool _refCountOnCreation = false)
 		{
 			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
@@ -3563,6 +4009,7 @@ namespace graphics
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
 			if (isValid(m_vertexLayoutRef.release(_handle) ) )
 			{
+				base::atomicFetchAndAdd<uint32_t>(&m_layoutGeneration, 1);
 				m_submit->free(_handle);
 			}
 		}
@@ -3633,35 +4080,135 @@ namespace graphics
 			cmdbuf.write(_handle);
 		}
 
-		void destroyVertexBufferInternal(VertexBufferHandle _handle)
+		GRAPHICS_API_FUNC(uint16_t createVertexBuffers(uint16_t _num, const VertexBufferDesc* _desc, VertexBufferHandle* _handles) )
 		{
-			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
-			if (isValid(layoutHandle) )
-			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
-				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
-			}
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
 
-			m_vertexBufferHandle.free(_handle.idx);
-		}
+			uint16_t numCreated = 0;
 
-		uint64_t allocDynamicIndexBuffer(uint32_t _size, uint16_t _flags)
-		{
-			uint64_t ptr = m_dynIndexBufferAllocator.alloc(_size);
-			if (ptr == NonLocalAllocator::kInvalidBlock)
+			// Vertex layouts are created first, so their commands precede vertex buffer batch.
+			for (uint16_t ii = 0; ii < _num; ++ii)
 			{
-				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
-				if (!isValid(indexBufferHandle) )
-				{
-					BASE_TRACE("Failed to allocate index buffer handle.");
-					return NonLocalAllocator::kInvalidBlock;
-				}
+				const VertexBufferDesc& desc = _desc[ii];
+				const VertexLayout& layout = *desc.layout;
 
-				const uint32_t allocSize = base::max<uint32_t>(GRAPHICS_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, base::alignUp(_size, 1<<20) );
+				VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
+				_handles[ii] = handle;
 
-				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
-				ib.m_size = allocSize;
+				if (isValid(handle) )
+				{
+					VertexLayoutHandle layoutHandle = findOrCreateVertexLayout(layout);
+					if (isValid(layoutHandle) )
+					{
+						m_vertexLayoutRef.add(handle, layoutHandle, layout.m_hash);
+
+						VertexBuffer& vb = m_vertexBuffers[handle.idx];
+						vb.m_size   = desc.mem->size;
+						vb.m_stride = layout.m_stride;
+
+						setDebugNameForHandle(handle);
+						++numCreated;
+						continue;
+					}
+
+					m_vertexBufferHandle.free(handle.idx);
+					_handles[ii] = GRAPHICS_INVALID_HANDLE;
+				}
+
+				release(desc.mem);
+			}
+
+			BASE_WARN(numCreated == _num, "Failed to allocate %d vertex buffer handle(s).", _num - numCreated);
+
+			if (0 < numCreated)
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffers);
+				cmdbuf.write(numCreated);
+
+				for (uint16_t ii = 0; ii < _num; ++ii)
+				{
+					const VertexBufferHandle handle = _handles[ii];
+
+					if (isValid(handle) )
+					{
+						cmdbuf.write(handle);
+						cmdbuf.write(_desc[ii].mem);
+						cmdbuf.write(m_vertexLayoutRef.m_vertexBufferRef[handle.idx]);
+						cmdbuf.write(_desc[ii].flags);
+					}
+				}
+			}
+
+			return numCreated;
+		}
+
+		GRAPHICS_API_FUNC(void destroyVertexBuffers(uint16_t _num, const VertexBufferHandle* _handles) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			uint16_t numDestroyed = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const VertexBufferHandle handle = _handles[ii];
+
+				if (isValid(handle) )
+				{
+					GRAPHICS_CHECK_HANDLE("destroyVertexBuffers", m_vertexBufferHandle, handle);
+					bool ok = m_submit->free(handle); BASE_UNUSED(ok);
+					BASE_ASSERT(ok, "Vertex buffer handle %d is already destroyed!", handle.idx);
+
+					m_vertexBuffers[handle.idx].m_name.clear();
+					++numDestroyed;
+				}
+			}
+
+			if (0 < numDestroyed)
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexBuffers);
+				cmdbuf.write(numDestroyed);
+
+				for (uint16_t ii = 0; ii < _num; ++ii)
+				{
+					if (isValid(_handles[ii]) )
+					{
+						cmdbuf.write(_handles[ii]);
+					}
+				}
+			}
+		}
+
+		void destroyVertexBufferInternal(VertexBufferHandle _handle)
+		{
+			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
+			if (isValid(layoutHandle) )
+			{
+				base::atomicFetchAndAdd<uint32_t>(&m_layoutGeneration, 1);
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
+				cmdbuf.write(layoutHandle);
+				m_render->free(layoutHandle);
+			}
+
+			m_vertexBufferHandle.free(_handle.idx);
+		}
+
+		uint64_t allocDynamicIndexBuffer(uint32_t _size, uint16_t _flags)
+		{
+			uint64_t ptr = m_dynIndexBufferAllocator.alloc(_size);
+			if (ptr == NonLocalAllocator::kInvalidBlock)
+			{
+				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
+				if (!isValid(indexBufferHandle) )
+				{
+					BASE_TRACE("Failed to allocate index buffer handle.");
+					return NonLocalAllocator::kInvalidBlock;
+				}
+
+				const uint32_t allocSize = base::max<uint32_t>(GRAPHICS_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, base::alignUp(_size, 1<<20) );
+
+				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
+				ib.m_size = allocSize;
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(indexBufferHandle);
@@ -4031,6 +4578,8 @@ namespace graphics
 
 			if (isValid(layoutHandle) )
 			{
+				base::atomicFetchAndAdd<uint32_t>(&m_layoutGeneration, 1);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
 				m_render->free(layoutHandle);
@@ -4044,18 +4593,14 @@ namespace graphics
 
 		GRAPHICS_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32) )
 		{
-			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
-
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
-			return m_submit->getAvailTransientIndexBuffer(_num, indexSize);
+			return m_submit->m_transientIb.getAvail(_num, indexSize);
 		}
 
 		GRAPHICS_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) )
 		{
-			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
-
-			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
+			return m_submit->m_transientVb.getAvail(_num, _stride);
 		}
 
 		TransientIndexBuffer* createTransientIndexBuffer(uint32_t _size)
@@ -4096,21 +4641,65 @@ namespace graphics
 			base::alignedFree(g_allocator, _tib, 16);
 		}
 
-		GRAPHICS_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32) )
+		/// Add transient index buffer page to submit frame if all `_numPages` observed by caller
+		/// are full. Returns false if page can't be created.
+		bool addTransientIndexPage(uint32_t _numPages, uint32_t _size)
 		{
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+			return addTransientIndexPageLocked(_numPages, _size);
+		}
+
+		/// Same as `addTransientIndexPage`, but caller must already hold `m_resourceApiLock`.
+		bool addTransientIndexPageLocked(uint32_t _numPages, uint32_t _size)
+		{
+			TransientPages<TransientIndexBuffer>& pages = m_submit->m_transientIb;
+			if (_numPages != pages.m_num)
+			{
+				return true;
+			}
+
+			const uint32_t size = base::max(m_init.limits.transientIbSize, base::alignUp(_size, 16) );
+			TransientIndexBuffer* tib = createTransientIndexBuffer(size);
+			if (NULL == tib)
+			{
+				return false;
+			}
 
+			pages.add(tib);
+			return true;
+		}
+
+		uint32_t allocTransientIndexPage(uint32_t& _num, uint16_t _indexSize, bool _exact, uint32_t& _offset)
+		{
+			TransientPages<TransientIndexBuffer>& pages = m_submit->m_transientIb;
+
+			uint32_t page   = 0;
+			bool     canGrow = true;
+			while (!pages.alloc(_num, _indexSize, _exact, canGrow, page, _offset) )
+			{
+				canGrow = addTransientIndexPage(page, (_num+1)*_indexSize);
+			}
+
+			return page;
+		}
+
+		GRAPHICS_API_FUNC(bool allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32, bool _exact = false) )
+		{
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
-			const uint32_t offset    = m_submit->allocTransientIndexBuffer(_num, indexSize);
 
-			TransientIndexBuffer& tib = *m_submit->m_transientIb;
+			uint32_t offset;
+			const uint32_t page = allocTransientIndexPage(_num, indexSize, _exact, offset);
+
+			TransientIndexBuffer& tib = *m_submit->m_transientIb.m_page[page];
 
 			_tib->data       = &tib.data[offset];
 			_tib->size       = _num * indexSize;
 			_tib->handle     = tib.handle;
 			_tib->startIndex = base::strideAlign(offset, indexSize) / indexSize;
 			_tib->isIndex16  = isIndex16;
+
+			return 0 != _num;
 		}
 
 		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexLayout* _layout = NULL)
@@ -4166,12 +4755,55 @@ namespace graphics
 			base::alignedFree(g_allocator, _tvb, 16);
 		}
 
-		GRAPHICS_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride) )
+		/// Add transient vertex buffer page to submit frame if all `_numPages` observed by caller
+		/// are full. Returns false if page can't be created.
+		bool addTransientVertexPage(uint32_t _numPages, uint32_t _size)
 		{
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+			return addTransientVertexPageLocked(_numPages, _size);
+		}
+
+		/// Same as `addTransientVertexPage`, but caller must already hold `m_resourceApiLock`.
+		bool addTransientVertexPageLocked(uint32_t _numPages, uint32_t _size)
+		{
+			TransientPages<TransientVertexBuffer>& pages = m_submit->m_transientVb;
+			if (_numPages != pages.m_num)
+			{
+				return true;
+			}
 
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _stride);
-			const TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+			const uint32_t size = base::max(m_init.limits.transientVbSize, base::alignUp(_size, 16) );
+			TransientVertexBuffer* tvb = createTransientVertexBuffer(size);
+			if (NULL == tvb)
+			{
+				return false;
+			}
+
+			pages.add(tvb);
+			return true;
+		}
+
+		uint32_t allocTransientVertexPage(uint32_t& _num, uint16_t _stride, bool _exact, uint32_t& _offset)
+		{
+			TransientPages<TransientVertexBuffer>& pages = m_submit->m_transientVb;
+
+			uint32_t page   = 0;
+			bool     canGrow = true;
+			while (!pages.alloc(_num, _stride, _exact, canGrow, page, _offset) )
+			{
+				// Page must fit stride alignment padding too.
+				canGrow = addTransientVertexPage(page, (_num+1)*_stride);
+			}
+
+			return page;
+		}
+
+		GRAPHICS_API_FUNC(bool allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride, bool _exact = false) )
+		{
+			uint32_t offset;
+			const uint32_t page = allocTransientVertexPage(_num, _stride, _exact, offset);
+
+			const TransientVertexBuffer& dvb = *m_submit->m_transientVb.m_page[page];
 
 			_tvb->data         = &dvb.data[offset];
 			_tvb->size         = _num * _stride;
@@ -4179,16 +4811,45 @@ namespace graphics
 			_tvb->stride       = _stride;
 			_tvb->handle       = dvb.handle;
 			_tvb->layoutHandle = _layoutHandle;
+
+			return 0 != _num;
 		}
 
-		GRAPHICS_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
+		GRAPHICS_API_FUNC(bool allocTransientBuffers(TransientVertexBuffer* _tvb, uint32_t _numVertices, VertexLayoutHandle _layoutHandle, uint16_t _stride, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32) )
 		{
-			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+			uint32_t vbOffset;
+			const uint32_t vbPage = allocTransientVertexPage(_numVertices, _stride, true, vbOffset);
+
+			if (0 != _numVertices)
+			{
+				if (allocTransientIndexBuffer(_tib, _numIndices, _index32, true) )
+				{
+					const TransientVertexBuffer& dvb = *m_submit->m_transientVb.m_page[vbPage];
+
+					_tvb->data         = &dvb.data[vbOffset];
+					_tvb->size         = _numVertices * _stride;
+					_tvb->startVertex  = vbOffset/_stride;
+					_tvb->stride       = _stride;
+					_tvb->handle       = dvb.handle;
+					_tvb->layoutHandle = _layoutHandle;
+
+					return true;
+				}
 
+				m_submit->m_transientVb.free(vbPage, vbOffset, _numVertices*_stride);
+			}
+
+			return false;
+		}
+
+		GRAPHICS_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
+		{
 			const uint16_t stride = base::alignUp(_stride, 16);
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+			uint32_t offset;
+			const uint32_t page = allocTransientVertexPage(_num, stride, false, offset);
+
+			TransientVertexBuffer& dvb = *m_submit->m_transientVb.m_page[page];
 			_idb->data   = &dvb.data[offset];
 			_idb->size   = _num * stride;
 			_idb->offset = offset;
@@ -4197,6 +4858,38 @@ namespace graphics
 			_idb->handle = dvb.handle;
 		}
 
+		void destroyTransientPages()
+		{
+			while (0 < m_submit->m_transientVb.m_num)
+			{
+				destroyTransientVertexBuffer(m_submit->m_transientVb.remove() );
+			}
+
+			while (0 < m_submit->m_transientIb.m_num)
+			{
+				destroyTransientIndexBuffer(m_submit->m_transientIb.remove() );
+			}
+		}
+
+		/// Release trailing transient page of submit frame once peak usage in last two shrink
+		/// windows stayed low long enough. Must be called after `Frame::start`.
+		void shrinkTransientPages()
+		{
+			const uint32_t vbPeak = base::max(m_transientVbPeak[0], m_transientVbPeak[1]);
+			TransientPages<TransientVertexBuffer>& vbPages = m_submit->m_transientVb;
+			if (vbPages.shouldShrink(vbPeak) )
+			{
+				destroyTransientVertexBuffer(vbPages.remove() );
+			}
+
+			const uint32_t ibPeak = base::max(m_transientIbPeak[0], m_transientIbPeak[1]);
+			TransientPages<TransientIndexBuffer>& ibPages = m_submit->m_transientIb;
+			if (ibPages.shouldShrink(ibPeak) )
+			{
+				destroyTransientIndexBuffer(ibPages.remove() );
+			}
+		}
+
 		IndirectBufferHandle createIndirectBuffer(uint32_t _num)
 		{
 			BASE_UNUSED(_num);
@@ -4227,10 +4920,19 @@ namespace graphics
 			m_submit->free(handle);
 		}
 
-		GRAPHICS_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
+		struct ShaderUniform
 		{
-			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+			uint32_t m_nameOffset;
+			uint8_t  m_nameSize;
+			uint8_t  m_type;
+			uint8_t  m_num;
+		};
 
+		/// Validate shader binary and read its uniform table, skipping predefined uniforms.
+		/// Doesn't touch context state, so it's called without holding resource API lock.
+		/// `_uniforms` must have room for `GRAPHICS_CONFIG_MAX_UNIFORMS` elements.
+		static bool parseShader(const Memory* _mem, uint32_t& _hashIn, uint32_t& _hashOut, ShaderUniform* _uniforms, uint16_t& _num)
+		{
 			base::MemoryReader reader(_mem->data, _mem->size);
 
 			base::Error err;
@@ -4241,8 +4943,7 @@ namespace graphics
 			if (!err.isOk())
 			{
 				BASE_TRACE("Couldn't read shader signature!");
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
+				return false;
 			}
 
 			if (!isShaderBin(magic) )
@@ -4253,16 +4954,14 @@ namespace graphics
 					, ( (uint8_t*)&magic)[2]
 					, ( (uint8_t*)&magic)[3]
 					);
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
+				return false;
 			}
 
 			if (isShaderType(magic, 'C')
 			&&  0 == (g_caps.supported & GRAPHICS_CAPS_COMPUTE) )
 			{
 				BASE_TRACE("Creating compute shader but compute is not supported!");
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
+				return false;
 			}
 
 			if ( (isShaderType(magic, 'C') && isShaderVerLess(magic, 3) )
@@ -4270,32 +4969,18 @@ namespace graphics
 			||   (isShaderType(magic, 'V') && isShaderVerLess(magic, 5) ) )
 			{
 				BASE_TRACE("Unsupported shader binary version.");
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
-			}
-
-			const uint32_t shaderHash = base::hash<base::HashMurmur2A>(_mem->data, _mem->size);
-			const uint16_t idx = m_shaderHashMap.find(shaderHash);
-			if (kInvalidHandle != idx)
-			{
-				ShaderHandle handle = { idx };
-				shaderIncRef(handle);
-				release(_mem);
-				return handle;
+				return false;
 			}
 
-			uint32_t hashIn;
-			base::read(&reader, hashIn, &err);
-
-			uint32_t hashOut;
+			base::read(&reader, _hashIn, &err);
 
 			if (isShaderVerLess(magic, 6) )
 			{
-				hashOut = hashIn;
+				_hashOut = _hashIn;
 			}
 			else
 			{
-				base::read(&reader, hashOut, &err);
+				base::read(&reader, _hashOut, &err);
 			}
 
 			uint16_t count;
@@ -4304,36 +4989,18 @@ namespace graphics
 			if (!err.isOk() )
 			{
 				BASE_TRACE("Corrupted shader binary!");
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
-			}
-
-			ShaderHandle handle = { m_shaderHandle.alloc() };
-
-			if (!isValid(handle) )
-			{
-				BASE_TRACE("Failed to allocate shader handle.");
-				release(_mem);
-				return GRAPHICS_INVALID_HANDLE;
+				return false;
 			}
 
-			bool ok = m_shaderHashMap.insert(shaderHash, handle.idx);
-			BASE_ASSERT(ok, "Shader already exists!"); BASE_UNUSED(ok);
-
-			ShaderRef& sr = m_shaderRef[handle.idx];
-			sr.m_refCount = 1;
-			sr.m_hashIn   = hashIn;
-			sr.m_hashOut  = hashOut;
-			sr.m_num      = 0;
-			sr.m_uniforms = NULL;
-
-			UniformHandle* uniforms = (UniformHandle*)alloca(count*sizeof(UniformHandle) );
+			_num = 0;
 
 			for (uint32_t ii = 0; ii < count; ++ii)
 			{
 				uint8_t nameSize = 0;
 				base::read(&reader, nameSize, &err);
 
+				const uint32_t nameOffset = uint32_t(reader.getPos() );
+
 				char name[256];
 				base::read(&reader, &name, nameSize, &err);
 				name[nameSize] = '\0';
@@ -4366,16 +5033,90 @@ namespace graphics
 				PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
 				if (PredefinedUniform::Count == predefined && UniformType::End != UniformType::Enum(type) )
 				{
-					uniforms[sr.m_num] = createUniform(name, UniformType::Enum(type), num);
-					sr.m_num++;
+					if (GRAPHICS_CONFIG_MAX_UNIFORMS == _num)
+					{
+						BASE_TRACE("Too many uniforms in shader!");
+						return false;
+					}
+
+					ShaderUniform& uniform = _uniforms[_num++];
+					uniform.m_nameOffset = nameOffset;
+					uniform.m_nameSize   = nameSize;
+					uniform.m_type       = type;
+					uniform.m_num        = num;
 				}
 			}
 
-			if (0 != sr.m_num)
+			if (!err.isOk() )
+			{
+				BASE_TRACE("Corrupted shader binary!");
+				return false;
+			}
+
+			return true;
+		}
+
+		GRAPHICS_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
+		{
+			// Parsing and hashing shader binary doesn't need context state. It's done before
+			// taking resource API lock, so loading many shaders doesn't block other threads.
+			ShaderUniform uniforms[GRAPHICS_CONFIG_MAX_UNIFORMS];
+			uint32_t hashIn;
+			uint32_t hashOut;
+			uint16_t num;
+			if (!parseShader(_mem, hashIn, hashOut, uniforms, num) )
+			{
+				release(_mem);
+				return GRAPHICS_INVALID_HANDLE;
+			}
+
+			const uint32_t shaderHash = base::hash<base::HashMurmur2A>(_mem->data, _mem->size);
+
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			const uint16_t idx = m_shaderHashMap.find(shaderHash);
+			if (kInvalidHandle != idx)
 			{
-				uint32_t size = sr.m_num*sizeof(UniformHandle);
-				sr.m_uniforms = (UniformHandle*)base::alloc(g_allocator, size);
-				base::memCopy(sr.m_uniforms, uniforms, size);
+				ShaderHandle handle = { idx };
+				shaderIncRef(handle);
+				release(_mem);
+				return handle;
+			}
+
+			ShaderHandle handle = { m_shaderHandle.alloc() };
+
+			if (!isValid(handle) )
+			{
+				BASE_TRACE("Failed to allocate shader handle.");
+				release(_mem);
+				return GRAPHICS_INVALID_HANDLE;
+			}
+
+			bool ok = m_shaderHashMap.insert(shaderHash, handle.idx);
+			BASE_ASSERT(ok, "Shader already exists!"); BASE_UNUSED(ok);
+
+			ShaderRef& sr = m_shaderRef[handle.idx];
+			sr.m_refCount = 1;
+			sr.m_hashIn   = hashIn;
+			sr.m_hashOut  = hashOut;
+			sr.m_num      = 0;
+			sr.m_uniforms = NULL;
+
+			if (0 != num)
+			{
+				sr.m_uniforms = (UniformHandle*)base::alloc(g_allocator, num*sizeof(UniformHandle) );
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					const ShaderUniform& uniform = uniforms[ii];
+
+					char name[256];
+					base::memCopy(name, &_mem->data[uniform.m_nameOffset], uniform.m_nameSize);
+					name[uniform.m_nameSize] = '\0';
+
+					sr.m_uniforms[sr.m_num] = createUniform(name, UniformType::Enum(uniform.m_type), uniform.m_num);
+					sr.m_num++;
+				}
 			}
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateShader);
@@ -4644,6 +5385,31 @@ namespace graphics
 		{
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
 
+			return createTextureInternal(_mem, _flags, _skip, _info, _ratio, _immutable);
+		}
+
+		GRAPHICS_API_FUNC(uint16_t createTextures(uint16_t _num, const TextureDesc* _desc, TextureHandle* _handles) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			uint16_t numCreated = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const TextureDesc& desc = _desc[ii];
+				_handles[ii] = createTextureInternal(desc.mem, desc.flags, desc.skip, desc.info, BackbufferRatio::Count, false);
+
+				if (isValid(_handles[ii]) )
+				{
+					++numCreated;
+				}
+			}
+
+			return numCreated;
+		}
+
+		TextureHandle createTextureInternal(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable)
+		{
 			TextureInfo ti;
 			if (NULL == _info)
 			{
@@ -4735,6 +5501,19 @@ namespace graphics
 			setNameForHandle(_handle, _name);
 		}
 
+		GRAPHICS_API_FUNC(void setTextureMinMip(TextureHandle _handle, uint8_t _mip) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+			GRAPHICS_CHECK_HANDLE("setTextureMinMip", m_textureHandle, _handle);
+
+			const TextureRef& ref = m_textureRef[_handle.idx];
+			BASE_ASSERT(_mip < ref.m_numMips, "Invalid min mip %d, texture has %d mips.", _mip, ref.m_numMips);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetTextureMinMip);
+			cmdbuf.write(_handle);
+			cmdbuf.write(uint8_t(base::min<uint32_t>(_mip, ref.m_numMips-1) ) );
+		}
+
 		void setDirectAccessPtr(TextureHandle _handle, void* _ptr)
 		{
 			TextureRef& ref = m_textureRef[_handle.idx];
@@ -4765,10 +5544,24 @@ namespace graphics
 			textureDecRef(_handle);
 		}
 
-		GRAPHICS_API_FUNC(uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip) )
+		GRAPHICS_API_FUNC(void destroyTextures(uint16_t _num, const TextureHandle* _handles) )
 		{
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
 
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const TextureHandle handle = _handles[ii];
+
+				if (isValid(handle) )
+				{
+					GRAPHICS_CHECK_HANDLE("destroyTextures", m_textureHandle, handle);
+					textureDecRef(handle);
+				}
+			}
+		}
+
+		uint32_t readTextureInternal(TextureHandle _handle, void* _data, uint8_t _mip)
+		{
 			GRAPHICS_CHECK_HANDLE("readTexture", m_textureHandle, _handle);
 
 			const TextureRef& ref = m_textureRef[_handle.idx];
@@ -4780,7 +5573,76 @@ namespace graphics
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_submit->m_frameNum + 2;
+			return m_submit->m_frameNum + g_caps.limits.readTextureLatency;
+		}
+
+		GRAPHICS_API_FUNC(uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			return readTextureInternal(_handle, _data, _mip);
+		}
+
+		GRAPHICS_API_FUNC(uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip, ReadTextureFn _fn, void* _userData) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			BASE_WARN(m_numReadTexture < BASE_COUNTOF(m_readTexture)
+				, "Too many texture read back callbacks in flight (max: %d), read back is not issued."
+				, GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS
+				);
+
+			if (m_numReadTexture >= BASE_COUNTOF(m_readTexture) )
+			{
+				return UINT32_MAX;
+			}
+
+			const uint32_t frame = readTextureInternal(_handle, _data, _mip);
+
+			ReadTexture& rt = m_readTexture[m_numReadTexture++];
+			rt.m_frame    = frame;
+			rt.m_handle   = _handle;
+			rt.m_data     = _data;
+			rt.m_mip      = _mip;
+			rt.m_fn       = _fn;
+			rt.m_userData = _userData;
+
+			return frame;
+		}
+
+		// Called from `graphics::frame` after frame `_frame` is done, to notify texture read backs
+		// that became available. Callbacks are called without holding API lock.
+		void readTextureCallback(uint32_t _frame)
+		{
+			ReadTexture done[GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS];
+			uint32_t numDone = 0;
+
+			{
+				GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+				uint32_t num = 0;
+				for (uint32_t ii = 0; ii < m_numReadTexture; ++ii)
+				{
+					const ReadTexture& rt = m_readTexture[ii];
+
+					if (rt.m_frame <= _frame)
+					{
+						done[numDone++] = rt;
+					}
+					else
+					{
+						m_readTexture[num++] = rt;
+					}
+				}
+
+				m_numReadTexture = num;
+			}
+
+			for (uint32_t ii = 0; ii < numDone; ++ii)
+			{
+				const ReadTexture& rt = done[ii];
+				rt.m_fn(rt.m_handle, rt.m_data, rt.m_mip, rt.m_userData);
+			}
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -5225,6 +6087,78 @@ namespace graphics
 			screenShot.filePath.set(_filePath);
 		}
 
+		GRAPHICS_API_FUNC(void requestProfilerCapture(uint32_t _numFrames, const char* _filePath) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			profilerCaptureRequest(_numFrames, _filePath);
+		}
+
+		GRAPHICS_API_FUNC(bool beginFrameCapture(const char* _filePath) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (NULL != m_frameCapture)
+			{
+				BASE_TRACE("Frame capture is already in progress.");
+				return false;
+			}
+
+			m_frameCapture = frameCaptureCreate(_filePath);
+			return NULL != m_frameCapture;
+		}
+
+		GRAPHICS_API_FUNC(void endFrameCapture() )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (NULL != m_frameCapture)
+			{
+				frameCaptureDestroy(m_frameCapture);
+				m_frameCapture = NULL;
+			}
+		}
+
+		GRAPHICS_API_FUNC(bool beginFrameReplay(const char* _filePath) )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (NULL != m_frameReplay)
+			{
+				BASE_TRACE("Frame replay is already in progress.");
+				return false;
+			}
+
+			m_frameReplay = frameReplayCreate(_filePath, this);
+			return NULL != m_frameReplay;
+		}
+
+		GRAPHICS_API_FUNC(bool replayFrame() )
+		{
+			if (NULL == m_frameReplay
+			||  !frameReplayRead(m_frameReplay) )
+			{
+				return false;
+			}
+
+			// Recorded frame replaces submitted frame in swap.
+			m_frameReplayPending = true;
+			frame();
+
+			return true;
+		}
+
+		GRAPHICS_API_FUNC(void endFrameReplay() )
+		{
+			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (NULL != m_frameReplay)
+			{
+				frameReplayDestroy(m_frameReplay, this);
+				m_frameReplay = NULL;
+			}
+		}
+
 		GRAPHICS_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
 			GRAPHICS_MUTEX_SCOPE(m_resourceApiLock);
@@ -5283,6 +6217,11 @@ namespace graphics
 			m_view[_id].setMode(_mode);
 		}
 
+		GRAPHICS_API_FUNC(void setViewMerge(ViewId _id, uint8_t _flags) )
+		{
+			m_view[_id].setMerge(_flags);
+		}
+
 		GRAPHICS_API_FUNC(void setViewFrameBuffer(ViewId _id, FrameBufferHandle _handle) )
 		{
 			GRAPHICS_CHECK_HANDLE_INVALID_OK("setViewFrameBuffer", m_frameBufferHandle, _handle);
@@ -5331,6 +6270,7 @@ namespace graphics
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
 		void frameNoRenderWait();
+		void finishSubmit();
 		void swap();
 
 		// render thread
@@ -5455,9 +6395,6 @@ namespace graphics
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[GRAPHICS_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[GRAPHICS_CONFIG_MAX_DRAW_CALLS];
-
 		IndexBuffer  m_indexBuffers[GRAPHICS_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[GRAPHICS_CONFIG_MAX_VERTEX_BUFFERS];
 
@@ -5513,9 +6450,13 @@ namespace graphics
 
 		Init     m_init;
 		int64_t  m_frameTimeLast;
+		int64_t  m_swapTime;
 		uint32_t m_frames;
 		uint32_t m_debug;
 
+		uint32_t m_transientVbPeak[2]; //!< Peak transient usage in previous and current shrink window.
+		uint32_t m_transientIbPeak[2];
+
 		int64_t m_rtMemoryUsed;
 		int64_t m_textureMemoryUsed;
 
@@ -5529,8 +6470,28 @@ namespace graphics
 		bool m_exit;
 		bool m_flipAfterRender;
 		bool m_singleThreaded;
+
+		FrameCapture* m_frameCapture;
+		FrameReplay*  m_frameReplay;
+		bool m_frameReplayPending;
 		bool m_flipped;
 
+		/// Incremented every time vertex layout is released, see `EncoderImpl::findOrCreateVertexLayout`.
+		volatile uint32_t m_layoutGeneration;
+
+		struct ReadTexture
+		{
+			uint32_t      m_frame;
+			TextureHandle m_handle;
+			void*         m_data;
+			uint8_t       m_mip;
+			ReadTextureFn m_fn;
+			void*         m_userData;
+		};
+
+		ReadTexture m_readTexture[GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS];
+		uint32_t    m_numReadTexture;
+
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		BASE_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
 	};
@@ -13,6 +13,7 @@
 #include <base/ringbuffer.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct InputMouse
 {
@@ -71,6 +72,7 @@ struct InputKeyboard
 {
 	InputKeyboard()
 		: m_ring(BASE_COUNTOF(m_char)-4)
+		, m_numChanged(0)
 	{
 	}
 
@@ -78,6 +80,8 @@ struct InputKeyboard
 	{
 		base::memSet(m_key, 0, sizeof(m_key) );
 		base::memSet(m_once, 0xff, sizeof(m_once) );
+		base::memSet(m_changed, 0, sizeof(m_changed) );
+		m_numChanged = 0;
 	}
 
 	static uint32_t encodeKeyState(uint8_t _modifiers, bool _down)
@@ -98,6 +102,29 @@ struct InputKeyboard
 	{
 		m_key[_key] = encodeKeyState(_modifiers, _down);
 		m_once[_key] = false;
+		markChanged(_key);
+	}
+
+	void markChanged(uint32_t _key)
+	{
+		if (!m_changed[_key])
+		{
+			m_changed[_key] = true;
+			m_changedKey[m_numChanged++] = uint8_t(_key);
+		}
+	}
+
+	uint32_t consumeChanged(uint8_t* _keys)
+	{
+		const uint32_t num = m_numChanged;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			_keys[ii] = m_changedKey[ii];
+			m_changed[m_changedKey[ii] ] = false;
+		}
+
+		m_numChanged = 0;
+		return num;
 	}
 
 	bool getKeyState(entry::Key::Enum _key, uint8_t* _modifiers)
@@ -153,6 +180,9 @@ struct InputKeyboard
 
 	uint32_t m_key[256];
 	bool m_once[256];
+	bool m_changed[256];
+	uint8_t m_changedKey[256];
+	uint32_t m_numChanged;
 
 	base::RingBufferControl m_ring;
 	uint8_t m_char[256];
@@ -183,20 +213,41 @@ struct Gamepad
 	int32_t m_axis[entry::GamepadAxis::Count];
 };
 
+struct InputKeyBinding
+{
+	uint8_t m_modifiers;
+	uint8_t m_flags;
+	InputBindingFn m_fn;
+	const void* m_userData;
+	CmdCompiled* m_cmd;
+};
+
+struct InputKeyBindings
+{
+	uint16_t m_start;
+	uint16_t m_num;
+	bool m_repeat;
+};
+
 struct Input
 {
 	Input()
+		: m_numRepeatKeys(0)
+		, m_dirty(false)
 	{
+		base::memSet(m_keyBindings, 0, sizeof(m_keyBindings) );
 		reset();
 	}
 
 	~Input()
 	{
+		freeBindings();
 	}
 
 	void addBindings(const char* _name, const InputBinding* _bindings)
 	{
 		m_inputBindingsMap.insert(std::make_pair(std::string(_name), _bindings) );
+		m_dirty = true;
 	}
 
 	void removeBindings(const char* _name)
@@ -205,62 +256,172 @@ struct Input
 		if (it != m_inputBindingsMap.end() )
 		{
 			m_inputBindingsMap.erase(it);
+			m_dirty = true;
 		}
 	}
 
-	void process(const InputBinding* _bindings)
+	void freeBindings()
 	{
-		for (const InputBinding* binding = _bindings; binding->m_key != entry::Key::None; ++binding)
+		for (InputKeyBindingArray::iterator it = m_bindings.begin(); it != m_bindings.end(); ++it)
 		{
-			uint8_t modifiers;
-			bool down = InputKeyboard::decodeKeyState(m_keyboard.m_key[binding->m_key], modifiers);
+			cmdFree(it->m_cmd);
+		}
+
+		m_bindings.clear();
+	}
+
+	// Flattens all binding tables into per key lookup, and compiles string bindings into
+	// console commands, so that process doesn't walk tables or parse strings.
+	void compileBindings()
+	{
+		freeBindings();
 
-			if (binding->m_flags == 1)
+		base::memSet(m_keyBindings, 0, sizeof(m_keyBindings) );
+		m_numRepeatKeys = 0;
+
+		for (InputBindingMap::const_iterator it = m_inputBindingsMap.begin(); it != m_inputBindingsMap.end(); ++it)
+		{
+			for (const InputBinding* binding = it->second; binding->m_key != entry::Key::None; ++binding)
 			{
-				if (down)
-				{
-					if (modifiers == binding->m_modifiers
-					&&  !m_keyboard.m_once[binding->m_key])
-					{
-						if (NULL == binding->m_fn)
-						{
-							cmdExec( (const char*)binding->m_userData);
-						}
-						else
-						{
-							binding->m_fn(binding->m_userData);
-						}
-						m_keyboard.m_once[binding->m_key] = true;
-					}
-				}
-				else
-				{
-					m_keyboard.m_once[binding->m_key] = false;
-				}
+				m_keyBindings[binding->m_key].m_num++;
 			}
-			else
+		}
+
+		uint16_t start = 0;
+		for (uint32_t ii = 0; ii < entry::Key::Count; ++ii)
+		{
+			InputKeyBindings& kb = m_keyBindings[ii];
+			kb.m_start = start;
+			start += kb.m_num;
+			kb.m_num = 0;
+		}
+
+		m_bindings.resize(start);
+
+		for (InputBindingMap::const_iterator it = m_inputBindingsMap.begin(); it != m_inputBindingsMap.end(); ++it)
+		{
+			for (const InputBinding* binding = it->second; binding->m_key != entry::Key::None; ++binding)
 			{
-				if (down
-				&&  modifiers == binding->m_modifiers)
+				InputKeyBindings& kb = m_keyBindings[binding->m_key];
+
+				InputKeyBinding& dst = m_bindings[kb.m_start + kb.m_num];
+				dst.m_modifiers = binding->m_modifiers;
+				dst.m_flags     = binding->m_flags;
+				dst.m_fn        = binding->m_fn;
+				dst.m_userData  = binding->m_userData;
+				dst.m_cmd       = NULL == binding->m_fn
+					? cmdCompile( (const char*)binding->m_userData)
+					: NULL
+					;
+
+				++kb.m_num;
+
+				if (1 != binding->m_flags
+				&&  !kb.m_repeat)
 				{
-					if (NULL == binding->m_fn)
-					{
-						cmdExec( (const char*)binding->m_userData);
-					}
-					else
-					{
-						binding->m_fn(binding->m_userData);
-					}
+					kb.m_repeat = true;
+					m_repeatKey[m_numRepeatKeys++] = uint8_t(binding->m_key);
 				}
 			}
 		}
+
+		// Keys held while bindings changed are evaluated once more, same as when bindings were
+		// polled every frame.
+		for (uint32_t ii = 0; ii < entry::Key::Count; ++ii)
+		{
+			uint8_t modifiers;
+			if (InputKeyboard::decodeKeyState(m_keyboard.m_key[ii], modifiers) )
+			{
+				m_keyboard.markChanged(ii);
+			}
+		}
+
+		m_dirty = false;
+	}
+
+	static void exec(const InputKeyBinding& _binding)
+	{
+		if (NULL == _binding.m_fn)
+		{
+			cmdExecCompiled(_binding.m_cmd);
+		}
+		else
+		{
+			_binding.m_fn(_binding.m_userData);
+		}
+	}
+
+	void processOnce(uint32_t _key)
+	{
+		uint8_t modifiers;
+		bool down = InputKeyboard::decodeKeyState(m_keyboard.m_key[_key], modifiers);
+
+		if (!down)
+		{
+			m_keyboard.m_once[_key] = false;
+			return;
+		}
+
+		const InputKeyBindings& kb = m_keyBindings[_key];
+		for (uint32_t ii = kb.m_start, end = kb.m_start + kb.m_num; ii < end; ++ii)
+		{
+			const InputKeyBinding& binding = m_bindings[ii];
+
+			if (binding.m_flags == 1
+			&&  modifiers == binding.m_modifiers
+			&&  !m_keyboard.m_once[_key])
+			{
+				exec(binding);
+				m_keyboard.m_once[_key] = true;
+			}
+		}
+	}
+
+	void processRepeat(uint32_t _key)
+	{
+		uint8_t modifiers;
+		bool down = InputKeyboard::decodeKeyState(m_keyboard.m_key[_key], modifiers);
+
+		if (!down)
+		{
+			return;
+		}
+
+		const InputKeyBindings& kb = m_keyBindings[_key];
+		for (uint32_t ii = kb.m_start, end = kb.m_start + kb.m_num; ii < end; ++ii)
+		{
+			const InputKeyBinding& binding = m_bindings[ii];
+
+			if (binding.m_flags != 1
+			&&  modifiers == binding.m_modifiers)
+			{
+				exec(binding);
+			}
+		}
 	}
 
 	void process()
 	{
-		for (InputBindingMap::const_iterator it = m_inputBindingsMap.begin(); it != m_inputBindingsMap.end(); ++it)
+		if (m_dirty)
+		{
+			compileBindings();
+		}
+
+		// One-shot bindings can only trigger on key state change, so only keys that received
+		// events since last call are visited. Changed keys are copied out first, since bindings
+		// might set key state.
+		uint8_t changed[256];
+		const uint32_t numChanged = m_keyboard.consumeChanged(changed);
+
+		for (uint32_t ii = 0; ii < numChanged; ++ii)
 		{
-			process(it->second);
+			processOnce(changed[ii]);
+		}
+
+		// Repeat bindings trigger every frame while key is held.
+		for (uint32_t ii = 0; ii < m_numRepeatKeys; ++ii)
+		{
+			processRepeat(m_repeatKey[ii]);
 		}
 	}
 
@@ -276,6 +437,14 @@ struct Input
 
 	typedef std::unordered_map<std::string, const InputBinding*> InputBindingMap;
 	InputBindingMap m_inputBindingsMap;
+
+	typedef std::vector<InputKeyBinding> InputKeyBindingArray;
+	InputKeyBindingArray m_bindings;
+	InputKeyBindings m_keyBindings[entry::Key::Count];
+	uint8_t m_repeatKey[entry::Key::Count];
+	uint32_t m_numRepeatKeys;
+	bool m_dirty;
+
 	InputKeyboard m_keyboard;
 	InputMouse m_mouse;
 	Gamepad m_gamepad[ENTRY_CONFIG_MAX_GAMEPADS];
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef MAPPED_FILE_H_HEADER_GUARD
+#define MAPPED_FILE_H_HEADER_GUARD
+
+#include <base/allocator.h>
+#include <base/file.h>
+
+#define MAPPED_FILE_MMAP_WINDOWS (BASE_PLATFORM_WINDOWS)
+#define MAPPED_FILE_MMAP_POSIX   (BASE_PLATFORM_POSIX && !BASE_PLATFORM_EMSCRIPTEN)
+
+#if MAPPED_FILE_MMAP_WINDOWS
+#	include <windows.h>
+#elif MAPPED_FILE_MMAP_POSIX
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // MAPPED_FILE_MMAP_*
+
+// Read only view of whole file. Memory mapped where platform supports it, otherwise file is read
+// into memory.
+struct MappedFile
+{
+	MappedFile()
+		: m_data(NULL)
+		, m_size(0)
+#if MAPPED_FILE_MMAP_WINDOWS
+		, m_file(INVALID_HANDLE_VALUE)
+		, m_mapping(NULL)
+#endif // MAPPED_FILE_MMAP_WINDOWS
+		, m_allocator(NULL)
+	{
+	}
+
+	bool open(const char* _filePath, base::AllocatorI* _allocator)
+	{
+		m_allocator = _allocator;
+
+#if MAPPED_FILE_MMAP_WINDOWS
+		m_file = CreateFileA(_filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (INVALID_HANDLE_VALUE == m_file)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size)
+		||  0 == size.QuadPart
+		||  UINT32_MAX < size.QuadPart)
+		{
+			close();
+			return false;
+		}
+
+		m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (NULL == m_mapping)
+		{
+			close();
+			return false;
+		}
+
+		m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+		m_size = uint32_t(size.QuadPart);
+#elif MAPPED_FILE_MMAP_POSIX
+		int fd = ::open(_filePath, O_RDONLY);
+		if (-1 == fd)
+		{
+			return false;
+		}
+
+		struct stat st;
+		if (0 != fstat(fd, &st)
+		||  0 == st.st_size
+		||  UINT32_MAX < uint64_t(st.st_size) )
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// Mapping stays valid after file descriptor is closed.
+		::close(fd);
+
+		if (MAP_FAILED == data)
+		{
+			return false;
+		}
+
+		m_data = (const uint8_t*)data;
+		m_size = uint32_t(st.st_size);
+#else
+		base::FileReader reader;
+		base::Error err;
+		if (!base::open(&reader, _filePath, &err) )
+		{
+			return false;
+		}
+
+		const uint32_t size = uint32_t(base::getSize(&reader) );
+		uint8_t* data = (uint8_t*)base::alloc(m_allocator, size);
+		base::read(&reader, data, size, &err);
+		base::close(&reader);
+
+		m_data = data;
+		m_size = size;
+#endif // MAPPED_FILE_MMAP_*
+
+		if (NULL == m_data)
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void close()
+	{
+#if MAPPED_FILE_MMAP_WINDOWS
+		if (NULL != m_data)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (NULL != m_mapping)
+		{
+			CloseHandle(m_mapping);
+			m_mapping = NULL;
+		}
+
+		if (INVALID_HANDLE_VALUE != m_file)
+		{
+			CloseHandle(m_file);
+			m_file = INVALID_HANDLE_VALUE;
+		}
+#elif MAPPED_FILE_MMAP_POSIX
+		if (NULL != m_data)
+		{
+			munmap(const_cast<uint8_t*>(m_data), m_size);
+		}
+#else
+		if (NULL != m_data)
+		{
+			base::free(m_allocator, const_cast<uint8_t*>(m_data) );
+		}
+#endif // MAPPED_FILE_MMAP_*
+
+		m_data = NULL;
+		m_size = 0;
+	}
+
+	bool isOpen() const
+	{
+		return NULL != m_data;
+	}
+
+	const uint8_t* m_data;
+	uint32_t m_size;
+
+#if MAPPED_FILE_MMAP_WINDOWS
+	HANDLE m_file;
+	HANDLE m_mapping;
+#endif // MAPPED_FILE_MMAP_WINDOWS
+
+	base::AllocatorI* m_allocator;
+};
+
+#endif // MAPPED_FILE_H_HEADER_GUARD
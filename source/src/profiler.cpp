@@ -0,0 +1,462 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#include "graphics_p.h"
+
+namespace graphics
+{
+	volatile bool g_profilerCaptureActive = false;
+
+#if GRAPHICS_CONFIG_PROFILER_CAPTURE
+	struct ProfilerEventType
+	{
+		enum Enum
+		{
+			Begin,
+			End,
+			Frame,
+		};
+	};
+
+	struct ProfilerEvent
+	{
+		int64_t     time;
+		const char* name;
+		uint32_t    abgr;
+		uint32_t    type;
+	};
+
+	// Each thread writes only into its own buffer, and capture writer reads only events that were
+	// published by incrementing `m_num`. Buffer is reset by owning thread when it notices that
+	// capture generation changed, so there is no need for any locking.
+	struct ProfilerThreadBuffer
+	{
+		ProfilerEvent m_event[GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_EVENTS];
+		char m_name[GRAPHICS_CONFIG_PROFILER_CAPTURE_NAME_BUFFER_SIZE];
+		char m_threadName[64];
+		volatile uint32_t m_num;
+		uint32_t m_nameUsed;
+		uint32_t m_numDropped;
+		uint32_t m_generation;
+	};
+
+	struct ProfilerCaptureState
+	{
+		enum Enum
+		{
+			Idle,
+			Requested,
+			Capturing,
+		};
+	};
+
+	static ProfilerThreadBuffer* s_profilerThread[GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS];
+	static volatile uint32_t s_profilerNumThreads = 0;
+	static uint32_t s_profilerInstance = 1;
+	static uint32_t s_profilerGeneration = 0;
+
+	static ProfilerCaptureState::Enum s_profilerState = ProfilerCaptureState::Idle;
+	static uint32_t s_profilerNumFrames = 0;
+	static int64_t  s_profilerCaptureBegin = 0;
+	static char     s_profilerFilePath[base::kMaxFilePath];
+
+	// Thread's ticket is combination of profiler instance and index of thread's buffer. Instance
+	// is incremented when buffers are released, so that stale tickets are ignored after shutdown.
+#if GRAPHICS_CONFIG_MULTITHREADED && !defined(BASE_THREAD_LOCAL)
+	static base::TlsData s_profilerTicket;
+	static base::TlsData s_profilerThreadName;
+
+	static uint32_t getProfilerTicket()
+	{
+		return uint32_t(uintptr_t(s_profilerTicket.get() ) );
+	}
+
+	static void setProfilerTicket(uint32_t _ticket)
+	{
+		s_profilerTicket.set( (void*)uintptr_t(_ticket) );
+	}
+
+	static const char* getProfilerThreadName()
+	{
+		return (const char*)s_profilerThreadName.get();
+	}
+
+	static void setProfilerThreadName(const char* _name)
+	{
+		s_profilerThreadName.set( (void*)_name);
+	}
+#else
+#	if GRAPHICS_CONFIG_MULTITHREADED
+	static BASE_THREAD_LOCAL uint32_t    s_profilerTicket = 0;
+	static BASE_THREAD_LOCAL const char* s_profilerThreadName = NULL;
+#	else
+	static uint32_t    s_profilerTicket = 0;
+	static const char* s_profilerThreadName = NULL;
+#	endif // GRAPHICS_CONFIG_MULTITHREADED
+
+	static uint32_t getProfilerTicket()
+	{
+		return s_profilerTicket;
+	}
+
+	static void setProfilerTicket(uint32_t _ticket)
+	{
+		s_profilerTicket = _ticket;
+	}
+
+	static const char* getProfilerThreadName()
+	{
+		return s_profilerThreadName;
+	}
+
+	static void setProfilerThreadName(const char* _name)
+	{
+		s_profilerThreadName = _name;
+	}
+#endif // GRAPHICS_CONFIG_MULTITHREADED && !defined(BASE_THREAD_LOCAL)
+
+	static ProfilerThreadBuffer* getProfilerThreadBuffer()
+	{
+		uint32_t ticket = getProfilerTicket();
+
+		if (s_profilerInstance != (ticket>>8) )
+		{
+			const uint32_t idx = base::atomicFetchAndAdd<uint32_t>(&s_profilerNumThreads, 1);
+			if (idx >= GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS)
+			{
+				ticket = s_profilerInstance<<8;
+				setProfilerTicket(ticket);
+				return NULL;
+			}
+
+			ProfilerThreadBuffer* tb = s_profilerThread[idx];
+			tb->m_num        = 0;
+			tb->m_nameUsed   = 0;
+			tb->m_numDropped = 0;
+			tb->m_generation = s_profilerGeneration;
+
+			const char* name = getProfilerThreadName();
+			if (NULL != name)
+			{
+				base::strCopy(tb->m_threadName, BASE_COUNTOF(tb->m_threadName), name);
+			}
+			else
+			{
+				base::snprintf(tb->m_threadName, BASE_COUNTOF(tb->m_threadName), "Thread %d", idx);
+			}
+
+			ticket = (s_profilerInstance<<8) | (idx+1);
+			setProfilerTicket(ticket);
+		}
+
+		const uint32_t idx = ticket & 0xff;
+		if (0 == idx)
+		{
+			return NULL;
+		}
+
+		ProfilerThreadBuffer* tb = s_profilerThread[idx-1];
+		if (tb->m_generation != s_profilerGeneration)
+		{
+			tb->m_num        = 0;
+			tb->m_nameUsed   = 0;
+			tb->m_numDropped = 0;
+			tb->m_generation = s_profilerGeneration;
+		}
+
+		return tb;
+	}
+
+	static void profilerCaptureEvent(ProfilerEventType::Enum _type, const char* _name, uint32_t _abgr, bool _copyName)
+	{
+		ProfilerThreadBuffer* tb = getProfilerThreadBuffer();
+		if (NULL == tb)
+		{
+			return;
+		}
+
+		const uint32_t num = tb->m_num;
+		if (num >= GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_EVENTS)
+		{
+			++tb->m_numDropped;
+			return;
+		}
+
+		if (_copyName)
+		{
+			const uint32_t len = base::strLen(_name)+1;
+			if (tb->m_nameUsed + len > BASE_COUNTOF(tb->m_name) )
+			{
+				++tb->m_numDropped;
+				return;
+			}
+
+			char* name = &tb->m_name[tb->m_nameUsed];
+			base::memCopy(name, _name, len);
+			tb->m_nameUsed += len;
+			_name = name;
+		}
+
+		ProfilerEvent& ev = tb->m_event[num];
+		ev.time = base::getHPCounter();
+		ev.name = _name;
+		ev.abgr = _abgr;
+		ev.type = _type;
+
+		base::memoryBarrier();
+		tb->m_num = num+1;
+	}
+
+	void profilerCaptureBegin(const char* _name, uint32_t _abgr, bool _copyName)
+	{
+		profilerCaptureEvent(ProfilerEventType::Begin, _name, _abgr, _copyName);
+	}
+
+	void profilerCaptureEnd()
+	{
+		profilerCaptureEvent(ProfilerEventType::End, NULL, 0, false);
+	}
+
+	void profilerCaptureSetThreadName(const char* _name)
+	{
+		setProfilerThreadName(_name);
+	}
+
+	void profilerCaptureRequest(uint32_t _numFrames, const char* _filePath)
+	{
+		if (ProfilerCaptureState::Idle != s_profilerState)
+		{
+			BASE_TRACE("Profiler capture is already in progress.");
+			return;
+		}
+
+		if (0 == _numFrames)
+		{
+			return;
+		}
+
+		s_profilerNumFrames = _numFrames;
+		base::strCopy(s_profilerFilePath, BASE_COUNTOF(s_profilerFilePath), _filePath);
+		s_profilerState = ProfilerCaptureState::Requested;
+	}
+
+	static void writeJsonString(base::WriterI* _writer, const char* _str, base::Error* _err)
+	{
+		base::write(_writer, "\"", 1, _err);
+
+		for (const char* ptr = _str; '\0' != *ptr; ++ptr)
+		{
+			const uint8_t ch = uint8_t(*ptr);
+			if ('"' == ch
+			||  '\\' == ch)
+			{
+				base::write(_writer, "\\", 1, _err);
+			}
+			else if (0x20 > ch)
+			{
+				// Control characters are not allowed in JSON strings.
+				base::write(_writer, _err, "\\u%04x", ch);
+				continue;
+			}
+
+			base::write(_writer, ptr, 1, _err);
+		}
+
+		base::write(_writer, "\"", 1, _err);
+	}
+
+	static void profilerCaptureWrite()
+	{
+		base::FileWriter writer;
+		base::Error err;
+		if (!base::open(&writer, s_profilerFilePath, false, &err) )
+		{
+			BASE_TRACE("Failed to open profiler capture file '%s'.", s_profilerFilePath);
+			return;
+		}
+
+		const double toUs = 1000000.0/double(base::getHPFrequency() );
+		const uint32_t numThreads = base::min<uint32_t>(uint32_t(s_profilerNumThreads), GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS);
+
+		base::write(&writer, &err, "{\"traceEvents\":[\n");
+
+		bool first = true;
+		uint32_t numDropped = 0;
+
+		for (uint32_t tid = 0; tid < numThreads; ++tid)
+		{
+			const ProfilerThreadBuffer* tb = s_profilerThread[tid];
+			if (tb->m_generation != s_profilerGeneration)
+			{
+				continue;
+			}
+
+			const uint32_t num = tb->m_num;
+			base::memoryBarrier();
+
+			numDropped += tb->m_numDropped;
+
+			base::write(&writer, &err
+				, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":"
+				, first ? "" : ",\n"
+				, tid
+				);
+			writeJsonString(&writer, tb->m_threadName, &err);
+			base::write(&writer, &err, "}}");
+			first = false;
+
+			// Match begin/end pairs and write complete events, unmatched events are dropped.
+			uint32_t stack[64];
+			uint32_t depth = 0;
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const ProfilerEvent& ev = tb->m_event[ii];
+				const double ts = double(ev.time - s_profilerCaptureBegin)*toUs;
+
+				switch (ev.type)
+				{
+				case ProfilerEventType::Begin:
+					if (depth < BASE_COUNTOF(stack) )
+					{
+						stack[depth] = ii;
+					}
+					++depth;
+					break;
+
+				case ProfilerEventType::End:
+					if (0 < depth)
+					{
+						--depth;
+						if (depth < BASE_COUNTOF(stack) )
+						{
+							const ProfilerEvent& begin = tb->m_event[stack[depth] ];
+							const double beginTs = double(begin.time - s_profilerCaptureBegin)*toUs;
+
+							base::write(&writer, &err, ",\n{\"name\":");
+							writeJsonString(&writer, begin.name, &err);
+							base::write(&writer, &err
+								, ",\"cat\":\"graphics\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"abgr\":%u}}"
+								, beginTs
+								, ts - beginTs
+								, tid
+								, begin.abgr
+								);
+						}
+					}
+					break;
+
+				case ProfilerEventType::Frame:
+					base::write(&writer, &err
+						, ",\n{\"name\":\"%s\",\"cat\":\"graphics\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":0,\"tid\":%d}"
+						, ev.name
+						, ts
+						, tid
+						);
+					break;
+
+				default:
+					break;
+				}
+			}
+		}
+
+		// Trace event timestamps and durations are always in microseconds.
+		base::write(&writer, &err, "\n]}\n");
+		base::close(&writer);
+
+		BASE_TRACE("Profiler capture written to '%s' (dropped %d events).", s_profilerFilePath, numDropped);
+	}
+
+	void profilerCaptureFrame(uint32_t _frameNum)
+	{
+		switch (s_profilerState)
+		{
+		case ProfilerCaptureState::Requested:
+			if (NULL == s_profilerThread[0])
+			{
+				for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS; ++ii)
+				{
+					s_profilerThread[ii] = (ProfilerThreadBuffer*)base::alloc(g_allocator, sizeof(ProfilerThreadBuffer) );
+					s_profilerThread[ii]->m_generation = UINT32_MAX;
+				}
+			}
+
+			++s_profilerGeneration;
+			s_profilerCaptureBegin = base::getHPCounter();
+			s_profilerState = ProfilerCaptureState::Capturing;
+
+			base::memoryBarrier();
+			g_profilerCaptureActive = true;
+
+			profilerCaptureEvent(ProfilerEventType::Frame, "graphics/Frame", 0, false);
+			BASE_TRACE("Profiler capture started at frame %d.", _frameNum);
+			break;
+
+		case ProfilerCaptureState::Capturing:
+			profilerCaptureEvent(ProfilerEventType::Frame, "graphics/Frame", 0, false);
+
+			--s_profilerNumFrames;
+			if (0 == s_profilerNumFrames)
+			{
+				g_profilerCaptureActive = false;
+				base::memoryBarrier();
+
+				profilerCaptureWrite();
+				s_profilerState = ProfilerCaptureState::Idle;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	void profilerCaptureShutdown()
+	{
+		g_profilerCaptureActive = false;
+		base::memoryBarrier();
+
+		for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_PROFILER_CAPTURE_MAX_THREADS; ++ii)
+		{
+			if (NULL != s_profilerThread[ii])
+			{
+				base::free(g_allocator, s_profilerThread[ii]);
+				s_profilerThread[ii] = NULL;
+			}
+		}
+
+		++s_profilerInstance;
+		s_profilerNumThreads = 0;
+		s_profilerState = ProfilerCaptureState::Idle;
+	}
+#else
+	void profilerCaptureBegin(const char* /*_name*/, uint32_t /*_abgr*/, bool /*_copyName*/)
+	{
+	}
+
+	void profilerCaptureEnd()
+	{
+	}
+
+	void profilerCaptureSetThreadName(const char* /*_name*/)
+	{
+	}
+
+	void profilerCaptureRequest(uint32_t /*_numFrames*/, const char* /*_filePath*/)
+	{
+		BASE_TRACE("Profiler capture is not available, GRAPHICS_CONFIG_PROFILER_CAPTURE is 0.");
+	}
+
+	void profilerCaptureFrame(uint32_t /*_frameNum*/)
+	{
+	}
+
+	void profilerCaptureShutdown()
+	{
+	}
+#endif // GRAPHICS_CONFIG_PROFILER_CAPTURE
+
+} // namespace graphics
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
+ */
+
+#ifndef GRAPHICS_PROFILER_H_HEADER_GUARD
+#define GRAPHICS_PROFILER_H_HEADER_GUARD
+
+namespace graphics
+{
+	/// Set while built-in profiler capture is recording events.
+	extern volatile bool g_profilerCaptureActive;
+
+	/// Record begin of CPU scope into calling thread's event buffer. Name is copied when
+	/// `_copyName` is set, otherwise it must stay valid until capture is written.
+	void profilerCaptureBegin(const char* _name, uint32_t _abgr, bool _copyName);
+
+	/// Record end of CPU scope into calling thread's event buffer.
+	void profilerCaptureEnd();
+
+	/// Set name of calling thread, as it will appear in capture.
+	void profilerCaptureSetThreadName(const char* _name);
+
+	/// Request capture of next `_numFrames` frames into Chrome trace file.
+	void profilerCaptureRequest(uint32_t _numFrames, const char* _filePath);
+
+	/// Advance capture state. Must be called from API thread while render thread and encoders
+	/// are not submitting.
+	void profilerCaptureFrame(uint32_t _frameNum);
+
+	/// Release all capture buffers.
+	void profilerCaptureShutdown();
+
+} // namespace graphics
+
+#endif // GRAPHICS_PROFILER_H_HEADER_GUARD
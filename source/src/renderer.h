@@ -476,6 +476,68 @@ namespace graphics
 		return false;
 	}
 
+	/// Uploads used part of every transient page into backend buffer the page is created with.
+	/// `_update(buffer, size, data)` is called only for pages written during frame.
+	template<typename BufferT, typename Ty, typename UpdateFnT>
+	inline void updateTransientPages(BufferT* _buffers, const TransientPages<Ty>& _pages, const UpdateFnT& _update)
+	{
+		for (uint32_t ii = 0, num = _pages.m_num; ii < num; ++ii)
+		{
+			const uint32_t used = _pages.m_used[ii];
+			if (0 < used)
+			{
+				GRAPHICS_PROFILER_SCOPE("graphics/Update transient buffer", kColorResource);
+				Ty* page = _pages.m_page[ii];
+				_update(_buffers[page->handle.idx], used, page->data);
+			}
+		}
+	}
+
+	/// Uploads used part of transient pages into persistently mapped rings backing page buffers.
+	/// Page memory stays owned by frontend, render thread only copies used part into mapped memory
+	/// of ring's current slot. Ring is created on first use with `_create(buffer)`. Once creation
+	/// fails `_persistentMap` is cleared, and buffers without ring are updated with
+	/// `_update(buffer, size, data)`.
+	template<typename BufferT, typename Ty, typename CreateFnT, typename UpdateFnT>
+	inline void updatePersistentTransientPages(BufferT* _buffers, const TransientPages<Ty>& _pages, bool& _persistentMap, const CreateFnT& _create, const UpdateFnT& _update)
+	{
+		updateTransientPages(_buffers, _pages, [&](BufferT& _buffer, uint32_t _size, void* _data)
+			{
+				if (_persistentMap
+				&&  NULL == _buffer.m_persistent
+				&&  !_create(_buffer) )
+				{
+					BASE_TRACE("Failed to create persistently mapped transient buffer, falling back to copy.");
+					_persistentMap = false;
+				}
+
+				if (NULL != _buffer.m_persistent)
+				{
+					base::memCopy(_buffer.m_persistent->m_data[_buffer.m_persistent->m_slot], _data, _size);
+				}
+				else
+				{
+					_update(_buffer, _size, _data);
+				}
+			});
+	}
+
+	/// Moves persistently mapped rings backing transient pages to their next slot, once frame
+	/// reading from current slot is submitted.
+	template<typename BufferT, typename Ty>
+	inline void nextTransientPages(BufferT* _buffers, const TransientPages<Ty>& _pages)
+	{
+		for (uint32_t ii = 0, num = _pages.m_num; ii < num; ++ii)
+		{
+			BufferT& buffer = _buffers[_pages.m_page[ii]->handle.idx];
+
+			if (NULL != buffer.m_persistent)
+			{
+				buffer.m_persistent->next(buffer);
+			}
+		}
+	}
+
 	template<typename Ty>
 	struct Profiler
 	{
@@ -539,6 +601,186 @@ namespace graphics
 		bool     m_enabled;
 	};
 
+	/// Returns number of primitives formed by `_num` indices or vertices with topology
+	/// `_primIndex`. Backend independent, used where renderer doesn't keep its own `PrimInfo`.
+	inline uint32_t getNumPrims(uint8_t _primIndex, uint32_t _num)
+	{
+		struct PrimCount
+		{
+			uint32_t m_min;
+			uint32_t m_div;
+			uint32_t m_sub;
+		};
+
+		static const PrimCount s_primCount[] =
+		{
+			{ 3, 3, 0 }, // TriList
+			{ 3, 1, 2 }, // TriStrip
+			{ 2, 2, 0 }, // LineList
+			{ 2, 1, 1 }, // LineStrip
+			{ 1, 1, 0 }, // PointList
+		};
+		BASE_STATIC_ASSERT(Topology::Count == BASE_COUNTOF(s_primCount) );
+
+		const PrimCount& prim = s_primCount[_primIndex];
+		return prim.m_min <= _num
+			? _num/prim.m_div - prim.m_sub
+			: 0
+			;
+	}
+
+	struct CostStats
+	{
+		CostStats(Frame* _frame)
+			: m_frame(_frame)
+			, m_viewStats(NULL)
+			, m_stateFlags(0)
+			, m_stencil(0)
+			, m_numViews(0)
+			, m_numPrograms(0)
+		{
+			m_program.idx = kInvalidHandle;
+			base::memSet(m_viewStatsIdx, 0xff, sizeof(m_viewStatsIdx) );
+
+			// Only programs used in previous frame have valid lookup entry.
+			const Stats& perfStats = _frame->m_perfStats;
+			for (uint16_t ii = 0, num = perfStats.numProgramStats; ii < num; ++ii)
+			{
+				_frame->m_programStatsIdx[_frame->m_programStats[ii].program.idx] = UINT16_MAX;
+			}
+		}
+
+		~CostStats()
+		{
+			m_frame->m_perfStats.numViewCostStats = m_numViews;
+			m_frame->m_perfStats.numProgramStats  = m_numPrograms;
+		}
+
+		void draw(ViewId _view, ProgramHandle _program, const RenderDraw& _draw, const RenderBind& _bind, uint32_t _numPrims)
+		{
+			ViewCostStats& viewStats = view(_view);
+			++viewStats.numDraw;
+			viewStats.numPrims     += _numPrims;
+			viewStats.uniformBytes += _draw.m_uniformEnd - _draw.m_uniformBegin;
+
+			if (m_stateFlags != _draw.m_stateFlags
+			||  m_stencil    != _draw.m_stencil)
+			{
+				m_stateFlags = _draw.m_stateFlags;
+				m_stencil    = _draw.m_stencil;
+				++viewStats.numStateChanges;
+			}
+
+			update(viewStats, _program, _bind);
+
+			if (isValid(_program) )
+			{
+				ProgramStats& programStats = program(_program);
+				++programStats.numDraw;
+				programStats.numPrims += _numPrims;
+			}
+		}
+
+		void compute(ViewId _view, ProgramHandle _program, const RenderCompute& _compute, const RenderBind& _bind)
+		{
+			ViewCostStats& viewStats = view(_view);
+			++viewStats.numCompute;
+			viewStats.uniformBytes += _compute.m_uniformEnd - _compute.m_uniformBegin;
+
+			update(viewStats, _program, _bind);
+
+			if (isValid(_program) )
+			{
+				++program(_program).numCompute;
+			}
+		}
+
+	private:
+		ViewCostStats& view(ViewId _view)
+		{
+			if (NULL == m_viewStats
+			||  m_viewStats->view != _view)
+			{
+				// Views are contiguous only when render items are sorted, fold repeated views into
+				// single entry otherwise.
+				uint16_t& idx = m_viewStatsIdx[_view];
+				if (UINT16_MAX == idx)
+				{
+					BASE_ASSERT(m_numViews < BASE_COUNTOF(m_frame->m_viewCostStats)
+						, "View cost stats overflow (max: %d)."
+						, BASE_COUNTOF(m_frame->m_viewCostStats)
+						);
+
+					idx = m_numViews++;
+
+					ViewCostStats& viewStats = m_frame->m_viewCostStats[idx];
+					base::memSet(&viewStats, 0, sizeof(ViewCostStats) );
+					viewStats.view = _view;
+				}
+
+				m_viewStats = &m_frame->m_viewCostStats[idx];
+
+				// Renderers reset their cached state on view change, do the same here.
+				m_stateFlags  = 0;
+				m_stencil     = 0;
+				m_program.idx = kInvalidHandle;
+				base::memSet(&m_bind, 0, sizeof(m_bind) );
+				m_bind.clear();
+			}
+
+			return *m_viewStats;
+		}
+
+		ProgramStats& program(ProgramHandle _program)
+		{
+			uint16_t& idx = m_frame->m_programStatsIdx[_program.idx];
+			if (UINT16_MAX == idx)
+			{
+				idx = m_numPrograms++;
+
+				ProgramStats& programStats = m_frame->m_programStats[idx];
+				base::memSet(&programStats, 0, sizeof(ProgramStats) );
+				programStats.program = _program;
+			}
+
+			return m_frame->m_programStats[idx];
+		}
+
+		void update(ViewCostStats& _viewStats, ProgramHandle _program, const RenderBind& _bind)
+		{
+			if (m_program.idx != _program.idx)
+			{
+				m_program = _program;
+				++_viewStats.numProgramChanges;
+			}
+
+			for (uint32_t stage = 0; stage < GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& bind = _bind.m_bind[stage];
+				Binding& current    = m_bind.m_bind[stage];
+
+				if (current.m_idx          != bind.m_idx
+				||  current.m_type         != bind.m_type
+				||  current.m_samplerFlags != bind.m_samplerFlags
+				||  current.m_mip          != bind.m_mip)
+				{
+					current = bind;
+					++_viewStats.numBindChanges;
+				}
+			}
+		}
+
+		Frame*         m_frame;
+		ViewCostStats* m_viewStats;
+		RenderBind     m_bind;
+		uint64_t       m_stateFlags;
+		uint64_t       m_stencil;
+		ProgramHandle  m_program;
+		uint16_t       m_viewStatsIdx[GRAPHICS_CONFIG_MAX_VIEWS];
+		uint16_t       m_numViews;
+		uint16_t       m_numPrograms;
+	};
+
 } // namespace graphics
 
 #endif // GRAPHICS_RENDERER_H_HEADER_GUARD
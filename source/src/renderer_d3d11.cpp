@@ -1222,6 +1222,7 @@ namespace graphics { namespace d3d11
 					| GRAPHICS_CAPS_SWAP_CHAIN
 					| GRAPHICS_CAPS_DRAW_INDIRECT
 					| GRAPHICS_CAPS_TEXTURE_BLIT
+					| GRAPHICS_CAPS_TEXTURE_MIN_MIP
 					| GRAPHICS_CAPS_TEXTURE_READ_BACK
 					| ( (m_featureLevel >= D3D_FEATURE_LEVEL_9_2)
 						? GRAPHICS_CAPS_OCCLUSION_QUERY
@@ -2093,6 +2094,16 @@ namespace graphics { namespace d3d11
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			TextureD3D11& texture = m_textures[_handle.idx];
+
+			if (NULL != texture.m_ptr)
+			{
+				m_deviceCtx->SetResourceMinLOD(texture.m_ptr, float(_mip) );
+			}
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -5595,21 +5606,9 @@ namespace graphics { namespace d3d11
 			frameQueryIdx = m_gpuTimer.begin(GRAPHICS_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
-		}
-
-		_render->sort();
+		const auto updateTransient = [](BufferD3D11& _buffer, uint32_t _size, void* _data) { _buffer.update(0, _size, _data, true); };
+		updateTransientPages(m_indexBuffers,  _render->m_transientIb, updateTransient);
+		updateTransientPages(m_vertexBuffers, _render->m_transientVb, updateTransient);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -5662,6 +5661,8 @@ namespace graphics { namespace d3d11
 			, m_timerQuerySupport
 			);
 
+		CostStats costStats(_render);
+
 		m_occlusionQuery.resolve(_render);
 
 		if (0 == (_render->m_debug&GRAPHICS_DEBUG_IFH) )
@@ -5757,6 +5758,7 @@ namespace graphics { namespace d3d11
 					}
 
 					const RenderCompute& compute = renderItem.compute;
+					costStats.compute(view, key.m_program, compute, renderBind);
 
 					bool programChanged = false;
 					bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
@@ -6444,6 +6446,8 @@ namespace graphics { namespace d3d11
 					statsNumInstances[primIndex]      += numInstances;
 					statsNumDrawIndirect[primIndex]   += numDrawIndirect;
 					statsNumIndices                   += numIndices;
+
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
 				}
 			}
 
@@ -6620,8 +6624,8 @@ namespace graphics { namespace d3d11
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " Occlusion queries: %3d ", m_occlusionQuery.m_control.available() );
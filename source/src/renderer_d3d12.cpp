@@ -1349,6 +1349,7 @@ namespace graphics { namespace d3d12
 					| (m_directAccessSupport   ? GRAPHICS_CAPS_TEXTURE_DIRECT_ACCESS : 0)
 					| (BASE_ENABLED(BASE_PLATFORM_WINDOWS) ? GRAPHICS_CAPS_SWAP_CHAIN : 0)
 					| GRAPHICS_CAPS_TEXTURE_BLIT
+					| GRAPHICS_CAPS_TEXTURE_MIN_MIP
 					| GRAPHICS_CAPS_TEXTURE_READ_BACK
 					| GRAPHICS_CAPS_OCCLUSION_QUERY
 					| GRAPHICS_CAPS_ALPHA_TO_COVERAGE
@@ -2124,6 +2125,23 @@ namespace graphics { namespace d3d12
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Shader resource view is created from m_srvd every time texture is bound.
+			D3D12_SHADER_RESOURCE_VIEW_DESC& srvd = m_textures[_handle.idx].m_srvd;
+			const float minLod = float(_mip);
+
+			switch (srvd.ViewDimension)
+			{
+			case D3D12_SRV_DIMENSION_TEXTURE2D:        srvd.Texture2D.ResourceMinLODClamp        = minLod; break;
+			case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:   srvd.Texture2DArray.ResourceMinLODClamp   = minLod; break;
+			case D3D12_SRV_DIMENSION_TEXTURE3D:        srvd.Texture3D.ResourceMinLODClamp        = minLod; break;
+			case D3D12_SRV_DIMENSION_TEXTURECUBE:      srvd.TextureCube.ResourceMinLODClamp      = minLod; break;
+			case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY: srvd.TextureCubeArray.ResourceMinLODClamp = minLod; break;
+			default: break;
+			}
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -6349,21 +6367,10 @@ namespace graphics { namespace d3d12
 
 		uint32_t frameQueryIdx = m_gpuTimer.begin(GRAPHICS_CONFIG_MAX_VIEWS, _render->m_frameNum);
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
-		}
-
-		_render->sort();
+		ID3D12GraphicsCommandList* commandList = m_commandList;
+		const auto updateTransient = [commandList](BufferD3D12& _buffer, uint32_t _size, void* _data) { _buffer.update(commandList, 0, _size, _data); };
+		updateTransientPages(m_indexBuffers,  _render->m_transientIb, updateTransient);
+		updateTransientPages(m_vertexBuffers, _render->m_transientVb, updateTransient);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -6417,6 +6424,8 @@ namespace graphics { namespace d3d12
 			, s_viewName
 			);
 
+		CostStats costStats(_render);
+
 #if BASE_PLATFORM_WINDOWS
 		if (NULL != m_swapChain)
 		{
@@ -6580,6 +6589,7 @@ namespace graphics { namespace d3d12
 					}
 
 					const RenderCompute& compute = renderItem.compute;
+					costStats.compute(view, key.m_program, compute, renderBind);
 
 					ID3D12PipelineState* pso = getPipelineState(key.m_program);
 					if (pso != currentPso)
@@ -7130,6 +7140,8 @@ namespace graphics { namespace d3d12
 					statsNumInstances[primIndex]      += draw.m_numInstances;
 					statsNumIndices                   += numIndices;
 
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
+
 					if (hasOcclusionQuery)
 					{
 						m_occlusionQuery.begin(m_commandList, _render, draw.m_occlusionQuery);
@@ -7372,8 +7384,8 @@ namespace graphics { namespace d3d12
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " State cache:                        ");
@@ -1353,6 +1353,12 @@ namespace graphics { namespace d3d9
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Not supported, GRAPHICS_CAPS_TEXTURE_MIN_MIP is not set.
+			BASE_UNUSED(_handle, _mip);
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			BASE_UNUSED(_handle, _name, _len)
@@ -3770,21 +3776,8 @@ namespace graphics { namespace d3d9
 			frameQueryIdx = m_gpuTimer.begin(GRAPHICS_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
-		}
-
-		_render->sort();
+		updateTransientPages(m_indexBuffers,  _render->m_transientIb, [](IndexBufferD3D9&  _buffer, uint32_t _size, void* _data) { _buffer.update(0, _size, _data, true); });
+		updateTransientPages(m_vertexBuffers, _render->m_transientVb, [](VertexBufferD3D9& _buffer, uint32_t _size, void* _data) { _buffer.update(0, _size, _data, true); });
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -3832,6 +3825,8 @@ namespace graphics { namespace d3d9
 			, m_timerQuerySupport
 			);
 
+		CostStats costStats(_render);
+
 		if (m_occlusionQuerySupport)
 		{
 			m_occlusionQuery.resolve(_render);
@@ -4403,6 +4398,8 @@ namespace graphics { namespace d3d9
 					statsNumPrimsRendered[primIndex]  += numPrimsRendered;
 					statsNumInstances[primIndex]      += numInstances;
 					statsNumIndices += numIndices;
+
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
 				}
 			}
 
@@ -4544,8 +4541,8 @@ namespace graphics { namespace d3d9
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " Occlusion queries: %3d ", m_occlusionQuery.m_control.available() );
@@ -546,6 +546,7 @@ namespace graphics { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
@@ -573,15 +574,18 @@ namespace graphics { namespace gl
 			ARB_multisample,
 			ARB_occlusion_query,
 			ARB_occlusion_query2,
+			ARB_parallel_shader_compile,
 			ARB_program_interface_query,
 			ARB_provoking_vertex,
 			ARB_sampler_objects,
 			ARB_seamless_cube_map,
 			ARB_shader_bit_encoding,
+			ARB_shader_draw_parameters,
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
 			ARB_shader_viewport_layer_array,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -610,6 +614,7 @@ namespace graphics { namespace gl
 			EXT_blend_color,
 			EXT_blend_minmax,
 			EXT_blend_subtract,
+			EXT_buffer_storage,
 			EXT_color_buffer_half_float,
 			EXT_color_buffer_float,
 			EXT_copy_image,
@@ -668,6 +673,7 @@ namespace graphics { namespace gl
 
 			KHR_debug,
 			KHR_no_error,
+			KHR_parallel_shader_compile,
 
 			MOZ_WEBGL_compressed_texture_s3tc,
 			MOZ_WEBGL_depth_texture,
@@ -764,6 +770,7 @@ namespace graphics { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       GRAPHICS_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         GRAPHICS_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       GRAPHICS_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   GRAPHICS_CONFIG_RENDERER_OPENGL >= 42, true  },
@@ -791,15 +798,18 @@ namespace graphics { namespace gl
 		{ "ARB_multisample",                          false,                             true  },
 		{ "ARB_occlusion_query",                      GRAPHICS_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_occlusion_query2",                     GRAPHICS_CONFIG_RENDERER_OPENGL >= 33, true  },
+		{ "ARB_parallel_shader_compile",              false,                             true  },
 		{ "ARB_program_interface_query",              GRAPHICS_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_provoking_vertex",                     GRAPHICS_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_sampler_objects",                      GRAPHICS_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_seamless_cube_map",                    GRAPHICS_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_shader_bit_encoding",                  GRAPHICS_CONFIG_RENDERER_OPENGL >= 33, true  },
+		{ "ARB_shader_draw_parameters",               GRAPHICS_CONFIG_RENDERER_OPENGL >= 46, true  },
 		{ "ARB_shader_image_load_store",              GRAPHICS_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         GRAPHICS_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   GRAPHICS_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_shader_viewport_layer_array",          false,                             true  },
+		{ "ARB_sync",                                 GRAPHICS_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             GRAPHICS_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             GRAPHICS_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               GRAPHICS_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -828,6 +838,7 @@ namespace graphics { namespace gl
 		{ "EXT_blend_color",                          GRAPHICS_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "EXT_blend_minmax",                         GRAPHICS_CONFIG_RENDERER_OPENGL >= 14, true  },
 		{ "EXT_blend_subtract",                       GRAPHICS_CONFIG_RENDERER_OPENGL >= 14, true  },
+		{ "EXT_buffer_storage",                       false,                             true  }, // GLES3.1 extension.
 		{ "EXT_color_buffer_half_float",              false,                             true  }, // GLES2 extension.
 		{ "EXT_color_buffer_float",                   false,                             true  }, // GLES2 extension.
 		{ "EXT_copy_image",                           false,                             true  }, // GLES2 extension.
@@ -886,6 +897,7 @@ namespace graphics { namespace gl
 
 		{ "KHR_debug",                                GRAPHICS_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "KHR_no_error",                             false,                             true  },
+		{ "KHR_parallel_shader_compile",              false,                             true  },
 
 		{ "MOZ_WEBGL_compressed_texture_s3tc",        false,                             true  },
 		{ "MOZ_WEBGL_depth_texture",                  false,                             true  },
@@ -2202,6 +2214,28 @@ namespace graphics { namespace gl
 		{ "ARM",                          GRAPHICS_PCI_ID_ARM    },
 	};
 
+	// Uniforms packed into std140 uniform block are addressed by location with kUniformBlockLoc
+	// bit set, shader stage (0 - vertex, 1 - fragment) in bit 24, and byte offset within block in
+	// low 24 bits.
+	static constexpr uint32_t kUniformBlockLoc = UINT32_C(0x80000000);
+
+	static const char* s_uniformBlockName[] =
+	{
+		"graphics_VsUniforms.",
+		"graphics_FsUniforms.",
+	};
+	static constexpr int32_t kUniformBlockNameLen = 20;
+
+	inline uint32_t toUniformBlockLoc(uint8_t _stage, uint32_t _offset)
+	{
+		return kUniformBlockLoc | (uint32_t(_stage) << 24) | _offset;
+	}
+
+	inline bool isUniformBlockLoc(uint32_t _loc)
+	{
+		return kUniformBlockLoc == (_loc & UINT32_C(0xfe000000) );
+	}
+
 	struct Workaround
 	{
 		void reset()
@@ -2235,6 +2269,12 @@ namespace graphics { namespace gl
 			, m_textureSwizzleSupport(false)
 			, m_depthTextureSupport(false)
 			, m_timerQuerySupport(false)
+			, m_persistentMapSupport(false)
+			, m_uniformBufferSupport(false)
+			, m_multiDrawSupport(false)
+			, m_drawIdSupport(false)
+			, m_readbackRingSupport(false)
+			, m_parallelShaderCompileSupport(false)
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
@@ -2245,8 +2285,15 @@ namespace graphics { namespace gl
 			, m_msaaBlitProgram(0)
 			, m_clearQuadColor(GRAPHICS_INVALID_HANDLE)
 			, m_clearQuadDepth(GRAPHICS_INVALID_HANDLE)
+			, m_numPendingPrograms(0)
+			, m_multiDrawRingPos(0)
+			, m_uniformRingPos(0)
+			, m_uniformRingAlign(16)
+			, m_numUniformCalls(0)
 		{
 			base::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			base::memSet(m_uniformDirty, 0, sizeof(m_uniformDirty) );
+			base::memSet(m_uniformScratch, 0, sizeof(m_uniformScratch) );
 		}
 
 		~RendererContextGL()
@@ -2837,6 +2884,22 @@ namespace graphics { namespace gl
 					|| s_extension[Extension::EXT_multi_draw_indirect].m_supported
 					;
 
+				// Coalescing draw calls requires native multi-draw, stub issues one draw per command
+				// and gl_DrawID would be always 0.
+				m_multiDrawSupport = true
+					&& BASE_ENABLED(GRAPHICS_GL_CONFIG_MULTI_DRAW)
+					&& (s_extension[Extension::AMD_multi_draw_indirect].m_supported
+					||  s_extension[Extension::ARB_multi_draw_indirect].m_supported
+					||  s_extension[Extension::EXT_multi_draw_indirect].m_supported)
+					&& NULL != glMultiDrawArraysIndirect
+					&& NULL != glMultiDrawElementsIndirect
+					;
+
+				m_drawIdSupport = true
+					&& BASE_ENABLED(GRAPHICS_CONFIG_RENDERER_OPENGL)
+					&& s_extension[Extension::ARB_shader_draw_parameters].m_supported
+					;
+
 				if (drawIndirectSupported)
 				{
 					if (NULL == glMultiDrawArraysIndirect
@@ -2881,6 +2944,11 @@ namespace graphics { namespace gl
 					: 0
 					;
 
+				g_caps.supported |= BASE_ENABLED(GRAPHICS_CONFIG_RENDERER_OPENGL) || m_gles3
+					? GRAPHICS_CAPS_TEXTURE_MIN_MIP
+					: 0
+					;
+
 				g_caps.supported |= false
 					|| s_extension[Extension::EXT_texture_array].m_supported
 					|| s_extension[Extension::EXT_gpu_shader4].m_supported
@@ -2986,6 +3054,76 @@ namespace graphics { namespace gl
 					&& NULL != glGetQueryObjectui64v
 					;
 
+#if GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+				const bool bufferStorageSupport = true
+					&& (s_extension[Extension::ARB_buffer_storage].m_supported
+					||  s_extension[Extension::EXT_buffer_storage].m_supported)
+					&& NULL != glBufferStorage
+					&& NULL != glMapBufferRange
+					&& NULL != glUnmapBuffer
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					;
+
+				m_persistentMapSupport = true
+					&& BASE_ENABLED(GRAPHICS_GL_CONFIG_PERSISTENT_MAP)
+					&& bufferStorageSupport
+					;
+
+				m_multiDrawSupport &= bufferStorageSupport;
+
+				m_uniformBufferSupport = true
+					&& BASE_ENABLED(GRAPHICS_GL_CONFIG_UNIFORM_BUFFER)
+					&& 0 != (_init.capabilities & GRAPHICS_CAPS_UNIFORM_BUFFER)
+					&& bufferStorageSupport
+					&& (BASE_ENABLED(GRAPHICS_CONFIG_RENDERER_OPENGL >= 31) || m_gles3)
+					&& (s_extension[Extension::ARB_uniform_buffer_object].m_supported || m_gles3)
+					&& NULL != glBindBufferRange
+					&& NULL != glGetUniformBlockIndex
+					&& NULL != glUniformBlockBinding
+					&& NULL != glGetActiveUniformBlockiv
+					&& NULL != glGetActiveUniformsiv
+					;
+
+				if (m_uniformBufferSupport)
+				{
+					m_uniformRingAlign = base::max<uint32_t>(16, glGet(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT) );
+				}
+#endif // GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+				m_readbackRingSupport = true
+					&& (m_readBackSupported || BASE_ENABLED(GRAPHICS_GL_CONFIG_TEXTURE_READ_BACK_EMULATION) )
+					&& (BASE_ENABLED(GRAPHICS_CONFIG_RENDERER_OPENGL) || m_gles3)
+					&& NULL != glMapBufferRange
+					&& NULL != glUnmapBuffer
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					;
+
+				if (m_readbackRingSupport)
+				{
+					// Texture read back is copied to destination at the end of frame after one
+					// it was issued in.
+					g_caps.limits.readTextureLatency += 1;
+				}
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+
+				m_parallelShaderCompileSupport = true
+					&& BASE_ENABLED(GRAPHICS_CONFIG_PARALLEL_SHADER_COMPILE)
+					&& (s_extension[Extension::KHR_parallel_shader_compile].m_supported
+					||  s_extension[Extension::ARB_parallel_shader_compile].m_supported)
+					;
+
+				if (m_parallelShaderCompileSupport
+				&&  NULL != glMaxShaderCompilerThreadsKHR)
+				{
+					// 0xffffffff lets implementation pick number of compiler threads.
+					GL_CHECK(glMaxShaderCompilerThreadsKHR(0xffffffff) );
+				}
+
 				m_occlusionQuerySupport = false
 					|| s_extension[Extension::ARB_occlusion_query        ].m_supported
 					|| s_extension[Extension::ARB_occlusion_query2       ].m_supported
@@ -3175,6 +3313,17 @@ namespace graphics { namespace gl
 					m_occlusionQuery.create();
 				}
 
+				if (m_uniformBufferSupport)
+				{
+					m_uniformBufferSupport = m_uniformRing.create(GL_UNIFORM_BUFFER, GRAPHICS_GL_CONFIG_UNIFORM_BUFFER_SIZE);
+					g_caps.supported |= m_uniformBufferSupport ? GRAPHICS_CAPS_UNIFORM_BUFFER : 0;
+				}
+
+				if (m_multiDrawSupport)
+				{
+					m_multiDrawSupport = m_multiDrawRing.create(GL_DRAW_INDIRECT_BUFFER, GRAPHICS_GL_CONFIG_MULTI_DRAW_BUFFER_SIZE);
+				}
+
 				// Init reserved part of view name.
 				for (uint32_t ii = 0; ii < GRAPHICS_CONFIG_MAX_VIEWS; ++ii)
 				{
@@ -3222,6 +3371,24 @@ namespace graphics { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			if (m_uniformBufferSupport)
+			{
+				m_uniformRing.destroy();
+				m_uniformBufferSupport = false;
+			}
+
+			if (m_multiDrawSupport)
+			{
+				m_multiDrawRing.destroy();
+				m_multiDrawSupport = false;
+			}
+
+			if (m_readbackRingSupport)
+			{
+				m_readbackRing.shutdown();
+				m_readbackRingSupport = false;
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -3350,7 +3517,34 @@ namespace graphics { namespace gl
 		void createProgram(ProgramHandle _handle, ShaderHandle _vsh, ShaderHandle _fsh) override
 		{
 			ShaderGL dummyFragmentShader;
-			m_program[_handle.idx].create(m_shaders[_vsh.idx], isValid(_fsh) ? m_shaders[_fsh.idx] : dummyFragmentShader);
+			ProgramGL& program = m_program[_handle.idx];
+
+			const bool deferLink = true
+				&& m_parallelShaderCompileSupport
+				&& m_numPendingPrograms < BASE_COUNTOF(m_pendingProgram)
+				;
+
+			program.create(m_shaders[_vsh.idx], isValid(_fsh) ? m_shaders[_fsh.idx] : dummyFragmentShader, deferLink);
+
+			if (program.m_linkPending)
+			{
+				m_pendingProgram[m_numPendingPrograms++] = _handle;
+			}
+		}
+
+		void finishPendingPrograms()
+		{
+			for (uint16_t ii = 0, num = m_numPendingPrograms; ii < num; ++ii)
+			{
+				ProgramGL& program = m_program[m_pendingProgram[ii].idx];
+
+				if (program.m_linkPending)
+				{
+					program.finish();
+				}
+			}
+
+			m_numPendingPrograms = 0;
 		}
 
 		void destroyProgram(ProgramHandle _handle) override
@@ -3379,6 +3573,68 @@ namespace graphics { namespace gl
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
+			// Emulated read back skips formats it can't read, ring would copy stale buffer instead.
+			if (m_readbackRingSupport
+			&& (m_readBackSupported || isReadPixelsSupported(m_textures[_handle.idx]) ) )
+			{
+				if (m_readbackRing.isFull() )
+				{
+					// All pixel pack buffers are in flight, wait for oldest one.
+					m_readbackRing.flush();
+				}
+
+				// With pixel pack buffer bound, destination pointer is offset into buffer.
+				m_readbackRing.begin(getReadTextureSize(m_textures[_handle.idx], _mip) );
+				readTextureImage(_handle, NULL, _mip);
+				m_readbackRing.end(_data);
+			}
+			else
+			{
+				readTextureImage(_handle, _data, _mip);
+			}
+		}
+
+		// glReadPixels always reads RGBA8, so emulated read back is limited to color formats with at
+		// least 32 bits per pixel, otherwise it would write past end of destination.
+		static bool isReadPixelsSupported(const TextureGL& _texture)
+		{
+			const bimg::TextureFormat::Enum format = bimg::TextureFormat::Enum(_texture.m_textureFormat);
+
+			return !bimg::isCompressed(format)
+				&& !bimg::isDepth(format)
+				&& 32 <= bimg::getBitsPerPixel(format)
+				;
+		}
+
+		uint32_t getReadTextureSize(const TextureGL& _texture, uint8_t _mip) const
+		{
+			const uint32_t width  = base::max<uint32_t>(1, _texture.m_width  >> _mip);
+			const uint32_t height = base::max<uint32_t>(1, _texture.m_height >> _mip);
+
+			if (!m_readBackSupported)
+			{
+				// Emulated read back reads first layer of mip with glReadPixels.
+				return width*height*4;
+			}
+
+			// glGetTexImage reads all layers of mip, rows are tightly packed.
+			return bimg::imageGetSize(
+				  NULL
+				, uint16_t(width)
+				, uint16_t(height)
+				, uint16_t(base::max<uint32_t>(1, _texture.m_depth >> _mip) )
+				, false
+				, false
+				, uint16_t(base::max<uint32_t>(1, _texture.m_numLayers) )
+				, bimg::TextureFormat::Enum(_texture.m_textureFormat)
+				);
+		}
+
+		void readTextureImage(TextureHandle _handle, void* _data, uint8_t _mip)
+		{
+			// Destination and pixel pack buffer are sized for tightly packed rows.
+			GL_CHECK(glPixelStorei(GL_PACK_ALIGNMENT, 1) );
+
 			if (m_readBackSupported)
 			{
 				const TextureGL& texture = m_textures[_handle.idx];
@@ -3408,12 +3664,11 @@ namespace graphics { namespace gl
 			else if (BASE_ENABLED(GRAPHICS_GL_CONFIG_TEXTURE_READ_BACK_EMULATION) )
 			{
 				const TextureGL& texture = m_textures[_handle.idx];
-				const bool compressed    = bimg::isCompressed(bimg::TextureFormat::Enum(texture.m_textureFormat) );
 
-				if (!compressed)
+				if (isReadPixelsSupported(texture) )
 				{
 					Attachment at[1];
-					at[0].init(_handle);
+					at[0].init(_handle, Access::Write, 0, 1, _mip);
 
 					FrameBufferGL frameBuffer;
 					frameBuffer.create(BASE_COUNTOF(at), at);
@@ -3436,8 +3691,8 @@ namespace graphics { namespace gl
 						GL_CHECK(glReadPixels(
 							  0
 							, 0
-							, texture.m_width
-							, texture.m_height
+							, base::max<uint32_t>(1, texture.m_width  >> _mip)
+							, base::max<uint32_t>(1, texture.m_height >> _mip)
 							, m_readPixelsFmt
 							, GL_UNSIGNED_BYTE
 							, _data
@@ -3649,11 +3904,18 @@ namespace graphics { namespace gl
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			m_textures[_handle.idx].setMinMip(_mip);
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 		void blitSetup(TextVideoMemBlitter& _blitter) override
 		{
+			finishPendingPrograms();
+
 			if (0 != m_vao)
 			{
 				GL_CHECK(glBindVertexArray(m_vao) );
@@ -3680,10 +3942,10 @@ namespace graphics { namespace gl
 			float proj[16];
 			base::mtxOrtho(proj, 0.0f, (float)width, (float)height, 0.0f, 0.0f, 1000.0f, 0.0f, g_caps.homogeneousDepth);
 
-			setUniformMatrix4fv(program.m_predefined[0].m_loc
-				, 1
-				, GL_FALSE
+			setShaderUniform4x4f(0
+				, program.m_predefined[0].m_loc
 				, proj
+				, 1
 				);
 
 			GL_CHECK(glActiveTexture(GL_TEXTURE0) );
@@ -3714,6 +3976,8 @@ namespace graphics { namespace gl
 				program.bindAttributes(_blitter.m_layout, 0);
 				program.bindAttributesEnd();
 
+				commitUniformBlocks(program);
+
 				GL_CHECK(glDrawElements(GL_TRIANGLES
 					, _numIndices
 					, GL_UNSIGNED_SHORT
@@ -3778,6 +4042,12 @@ namespace graphics { namespace gl
 
 		void setShaderUniform4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (isUniformBlockLoc(_regIndex) )
+			{
+				writeUniformBlock(_regIndex, _val, _numRegs*16);
+				return;
+			}
+
 			setUniform4fv(_regIndex
 				, _numRegs
 				, (const GLfloat*)_val
@@ -3786,6 +4056,12 @@ namespace graphics { namespace gl
 
 		void setShaderUniform4x4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (isUniformBlockLoc(_regIndex) )
+			{
+				writeUniformBlock(_regIndex, _val, _numRegs*64);
+				return;
+			}
+
 			setUniformMatrix4fv(_regIndex
 				, _numRegs
 				, GL_FALSE
@@ -3793,6 +4069,79 @@ namespace graphics { namespace gl
 				);
 		}
 
+		void writeUniformBlock(uint32_t _loc, const void* _data, uint32_t _size)
+		{
+			const uint8_t  stage  = uint8_t( (_loc >> 24) & 1);
+			const uint32_t offset = _loc & UINT32_C(0x00ffffff);
+			BASE_ASSERT(offset + _size <= GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE, "Uniform block overflow.");
+
+			uint8_t* dst = &m_uniformScratch[stage][offset];
+			if (0 != base::memCmp(dst, _data, _size) )
+			{
+				base::memCopy(dst, _data, _size);
+				m_uniformDirty[stage] = true;
+			}
+		}
+
+		void writeUniformBlockMtx3(uint32_t _loc, const float* _data, uint32_t _num)
+		{
+			// std140 stores mat3 as 3 vec4 columns.
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				float col[12];
+				for (uint32_t jj = 0; jj < 3; ++jj)
+				{
+					col[jj*4+0] = _data[ii*9 + jj*3 + 0];
+					col[jj*4+1] = _data[ii*9 + jj*3 + 1];
+					col[jj*4+2] = _data[ii*9 + jj*3 + 2];
+					col[jj*4+3] = 0.0f;
+				}
+
+				writeUniformBlock(_loc + ii*sizeof(col), col, sizeof(col) );
+			}
+		}
+
+		/// Copy dirty uniform blocks of current program into persistently mapped uniform ring, and
+		/// bind them. Must be called before each draw/dispatch.
+		void commitUniformBlocks(const ProgramGL& _program)
+		{
+			if (!m_uniformBufferSupport)
+			{
+				return;
+			}
+
+			for (uint8_t stage = 0; stage < 2; ++stage)
+			{
+				const uint32_t size = _program.m_uniformBlockSize[stage];
+				if (0 == size
+				||  !m_uniformDirty[stage])
+				{
+					continue;
+				}
+
+				const uint32_t alignedSize = base::strideAlign(size, m_uniformRingAlign);
+				if (m_uniformRingPos + alignedSize > GRAPHICS_GL_CONFIG_UNIFORM_BUFFER_SIZE)
+				{
+					m_uniformRing.next();
+					m_uniformRingPos = 0;
+				}
+
+				const uint32_t slot = m_uniformRing.m_slot;
+				base::memCopy(&m_uniformRing.m_data[slot][m_uniformRingPos], m_uniformScratch[stage], size);
+
+				GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER
+					, stage
+					, m_uniformRing.m_id[slot]
+					, m_uniformRingPos
+					, size
+					) );
+
+				m_uniformRingPos += alignedSize;
+				m_uniformDirty[stage] = false;
+				++m_numUniformCalls;
+			}
+		}
+
 		uint32_t setFrameBuffer(FrameBufferHandle _fbh, uint32_t _height, uint16_t _discard = GRAPHICS_CLEAR_NONE, bool _msaa = true)
 		{
 			if (isValid(m_fbh)
@@ -4419,6 +4768,19 @@ namespace graphics { namespace gl
 
 				uint32_t loc = _uniformBuffer.read();
 
+				if (isUniformBlockLoc(loc) )
+				{
+					switch (type)
+					{
+					case UniformType::Vec4: writeUniformBlock(loc, data, num*16);                  break;
+					case UniformType::Mat3: writeUniformBlockMtx3(loc, (const float*)data, num); break;
+					case UniformType::Mat4: writeUniformBlock(loc, data, num*64);                  break;
+					default: break;
+					}
+
+					continue;
+				}
+
 				switch (type)
 				{
 #if BASE_PLATFORM_EMSCRIPTEN
@@ -4632,6 +4994,7 @@ namespace graphics { namespace gl
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
 
 				commit(*program.m_constantBuffer);
+				commitUniformBlocks(program);
 
 				GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP
 					, 0
@@ -4642,6 +5005,8 @@ namespace graphics { namespace gl
 
 		void setProgram(GLuint program)
 		{
+			m_uniformDirty[0] = true;
+			m_uniformDirty[1] = true;
 			m_uniformStateCache.saveCurrentProgram(program);
 			GL_CHECK(glUseProgram(program) );
 		}
@@ -4652,6 +5017,7 @@ namespace graphics { namespace gl
 		{
 			if (m_uniformStateCache.updateUniformCache(loc, value) )
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniform1i(loc, value) );
 			}
 		}
@@ -4668,6 +5034,7 @@ namespace graphics { namespace gl
 			}
 			if (changed)
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniform1iv(loc, num, data) );
 			}
 		}
@@ -4677,6 +5044,7 @@ namespace graphics { namespace gl
 			UniformStateCache::f4 f; f.val[0] = x; f.val[1] = y; f.val[2] = z; f.val[3] = w;
 			if (m_uniformStateCache.updateUniformCache(loc, f) )
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniform4f(loc, x, y, z, w) );
 			}
 		}
@@ -4693,6 +5061,7 @@ namespace graphics { namespace gl
 			}
 			if (changed)
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniform4fv(loc, num, data) );
 			}
 		}
@@ -4709,6 +5078,7 @@ namespace graphics { namespace gl
 			}
 			if (changed)
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniformMatrix3fv(loc, num, transpose, data) );
 			}
 		}
@@ -4725,6 +5095,7 @@ namespace graphics { namespace gl
 			}
 			if (changed)
 			{
+				++m_numUniformCalls;
 				GL_CHECK(glUniformMatrix4fv(loc, num, transpose, data) );
 			}
 		}
@@ -4775,6 +5146,12 @@ namespace graphics { namespace gl
 		bool m_textureSwizzleSupport;
 		bool m_depthTextureSupport;
 		bool m_timerQuerySupport;
+		bool m_persistentMapSupport;
+		bool m_uniformBufferSupport;
+		bool m_multiDrawSupport;
+		bool m_drawIdSupport;
+		bool m_readbackRingSupport;
+		bool m_parallelShaderCompileSupport;
 		bool m_occlusionQuerySupport;
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
@@ -4797,6 +5174,21 @@ namespace graphics { namespace gl
 		UniformHandle m_clearQuadColor;
 		UniformHandle m_clearQuadDepth;
 
+		ProgramHandle m_pendingProgram[GRAPHICS_CONFIG_MAX_PROGRAMS];
+		uint16_t m_numPendingPrograms;
+
+		PersistentBufferGL m_multiDrawRing;
+		uint32_t m_multiDrawRingPos;
+
+		ReadbackRingGL m_readbackRing;
+
+		PersistentBufferGL m_uniformRing;
+		uint32_t m_uniformRingPos;
+		uint32_t m_uniformRingAlign;
+		uint32_t m_numUniformCalls;
+		bool     m_uniformDirty[2];
+		uint8_t  m_uniformScratch[2][GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE];
+
 		const char* m_vendor;
 		const char* m_renderer;
 		const char* m_version;
@@ -5006,67 +5398,112 @@ namespace graphics { namespace gl
 		return UniformType::End;
 	}
 
-	void ProgramGL::create(const ShaderGL& _vsh, const ShaderGL& _fsh)
+	void ProgramGL::create(const ShaderGL& _vsh, const ShaderGL& _fsh, bool _deferLink)
 	{
 		m_id = glCreateProgram();
 		BASE_TRACE("Program create: GL%d: GL%d, GL%d", m_id, _vsh.m_id, _fsh.m_id);
 
-		const uint64_t id = (uint64_t(_vsh.m_hash)<<32) | _fsh.m_hash;
-		const bool cached = s_renderGL->programFetchFromCache(m_id, id);
+		m_vsh     = _vsh.m_id;
+		m_fsh     = _fsh.m_id;
+		m_cacheId = (uint64_t(_vsh.m_hash)<<32) | _fsh.m_hash;
+
+		const bool cached = s_renderGL->programFetchFromCache(m_id, m_cacheId);
 
-		if (!cached)
+		if (cached)
 		{
-			GLint linked = 0;
-			if (0 != _vsh.m_id)
+			init();
+			return;
+		}
+
+		if (0 != m_vsh)
+		{
+			GL_CHECK(glAttachShader(m_id, m_vsh) );
+
+			if (0 != m_fsh)
 			{
-				GL_CHECK(glAttachShader(m_id, _vsh.m_id) );
+				GL_CHECK(glAttachShader(m_id, m_fsh) );
+			}
 
-				if (0 != _fsh.m_id)
-				{
-					GL_CHECK(glAttachShader(m_id, _fsh.m_id) );
-				}
+			GL_CHECK(glLinkProgram(m_id) );
+		}
 
-				GL_CHECK(glLinkProgram(m_id) );
-				GL_CHECK(glGetProgramiv(m_id, GL_LINK_STATUS, &linked) );
+		m_linkPending = true;
 
-				if (0 == linked)
-				{
-					char log[1024];
-					GL_CHECK(glGetProgramInfoLog(m_id, sizeof(log), NULL, log) );
-					BASE_TRACE("%d: %s", linked, log);
-				}
-			}
+		if (!_deferLink)
+		{
+			finish();
+		}
+	}
+
+	void ProgramGL::finish()
+	{
+		BASE_ASSERT(m_linkPending, "Program link is not pending.");
+		m_linkPending = false;
+
+		GLint linked = 0;
+		if (0 != m_vsh)
+		{
+			// Blocks until driver is done with compile and link.
+			GL_CHECK(glGetProgramiv(m_id, GL_LINK_STATUS, &linked) );
 
 			if (0 == linked)
 			{
-				BASE_WARN(0 != _vsh.m_id, "Invalid vertex/compute shader.");
-				GL_CHECK(glDeleteProgram(m_id) );
-				m_usedCount = 0;
-				m_id = 0;
-				return;
+				char log[1024];
+				GL_CHECK(glGetProgramInfoLog(m_id, sizeof(log), NULL, log) );
+				BASE_TRACE("%d: %s", linked, log);
+
+				const GLuint shaders[] = { m_vsh, m_fsh };
+				for (uint32_t ii = 0; ii < BASE_COUNTOF(shaders); ++ii)
+				{
+					GLint compiled = 1;
+					if (0 != shaders[ii])
+					{
+						GL_CHECK(glGetShaderiv(shaders[ii], GL_COMPILE_STATUS, &compiled) );
+					}
+
+					if (0 == compiled)
+					{
+						GL_CHECK(glGetShaderInfoLog(shaders[ii], sizeof(log), NULL, log) );
+						GL_CHECK(glDeleteProgram(m_id) );
+						m_usedCount = 0;
+						m_id = 0;
+						GRAPHICS_FATAL(false, graphics::Fatal::InvalidShader, "Failed to compile shader. %d: %s", compiled, log);
+						return;
+					}
+				}
 			}
+		}
 
-			s_renderGL->programCache(m_id, id);
+		if (0 == linked)
+		{
+			BASE_WARN(0 != m_vsh, "Invalid vertex/compute shader.");
+			GL_CHECK(glDeleteProgram(m_id) );
+			m_usedCount = 0;
+			m_id = 0;
+			return;
 		}
 
+		s_renderGL->programCache(m_id, m_cacheId);
+
 		init();
 
-		if (!cached
-		&&  s_renderGL->m_workaround.m_detachShader)
+		if (s_renderGL->m_workaround.m_detachShader)
 		{
 			// Must be after init, otherwise init might fail to lookup shader
 			// info (NVIDIA Tegra 3 OpenGL ES 2.0 14.01003).
-			GL_CHECK(glDetachShader(m_id, _vsh.m_id) );
+			GL_CHECK(glDetachShader(m_id, m_vsh) );
 
-			if (0 != _fsh.m_id)
+			if (0 != m_fsh)
 			{
-				GL_CHECK(glDetachShader(m_id, _fsh.m_id) );
+				GL_CHECK(glDetachShader(m_id, m_fsh) );
 			}
 		}
 	}
 
 	void ProgramGL::destroy()
 	{
+		m_linkPending = false;
+
 		if (NULL != m_constantBuffer)
 		{
 			UniformBuffer::destroy(m_constantBuffer);
@@ -5154,6 +5591,9 @@ namespace graphics { namespace gl
 
 		m_numPredefined = 0;
 		m_numSamplers = 0;
+		m_drawModelNum = 0;
+		m_numDrawModel = 0;
+		m_perDrawPredefined = false;
 
 		BASE_TRACE("Uniforms (%d):", activeUniforms);
 		for (int32_t ii = 0; ii < activeUniforms; ++ii)
@@ -5201,6 +5641,28 @@ namespace graphics { namespace gl
 				loc = glGetUniformLocation(m_id, name);
 			}
 
+#if GRAPHICS_GL_CONFIG_UNIFORM_BUFFER
+			if (s_renderGL->m_uniformBufferSupport)
+			{
+				const uint8_t stage = 0 == base::strCmp(name, s_uniformBlockName[0], kUniformBlockNameLen) ? 0
+					: 0 == base::strCmp(name, s_uniformBlockName[1], kUniformBlockNameLen) ? 1
+					: UINT8_MAX
+					;
+
+				if (UINT8_MAX != stage)
+				{
+					// Member of uniform block generated by ShaderGL::create, strip block name and
+					// address it by its offset within block.
+					GLuint index = GLuint(ii);
+					GLint blockOffset = 0;
+					GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_OFFSET, &blockOffset) );
+
+					loc = GLint(toUniformBlockLoc(stage, uint32_t(blockOffset) ) );
+					base::memMove(name, &name[kUniformBlockNameLen], base::strLen(&name[kUniformBlockNameLen])+1);
+				}
+			}
+#endif // GRAPHICS_GL_CONFIG_UNIFORM_BUFFER
+
 			num = base::uint32_max(num, 1);
 
 			int32_t offset = 0;
@@ -5273,12 +5735,31 @@ namespace graphics { namespace gl
 			}
 
 			PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
-			if (PredefinedUniform::Count != predefined)
+			if (0 == base::strCmp(name, "u_drawModel") )
+			{
+				if (m_numDrawModel < BASE_COUNTOF(m_drawModel) )
+				{
+					m_drawModelNum = 0 == m_numDrawModel
+						? uint16_t(num)
+						: base::min<uint16_t>(m_drawModelNum, uint16_t(num) )
+						;
+					m_drawModel[m_numDrawModel] = loc;
+					m_numDrawModel++;
+				}
+			}
+			else if (PredefinedUniform::Count != predefined
+			&&  m_numPredefined < BASE_COUNTOF(m_predefined) )
 			{
 				m_predefined[m_numPredefined].m_loc   = loc;
 				m_predefined[m_numPredefined].m_count = uint16_t(num);
 				m_predefined[m_numPredefined].m_type  = uint8_t(predefined);
 				m_numPredefined++;
+
+				m_perDrawPredefined |= false
+					|| PredefinedUniform::Model         == predefined
+					|| PredefinedUniform::ModelView     == predefined
+					|| PredefinedUniform::ModelViewProj == predefined
+					;
 			}
 			else
 			{
@@ -5315,6 +5796,32 @@ namespace graphics { namespace gl
 			m_constantBuffer->finish();
 		}
 
+		m_uniformBlockSize[0] = 0;
+		m_uniformBlockSize[1] = 0;
+
+#if GRAPHICS_GL_CONFIG_UNIFORM_BUFFER
+		if (s_renderGL->m_uniformBufferSupport)
+		{
+			for (uint8_t stage = 0; stage < 2; ++stage)
+			{
+				// Block name without trailing '.'.
+				char blockName[kUniformBlockNameLen];
+				base::strCopy(blockName, kUniformBlockNameLen, s_uniformBlockName[stage]);
+
+				const GLuint index = glGetUniformBlockIndex(m_id, blockName);
+				if (GL_INVALID_INDEX != index)
+				{
+					GLint size = 0;
+					GL_CHECK(glUniformBlockBinding(m_id, index, stage) );
+					GL_CHECK(glGetActiveUniformBlockiv(m_id, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size) );
+					m_uniformBlockSize[stage] = uint32_t(size);
+
+					BASE_TRACE("\tuniform block %s size %d, binding %d", blockName, size, stage);
+				}
+			}
+		}
+#endif // GRAPHICS_GL_CONFIG_UNIFORM_BUFFER
+
 		if (piqSupported)
 		{
 			struct VariableInfo
@@ -5468,39 +5975,263 @@ namespace graphics { namespace gl
 			}
 		}
 
-		applyLazyEnabledVertexAttributes();
+		applyLazyEnabledVertexAttributes();
+	}
+
+	void ProgramGL::unbindAttributes()
+	{
+		for(uint32_t ii = 0, iiEnd = m_usedCount; ii < iiEnd; ++ii)
+		{
+			if (Attrib::Count == m_unboundUsedAttrib[ii])
+			{
+				Attrib::Enum attr = Attrib::Enum(m_used[ii]);
+				GLint loc = m_attributes[attr];
+				lazyDisableVertexAttribArray(loc);
+			}
+		}
+	}
+
+	void ProgramGL::unbindInstanceData() const
+	{
+		for(uint32_t ii = 0; -1 != m_instanceData[ii]; ++ii)
+		{
+			GLint loc = m_instanceData[ii];
+			lazyDisableVertexAttribArray(loc);
+		}
+	}
+
+	bool PersistentBufferGL::create(GLenum _target, uint32_t _size)
+	{
+		m_target = _target;
+		m_slot   = 0;
+		base::memSet(m_data,  0, sizeof(m_data) );
+		base::memSet(m_fence, 0, sizeof(m_fence) );
+
+#if GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
+
+		GL_CHECK(glGenBuffers(BASE_COUNTOF(m_id), m_id) );
+
+		bool mapped = true;
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_id); ++ii)
+		{
+			GL_CHECK(glBindBuffer(_target, m_id[ii]) );
+			GL_CHECK(glBufferStorage(_target, _size, NULL, flags) );
+			m_data[ii] = (uint8_t*)glMapBufferRange(_target, 0, _size, flags);
+			mapped &= NULL != m_data[ii];
+		}
+
+		GL_CHECK(glBindBuffer(_target, 0) );
+
+		if (!mapped)
+		{
+			destroy();
+		}
+
+		return mapped;
+#else
+		BASE_UNUSED(_size);
+		return false;
+#endif // GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+	}
+
+	void PersistentBufferGL::destroy()
+	{
+#if GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_id); ++ii)
+		{
+			if (NULL != m_fence[ii])
+			{
+				GL_CHECK(glDeleteSync(m_fence[ii]) );
+				m_fence[ii] = NULL;
+			}
+
+			if (NULL != m_data[ii])
+			{
+				GL_CHECK(glBindBuffer(m_target, m_id[ii]) );
+				GL_CHECK(glUnmapBuffer(m_target) );
+				m_data[ii] = NULL;
+			}
+		}
+
+		GL_CHECK(glBindBuffer(m_target, 0) );
+		GL_CHECK(glDeleteBuffers(BASE_COUNTOF(m_id), m_id) );
+#endif // GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+	}
+
+	void PersistentBufferGL::next()
+	{
+#if GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+		m_fence[m_slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_slot = (m_slot + 1) % BASE_COUNTOF(m_id);
+
+		if (NULL != m_fence[m_slot])
+		{
+			GRAPHICS_PROFILER_SCOPE("graphics/Wait transient buffer", kColorResource);
+			GL_CHECK(glClientWaitSync(m_fence[m_slot], GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX) );
+			GL_CHECK(glDeleteSync(m_fence[m_slot]) );
+			m_fence[m_slot] = NULL;
+		}
+#endif // GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+	}
+
+	void ReadbackRingGL::shutdown()
+	{
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		// Pending read backs are dropped, destination memory might not be valid anymore.
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_request); ++ii)
+		{
+			Request& request = m_request[ii];
+
+			if (NULL != request.m_fence)
+			{
+				GL_CHECK(glDeleteSync(request.m_fence) );
+			}
+
+			if (0 != request.m_id)
+			{
+				GL_CHECK(glDeleteBuffers(1, &request.m_id) );
+			}
+		}
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+
+		base::memSet(m_request, 0, sizeof(m_request) );
+		m_read = 0;
+		m_num  = 0;
+	}
+
+	void ReadbackRingGL::begin(uint32_t _size)
+	{
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		BASE_ASSERT(!isFull(), "Texture read back ring is full.");
+
+		Request& request = m_request[(m_read + m_num) % BASE_COUNTOF(m_request)];
+
+		if (0 == request.m_id)
+		{
+			GL_CHECK(glGenBuffers(1, &request.m_id) );
+		}
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, request.m_id) );
+
+		if (request.m_capacity < _size)
+		{
+			GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, _size, NULL, GL_STREAM_READ) );
+			request.m_capacity = _size;
+		}
+
+		request.m_size = _size;
+#else
+		BASE_UNUSED(_size);
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+	}
+
+	void ReadbackRingGL::end(void* _data)
+	{
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		Request& request = m_request[(m_read + m_num) % BASE_COUNTOF(m_request)];
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		request.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		request.m_frame = m_frame;
+		request.m_data  = _data;
+
+		++m_num;
+#else
+		BASE_UNUSED(_data);
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+	}
+
+	void ReadbackRingGL::update()
+	{
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		while (0 < m_num)
+		{
+			const Request& request = m_request[m_read];
+
+			// Requests are in submission order, stop at first one still in flight, unless it's
+			// from previous frame.
+			const GLuint64 timeout = request.m_frame < m_frame ? UINT64_MAX : 0;
+			const GLenum   status  = glClientWaitSync(request.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+
+			if (GL_TIMEOUT_EXPIRED == status)
+			{
+				break;
+			}
+
+			pop();
+		}
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+
+		++m_frame;
 	}
 
-	void ProgramGL::unbindAttributes()
+	void ReadbackRingGL::flush()
 	{
-		for(uint32_t ii = 0, iiEnd = m_usedCount; ii < iiEnd; ++ii)
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		if (0 < m_num)
 		{
-			if (Attrib::Count == m_unboundUsedAttrib[ii])
-			{
-				Attrib::Enum attr = Attrib::Enum(m_used[ii]);
-				GLint loc = m_attributes[attr];
-				lazyDisableVertexAttribArray(loc);
-			}
+			GRAPHICS_PROFILER_SCOPE("graphics/Wait texture read back", kColorResource);
+			GL_CHECK(glClientWaitSync(m_request[m_read].m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX) );
+			pop();
 		}
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
 	}
 
-	void ProgramGL::unbindInstanceData() const
+	void ReadbackRingGL::pop()
 	{
-		for(uint32_t ii = 0; -1 != m_instanceData[ii]; ++ii)
+#if GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+		Request& request = m_request[m_read];
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, request.m_id) );
+
+		const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, request.m_size, GL_MAP_READ_BIT);
+		if (NULL != data)
 		{
-			GLint loc = m_instanceData[ii];
-			lazyDisableVertexAttribArray(loc);
+			base::memCopy(request.m_data, data, request.m_size);
+			GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
 		}
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		GL_CHECK(glDeleteSync(request.m_fence) );
+		request.m_fence = NULL;
+		request.m_data  = NULL;
+
+		m_read = (m_read + 1) % BASE_COUNTOF(m_request);
+		--m_num;
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
 	}
 
 	void IndexBufferGL::destroy()
 	{
+		if (NULL != m_persistent)
+		{
+			m_persistent->destroy();
+			base::deleteObject(g_allocator, m_persistent);
+			m_persistent = NULL;
+			return;
+		}
+
 		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
 		GL_CHECK(glDeleteBuffers(1, &m_id) );
 	}
 
 	void VertexBufferGL::destroy()
 	{
+		if (NULL != m_persistent)
+		{
+			m_persistent->destroy();
+			base::deleteObject(g_allocator, m_persistent);
+			m_persistent = NULL;
+			return;
+		}
+
 		GL_CHECK(glBindBuffer(m_target, 0) );
 		GL_CHECK(glDeleteBuffers(1, &m_id) );
 	}
@@ -5938,6 +6669,16 @@ namespace graphics { namespace gl
 		m_id = (GLuint)_ptr;
 	}
 
+	void TextureGL::setMinMip(uint8_t _mip)
+	{
+		// Base level is texture state, sampler objects don't override it.
+		if (0 != m_id)
+		{
+			GL_CHECK(glBindTexture(m_target, m_id) );
+			GL_CHECK(glTexParameteri(m_target, GL_TEXTURE_BASE_LEVEL, _mip) );
+		}
+	}
+
 	void TextureGL::update(uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
 	{
 		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
@@ -6197,6 +6938,167 @@ namespace graphics { namespace gl
 		base::memCopy(_str, _insert, len);
 	}
 
+	/// Parse `uniform [precision] vec4|mat3|mat4 name[num];` declaration.
+	///
+	/// @returns std140 size of declaration in bytes, 0 if line is not declaration that can be packed
+	///   into uniform block.
+	///
+	static uint32_t parseUniformBlockMember(const base::StringView& _line, base::StringView& _decl, base::StringView& _name)
+	{
+		base::StringView parse = base::strLTrimSpace(_line);
+		base::StringView word  = base::strWord(parse);
+		if (0 != base::strCmp(word, "uniform") )
+		{
+			return 0;
+		}
+
+		parse = base::strLTrimSpace(base::StringView(word.getTerm(), parse.getTerm() ) );
+		const char* declPtr = parse.getPtr();
+
+		word = base::strWord(parse);
+		if (0 == base::strCmp(word, "lowp")
+		||  0 == base::strCmp(word, "mediump")
+		||  0 == base::strCmp(word, "highp") )
+		{
+			parse = base::strLTrimSpace(base::StringView(word.getTerm(), parse.getTerm() ) );
+			word  = base::strWord(parse);
+		}
+
+		const uint32_t size = 0 == base::strCmp(word, "vec4") ? 16
+			: 0 == base::strCmp(word, "mat3") ? 48
+			: 0 == base::strCmp(word, "mat4") ? 64
+			: 0
+			;
+
+		if (0 == size)
+		{
+			return 0;
+		}
+
+		parse = base::strLTrimSpace(base::StringView(word.getTerm(), parse.getTerm() ) );
+		_name = base::strWord(parse);
+		if (_name.isEmpty() )
+		{
+			return 0;
+		}
+
+		parse = base::strLTrimSpace(base::StringView(_name.getTerm(), parse.getTerm() ) );
+
+		uint32_t num = 1;
+		if (!parse.isEmpty()
+		&&  '[' == *parse.getPtr() )
+		{
+			const base::StringView end = base::strFind(parse, ']');
+			if (end.isEmpty()
+			||  !base::fromString(&num, base::StringView(parse.getPtr()+1, end.getPtr() ) ) )
+			{
+				return 0;
+			}
+
+			parse = base::strLTrimSpace(base::StringView(end.getTerm(), parse.getTerm() ) );
+		}
+
+		if (parse.isEmpty()
+		||  ';' != *parse.getPtr() )
+		{
+			return 0;
+		}
+
+		_decl = base::StringView(declPtr, parse.getPtr()+1);
+
+		return size*num;
+	}
+
+	/// Move vec4/mat3/mat4 uniforms of vertex or fragment shader into std140 uniform block, and
+	/// redirect uses of them to block instance, so that all of them are updated with single
+	/// glBindBufferRange call instead of glUniform* call per uniform.
+	///
+	/// @returns `false` and doesn't write anything if shader has no uniforms that can be packed,
+	///   or they don't fit into GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE.
+	///
+	static bool writeUniformBlockCode(base::WriterI* _writer, const base::StringView& _code, uint8_t _stage, base::Error* _err)
+	{
+		uint32_t size = 0;
+
+		for (base::StringView parse = _code; !parse.isEmpty();)
+		{
+			const base::StringView eol = base::strFindEol(parse);
+
+			base::StringView decl;
+			base::StringView name;
+			size += parseUniformBlockMember(base::StringView(parse.getPtr(), eol.getPtr() ), decl, name);
+
+			parse = base::strFindNl(base::StringView(eol.getPtr(), parse.getTerm() ) );
+		}
+
+		if (0 == size
+		||  GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE < size)
+		{
+			return false;
+		}
+
+		const char* instanceName = 0 == _stage ? "graphics_vs" : "graphics_fs";
+		bool blockWritten = false;
+
+		for (base::StringView parse = _code; !parse.isEmpty();)
+		{
+			const base::StringView eol  = base::strFindEol(parse);
+			const base::StringView next = base::strFindNl(base::StringView(eol.getPtr(), parse.getTerm() ) );
+
+			base::StringView decl;
+			base::StringView name;
+			if (0 == parseUniformBlockMember(base::StringView(parse.getPtr(), eol.getPtr() ), decl, name) )
+			{
+				base::write(_writer, base::StringView(parse.getPtr(), next.getPtr() ), _err);
+			}
+			else if (!blockWritten)
+			{
+				// Whole block is declared in place of first packed uniform, remaining declarations
+				// are dropped.
+				blockWritten = true;
+
+				base::write(_writer, _err
+					, "layout(std140) uniform %.*s\n{\n"
+					, kUniformBlockNameLen-1
+					, s_uniformBlockName[_stage]
+					);
+
+				for (base::StringView member = parse; !member.isEmpty();)
+				{
+					const base::StringView memberEol = base::strFindEol(member);
+					if (0 != parseUniformBlockMember(base::StringView(member.getPtr(), memberEol.getPtr() ), decl, name) )
+					{
+						base::write(_writer, _err, "\t%.*s\n", decl.getLength(), decl.getPtr() );
+					}
+
+					member = base::strFindNl(base::StringView(memberEol.getPtr(), member.getTerm() ) );
+				}
+
+				base::write(_writer, _err, "} %s;\n", instanceName);
+
+				for (base::StringView member = parse; !member.isEmpty();)
+				{
+					const base::StringView memberEol = base::strFindEol(member);
+					if (0 != parseUniformBlockMember(base::StringView(member.getPtr(), memberEol.getPtr() ), decl, name) )
+					{
+						base::write(_writer, _err
+							, "#define %.*s %s.%.*s\n"
+							, name.getLength(), name.getPtr()
+							, instanceName
+							, name.getLength(), name.getPtr()
+							);
+					}
+
+					member = base::strFindNl(base::StringView(memberEol.getPtr(), member.getTerm() ) );
+				}
+			}
+
+			parse = next;
+		}
+
+		return true;
+	}
+
 	void ShaderGL::create(const Memory* _mem)
 	{
 		base::MemoryReader reader(_mem->data, _mem->size);
@@ -6289,7 +7191,7 @@ namespace graphics { namespace gl
 			if (GL_COMPUTE_SHADER != m_type
 			&&  0 != base::strCmp(code, "#version", 8) ) // #2000
 			{
-				int32_t tempLen = code.getLength() + (4<<10);
+				int32_t tempLen = code.getLength() + (16<<10);
 				char* temp = (char*)alloca(tempLen);
 				base::StaticMemoryBlockWriter writer(temp, tempLen);
 
@@ -6700,6 +7602,17 @@ namespace graphics { namespace gl
 						base::write(&writer, "#version 140\n", &err);
 					}
 
+					if (m_type == GL_VERTEX_SHADER
+					&&  s_renderGL->m_drawIdSupport
+					&&  !base::findIdentifierMatch(code, "gl_DrawID").isEmpty() )
+					{
+						base::write(&writer
+							, "#extension GL_ARB_shader_draw_parameters : enable\n"
+							  "#define gl_DrawID gl_DrawIDARB\n"
+							, &err
+							);
+					}
+
 					base::write(&writer
 						, "#define texture2DLod    textureLod\n"
 						  "#define texture3DLod    textureLod\n"
@@ -6815,7 +7728,12 @@ namespace graphics { namespace gl
 							);
 					}
 
-					base::write(&writer, code.getPtr(), code.getLength(), &err);
+					if (!s_renderGL->m_uniformBufferSupport
+					||  !writeUniformBlockCode(&writer, code, GL_VERTEX_SHADER == m_type ? 0 : 1, &err) )
+					{
+						base::write(&writer, code.getPtr(), code.getLength(), &err);
+					}
+
 					base::write(&writer, '\0', &err);
 				}
 
@@ -6857,6 +7775,14 @@ namespace graphics { namespace gl
 
 			GL_CHECK(glCompileShader(m_id) );
 
+			// With parallel shader compile, querying compile status here would
+			// stall until compile is done. Status is checked when program link
+			// is finished instead.
+			if (s_renderGL->m_parallelShaderCompileSupport)
+			{
+				return;
+			}
+
 			GLint compiled = 0;
 			GL_CHECK(glGetShaderiv(m_id, GL_COMPILE_STATUS, &compiled) );
 
@@ -7426,6 +8352,131 @@ namespace graphics { namespace gl
 		}
 	}
 
+	// Replace transient page buffer with persistently mapped ring, see `updatePersistentTransientPages`.
+	template<typename BufferGL>
+	static bool createPersistentBuffer(BufferGL& _buffer, GLenum _target)
+	{
+		PersistentBufferGL* persistent = BASE_NEW(g_allocator, PersistentBufferGL);
+
+		if (!persistent->create(_target, _buffer.m_size) )
+		{
+			base::deleteObject(g_allocator, persistent);
+			return false;
+		}
+
+		GL_CHECK(glDeleteBuffers(1, &_buffer.m_id) );
+		_buffer.m_persistent = persistent;
+		_buffer.m_id         = persistent->m_id[persistent->m_slot];
+
+		return true;
+	}
+
+	static bool isMultiDrawable(const RenderDraw& _draw, const PrimInfo& _prim)
+	{
+		return true
+			&& !isValid(_draw.m_indirectBuffer)
+			&& !isValid(_draw.m_occlusionQuery)
+			&& 0 != _draw.m_streamMask
+			&& UINT8_MAX != _draw.m_streamMask
+			&& (isValid(_draw.m_indexBuffer)
+				? UINT32_MAX == _draw.m_numIndices || _prim.m_min <= _draw.m_numIndices
+				: UINT32_MAX != _draw.m_numVertices)
+			;
+	}
+
+	// Returns start vertex of draw call relative to first draw call in multi-draw run, or -1 when
+	// vertex streams can't be shared.
+	static int32_t multiDrawBaseVertex(const RenderDraw& _first, const RenderDraw& _draw)
+	{
+		int32_t baseVertex = -1;
+
+		for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = base::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const Stream& first  = _first.m_stream[idx];
+			const Stream& stream = _draw.m_stream[idx];
+
+			const int32_t delta = int32_t(stream.m_startVertex - first.m_startVertex);
+			if (first.m_handle.idx       != stream.m_handle.idx
+			||  first.m_layoutHandle.idx != stream.m_layoutHandle.idx
+			||  stream.m_startVertex     <  first.m_startVertex
+			|| (-1 != baseVertex && delta != baseVertex) )
+			{
+				return -1;
+			}
+
+			baseVertex = delta;
+		}
+
+		return baseVertex;
+	}
+
+	// Draw call can be coalesced into multi-draw run started by first draw call when it differs
+	// only by draw range, and when per-draw data of program is either the same or addressed with
+	// gl_DrawID.
+	static bool isMultiDrawMergeable(
+		  const ProgramGL& _program
+		, const PrimInfo& _prim
+		, const RenderDraw& _first
+		, const RenderBind& _firstBind
+		, const RenderDraw& _draw
+		, const RenderBind& _bind
+		)
+	{
+		if (!isMultiDrawable(_draw, _prim)
+		||  _draw.m_uniformBegin       != _draw.m_uniformEnd
+		||  _first.m_stateFlags        != _draw.m_stateFlags
+		||  _first.m_stencil           != _draw.m_stencil
+		||  _first.m_rgba              != _draw.m_rgba
+		||  _first.m_scissor           != _draw.m_scissor
+		||  _first.m_submitFlags       != _draw.m_submitFlags
+		||  _first.m_streamMask        != _draw.m_streamMask
+		||  _first.m_indexBuffer.idx   != _draw.m_indexBuffer.idx
+		||  _first.m_instanceDataBuffer.idx != _draw.m_instanceDataBuffer.idx
+		||  _first.m_instanceDataOffset     != _draw.m_instanceDataOffset
+		||  _first.m_instanceDataStride     != _draw.m_instanceDataStride
+		||  0 > multiDrawBaseVertex(_first, _draw) )
+		{
+			return false;
+		}
+
+		if (_program.m_perDrawPredefined
+		&& (_first.m_startMatrix != _draw.m_startMatrix
+		||  _first.m_numMatrices != _draw.m_numMatrices) )
+		{
+			return false;
+		}
+
+		for (uint32_t stage = 0; stage < GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const Binding& first = _firstBind.m_bind[stage];
+			const Binding& bind  = _bind.m_bind[stage];
+
+			if (first.m_idx != bind.m_idx)
+			{
+				return false;
+			}
+
+			if (kInvalidHandle != bind.m_idx
+			&& (first.m_type         != bind.m_type
+			||  first.m_samplerFlags != bind.m_samplerFlags
+			||  first.m_format       != bind.m_format
+			||  first.m_access       != bind.m_access
+			||  first.m_mip          != bind.m_mip) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	void RendererContextGL::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		if (_render->m_capture)
@@ -7435,6 +8486,10 @@ namespace graphics { namespace gl
 
 		m_glctx.makeCurrent(NULL);
 
+		// Programs created since last frame were linking on driver threads while
+		// the rest of resource commands were processed. Collect link results now.
+		finishPendingPrograms();
+
 		GRAPHICS_GL_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
 
 		if (1 < m_numWindows
@@ -7460,6 +8515,8 @@ namespace graphics { namespace gl
 		int64_t timeBegin = base::getHPCounter();
 		int64_t captureElapsed = 0;
 
+		m_numUniformCalls = 0;
+
 		uint32_t frameQueryIdx = UINT32_MAX;
 
 		if (m_timerQuerySupport)
@@ -7467,21 +8524,14 @@ namespace graphics { namespace gl
 			frameQueryIdx = m_gpuTimer.begin(GRAPHICS_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
-		}
-
-		_render->sort();
+		updatePersistentTransientPages(m_indexBuffers, _render->m_transientIb, m_persistentMapSupport
+			, [](IndexBufferGL& _buffer) { return createPersistentBuffer(_buffer, GL_ELEMENT_ARRAY_BUFFER); }
+			, [](IndexBufferGL& _buffer, uint32_t _size, void* _data) { _buffer.update(0, _size, _data, true); }
+			);
+		updatePersistentTransientPages(m_vertexBuffers, _render->m_transientVb, m_persistentMapSupport
+			, [](VertexBufferGL& _buffer) { return createPersistentBuffer(_buffer, GL_ARRAY_BUFFER); }
+			, [](VertexBufferGL& _buffer, uint32_t _size, void* _data) { _buffer.update(0, _size, _data, true); }
+			);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -7536,6 +8586,8 @@ namespace graphics { namespace gl
 		uint32_t statsNumInstances[BASE_COUNTOF(s_primInfo)] = {};
 		uint32_t statsNumIndices = 0;
 		uint32_t statsKeyType[2] = {};
+		uint32_t statsNumMultiDraws = 0;
+		uint32_t statsNumMultiDrawBatches = 0;
 
 		Profiler<TimerQueryGL> profiler(
 			  _render
@@ -7544,6 +8596,8 @@ namespace graphics { namespace gl
 			, m_timerQuerySupport
 			);
 
+		CostStats costStats(_render);
+
 		if (m_occlusionQuerySupport)
 		{
 			m_occlusionQuery.resolve(_render);
@@ -7639,6 +8693,7 @@ namespace graphics { namespace gl
 					if (computeSupported)
 					{
 						const RenderCompute& compute = renderItem.compute;
+						costStats.compute(view, key.m_program, compute, renderBind);
 
 						ProgramGL& program = m_program[key.m_program.idx];
 						setProgram(program.m_id);
@@ -8157,6 +9212,7 @@ namespace graphics { namespace gl
 					}
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
+					commitUniformBlocks(program);
 
 					{
 						GLbitfield barrier = 0;
@@ -8454,7 +9510,170 @@ namespace graphics { namespace gl
 								}
 							}
 
-							if (isValid(draw.m_indexBuffer) )
+							// Look ahead for following draw calls that can be coalesced with this one.
+							uint32_t numMultiDraw = 1;
+
+							if (m_multiDrawSupport
+							&&  !hasOcclusionQuery
+							&&  isMultiDrawable(draw, prim) )
+							{
+								const uint32_t maxMultiDraw = 0 != program.m_numDrawModel
+									? base::min<uint32_t>(GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX, program.m_drawModelNum)
+									: GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX
+									;
+
+								SortKey nextKey;
+
+								for (int32_t next = item
+									; next < numItems && numMultiDraw < maxMultiDraw
+									; ++next, ++numMultiDraw
+									)
+								{
+									if (nextKey.decode(_render->m_sortKeys[next], _render->m_viewRemap)
+									||  nextKey.m_view        != key.m_view
+									||  nextKey.m_program.idx != key.m_program.idx)
+									{
+										break;
+									}
+
+									const uint32_t nextIdx = _render->m_sortValues[next];
+									if (!isMultiDrawMergeable(program
+										, prim
+										, draw
+										, renderBind
+										, _render->m_renderItem[nextIdx].draw
+										, _render->m_renderItemBind[nextIdx]
+										) )
+									{
+										break;
+									}
+								}
+							}
+
+							if (0 != program.m_numDrawModel)
+							{
+								// Program opted into per-draw data, it reads model matrix of each
+								// draw call in run from u_drawModel[gl_DrawID].
+								float drawModel[GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX*16];
+								const uint32_t numDrawModel = base::min<uint32_t>(numMultiDraw, program.m_drawModelNum);
+
+								for (uint32_t ii = 0; ii < numDrawModel; ++ii)
+								{
+									const RenderDraw& mdraw = 0 == ii
+										? draw
+										: _render->m_renderItem[_render->m_sortValues[item+ii-1] ].draw
+										;
+									base::memCopy(&drawModel[ii*16], _render->m_frameCache.m_matrixCache.m_cache[mdraw.m_startMatrix].un.val, 64);
+								}
+
+								for (uint32_t ii = 0; ii < program.m_numDrawModel; ++ii)
+								{
+									setShaderUniform4x4f(0, program.m_drawModel[ii], drawModel, numDrawModel);
+								}
+
+								commitUniformBlocks(program);
+							}
+
+							if (1 < numMultiDraw)
+							{
+								const bool isIndexed = isValid(draw.m_indexBuffer);
+								const uint32_t cmdSize = (isIndexed ? 5 : 4) * sizeof(uint32_t);
+								const uint32_t size    = numMultiDraw*cmdSize;
+
+								if (m_multiDrawRingPos + size > GRAPHICS_GL_CONFIG_MULTI_DRAW_BUFFER_SIZE)
+								{
+									m_multiDrawRing.next();
+									m_multiDrawRingPos = 0;
+								}
+
+								const uint32_t slot = m_multiDrawRing.m_slot;
+								uint32_t* cmd = (uint32_t*)&m_multiDrawRing.m_data[slot][m_multiDrawRingPos];
+
+								const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
+								const uint32_t ibSize    = isIndexed ? m_indexBuffers[draw.m_indexBuffer.idx].m_size : 0;
+
+								for (uint32_t ii = 0; ii < numMultiDraw; ++ii)
+								{
+									const uint32_t mdrawIdx = 0 == ii ? itemIdx : _render->m_sortValues[item+ii-1];
+									const RenderDraw& mdraw = _render->m_renderItem[mdrawIdx].draw;
+									const uint32_t baseVertex = uint32_t(multiDrawBaseVertex(draw, mdraw) );
+
+									uint32_t count;
+									if (isIndexed)
+									{
+										const bool wholeBuffer = UINT32_MAX == mdraw.m_numIndices;
+										count  = wholeBuffer ? ibSize/indexSize : mdraw.m_numIndices;
+										cmd[0] = count;
+										cmd[1] = mdraw.m_numInstances;
+										cmd[2] = wholeBuffer ? 0 : mdraw.m_startIndex;
+										cmd[3] = baseVertex;
+										cmd[4] = 0;
+										cmd += 5;
+									}
+									else
+									{
+										count  = mdraw.m_numVertices;
+										cmd[0] = count;
+										cmd[1] = mdraw.m_numInstances;
+										cmd[2] = baseVertex;
+										cmd[3] = 0;
+										cmd += 4;
+									}
+
+									const uint32_t mdrawPrimsSubmitted = count/prim.m_div - prim.m_sub;
+									const uint32_t mdrawPrimsRendered  = mdrawPrimsSubmitted*mdraw.m_numInstances;
+
+									if (0 == ii)
+									{
+										numIndices        = isIndexed ? count : 0;
+										numPrimsSubmitted = mdrawPrimsSubmitted;
+										numInstances      = mdraw.m_numInstances;
+										numPrimsRendered  = mdrawPrimsRendered;
+									}
+									else
+									{
+										statsNumPrimsSubmitted[primIndex] += mdrawPrimsSubmitted;
+										statsNumPrimsRendered[primIndex]  += mdrawPrimsRendered;
+										statsNumInstances[primIndex]      += mdraw.m_numInstances;
+										statsNumIndices += isIndexed ? count : 0;
+										statsKeyType[0]++;
+
+										costStats.draw(view, currentProgram, mdraw, _render->m_renderItemBind[mdrawIdx], mdrawPrimsRendered);
+									}
+								}
+
+								// Indirect buffer binding is shared with application indirect
+								// buffers, force it to be rebound next time one is used.
+								currentState.m_indirectBuffer.idx = kInvalidHandle;
+								GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_multiDrawRing.m_id[slot]) );
+
+								const uintptr_t args = m_multiDrawRingPos;
+								m_multiDrawRingPos += size;
+
+								if (isIndexed)
+								{
+									GL_CHECK(glMultiDrawElementsIndirect(prim.m_type
+										, draw.isIndex16() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT
+										, (void*)args
+										, numMultiDraw
+										, cmdSize
+										) );
+								}
+								else
+								{
+									GL_CHECK(glMultiDrawArraysIndirect(prim.m_type
+										, (void*)args
+										, numMultiDraw
+										, cmdSize
+										) );
+								}
+
+								statsNumMultiDraws += numMultiDraw;
+								statsNumMultiDrawBatches++;
+
+								item += numMultiDraw-1;
+							}
+							else if (isValid(draw.m_indexBuffer) )
 							{
 								const IndexBufferGL& ib  = m_indexBuffers[draw.m_indexBuffer.idx];
 								const bool isIndex16     = draw.isIndex16();
@@ -8516,6 +9735,8 @@ namespace graphics { namespace gl
 						statsNumPrimsRendered[primIndex]  += numPrimsRendered;
 						statsNumInstances[primIndex]      += numInstances;
 						statsNumIndices += numIndices;
+
+						costStats.draw(view, currentProgram, draw, renderBind, numPrimsRendered);
 					}
 				}
 			}
@@ -8603,6 +9824,9 @@ namespace graphics { namespace gl
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.numBlit       = _render->m_numBlitItems;
+		perfStats.numUniformCalls = m_numUniformCalls;
+		perfStats.numMultiDraws       = statsNumMultiDraws;
+		perfStats.numMultiDrawBatches = statsNumMultiDrawBatches;
 		perfStats.maxGpuLatency = maxGpuLatency;
 		perfStats.gpuFrameNum   = result.m_frameNum;
 		base::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
@@ -8692,8 +9916,8 @@ namespace graphics { namespace gl
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " State cache:     ");
@@ -8799,6 +10023,26 @@ namespace graphics { namespace gl
 
 			GRAPHICS_GL_PROFILER_END();
 		}
+
+		nextTransientPages(m_indexBuffers,  _render->m_transientIb);
+		nextTransientPages(m_vertexBuffers, _render->m_transientVb);
+
+		if (m_uniformBufferSupport)
+		{
+			m_uniformRing.next();
+			m_uniformRingPos = 0;
+		}
+
+		if (m_multiDrawSupport)
+		{
+			m_multiDrawRing.next();
+			m_multiDrawRingPos = 0;
+		}
+
+		if (m_readbackRingSupport)
+		{
+			m_readbackRing.update();
+		}
 	}
 } } // namespace graphics
 
@@ -40,6 +40,61 @@
 #	define GRAPHICS_GL_CONFIG_TEXTURE_READ_BACK_EMULATION 0
 #endif // GRAPHICS_GL_CONFIG_TEXTURE_READ_BACK_EMULATION
 
+// Buffer storage and sync objects are not available with GLES2 headers or WebGL.
+#define GRAPHICS_GL_CONFIG_BUFFER_STORAGE (0                                  \
+	|| GRAPHICS_CONFIG_RENDERER_OPENGL                                        \
+	|| (GRAPHICS_CONFIG_RENDERER_OPENGLES >= 30 && !BASE_PLATFORM_EMSCRIPTEN) \
+	)
+
+// Persistently mapped transient buffers require buffer storage.
+#define GRAPHICS_GL_CONFIG_PERSISTENT_MAP (GRAPHICS_CONFIG_TRANSIENT_PERSISTENT_MAP && GRAPHICS_GL_CONFIG_BUFFER_STORAGE)
+
+// Pack uniforms into std140 uniform blocks backed by ring of persistently mapped uniform buffers,
+// instead of uploading each uniform with glUniform* call. Requires buffer storage. Used only when
+// driver supports uniform buffer objects, and GRAPHICS_CAPS_UNIFORM_BUFFER is not masked out by
+// Init::capabilities.
+#define GRAPHICS_GL_CONFIG_UNIFORM_BUFFER (GRAPHICS_CONFIG_UNIFORM_BUFFER && GRAPHICS_GL_CONFIG_BUFFER_STORAGE)
+
+// Size of each uniform buffer in ring, one per frame in flight.
+#ifndef GRAPHICS_GL_CONFIG_UNIFORM_BUFFER_SIZE
+#	define GRAPHICS_GL_CONFIG_UNIFORM_BUFFER_SIZE (4<<20)
+#endif // GRAPHICS_GL_CONFIG_UNIFORM_BUFFER_SIZE
+
+// Maximum size of vertex or fragment shader uniform block. Shaders with more uniform data keep
+// using glUniform* calls. GL guarantees at least 16KiB.
+#ifndef GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE
+#	define GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE (16<<10)
+#endif // GRAPHICS_GL_CONFIG_MAX_UNIFORM_BLOCK_SIZE
+
+// Coalesce runs of sorted draw calls that share program, state, vertex/index buffers and bindings,
+// and differ only by draw range, into single multi-draw indirect call. Draw commands are written
+// into ring of persistently mapped indirect buffers, which requires buffer storage.
+#define GRAPHICS_GL_CONFIG_MULTI_DRAW (GRAPHICS_CONFIG_MULTI_DRAW && GRAPHICS_GL_CONFIG_BUFFER_STORAGE)
+
+// Maximum number of draw calls coalesced into single multi-draw indirect call.
+#ifndef GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX
+#	define GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX 64
+#endif // GRAPHICS_GL_CONFIG_MULTI_DRAW_MAX
+
+// Size of each draw indirect buffer in ring, one per frame in flight.
+#ifndef GRAPHICS_GL_CONFIG_MULTI_DRAW_BUFFER_SIZE
+#	define GRAPHICS_GL_CONFIG_MULTI_DRAW_BUFFER_SIZE (256<<10)
+#endif // GRAPHICS_GL_CONFIG_MULTI_DRAW_BUFFER_SIZE
+
+// Read back textures into ring of pixel pack buffers, and copy to destination once fence is
+// signaled, instead of stalling pipeline in glGetTexImage/glReadPixels. Adds one frame to
+// Caps::Limits::readTextureLatency.
+#ifndef GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+#	define GRAPHICS_GL_CONFIG_ASYNC_READ_BACK GRAPHICS_GL_CONFIG_BUFFER_STORAGE
+#endif // GRAPHICS_GL_CONFIG_ASYNC_READ_BACK
+
+// In headless mode, when neither window nor display handle is set, create EGL display on Mesa
+// surfaceless or EGL device platform, and make context current without any surface. Otherwise
+// headless context is created with 1x1 pbuffer on default display, which requires display server.
+#ifndef GRAPHICS_GL_CONFIG_EGL_SURFACELESS
+#	define GRAPHICS_GL_CONFIG_EGL_SURFACELESS 1
+#endif // GRAPHICS_GL_CONFIG_EGL_SURFACELESS
+
 #define GRAPHICS_GL_PROFILER_BEGIN(_view, _abgr)                                               \
 	BASE_MACRO_BLOCK_BEGIN                                                                   \
 		GL_CHECK(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, s_viewName[view]) ); \
@@ -645,6 +700,10 @@ typedef uint64_t GLuint64;
 #	define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
 #endif // GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#	define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif // GL_COMPLETION_STATUS_KHR
+
 #ifndef GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE
 #	define GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE 0x93A0
 #endif // GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE
@@ -838,6 +897,10 @@ typedef uint64_t GLuint64;
 #	define GL_SAMPLER_2D_ARRAY_SHADOW 0x8DC4
 #endif // GL_SAMPLER_2D_ARRAY_SHADOW
 
+#ifndef GL_TEXTURE_BASE_LEVEL
+#	define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif // GL_TEXTURE_BASE_LEVEL
+
 #ifndef GL_TEXTURE_MAX_LEVEL
 #	define GL_TEXTURE_MAX_LEVEL 0x813D
 #endif // GL_TEXTURE_MAX_LEVEL
@@ -878,6 +941,26 @@ typedef uint64_t GLuint64;
 #	define GL_SHADER_STORAGE_BUFFER 0x90D2
 #endif // GL_SHADER_STORAGE_BUFFER
 
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_UNIFORM_BLOCK_DATA_SIZE
+#	define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#endif // GL_UNIFORM_BLOCK_DATA_SIZE
+
+#ifndef GL_UNIFORM_OFFSET
+#	define GL_UNIFORM_OFFSET 0x8A3B
+#endif // GL_UNIFORM_OFFSET
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
 #ifndef GL_IMAGE_1D
 #	define GL_IMAGE_1D 0x904C
 #endif // GL_IMAGE_1D
@@ -1129,6 +1212,26 @@ typedef uint64_t GLuint64;
 #	define GL_TEXTURE_LOD_BIAS 0x8501
 #endif // GL_TEXTURE_LOD_BIAS
 
+#ifndef GL_MAP_WRITE_BIT
+#	define GL_MAP_WRITE_BIT 0x0002
+#endif // GL_MAP_WRITE_BIT
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
 #if GRAPHICS_USE_EGL
 #	include "glcontext_egl.h"
 #elif GRAPHICS_USE_HTML5
@@ -1323,12 +1426,91 @@ namespace graphics { namespace gl
 		HashMap m_hashMap;
 	};
 
+	/// Ring of persistently mapped buffers, one per frame in flight. Used to back transient buffer
+	/// pages and packed uniform blocks. Data is written directly into mapped memory of current
+	/// slot, fence guards slot reuse.
+	struct PersistentBufferGL
+	{
+		bool create(GLenum _target, uint32_t _size);
+		void destroy();
+
+		/// Fence current slot, and move to next one waiting until GPU is done reading from it.
+		void next();
+
+		/// Move to next slot, and make buffer backed by this ring use it.
+		template<typename BufferT>
+		void next(BufferT& _buffer)
+		{
+			next();
+			_buffer.m_id = m_id[m_slot];
+		}
+
+		GLuint   m_id[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		uint8_t* m_data[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		GLsync   m_fence[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		GLenum   m_target;
+		uint32_t m_slot;
+	};
+
+	/// Ring of pixel pack buffers used for texture read back. Texture is read into buffer and
+	/// fenced, and buffer is copied to destination once fence is signaled, without waiting on GPU.
+	struct ReadbackRingGL
+	{
+		ReadbackRingGL()
+			: m_read(0)
+			, m_num(0)
+			, m_frame(0)
+		{
+			base::memSet(m_request, 0, sizeof(m_request) );
+		}
+
+		void shutdown();
+
+		bool isFull() const
+		{
+			return m_num == BASE_COUNTOF(m_request);
+		}
+
+		/// Bind pixel pack buffer of at least `_size` bytes. Texture read issued after this call
+		/// writes into buffer at offset 0.
+		void begin(uint32_t _size);
+
+		/// Fence read issued since `begin`, and queue copy to destination.
+		void end(void* _data);
+
+		/// Copy completed read backs to destination. Read backs issued before previous call are
+		/// waited on, so that result is available within one frame.
+		void update();
+
+		/// Wait for oldest read back, and copy it to destination.
+		void flush();
+
+		/// Copy oldest read back to destination, and remove it from ring.
+		void pop();
+
+		struct Request
+		{
+			GLuint   m_id;
+			uint32_t m_capacity;
+			uint32_t m_size;
+			uint32_t m_frame;
+			GLsync   m_fence;
+			void*    m_data;
+		};
+
+		Request  m_request[GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS];
+		uint32_t m_read;
+		uint32_t m_num;
+		uint32_t m_frame;
+	};
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
 		{
 			m_size  = _size;
 			m_flags = _flags;
+			m_persistent = NULL;
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BASE_ASSERT(0 != m_id, "Failed to generate buffer id.");
@@ -1366,6 +1548,7 @@ namespace graphics { namespace gl
 		GLuint m_id;
 		uint32_t m_size;
 		uint16_t m_flags;
+		PersistentBufferGL* m_persistent;
 	};
 
 	struct VertexBufferGL
@@ -1374,6 +1557,7 @@ namespace graphics { namespace gl
 		{
 			m_size = _size;
 			m_layoutHandle = _layoutHandle;
+			m_persistent = NULL;
 			const bool drawIndirect = 0 != (_flags & GRAPHICS_BUFFER_DRAW_INDIRECT);
 
 			m_target = drawIndirect ? GL_DRAW_INDIRECT_BUFFER : GL_ARRAY_BUFFER;
@@ -1415,6 +1599,7 @@ namespace graphics { namespace gl
 		GLenum m_target;
 		uint32_t m_size;
 		VertexLayoutHandle m_layoutHandle;
+		PersistentBufferGL* m_persistent;
 	};
 
 	struct TextureGL
@@ -1439,6 +1624,7 @@ namespace graphics { namespace gl
 		void setSamplerState(uint32_t _flags, const float _rgba[4]);
 		void commit(uint32_t _stage, uint32_t _flags, const float _palette[][4]);
 		void resolve(uint8_t _resolve) const;
+		void setMinMip(uint8_t _mip);
 
 		bool isCubeMap() const
 		{
@@ -1514,13 +1700,26 @@ namespace graphics { namespace gl
 	{
 		ProgramGL()
 			: m_id(0)
+			, m_vsh(0)
+			, m_fsh(0)
+			, m_cacheId(0)
+			, m_linkPending(false)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
 		{
 			m_instanceData[0] = -1;
+			m_uniformBlockSize[0] = 0;
+			m_uniformBlockSize[1] = 0;
+			m_drawModelNum      = 0;
+			m_numDrawModel      = 0;
+			m_perDrawPredefined = false;
 		}
 
-		void create(const ShaderGL& _vsh, const ShaderGL& _fsh);
+		/// Attaches shaders and issues link. When driver supports parallel
+		/// shader compile, link status is not queried until `finish` is
+		/// called, otherwise program is finished immediately.
+		void create(const ShaderGL& _vsh, const ShaderGL& _fsh, bool _deferLink = false);
+		void finish();
 		void destroy();
 		void init();
 
@@ -1532,6 +1731,10 @@ namespace graphics { namespace gl
 		void unbindAttributes();
 
 		GLuint m_id;
+		GLuint m_vsh;
+		GLuint m_fsh;
+		uint64_t m_cacheId;
+		bool m_linkPending;
 
 		uint8_t m_unboundUsedAttrib[Attrib::Count]; // For tracking unbound used attributes between begin()/end().
 		uint8_t m_usedCount;
@@ -1545,8 +1748,18 @@ namespace graphics { namespace gl
 		uint8_t m_numSamplers;
 
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count*2]; //!< Uniform packed into uniform
+		                                                            //!  blocks is listed once per stage.
 		uint8_t m_numPredefined;
+
+		uint32_t m_uniformBlockSize[2]; //!< Vertex and fragment shader uniform block size, 0 when
+		                                //!  shader uses glUniform* calls.
+
+		uint32_t m_drawModel[2];     //!< Locations of `u_drawModel` array, per-draw model matrices of
+		                             //!  multi-draw call indexed with gl_DrawID.
+		uint16_t m_drawModelNum;     //!< Number of elements in `u_drawModel` array.
+		uint8_t  m_numDrawModel;     //!< Number of `u_drawModel` locations, 0 when program doesn't use it.
+		bool     m_perDrawPredefined; //!< Program uses predefined uniforms derived from draw transform.
 	};
 
 	struct TimerQueryGL
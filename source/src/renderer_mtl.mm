@@ -1184,6 +1184,12 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Not supported, GRAPHICS_CAPS_TEXTURE_MIN_MIP is not set.
+			BASE_UNUSED(_handle, _mip);
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			BASE_UNUSED(_len);
@@ -3953,21 +3959,9 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 		m_uniformBufferVertexOffset = 0;
 		m_uniformBufferFragmentOffset = 0;
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, base::strideAlign(_render->m_iboffset,4), ib->data, true);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, base::strideAlign(_render->m_vboffset,4), vb->data, true);
-		}
-
-		_render->sort();
+		const auto updateTransient = [](BufferMtl& _buffer, uint32_t _size, void* _data) { _buffer.update(0, base::strideAlign(_size, 4), _data, true); };
+		updateTransientPages(m_indexBuffers,  _render->m_transientIb, updateTransient);
+		updateTransientPages(m_vertexBuffers, _render->m_transientVb, updateTransient);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -4017,6 +4011,8 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 			, s_viewName
 			);
 
+		CostStats costStats(_render);
+
 		m_occlusionQuery.resolve(_render);
 
 		if (0 == (_render->m_debug&GRAPHICS_DEBUG_IFH) )
@@ -4291,6 +4287,7 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 					}
 
 					const RenderCompute& compute = renderItem.compute;
+					costStats.compute(view, key.m_program, compute, renderBind);
 
 					bool programChanged = false;
 					rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
@@ -4916,6 +4913,8 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 					statsNumInstances[primIndex]      += numInstances;
 					statsNumDrawIndirect[primIndex]   += numDrawIndirect;
 					statsNumIndices                   += numIndices;
+
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
 				}
 			}
 
@@ -5061,8 +5060,8 @@ BASE_STATIC_ASSERT(BASE_COUNTOF(s_accessNames) == Access::Count, "Invalid s_acce
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				double captureMs = double(captureElapsed)*toMs;
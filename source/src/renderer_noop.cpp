@@ -3,7 +3,7 @@
  * License: https://github.com/bkaradzic/graphics/blob/master/LICENSE
  */
 
-#include "graphics_p.h"
+#include "renderer.h"
 
 namespace graphics { namespace noop
 {
@@ -33,6 +33,7 @@ namespace graphics { namespace noop
 				| GRAPHICS_CAPS_TEXTURE_COMPARE_ALL
 				| GRAPHICS_CAPS_TEXTURE_COMPARE_LEQUAL
 				| GRAPHICS_CAPS_TEXTURE_CUBE_ARRAY
+				| GRAPHICS_CAPS_TEXTURE_MIN_MIP
 				| GRAPHICS_CAPS_TEXTURE_READ_BACK
 				| GRAPHICS_CAPS_VERTEX_ATTRIB_HALF
 				| GRAPHICS_CAPS_VERTEX_ATTRIB_UINT10
@@ -93,8 +94,9 @@ namespace graphics { namespace noop
 		{
 		}
 
-		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* /*_mem*/, uint16_t /*_flags*/) override
+		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t /*_flags*/) override
 		{
+			m_indexBufferSize[_handle.idx] = _mem->size;
 		}
 
 		void destroyIndexBuffer(IndexBufferHandle /*_handle*/) override
@@ -117,8 +119,9 @@ namespace graphics { namespace noop
 		{
 		}
 
-		void createDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t /*_flags*/) override
 		{
+			m_indexBufferSize[_handle.idx] = _size;
 		}
 
 		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
@@ -239,6 +242,10 @@ namespace graphics { namespace noop
 		{
 		}
 
+		void setTextureMinMip(TextureHandle /*_handle*/, uint8_t /*_mip*/) override
+		{
+		}
+
 		void submit(Frame* _render, ClearQuad& /*_clearQuad*/, TextVideoMemBlitter& /*_textVideoMemBlitter*/) override
 		{
 			const int64_t timerFreq = base::getHPFrequency();
@@ -246,7 +253,6 @@ namespace graphics { namespace noop
 
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
@@ -254,10 +260,70 @@ namespace graphics { namespace noop
 			perfStats.gpuTimerFreq  = 1000000000;
 			perfStats.gpuFrameNum   = 0;
 
-			base::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
+			uint32_t statsNumPrims[Topology::Count] = {};
+			uint32_t statsKeyType[2] = {};
+
+			if (0 == (_render->m_debug&GRAPHICS_DEBUG_IFH) )
+			{
+				// Walk sorted render items without issuing anything, so that CPU-side counters
+				// match what a real renderer would report.
+				CostStats costStats(_render);
+				SortKey key;
+
+				for (uint32_t item = 0, numItems = _render->m_numRenderItems; item < numItems; ++item)
+				{
+					const bool isCompute = key.decode(_render->m_sortKeys[item], _render->m_viewRemap);
+					statsKeyType[isCompute]++;
+
+					const uint32_t itemIdx       = _render->m_sortValues[item];
+					const RenderItem& renderItem = _render->m_renderItem[itemIdx];
+					const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+
+					if (isCompute)
+					{
+						costStats.compute(key.m_view, key.m_program, renderItem.compute, renderBind);
+						continue;
+					}
+
+					const RenderDraw& draw = renderItem.draw;
+					const uint8_t primIndex = uint8_t( (draw.m_stateFlags&GRAPHICS_STATE_PT_MASK)>>GRAPHICS_STATE_PT_SHIFT);
+
+					uint32_t numPrims = 0;
+
+					if (isValid(draw.m_indirectBuffer) )
+					{
+						// Number of primitives for indirect draw is known only to GPU.
+					}
+					else if (isValid(draw.m_indexBuffer) )
+					{
+						const uint32_t indexSize  = draw.isIndex16() ? 2 : 4;
+						const uint32_t numIndices = UINT32_MAX == draw.m_numIndices
+							? m_indexBufferSize[draw.m_indexBuffer.idx]/indexSize
+							: draw.m_numIndices
+							;
+
+						numPrims = getNumPrims(primIndex, numIndices);
+					}
+					else if (UINT32_MAX != draw.m_numVertices)
+					{
+						numPrims = getNumPrims(primIndex, draw.m_numVertices);
+					}
+
+					numPrims *= draw.m_numInstances;
+					statsNumPrims[primIndex] += numPrims;
+
+					costStats.draw(key.m_view, key.m_program, draw, renderBind, numPrims);
+				}
+			}
+
+			perfStats.numDraw    = statsKeyType[0];
+			perfStats.numCompute = statsKeyType[1];
+			perfStats.numBlit    = _render->m_numBlitItems;
+			base::memCopy(perfStats.numPrims, statsNumPrims, sizeof(perfStats.numPrims) );
 
 			perfStats.gpuMemoryMax  = -INT64_MAX;
 			perfStats.gpuMemoryUsed = -INT64_MAX;
+			perfStats.cpuTimeEnd    = base::getHPCounter();
 		}
 
 		void blitSetup(TextVideoMemBlitter& /*_blitter*/) override
@@ -267,6 +333,8 @@ namespace graphics { namespace noop
 		void blitRender(TextVideoMemBlitter& /*_blitter*/, uint32_t /*_numIndices*/) override
 		{
 		}
+
+		uint32_t m_indexBufferSize[GRAPHICS_CONFIG_MAX_INDEX_BUFFERS];
 	};
 
 	static RendererContextNOOP* s_renderNOOP;
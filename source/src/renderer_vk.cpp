@@ -1095,6 +1095,7 @@ VK_IMPORT_DEVICE
 			, m_renderDocDll(NULL)
 			, m_vulkan1Dll(NULL)
 			, m_maxAnisotropy(1.0f)
+			, m_persistentMapSupport(false)
 			, m_depthClamp(false)
 			, m_wireframe(false)
 			, m_captureBuffer(VK_NULL_HANDLE)
@@ -1579,6 +1580,8 @@ VK_IMPORT_INSTANCE
 
 				m_timerQuerySupport = m_deviceProperties.limits.timestampComputeAndGraphics;
 
+				m_persistentMapSupport = 0 != GRAPHICS_CONFIG_TRANSIENT_PERSISTENT_MAP;
+
 				const bool indirectDrawSupport = true
 					&& m_deviceFeatures.multiDrawIndirect
 					&& m_deviceFeatures.drawIndirectFirstInstance
@@ -1600,6 +1603,7 @@ VK_IMPORT_INSTANCE
 					| GRAPHICS_CAPS_TEXTURE_BLIT
 					| GRAPHICS_CAPS_TEXTURE_COMPARE_ALL
 					| (m_deviceFeatures.imageCubeArray ? GRAPHICS_CAPS_TEXTURE_CUBE_ARRAY : 0)
+					| GRAPHICS_CAPS_TEXTURE_MIN_MIP
 					| GRAPHICS_CAPS_TEXTURE_READ_BACK
 					| GRAPHICS_CAPS_VERTEX_ATTRIB_HALF
 					| GRAPHICS_CAPS_VERTEX_ATTRIB_UINT10
@@ -1891,6 +1895,10 @@ VK_IMPORT_DEVICE
 					: _init.resolution.maxFrameLatency
 					;
 
+				// Texture read back is copied once command buffer it was recorded in completes,
+				// which is guaranteed when that command buffer is reused.
+				g_caps.limits.readTextureLatency = m_numFramesInFlight + 1;
+
 				result = m_cmd.init(m_globalQueueFamily, m_globalQueue, m_numFramesInFlight);
 
 				if (VK_SUCCESS != result)
@@ -1946,29 +1954,15 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SwapChainCreated;
 
 			{
-				VkDescriptorPoolSize dps[] =
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
-					{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          MAX_DESCRIPTOR_SETS * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_SAMPLER,                MAX_DESCRIPTOR_SETS * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, MAX_DESCRIPTOR_SETS * 2                                },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         MAX_DESCRIPTOR_SETS * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          MAX_DESCRIPTOR_SETS * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
-				};
-
-				VkDescriptorPoolCreateInfo dpci;
-				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-				dpci.pNext = NULL;
-				dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-				dpci.maxSets       = MAX_DESCRIPTOR_SETS;
-				dpci.poolSizeCount = BASE_COUNTOF(dps);
-				dpci.pPoolSizes    = dps;
+					result = m_descriptorSetPool[ii].create(MAX_DESCRIPTOR_SETS);
 
-				result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &m_descriptorPool);
-
-				if (VK_SUCCESS != result)
-				{
-					BASE_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
-					goto error;
+					if (VK_SUCCESS != result)
+					{
+						BASE_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 				}
 
 				VkPipelineCacheCreateInfo pcci;
@@ -2061,8 +2055,11 @@ VK_IMPORT_DEVICE
 				{
 					m_scratchBuffer[ii].destroy();
 				}
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+				{
+					m_descriptorSetPool[ii].destroy();
+				}
 				vkDestroy(m_pipelineCache);
-				vkDestroy(m_descriptorPool);
 				BASE_FALLTHROUGH;
 
 			case ErrorState::SwapChainCreated:
@@ -2109,6 +2106,7 @@ VK_IMPORT_DEVICE
 				m_gpuTimer.shutdown();
 			}
 			m_occlusionQuery.shutdown();
+			m_readbackRing.shutdown();
 
 			preReset();
 
@@ -2154,7 +2152,11 @@ VK_IMPORT_DEVICE
 			m_cmd.shutdown();
 
 			vkDestroy(m_pipelineCache);
-			vkDestroy(m_descriptorPool);
+
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				m_descriptorSetPool[ii].destroy();
+			}
 
 			vkDestroyDevice(m_device, m_allocatorCb);
 
@@ -2307,30 +2309,16 @@ VK_IMPORT_DEVICE
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
-			TextureVK& texture = m_textures[_handle.idx];
-
-			uint32_t height = base::uint32_max(1, texture.m_height >> _mip);
-			uint32_t pitch  = texture.m_readback.pitch(_mip);
-			uint32_t size = height * pitch;
-
-			VkDeviceMemory stagingMemory;
-			VkBuffer stagingBuffer;
-			VK_CHECK(createReadbackBuffer(size, &stagingBuffer, &stagingMemory) );
-
-			texture.m_readback.copyImageToBuffer(
-				  m_commandBuffer
-				, stagingBuffer
-				, texture.m_currentImageLayout
-				, texture.m_aspectMask
-				, _mip
-				);
-
-			kick(true);
+			const TextureVK& texture = m_textures[_handle.idx];
 
-			texture.m_readback.readback(stagingMemory, 0, _data, _mip);
+			if (m_readbackRing.isFull() )
+			{
+				// All staging buffers are in flight, wait for queue to free them.
+				kick(true);
+				m_readbackRing.update();
+			}
 
-			vkDestroy(stagingBuffer);
-			vkDestroy(stagingMemory);
+			m_readbackRing.copy(m_commandBuffer, texture, _data, _mip);
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
@@ -2527,6 +2515,13 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Sampled image view is selected per descriptor set, sets written after this use
+			// view starting at min mip.
+			m_textures[_handle.idx].m_minMip = _mip;
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -2638,7 +2633,8 @@ VK_IMPORT_DEVICE
 			bind.m_bind[0].m_idx = _blitter.m_texture.idx;
 			bind.m_bind[0].m_samplerFlags = (uint32_t)(texture.m_flags & GRAPHICS_SAMPLER_BITS_MASK);
 
-			const VkDescriptorSet descriptorSet = getDescriptorSet(program, bind, scratchBuffer, NULL);
+			DescriptorSetPoolVK& descriptorSetPool = m_descriptorSetPool[m_cmd.m_currentFrameInFlight];
+			const VkDescriptorSet descriptorSet = getDescriptorSet(program, bind, scratchBuffer, descriptorSetPool, NULL);
 
 			vkCmdBindDescriptorSets(
 				  m_commandBuffer
@@ -3789,18 +3785,10 @@ VK_IMPORT_DEVICE
 			return pipeline;
 		}
 
-		VkDescriptorSet getDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, const ScratchBufferVK& scratchBuffer, const float _palette[][4])
+		VkDescriptorSet getDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, const ScratchBufferVK& scratchBuffer, DescriptorSetPoolVK& descriptorSetPool, const float _palette[][4])
 		{
-			VkDescriptorSet descriptorSet;
-
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext              = NULL;
-			dsai.descriptorPool     = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts        = &program.m_descriptorSetLayout;
-
-			VK_CHECK(vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet) );
+			// Destination set is known only after resolved descriptors are hashed.
+			const VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 
 			VkDescriptorImageInfo  imageInfo[GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS];
 			VkDescriptorBufferInfo bufferInfo[GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS];
@@ -3926,8 +3914,8 @@ VK_IMPORT_DEVICE
 							imageInfo[imageCount].sampler     = sampler;
 							imageInfo[imageCount].imageView   = getCachedImageView(
 								  { bind.m_idx }
-								, 0
-								, texture.m_numMips
+								, texture.m_minMip
+								, texture.m_numMips - texture.m_minMip
 								, type
 								, sampleStencil
 								);
@@ -4006,12 +3994,62 @@ VK_IMPORT_DEVICE
 				++bufferCount;
 			}
 
-			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+			// Descriptor tuple, 4 words per write: binding and type, then sampler, image view, and
+			// layout for images, or buffer, offset, and range for buffers.
+			uint64_t desc[1 + kMaxDescriptorSets*4];
+			uint32_t numDesc = 0;
+			desc[numDesc++] = uint64_t(program.m_descriptorSetLayout.vk);
+
+			for (uint32_t ii = 0; ii < wdsCount; ++ii)
+			{
+				const VkWriteDescriptorSet& write = wds[ii];
+				desc[numDesc++] = uint64_t(write.dstBinding)<<32 | uint64_t(write.descriptorType);
 
-			VkDescriptorSet temp = descriptorSet;
-			release(temp);
+				if (NULL != write.pImageInfo)
+				{
+					desc[numDesc++] = uint64_t(write.pImageInfo->sampler);
+					desc[numDesc++] = uint64_t(write.pImageInfo->imageView);
+					desc[numDesc++] = uint64_t(write.pImageInfo->imageLayout);
+				}
+				else
+				{
+					desc[numDesc++] = uint64_t(write.pBufferInfo->buffer);
+					desc[numDesc++] = uint64_t(write.pBufferInfo->offset);
+					desc[numDesc++] = uint64_t(write.pBufferInfo->range);
+				}
+			}
+
+			// 64-bit key from two differently seeded passes, tuple is still compared on hit.
+			const uint32_t descSize = numDesc*sizeof(uint64_t);
+
+			base::HashMurmur2A hash;
+			hash.begin(0);
+			hash.add(desc, descSize);
+			const uint32_t hashLo = hash.end();
 
-			return descriptorSet;
+			hash.begin(0x9e3779b9);
+			hash.add(desc, descSize);
+			const uint32_t hashHi = hash.end();
+
+			const uint64_t key = uint64_t(hashHi)<<32 | uint64_t(hashLo);
+
+			VkDescriptorSet cached = descriptorSetPool.find(key, desc, numDesc);
+
+			if (VK_NULL_HANDLE != cached)
+			{
+				return cached;
+			}
+
+			cached = descriptorSetPool.alloc(key, desc, numDesc, program.m_descriptorSetLayout);
+
+			for (uint32_t ii = 0; ii < wdsCount; ++ii)
+			{
+				wds[ii].dstSet = cached;
+			}
+
+			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+
+			return cached;
 		}
 
 		bool isSwapChainReadable(const SwapChainVK& _swapChain)
@@ -4437,6 +4475,7 @@ VK_IMPORT_DEVICE
 		bool m_lineAASupport;
 		bool m_borderColorSupport;
 		bool m_timerQuerySupport;
+		bool m_persistentMapSupport;
 
 		FrameBufferVK m_backBuffer;
 		TextureFormat::Enum m_swapchainFormats[TextureFormat::Count];
@@ -4454,11 +4493,12 @@ VK_IMPORT_DEVICE
 		VkDevice m_device;
 		uint32_t m_globalQueueFamily;
 		VkQueue  m_globalQueue;
-		VkDescriptorPool m_descriptorPool;
+		DescriptorSetPoolVK m_descriptorSetPool[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
 		VkPipelineCache  m_pipelineCache;
 
 		TimerQueryVK m_gpuTimer;
 		OcclusionQueryVK m_occlusionQuery;
+		ReadbackRingVK m_readbackRing;
 
 		void* m_renderDocDll;
 		void* m_vulkan1Dll;
@@ -4555,11 +4595,8 @@ VK_DESTROY
 
 	void vkDestroy(VkDescriptorSet& _obj)
 	{
-		if (VK_NULL_HANDLE != _obj)
-		{
-			vkFreeDescriptorSets(s_renderVK->m_device, s_renderVK->m_descriptorPool, 1, &_obj);
-			_obj = VK_NULL_HANDLE;
-		}
+		// Descriptor sets are freed all at once, when owning DescriptorSetPoolVK is reset.
+		_obj = VK_NULL_HANDLE;
 	}
 
 	void release(VkDeviceMemory& _obj)
@@ -4680,6 +4717,148 @@ VK_DESTROY
 		VK_CHECK(vkFlushMappedMemoryRanges(device, 1, &range) );
 	}
 
+	VkResult DescriptorSetPoolVK::create(uint32_t _maxSets)
+	{
+		m_maxSets   = _maxSets;
+		m_current   = 0;
+		m_submitted = 0;
+
+		return createPool();
+	}
+
+	VkResult DescriptorSetPoolVK::createPool()
+	{
+		const uint32_t maxSets = m_maxSets;
+
+		VkDescriptorPoolSize dps[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          maxSets * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,                maxSets * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, maxSets * 2                                },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         maxSets * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          maxSets * GRAPHICS_CONFIG_MAX_TEXTURE_SAMPLERS },
+		};
+
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = 0;
+		dpci.maxSets       = maxSets;
+		dpci.poolSizeCount = BASE_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
+
+		VkDescriptorPool descriptorPool;
+		const VkResult result = vkCreateDescriptorPool(s_renderVK->m_device, &dpci, s_renderVK->m_allocatorCb, &descriptorPool);
+
+		if (VK_SUCCESS == result)
+		{
+			m_descriptorPool.push_back(descriptorPool);
+		}
+
+		return result;
+	}
+
+	void DescriptorSetPoolVK::destroy()
+	{
+		m_descriptorSet.clear();
+		m_desc.clear();
+
+		for (uint32_t ii = 0, num = uint32_t(m_descriptorPool.size() ); ii < num; ++ii)
+		{
+			vkDestroy(m_descriptorPool[ii]);
+		}
+
+		m_descriptorPool.clear();
+		m_current = 0;
+	}
+
+	void DescriptorSetPoolVK::reset()
+	{
+		CommandQueueVK& cmd = s_renderVK->m_cmd;
+
+		// Sets might have been used by submission recorded after frame slot changed (when command
+		// buffer was kicked mid frame), wait for last one that used them.
+		if (0 != m_submitted
+		&&  m_submitted - 1 < cmd.m_submitted)
+		{
+			cmd.wait(m_submitted - 1);
+		}
+
+		m_descriptorSet.clear();
+		m_desc.clear();
+		m_numAlloc  = 0;
+		m_numReused = 0;
+		m_submitted = 0;
+
+		for (uint32_t ii = 0, num = base::min<uint32_t>(m_current+1, uint32_t(m_descriptorPool.size() ) ); ii < num; ++ii)
+		{
+			VK_CHECK(vkResetDescriptorPool(s_renderVK->m_device, m_descriptorPool[ii], 0) );
+		}
+
+		m_current = 0;
+	}
+
+	VkDescriptorSet DescriptorSetPoolVK::find(uint64_t _key, const uint64_t* _desc, uint32_t _num)
+	{
+		DescriptorSetMap::const_iterator it = m_descriptorSet.find(_key);
+
+		if (it != m_descriptorSet.end()
+		&&  it->second.num == _num
+		&&  0 == base::memCmp(&m_desc[it->second.offset], _desc, _num*sizeof(uint64_t) ) )
+		{
+			++m_numReused;
+			m_submitted = s_renderVK->m_cmd.m_submitted + 1;
+			return it->second.set;
+		}
+
+		return VK_NULL_HANDLE;
+	}
+
+	VkDescriptorSet DescriptorSetPoolVK::alloc(uint64_t _key, const uint64_t* _desc, uint32_t _num, VkDescriptorSetLayout _layout)
+	{
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext              = NULL;
+		dsai.descriptorPool     = m_descriptorPool[m_current];
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &_layout;
+
+		VkDescriptorSet descriptorSet;
+		VkResult result = vkAllocateDescriptorSets(s_renderVK->m_device, &dsai, &descriptorSet);
+
+		if (VK_SUCCESS != result)
+		{
+			// Pool is exhausted (VK_ERROR_OUT_OF_POOL_MEMORY, or VK_ERROR_FRAGMENTED_POOL, drivers
+			// without VK_KHR_maintenance1 may return anything else), move to next chained pool.
+			++m_current;
+
+			if (m_current == m_descriptorPool.size() )
+			{
+				VK_CHECK(createPool() );
+				BASE_TRACE("Descriptor pool exhausted, chained pool %d.", m_current);
+			}
+
+			dsai.descriptorPool = m_descriptorPool[m_current];
+			VK_CHECK(vkAllocateDescriptorSets(s_renderVK->m_device, &dsai, &descriptorSet) );
+		}
+
+		// Different tuple with same key stays uncached, cached one is still valid.
+		if (m_descriptorSet.end() == m_descriptorSet.find(_key) )
+		{
+			DescriptorSet ds;
+			ds.set    = descriptorSet;
+			ds.offset = uint32_t(m_desc.size() );
+			ds.num    = _num;
+			m_desc.insert(m_desc.end(), _desc, _desc + _num);
+			m_descriptorSet.insert(stl::make_pair(_key, ds) );
+		}
+
+		++m_numAlloc;
+		m_submitted = s_renderVK->m_cmd.m_submitted + 1;
+
+		return descriptorSet;
+	}
+
 	void BufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
 	{
 		BASE_UNUSED(_stride);
@@ -4749,7 +4928,16 @@ VK_DESTROY
 
 	void BufferVK::destroy()
 	{
-		if (VK_NULL_HANDLE != m_buffer)
+		if (NULL != m_persistent)
+		{
+			m_persistent->destroy();
+			base::deleteObject(g_allocator, m_persistent);
+			m_persistent = NULL;
+			m_buffer     = VK_NULL_HANDLE;
+			m_deviceMem  = VK_NULL_HANDLE;
+			m_dynamic    = false;
+		}
+		else if (VK_NULL_HANDLE != m_buffer)
 		{
 			s_renderVK->release(m_buffer);
 			s_renderVK->release(m_deviceMem);
@@ -4758,6 +4946,120 @@ VK_DESTROY
 		}
 	}
 
+	bool PersistentBufferVK::create(uint32_t _size, bool _vertex)
+	{
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		const VkDevice device = s_renderVK->m_device;
+
+		const uint32_t numSlots = s_renderVK->m_cmd.m_numFramesInFlight;
+
+		base::memSet(m_buffer,    0, sizeof(m_buffer)    );
+		base::memSet(m_deviceMem, 0, sizeof(m_deviceMem) );
+		base::memSet(m_data,      0, sizeof(m_data)      );
+		base::memSet(m_submitted, 0, sizeof(m_submitted) );
+		m_slot = 0;
+
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = _vertex ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT : VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+		bci.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
+
+		for (uint32_t ii = 0; ii < numSlots; ++ii)
+		{
+			VkResult result = vkCreateBuffer(device, &bci, allocatorCb, &m_buffer[ii]);
+
+			if (VK_SUCCESS == result)
+			{
+				VkMemoryRequirements mr;
+				vkGetBufferMemoryRequirements(device, m_buffer[ii], &mr);
+
+				VkMemoryPropertyFlags flags = 0
+					| VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+					| VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+					| VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+					;
+				result = s_renderVK->allocateMemory(&mr, flags, &m_deviceMem[ii]);
+
+				if (VK_SUCCESS != result)
+				{
+					flags &= ~VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+					result = s_renderVK->allocateMemory(&mr, flags, &m_deviceMem[ii]);
+				}
+			}
+
+			if (VK_SUCCESS == result)
+			{
+				result = vkBindBufferMemory(device, m_buffer[ii], m_deviceMem[ii], 0);
+			}
+
+			if (VK_SUCCESS == result)
+			{
+				result = vkMapMemory(device, m_deviceMem[ii], 0, _size, 0, (void**)&m_data[ii]);
+			}
+
+			if (VK_SUCCESS != result)
+			{
+				BASE_TRACE("Failed to create persistently mapped transient buffer: %d", result);
+				destroy();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void PersistentBufferVK::destroy()
+	{
+		const VkDevice device = s_renderVK->m_device;
+
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_buffer); ++ii)
+		{
+			if (NULL != m_data[ii])
+			{
+				vkUnmapMemory(device, m_deviceMem[ii]);
+				m_data[ii] = NULL;
+			}
+
+			if (VK_NULL_HANDLE != m_buffer[ii])
+			{
+				s_renderVK->release(m_buffer[ii]);
+			}
+
+			if (VK_NULL_HANDLE != m_deviceMem[ii])
+			{
+				s_renderVK->release(m_deviceMem[ii]);
+			}
+		}
+	}
+
+	void PersistentBufferVK::next()
+	{
+		CommandQueueVK& cmd = s_renderVK->m_cmd;
+
+		// Command buffer recorded this frame is submitted as `cmd.m_submitted`. Stored biased by
+		// one, so zero marks slot that was never used.
+		m_submitted[m_slot] = cmd.m_submitted + 1;
+		m_slot = (m_slot + 1) % cmd.m_numFramesInFlight;
+
+		if (0 != m_submitted[m_slot])
+		{
+			GRAPHICS_PROFILER_SCOPE("graphics/Wait transient buffer", kColorResource);
+			cmd.wait(m_submitted[m_slot] - 1);
+		}
+	}
+
+	void PersistentBufferVK::next(BufferVK& _buffer)
+	{
+		next();
+		_buffer.m_buffer    = m_buffer[m_slot];
+		_buffer.m_deviceMem = m_deviceMem[m_slot];
+	}
+
 	void VertexBufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle, uint16_t _flags)
 	{
 		BufferVK::create(_commandBuffer, _size, _data, _flags, true);
@@ -5703,6 +6005,82 @@ VK_DESTROY
 		vkUnmapMemory(s_renderVK->m_device, _memory);
 	}
 
+	void ReadbackRingVK::shutdown()
+	{
+		update();
+
+		for (uint32_t ii = 0; ii < BASE_COUNTOF(m_request); ++ii)
+		{
+			Request& request = m_request[ii];
+
+			if (VK_NULL_HANDLE != request.m_buffer)
+			{
+				s_renderVK->release(request.m_buffer);
+				s_renderVK->release(request.m_memory);
+			}
+		}
+
+		base::memSet(m_request, 0, sizeof(m_request) );
+		m_read = 0;
+		m_num  = 0;
+	}
+
+	void ReadbackRingVK::copy(VkCommandBuffer _commandBuffer, const TextureVK& _texture, void* _data, uint8_t _mip)
+	{
+		BASE_ASSERT(!isFull(), "Texture read back ring is full.");
+
+		Request& request = m_request[(m_read + m_num) % BASE_COUNTOF(m_request)];
+
+		const ReadbackVK& readback = _texture.m_readback;
+		const uint32_t height = base::uint32_max(1, readback.m_height >> _mip);
+		const uint32_t size   = height * readback.pitch(_mip);
+
+		if (request.m_size < size)
+		{
+			if (VK_NULL_HANDLE != request.m_buffer)
+			{
+				s_renderVK->release(request.m_buffer);
+				s_renderVK->release(request.m_memory);
+			}
+
+			VK_CHECK(s_renderVK->createReadbackBuffer(size, &request.m_buffer, &request.m_memory) );
+			request.m_size = size;
+		}
+
+		readback.copyImageToBuffer(
+			  _commandBuffer
+			, request.m_buffer
+			, _texture.m_currentImageLayout
+			, _texture.m_aspectMask
+			, _mip
+			);
+
+		request.m_readback  = readback;
+		request.m_submitted = s_renderVK->m_cmd.m_submitted;
+		request.m_data      = _data;
+		request.m_mip       = _mip;
+
+		++m_num;
+	}
+
+	void ReadbackRingVK::update()
+	{
+		const CommandQueueVK& cmd = s_renderVK->m_cmd;
+
+		for (; 0 < m_num; --m_num, m_read = (m_read + 1) % BASE_COUNTOF(m_request) )
+		{
+			const Request& request = m_request[m_read];
+
+			// Requests are in submission order, stop at first one still in flight.
+			if (!cmd.isComplete(request.m_submitted) )
+			{
+				break;
+			}
+
+			request.m_readback.readback(request.m_memory, 0, request.m_data, request.m_mip);
+		}
+	}
+
 	VkResult TextureVK::create(VkCommandBuffer _commandBuffer, uint32_t _width, uint32_t _height, uint64_t _flags, VkFormat _format)
 	{
 		BASE_ASSERT(0 != (_flags & GRAPHICS_TEXTURE_RT_MASK), "");
@@ -5721,6 +6099,7 @@ VK_DESTROY
 		m_sampler = s_msaa[base::uint32_satsub( (m_flags & GRAPHICS_TEXTURE_RT_MSAA_MASK) >> GRAPHICS_TEXTURE_RT_MSAA_SHIFT, 1)];
 		m_type = VK_IMAGE_VIEW_TYPE_2D;
 		m_numMips = 1;
+		m_minMip  = 0;
 		m_numSides = 1;
 
 		VkResult result = createImages(_commandBuffer);
@@ -5929,6 +6308,7 @@ VK_DESTROY
 			}
 
 			m_numMips = ti.numMips;
+			m_minMip  = 0;
 			m_numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
 			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
 			const uint32_t numSrd = numSides * ti.numMips;
@@ -7936,6 +8316,42 @@ VK_DESTROY
 		}
 	}
 
+	void CommandQueueVK::wait(uint64_t _submitted)
+	{
+		BASE_ASSERT(_submitted < m_submitted, "Waiting on work that was not submitted yet.");
+
+		if (_submitted + m_numFramesInFlight <= m_submitted)
+		{
+			// Command list was already reused, and alloc waited on its fence.
+			return;
+		}
+
+		const uint32_t distance = uint32_t(m_submitted - _submitted);
+		const uint32_t idx = (m_currentFrameInFlight + m_numFramesInFlight - distance) % m_numFramesInFlight;
+
+		const VkDevice device = s_renderVK->m_device;
+		VK_CHECK(vkWaitForFences(device, 1, &m_commandList[idx].m_fence, VK_TRUE, UINT64_MAX) );
+	}
+
+	bool CommandQueueVK::isComplete(uint64_t _submitted) const
+	{
+		if (_submitted >= m_submitted)
+		{
+			return false;
+		}
+
+		if (_submitted + m_numFramesInFlight <= m_submitted)
+		{
+			return true;
+		}
+
+		const uint32_t distance = uint32_t(m_submitted - _submitted);
+		const uint32_t idx = (m_currentFrameInFlight + m_numFramesInFlight - distance) % m_numFramesInFlight;
+
+		const VkDevice device = s_renderVK->m_device;
+		return VK_SUCCESS == vkGetFenceStatus(device, m_commandList[idx].m_fence);
+	}
+
 	void CommandQueueVK::release(uint64_t _handle, VkObjectType _type)
 	{
 		Resource resource;
@@ -8094,6 +8510,26 @@ VK_DESTROY
 		}
 	}
 
+	// Replace transient page buffer with persistently mapped ring, see `updatePersistentTransientPages`.
+	static bool createPersistentBuffer(BufferVK& _buffer, bool _vertex)
+	{
+		PersistentBufferVK* persistent = BASE_NEW(g_allocator, PersistentBufferVK);
+
+		if (!persistent->create(_buffer.m_size, _vertex) )
+		{
+			base::deleteObject(g_allocator, persistent);
+			return false;
+		}
+
+		s_renderVK->release(_buffer.m_buffer);
+		s_renderVK->release(_buffer.m_deviceMem);
+		_buffer.m_persistent = persistent;
+		_buffer.m_buffer     = persistent->m_buffer[persistent->m_slot];
+		_buffer.m_deviceMem  = persistent->m_deviceMem[persistent->m_slot];
+
+		return true;
+	}
+
 	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		BASE_UNUSED(_clearQuad);
@@ -8120,21 +8556,10 @@ VK_DESTROY
 			frameQueryIdx = m_gpuTimer.begin(GRAPHICS_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->m_iboffset, ib->data);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
-		}
-
-		_render->sort();
+		VkCommandBuffer commandBuffer = m_commandBuffer;
+		const auto updateTransient = [commandBuffer](BufferVK& _buffer, uint32_t _size, void* _data) { _buffer.update(commandBuffer, 0, _size, _data); };
+		updatePersistentTransientPages(m_indexBuffers,  _render->m_transientIb, m_persistentMapSupport, [](BufferVK& _buffer) { return createPersistentBuffer(_buffer, false); }, updateTransient);
+		updatePersistentTransientPages(m_vertexBuffers, _render->m_transientVb, m_persistentMapSupport, [](BufferVK& _buffer) { return createPersistentBuffer(_buffer, true);  }, updateTransient);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -8152,7 +8577,6 @@ VK_DESTROY
 		VkPipeline currentPipeline = VK_NULL_HANDLE;
 		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
 		uint32_t currentBindHash = 0;
-		uint32_t descriptorSetCount = 0;
 		VkIndexType currentIndexFormat = VK_INDEX_TYPE_MAX_ENUM;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
@@ -8184,6 +8608,9 @@ VK_DESTROY
 		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_cmd.m_currentFrameInFlight];
 		scratchBuffer.reset();
 
+		DescriptorSetPoolVK& descriptorSetPool = m_descriptorSetPool[m_cmd.m_currentFrameInFlight];
+		descriptorSetPool.reset();
+
 		setMemoryBarrier(
 			  m_commandBuffer
 			, VK_PIPELINE_STAGE_TRANSFER_BIT
@@ -8205,6 +8632,8 @@ VK_DESTROY
 			, m_timerQuerySupport
 			);
 
+		CostStats costStats(_render);
+
 		m_occlusionQuery.flush(_render);
 
 		if (0 == (_render->m_debug&GRAPHICS_DEBUG_IFH) )
@@ -8333,6 +8762,7 @@ VK_DESTROY
 					);
 
 					const RenderCompute& compute = renderItem.compute;
+					costStats.compute(view, key.m_program, compute, renderBind);
 
 					const VkPipeline pipeline = getPipeline(key.m_program);
 
@@ -8403,10 +8833,9 @@ VK_DESTROY
 								  program
 								, renderBind
 								, scratchBuffer
+								, descriptorSetPool
 								, _render->m_colorPalette
 							);
-
-							descriptorSetCount++;
 						}
 
 						vkCmdBindDescriptorSets(
@@ -8714,10 +9143,9 @@ VK_DESTROY
 								  program
 								, renderBind
 								, scratchBuffer
+								, descriptorSetPool
 								, _render->m_colorPalette
 							);
-
-							descriptorSetCount++;
 						}
 
 						vkCmdBindDescriptorSets(
@@ -8878,6 +9306,8 @@ VK_DESTROY
 					statsNumInstances[primIndex]      += draw.m_numInstances;
 					statsNumIndices                   += numIndices;
 
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
+
 					if (hasOcclusionQuery)
 					{
 						m_occlusionQuery.end();
@@ -8986,6 +9416,8 @@ VK_DESTROY
 		perfStats.numBlit       = _render->m_numBlitItems;
 		perfStats.maxGpuLatency = maxGpuLatency;
 		perfStats.gpuFrameNum   = result.m_frameNum;
+		perfStats.numDescriptorSets       = descriptorSetPool.m_numAlloc;
+		perfStats.numDescriptorSetsReused = descriptorSetPool.m_numReused;
 		base::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
 		perfStats.gpuMemoryMax  = gpuMemoryAvailable;
 		perfStats.gpuMemoryUsed = gpuMemoryUsed;
@@ -9091,19 +9523,20 @@ VK_DESTROY
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " Occlusion queries: %3d ", m_occlusionQuery.m_control.available() );
 
 				pos++;
-				tvm.printf(10, pos++, 0x8b, " State cache:             ");
-				tvm.printf(10, pos++, 0x8b, " PSO    | DSL    |  DS    ");
-				tvm.printf(10, pos++, 0x8b, " %6d | %6d | %6d "
+				tvm.printf(10, pos++, 0x8b, " State cache:                      ");
+				tvm.printf(10, pos++, 0x8b, " PSO    | DSL    |  DS    | DS hit ");
+				tvm.printf(10, pos++, 0x8b, " %6d | %6d | %6d | %6d "
 					, m_pipelineStateCache.getCount()
 					, m_descriptorSetLayoutCache.getCount()
-					, descriptorSetCount
+					, descriptorSetPool.m_numAlloc
+					, descriptorSetPool.m_numReused
 					);
 				pos++;
 
@@ -9160,7 +9593,12 @@ VK_DESTROY
 			}
 		}
 
+		nextTransientPages(m_indexBuffers,  _render->m_transientIb);
+		nextTransientPages(m_vertexBuffers, _render->m_transientVb);
+
 		kick();
+
+		m_readbackRing.update();
 	}
 
 } /* namespace vk */ } // namespace graphics
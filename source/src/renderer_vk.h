@@ -117,6 +117,7 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateSemaphore);                \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroySemaphore);               \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetFences);                    \
+			VK_IMPORT_DEVICE_FUNC(false, vkGetFenceStatus);                 \
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateCommandPool);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroyCommandPool);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetCommandPool);               \
@@ -394,11 +395,94 @@ VK_DESTROY_FUNC(DescriptorSet);
 		uint32_t m_pos;
 	};
 
+	/// Descriptor pools owned by one frame in flight. Identical descriptor sets (same layout, and
+	/// same resources bound) written during frame are shared between draws, and all sets are freed
+	/// at once by resetting pools when frame slot is reused. When pool runs out of sets another one
+	/// with same size is chained, chained pools are kept and reused in following frames.
+	class DescriptorSetPoolVK
+	{
+	public:
+		DescriptorSetPoolVK()
+			: m_numAlloc(0)
+			, m_numReused(0)
+			, m_maxSets(0)
+			, m_current(0)
+			, m_submitted(0)
+		{
+		}
+
+		VkResult create(uint32_t _maxSets);
+		void destroy();
+
+		/// Wait until GPU is done with sets allocated from pools, and reset them.
+		void reset();
+
+		/// Returns cached descriptor set, or VK_NULL_HANDLE if there is no set with `_key`. On hit
+		/// descriptor tuple `_desc` is compared with one set was written with, so hash collision
+		/// never returns set with different resources.
+		VkDescriptorSet find(uint64_t _key, const uint64_t* _desc, uint32_t _num);
+
+		/// Allocates set with `_layout`, and caches it under `_key` unless key is already used by
+		/// different tuple.
+		VkDescriptorSet alloc(uint64_t _key, const uint64_t* _desc, uint32_t _num, VkDescriptorSetLayout _layout);
+
+		uint32_t m_numAlloc;  //!< Number of sets allocated since last reset.
+		uint32_t m_numReused; //!< Number of times cached set was returned since last reset.
+
+	private:
+		VkResult createPool();
+
+		struct DescriptorSet
+		{
+			VkDescriptorSet set;
+			uint32_t offset; //!< Offset of descriptor tuple in m_desc.
+			uint32_t num;    //!< Number of words in descriptor tuple.
+		};
+
+		typedef stl::unordered_map<uint64_t, DescriptorSet> DescriptorSetMap;
+		DescriptorSetMap m_descriptorSet;
+
+		typedef stl::vector<uint64_t> DescriptorArray;
+		DescriptorArray m_desc;
+
+		typedef stl::vector<VkDescriptorPool> DescriptorPoolArray;
+		DescriptorPoolArray m_descriptorPool;
+
+		uint32_t m_maxSets;
+		uint32_t m_current;
+		uint64_t m_submitted;
+	};
+
+	/// Ring of persistently mapped host visible buffers backing transient buffer page. Each frame
+	/// page data is written directly into mapped memory of current slot, slot is reused only after
+	/// command buffer submission which last used it has completed.
+	struct BufferVK;
+
+	struct PersistentBufferVK
+	{
+		bool create(uint32_t _size, bool _vertex);
+		void destroy();
+
+		/// Mark current slot as used by pending submission, and move to next one waiting until
+		/// GPU is done reading from it.
+		void next();
+
+		/// Move to next slot, and make buffer backed by this ring use it.
+		void next(BufferVK& _buffer);
+
+		VkBuffer       m_buffer[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		VkDeviceMemory m_deviceMem[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		uint8_t*       m_data[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		uint64_t       m_submitted[GRAPHICS_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t       m_slot;
+	};
+
 	struct BufferVK
 	{
 		BufferVK()
 			: m_buffer(VK_NULL_HANDLE)
 			, m_deviceMem(VK_NULL_HANDLE)
+			, m_persistent(NULL)
 			, m_size(0)
 			, m_flags(GRAPHICS_BUFFER_NONE)
 			, m_dynamic(false)
@@ -411,6 +495,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 
 		VkBuffer m_buffer;
 		VkDeviceMemory m_deviceMem;
+		PersistentBufferVK* m_persistent;
 		uint32_t m_size;
 		uint16_t m_flags;
 		bool m_dynamic;
@@ -655,6 +740,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 		uint8_t  m_requestedFormat;
 		uint8_t  m_textureFormat;
 		uint8_t  m_numMips;
+		uint8_t  m_minMip; //!< Most detailed mip sampled through texture binding.
 
 		MsaaSamplerVK m_sampler;
 
@@ -680,6 +766,47 @@ VK_DESTROY_FUNC(DescriptorSet);
 		static VkImageAspectFlags getAspectMask(VkFormat _format);
 	};
 
+	/// Ring of host visible staging buffers used for texture read back. Copy is recorded into frame
+	/// command buffer, and staging memory is copied to destination once submission that executed
+	/// copy is complete, without waiting on queue.
+	struct ReadbackRingVK
+	{
+		ReadbackRingVK()
+			: m_read(0)
+			, m_num(0)
+		{
+			base::memSet(m_request, 0, sizeof(m_request) );
+		}
+
+		void shutdown();
+
+		bool isFull() const
+		{
+			return m_num == BASE_COUNTOF(m_request);
+		}
+
+		/// Record texture copy into command buffer.
+		void copy(VkCommandBuffer _commandBuffer, const TextureVK& _texture, void* _data, uint8_t _mip);
+
+		/// Copy results of completed submissions to destination memory.
+		void update();
+
+		struct Request
+		{
+			ReadbackVK     m_readback;
+			VkBuffer       m_buffer;
+			VkDeviceMemory m_memory;
+			uint32_t       m_size;
+			uint64_t       m_submitted;
+			void*          m_data;
+			uint8_t        m_mip;
+		};
+
+		Request  m_request[GRAPHICS_CONFIG_MAX_TEXTURE_READBACKS];
+		uint32_t m_read;
+		uint32_t m_num;
+	};
+
 	constexpr uint32_t kMaxBackBuffers = base::max(GRAPHICS_CONFIG_MAX_BACK_BUFFERS, 10);
 
 	struct SwapChainVK
@@ -823,6 +950,13 @@ VK_DESTROY_FUNC(DescriptorSet);
 		void kick(bool _wait = false);
 		void finish(bool _finishAll = false);
 
+		/// Wait until submission `_submitted` (value of `m_submitted` when work was recorded)
+		/// is complete.
+		void wait(uint64_t _submitted);
+
+		/// Returns true if submission `_submitted` is complete, without waiting.
+		bool isComplete(uint64_t _submitted) const;
+
 		void release(uint64_t _handle, VkObjectType _type);
 		void consume();
 
@@ -1074,6 +1074,12 @@ namespace graphics { namespace webgpu
 			}
 		}
 
+		void setTextureMinMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Not supported, GRAPHICS_CAPS_TEXTURE_MIN_MIP is not set.
+			BASE_UNUSED(_handle, _mip);
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			BASE_UNUSED(_handle); BASE_UNUSED(_name); BASE_UNUSED(_len);
@@ -4131,21 +4137,9 @@ namespace graphics { namespace webgpu
 		BindStateCacheWgpu& bindStates = m_bindStateCache[m_frameIndex];
 		bindStates.reset();
 
-		if (0 < _render->m_iboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, base::strideAlign(_render->m_iboffset,4), ib->data, true);
-		}
-
-		if (0 < _render->m_vboffset)
-		{
-			GRAPHICS_PROFILER_SCOPE("graphics/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, base::strideAlign(_render->m_vboffset,4), vb->data, true);
-		}
-
-		_render->sort();
+		const auto updateTransient = [](BufferWgpu& _buffer, uint32_t _size, void* _data) { _buffer.update(0, base::strideAlign(_size, 4), _data, true); };
+		updateTransientPages(m_indexBuffers,  _render->m_transientIb, updateTransient);
+		updateTransientPages(m_vertexBuffers, _render->m_transientVb, updateTransient);
 
 		RenderDraw currentState;
 		currentState.clear();
@@ -4199,6 +4193,8 @@ namespace graphics { namespace webgpu
 			, s_viewName
 			);
 
+		CostStats costStats(_render);
+
 		if (0 == (_render->m_debug & GRAPHICS_DEBUG_IFH))
 		{
 			viewState.m_rect = _render->m_view[0].m_rect;
@@ -4339,6 +4335,7 @@ namespace graphics { namespace webgpu
 					}
 
 					const RenderCompute& compute = renderItem.compute;
+					costStats.compute(view, key.m_program, compute, renderBind);
 
 					bool programChanged = false;
 					bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
@@ -4786,6 +4783,8 @@ namespace graphics { namespace webgpu
 					statsNumInstances[primIndex]      += numInstances;
 					statsNumDrawIndirect[primIndex]   += numDrawIndirect;
 					statsNumIndices                   += numIndices;
+
+					costStats.draw(view, key.m_program, draw, renderBind, numPrimsRendered);
 				}
 			}
 
@@ -4936,8 +4935,8 @@ namespace graphics { namespace webgpu
 
 				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
-				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
-				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
+				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d, Pages: %d ", _render->m_transientVb.getUsed(), _render->m_transientVb.m_num);
+				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d, Pages: %d ", _render->m_transientIb.getUsed(), _render->m_transientIb.m_num);
 
 				pos++;
 				double captureMs = double(captureElapsed)*toMs;
@@ -4,6 +4,7 @@
  */
 
 #include "shaderc.h"
+#include "shaderpack/shaderpack.h"
 
 #include <iostream>
 #include <base/commandline.h>
@@ -667,6 +668,56 @@ namespace shaderc {
 		}
 	}
 
+	uint32_t getRendererMask(ShadingLang::Enum _lang)
+	{
+		switch (_lang)
+		{
+		case ShadingLang::ESSL:  return spRendererMask(graphics::RendererType::OpenGLES);
+		case ShadingLang::GLSL:  return spRendererMask(graphics::RendererType::OpenGL);
+		case ShadingLang::Metal: return spRendererMask(graphics::RendererType::Metal);
+		case ShadingLang::HLSL:
+			return 0
+				| spRendererMask(graphics::RendererType::Direct3D11)
+				| spRendererMask(graphics::RendererType::Direct3D12)
+				;
+		case ShadingLang::PSSL:
+			return 0
+				| spRendererMask(graphics::RendererType::Agc)
+				| spRendererMask(graphics::RendererType::Gnm)
+				;
+		case ShadingLang::SpirV:
+			return 0
+				| spRendererMask(graphics::RendererType::Vulkan)
+				| spRendererMask(graphics::RendererType::WebGPU)
+				;
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	bool writePack(const char* _filePath, const char* _name, ShadingLang::Enum _lang, const graphics::Memory* _mem, bool _compress)
+	{
+		ShaderPackWriter* pack = spWriterCreate();
+
+		// Pack is rebuilt with shaders it already has, so that it can be built one shader at a time.
+		spWriterAddPack(pack, _filePath);
+		spWriterAdd(pack, _name, getRendererMask(_lang), _mem->data, _mem->size);
+
+		base::Error err;
+		base::FileWriter out;
+		if (base::open(&out, _filePath, false, &err) )
+		{
+			spWriterWrite(pack, &out, _compress, &err);
+			base::close(&out);
+		}
+
+		spWriterDestroy(pack);
+
+		return err.isOk();
+	}
+
 	struct Preprocessor
 	{
 		Preprocessor(const char* _filePath, bool _essl, base::WriterI* _messageWriter)
@@ -965,6 +1016,9 @@ namespace shaderc {
 			"      --stdout                  Output to console.\n"
 			"      --bin2c [array name]      Generate C header file. If array name is not specified base file name will be used as name.\n"
 			"      --depends                 Generate makefile style depends file.\n"
+			"      --pack <file path>        Add compiled shader to shader pack. Pack is created if it doesn't exist.\n"
+			"      --pack-name <name>        Shader name in pack. If not specified base file name will be used as name.\n"
+			"      --pack-compress           Compress shader binaries in pack.\n"
 			"      --platform <platform>     Target platform.\n"
 			"           android\n"
 			"           asm.js\n"
@@ -3014,7 +3068,36 @@ namespace shaderc {
 
 			if (compiled)
 			{
-				return writer.finalize();
+				const graphics::Memory* mem = writer.finalize();
+
+				const char* packFilePath = cmdLine.findOption('\0', "pack");
+				if (NULL != packFilePath
+				&&  NULL != mem)
+				{
+					base::FilePath fp(filePath);
+					const base::StringView baseName = fp.getBaseName();
+					const std::string defaultName(baseName.getPtr(), baseName.getTerm() );
+
+					// Without profile shader is compiled with first profile, same as in compileShader.
+					ShadingLang::Enum lang = s_profiles[0].lang;
+					for (uint32_t ii = 0; ii < BASE_COUNTOF(s_profiles); ++ii)
+					{
+						if (0 == base::strCmp(options.profile.c_str(), s_profiles[ii].name)
+						|| (ShadingLang::HLSL == s_profiles[ii].lang && 0 == base::strCmp(&options.profile.c_str()[1], s_profiles[ii].name) ) )
+						{
+							lang = s_profiles[ii].lang;
+							break;
+						}
+					}
+
+					const char* name = cmdLine.findOption("pack-name", defaultName.c_str() );
+					if (!writePack(packFilePath, name, lang, mem, cmdLine.hasArg('\0', "pack-compress") ) )
+					{
+						BASE_TRACE("Failed to write shader pack '%s'.\n", packFilePath);
+					}
+				}
+
+				return mem;
 			}
 		}
 		else
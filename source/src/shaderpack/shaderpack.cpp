@@ -0,0 +1,625 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include <graphics/graphics.h>
+#include <bimg/bimg.h>
+#include "shaderpack.h"
+#include "../mappedfile.h"
+
+#include <base/cpu.h>
+#include <base/debug.h>
+#include <base/hash.h>
+#include <base/sort.h>
+#include <base/string.h>
+
+BASE_ERROR_RESULT(SHADER_PACK_ERROR_WRITE, BASE_MAKEFOURCC('S', 'P', 0, 1) );
+
+#define SHADER_PACK_MAGIC       BASE_MAKEFOURCC('G', 'S', 'P', 'K')
+#define SHADER_PACK_VERSION     1
+#define SHADER_PACK_DATA_ALIGN  16
+
+// File layout:
+//
+//   ShaderPackHeader
+//   ShaderPackEntry[numEntries] - Sorted by name hash.
+//   ShaderPackBlob[numBlobs]
+//   char names[namesSize]       - Zero terminated entry names.
+//   uint8_t data[]              - Blobs, starting at dataOffset, each aligned to SHADER_PACK_DATA_ALIGN.
+//
+// Blob is zlib compressed when storedSize differs from size.
+
+struct ShaderPackHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t numEntries;
+	uint32_t numBlobs;
+	uint32_t namesSize;
+	uint32_t dataOffset;
+};
+
+struct ShaderPackEntry
+{
+	uint32_t nameHash;
+	uint32_t rendererMask;
+	uint32_t nameOffset;
+	uint32_t blob;
+};
+
+struct ShaderPackBlob
+{
+	uint32_t offset;
+	uint32_t size;
+	uint32_t storedSize;
+	uint32_t hash;
+};
+
+static base::AllocatorI* getAllocator(base::AllocatorI* _allocator)
+{
+	if (NULL == _allocator)
+	{
+		static base::DefaultAllocator allocator;
+		return &allocator;
+	}
+
+	return _allocator;
+}
+
+static uint32_t hashName(const char* _name)
+{
+	return base::hash<base::HashMurmur2A>(_name);
+}
+
+struct ShaderPackWriter
+{
+	struct Entry
+	{
+		char*    m_name;
+		uint32_t m_nameHash;
+		uint32_t m_rendererMask;
+		uint32_t m_blob;
+	};
+
+	struct Blob
+	{
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_hash;
+	};
+
+	void init(base::AllocatorI* _allocator)
+	{
+		m_allocator  = _allocator;
+		m_entry      = NULL;
+		m_blob       = NULL;
+		m_numEntries = 0;
+		m_maxEntries = 0;
+		m_numBlobs   = 0;
+		m_maxBlobs   = 0;
+	}
+
+	void shutdown()
+	{
+		for (uint32_t ii = 0; ii < m_numEntries; ++ii)
+		{
+			base::free(m_allocator, m_entry[ii].m_name);
+		}
+
+		for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+		{
+			base::free(m_allocator, m_blob[ii].m_data);
+		}
+
+		base::free(m_allocator, m_entry);
+		base::free(m_allocator, m_blob);
+	}
+
+	uint32_t addBlob(const void* _data, uint32_t _size)
+	{
+		const uint32_t hash = base::hash<base::HashMurmur2A>(_data, _size);
+
+		for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+		{
+			const Blob& blob = m_blob[ii];
+			if (blob.m_hash == hash
+			&&  blob.m_size == _size
+			&&  0 == base::memCmp(blob.m_data, _data, _size) )
+			{
+				return ii;
+			}
+		}
+
+		if (m_numBlobs == m_maxBlobs)
+		{
+			m_maxBlobs = base::max<uint32_t>(m_maxBlobs*2, 64);
+			m_blob = (Blob*)base::realloc(m_allocator, m_blob, m_maxBlobs*sizeof(Blob) );
+		}
+
+		Blob& blob = m_blob[m_numBlobs];
+		blob.m_data = (uint8_t*)base::alloc(m_allocator, _size);
+		blob.m_size = _size;
+		blob.m_hash = hash;
+		base::memCopy(blob.m_data, _data, _size);
+
+		return m_numBlobs++;
+	}
+
+	void add(const char* _name, uint32_t _rendererMask, const void* _data, uint32_t _size)
+	{
+		const uint32_t blob     = addBlob(_data, _size);
+		const uint32_t nameHash = hashName(_name);
+
+		// Take renderers over from previously added shader with same name. Entry that is left
+		// without renderers is reused.
+		Entry* entry = NULL;
+		for (uint32_t ii = 0; ii < m_numEntries; ++ii)
+		{
+			Entry& other = m_entry[ii];
+			if (other.m_nameHash == nameHash
+			&&  0 == base::strCmp(other.m_name, _name) )
+			{
+				other.m_rendererMask &= ~_rendererMask;
+				if (0 == other.m_rendererMask
+				&&  NULL == entry)
+				{
+					entry = &other;
+				}
+			}
+		}
+
+		if (NULL == entry)
+		{
+			if (m_numEntries == m_maxEntries)
+			{
+				m_maxEntries = base::max<uint32_t>(m_maxEntries*2, 64);
+				m_entry = (Entry*)base::realloc(m_allocator, m_entry, m_maxEntries*sizeof(Entry) );
+			}
+
+			const int32_t len = base::strLen(_name);
+			entry = &m_entry[m_numEntries++];
+			entry->m_name = (char*)base::alloc(m_allocator, len+1);
+			base::strCopy(entry->m_name, len+1, _name);
+		}
+
+		entry->m_nameHash     = nameHash;
+		entry->m_rendererMask = _rendererMask;
+		entry->m_blob         = blob;
+	}
+
+	static int32_t compareEntry(const void* _lhs, const void* _rhs)
+	{
+		const ShaderPackEntry& lhs = *(const ShaderPackEntry*)_lhs;
+		const ShaderPackEntry& rhs = *(const ShaderPackEntry*)_rhs;
+		return lhs.nameHash < rhs.nameHash ? -1 : lhs.nameHash > rhs.nameHash ? 1 : 0;
+	}
+
+	int32_t write(base::WriterI* _writer, bool _compress, base::Error* _err)
+	{
+		BASE_ERROR_SCOPE(_err);
+
+		// Blobs of replaced shaders are dropped, remaining ones are renumbered in order they were
+		// added.
+		uint32_t* remap = (uint32_t*)base::alloc(m_allocator, base::max<uint32_t>(m_numBlobs, 1)*sizeof(uint32_t) );
+		base::memSet(remap, 0xff, m_numBlobs*sizeof(uint32_t) );
+
+		ShaderPackHeader header;
+		header.magic      = SHADER_PACK_MAGIC;
+		header.version    = SHADER_PACK_VERSION;
+		header.numEntries = 0;
+		header.numBlobs   = 0;
+		header.namesSize  = 0;
+		header.dataOffset = 0;
+
+		for (uint32_t ii = 0; ii < m_numEntries; ++ii)
+		{
+			const Entry& entry = m_entry[ii];
+			if (0 != entry.m_rendererMask)
+			{
+				remap[entry.m_blob] = 0;
+				header.namesSize += base::strLen(entry.m_name) + 1;
+				++header.numEntries;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+		{
+			if (UINT32_MAX != remap[ii])
+			{
+				remap[ii] = header.numBlobs++;
+			}
+		}
+
+		ShaderPackEntry* entries = (ShaderPackEntry*)base::alloc(m_allocator, base::max<uint32_t>(header.numEntries, 1)*sizeof(ShaderPackEntry) );
+		ShaderPackBlob*  blobs   = (ShaderPackBlob* )base::alloc(m_allocator, base::max<uint32_t>(header.numBlobs,   1)*sizeof(ShaderPackBlob) );
+		const uint8_t**  data    = (const uint8_t**)base::alloc(m_allocator, base::max<uint32_t>(header.numBlobs,   1)*sizeof(uint8_t*) );
+		uint8_t*         packed  = NULL;
+
+		uint32_t nameOffset = 0;
+		for (uint32_t ii = 0, num = 0; ii < m_numEntries; ++ii)
+		{
+			const Entry& entry = m_entry[ii];
+			if (0 != entry.m_rendererMask)
+			{
+				ShaderPackEntry& dst = entries[num++];
+				dst.nameHash     = entry.m_nameHash;
+				dst.rendererMask = entry.m_rendererMask;
+				dst.nameOffset   = nameOffset;
+				dst.blob         = remap[entry.m_blob];
+
+				nameOffset += base::strLen(entry.m_name) + 1;
+			}
+		}
+
+		header.dataOffset = base::alignUp<uint32_t>(0
+			+ sizeof(ShaderPackHeader)
+			+ header.numEntries*sizeof(ShaderPackEntry)
+			+ header.numBlobs*sizeof(ShaderPackBlob)
+			+ header.namesSize
+			, SHADER_PACK_DATA_ALIGN
+			);
+
+		uint32_t packedSize = 0;
+		if (_compress)
+		{
+			for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+			{
+				packedSize += UINT32_MAX != remap[ii] ? bimg::zlibDeflateBound(m_blob[ii].m_size) : 0;
+			}
+
+			packed = (uint8_t*)base::alloc(m_allocator, base::max<uint32_t>(packedSize, 1) );
+		}
+
+		uint32_t offset       = header.dataOffset;
+		uint32_t packedOffset = 0;
+		for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+		{
+			if (UINT32_MAX == remap[ii])
+			{
+				continue;
+			}
+
+			const Blob& blob = m_blob[ii];
+			ShaderPackBlob& dst = blobs[remap[ii] ];
+			dst.offset     = offset;
+			dst.size       = blob.m_size;
+			dst.storedSize = blob.m_size;
+			dst.hash       = blob.m_hash;
+			data[remap[ii] ] = blob.m_data;
+
+			if (_compress)
+			{
+				uint8_t* ptr = &packed[packedOffset];
+				const uint32_t size = bimg::zlibDeflate(m_allocator, ptr, packedSize - packedOffset, blob.m_data, blob.m_size);
+
+				// Keep compressed binary only when it's worth inflating.
+				if (0 != size
+				&&  size < blob.m_size - blob.m_size/8)
+				{
+					dst.storedSize   = size;
+					data[remap[ii] ] = ptr;
+					packedOffset    += size;
+				}
+			}
+
+			offset = base::alignUp<uint32_t>(offset + dst.storedSize, SHADER_PACK_DATA_ALIGN);
+		}
+
+		// Sorting only entries, names stay in order they were added, and are referenced by offset.
+		base::quickSort(entries, header.numEntries, sizeof(ShaderPackEntry), compareEntry);
+
+		int32_t total = 0;
+		total += base::write(_writer, header, _err);
+		total += base::write(_writer, entries, int32_t(header.numEntries*sizeof(ShaderPackEntry) ), _err);
+		total += base::write(_writer, blobs,   int32_t(header.numBlobs*sizeof(ShaderPackBlob) ), _err);
+
+		for (uint32_t ii = 0; ii < m_numEntries && _err->isOk(); ++ii)
+		{
+			const Entry& entry = m_entry[ii];
+			if (0 != entry.m_rendererMask)
+			{
+				total += base::write(_writer, entry.m_name, base::strLen(entry.m_name) + 1, _err);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < header.numBlobs && _err->isOk(); ++ii)
+		{
+			total += base::writeRep(_writer, 0, int32_t(blobs[ii].offset - total), _err);
+			total += base::write(_writer, data[ii], int32_t(blobs[ii].storedSize), _err);
+		}
+
+		base::free(m_allocator, packed);
+		base::free(m_allocator, data);
+		base::free(m_allocator, blobs);
+		base::free(m_allocator, entries);
+		base::free(m_allocator, remap);
+
+		if (!_err->isOk() )
+		{
+			BASE_ERROR_SET(_err, SHADER_PACK_ERROR_WRITE, "Failed to write shader pack.");
+			return 0;
+		}
+
+		return total;
+	}
+
+	base::AllocatorI* m_allocator;
+	Entry*   m_entry;
+	Blob*    m_blob;
+	uint32_t m_numEntries;
+	uint32_t m_maxEntries;
+	uint32_t m_numBlobs;
+	uint32_t m_maxBlobs;
+};
+
+struct ShaderPack
+{
+	static void releaseFn(void* _ptr, void* _userData)
+	{
+		BASE_UNUSED(_ptr);
+
+		// Called from render thread once shader binary is consumed.
+		ShaderPack* pack = (ShaderPack*)_userData;
+		pack->release();
+	}
+
+	static void freeFn(void* _ptr, void* _userData)
+	{
+		base::free( (base::AllocatorI*)_userData, _ptr);
+	}
+
+	bool open(const char* _filePath, base::AllocatorI* _allocator)
+	{
+		m_refCount = 1;
+
+		if (!m_file.open(_filePath, _allocator) )
+		{
+			return false;
+		}
+
+		const uint8_t* data = m_file.m_data;
+		const uint32_t size = m_file.m_size;
+
+		if (sizeof(ShaderPackHeader) > size)
+		{
+			m_file.close();
+			return false;
+		}
+
+		m_header = (const ShaderPackHeader*)data;
+
+		const uint64_t tableSize = 0
+			+ sizeof(ShaderPackHeader)
+			+ uint64_t(m_header->numEntries)*sizeof(ShaderPackEntry)
+			+ uint64_t(m_header->numBlobs)*sizeof(ShaderPackBlob)
+			;
+
+		if (SHADER_PACK_MAGIC   != m_header->magic
+		||  SHADER_PACK_VERSION != m_header->version
+		||  tableSize + m_header->namesSize > m_header->dataOffset
+		||  m_header->dataOffset > size)
+		{
+			m_file.close();
+			return false;
+		}
+
+		m_entry = (const ShaderPackEntry*)&data[sizeof(ShaderPackHeader)];
+		m_blob  = (const ShaderPackBlob*)&m_entry[m_header->numEntries];
+		m_names = (const char*)&m_blob[m_header->numBlobs];
+
+		// Validate everything that's referenced by offset once, so that lookup doesn't have to.
+		for (uint32_t ii = 0; ii < m_header->numBlobs; ++ii)
+		{
+			const ShaderPackBlob& blob = m_blob[ii];
+			if (blob.offset < m_header->dataOffset
+			||  uint64_t(blob.offset) + blob.storedSize > size)
+			{
+				m_file.close();
+				return false;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < m_header->numEntries; ++ii)
+		{
+			const ShaderPackEntry& entry = m_entry[ii];
+			if (entry.blob       >= m_header->numBlobs
+			||  entry.nameOffset >= m_header->namesSize
+			||  0 == base::strLen(&m_names[entry.nameOffset], m_header->namesSize - entry.nameOffset) )
+			{
+				m_file.close();
+				return false;
+			}
+		}
+
+		if (0 != m_header->namesSize
+		&&  '\0' != m_names[m_header->namesSize-1])
+		{
+			m_file.close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void release()
+	{
+		if (0 == base::atomicSubAndFetch<int32_t>(&m_refCount, 1) )
+		{
+			base::AllocatorI* allocator = m_file.m_allocator;
+			m_file.close();
+			base::deleteObject(allocator, this);
+		}
+	}
+
+	const ShaderPackEntry* find(const char* _name, uint32_t _rendererMask) const
+	{
+		const uint32_t nameHash = hashName(_name);
+
+		// Lower bound of name hash, then linear over entries with same hash.
+		uint32_t first = 0;
+		uint32_t count = m_header->numEntries;
+		while (0 < count)
+		{
+			const uint32_t step = count/2;
+			const uint32_t mid  = first + step;
+			if (m_entry[mid].nameHash < nameHash)
+			{
+				first  = mid + 1;
+				count -= step + 1;
+			}
+			else
+			{
+				count = step;
+			}
+		}
+
+		for (uint32_t ii = first; ii < m_header->numEntries && m_entry[ii].nameHash == nameHash; ++ii)
+		{
+			const ShaderPackEntry& entry = m_entry[ii];
+			if (0 != (entry.rendererMask & _rendererMask)
+			&&  0 == base::strCmp(&m_names[entry.nameOffset], _name) )
+			{
+				return &entry;
+			}
+		}
+
+		return NULL;
+	}
+
+	const uint8_t* getData(const ShaderPackBlob& _blob) const
+	{
+		return &m_file.m_data[_blob.offset];
+	}
+
+	MappedFile m_file;
+	const ShaderPackHeader* m_header;
+	const ShaderPackEntry*  m_entry;
+	const ShaderPackBlob*   m_blob;
+	const char*             m_names;
+	int32_t m_refCount;
+};
+
+ShaderPackWriter* spWriterCreate(base::AllocatorI* _allocator)
+{
+	_allocator = getAllocator(_allocator);
+
+	ShaderPackWriter* writer = BASE_NEW(_allocator, ShaderPackWriter);
+	writer->init(_allocator);
+
+	return writer;
+}
+
+void spWriterDestroy(ShaderPackWriter* _writer)
+{
+	base::AllocatorI* allocator = _writer->m_allocator;
+	_writer->shutdown();
+	base::deleteObject(allocator, _writer);
+}
+
+bool spWriterAddPack(ShaderPackWriter* _writer, const char* _filePath)
+{
+	ShaderPack* pack = spOpen(_filePath, _writer->m_allocator);
+	if (NULL == pack)
+	{
+		return false;
+	}
+
+	bool result = true;
+	uint8_t* temp = NULL;
+
+	for (uint32_t ii = 0; ii < pack->m_header->numEntries && result; ++ii)
+	{
+		const ShaderPackEntry& entry = pack->m_entry[ii];
+		const ShaderPackBlob&  blob  = pack->m_blob[entry.blob];
+		const uint8_t* data = pack->getData(blob);
+
+		if (blob.storedSize != blob.size)
+		{
+			temp = (uint8_t*)base::realloc(_writer->m_allocator, temp, blob.size);
+			result = bimg::zlibInflate(temp, blob.size, data, blob.storedSize);
+			data = temp;
+		}
+
+		if (result)
+		{
+			_writer->add(&pack->m_names[entry.nameOffset], entry.rendererMask, data, blob.size);
+		}
+	}
+
+	base::free(_writer->m_allocator, temp);
+	spClose(pack);
+
+	return result;
+}
+
+void spWriterAdd(ShaderPackWriter* _writer, const char* _name, uint32_t _rendererMask, const void* _data, uint32_t _size)
+{
+	_writer->add(_name, _rendererMask, _data, _size);
+}
+
+int32_t spWriterWrite(ShaderPackWriter* _writer, base::WriterI* _fileWriter, bool _compress, base::Error* _err)
+{
+	return _writer->write(_fileWriter, _compress, _err);
+}
+
+ShaderPack* spOpen(const char* _filePath, base::AllocatorI* _allocator)
+{
+	_allocator = getAllocator(_allocator);
+
+	ShaderPack* pack = BASE_NEW(_allocator, ShaderPack);
+	if (!pack->open(_filePath, _allocator) )
+	{
+		BASE_TRACE("Failed to open shader pack '%s'.", _filePath);
+		base::deleteObject(_allocator, pack);
+		return NULL;
+	}
+
+	return pack;
+}
+
+void spClose(ShaderPack* _pack)
+{
+	// Shaders created from uncompressed binaries hold reference until renderer releases them.
+	_pack->release();
+}
+
+uint32_t spGetNumShaders(const ShaderPack* _pack)
+{
+	return _pack->m_header->numEntries;
+}
+
+graphics::ShaderHandle spCreateShader(ShaderPack* _pack, const char* _name)
+{
+	const ShaderPackEntry* entry = _pack->find(_name, spRendererMask(graphics::getRendererType() ) );
+	if (NULL == entry)
+	{
+		BASE_TRACE("Shader '%s' is not in shader pack.", _name);
+		return GRAPHICS_INVALID_HANDLE;
+	}
+
+	const ShaderPackBlob& blob = _pack->m_blob[entry->blob];
+	const uint8_t* data = _pack->getData(blob);
+
+	const graphics::Memory* mem;
+	if (blob.storedSize == blob.size)
+	{
+		base::atomicFetchAndAdd<int32_t>(&_pack->m_refCount, 1);
+		mem = graphics::makeRef(data, blob.size, NULL, ShaderPack::releaseFn, _pack);
+	}
+	else
+	{
+		base::AllocatorI* allocator = _pack->m_file.m_allocator;
+		uint8_t* inflated = (uint8_t*)base::alloc(allocator, blob.size);
+		if (!bimg::zlibInflate(inflated, blob.size, data, blob.storedSize) )
+		{
+			BASE_TRACE("Failed to inflate shader '%s'.", _name);
+			base::free(allocator, inflated);
+			return GRAPHICS_INVALID_HANDLE;
+		}
+
+		mem = graphics::makeRef(inflated, blob.size, NULL, ShaderPack::freeFn, allocator);
+	}
+
+	return graphics::createShader(mem);
+}
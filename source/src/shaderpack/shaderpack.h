@@ -0,0 +1,104 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef SHADER_PACK_H_HEADER_GUARD
+#define SHADER_PACK_H_HEADER_GUARD
+
+#include <base/allocator.h>
+#include <base/error.h>
+#include <base/readerwriter.h>
+#include <graphics/graphics.h>
+
+struct ShaderPack;
+struct ShaderPackWriter;
+
+/// Returns renderer mask bit for renderer type. Shader compiled for multiple renderers (for
+/// example SPIR-V for Vulkan and WebGPU) is added with all bits set.
+///
+inline uint32_t spRendererMask(graphics::RendererType::Enum _type)
+{
+	return UINT32_C(1) << _type;
+}
+
+/// Create shader pack writer.
+///
+/// @param[in] _allocator Allocator.
+///
+ShaderPackWriter* spWriterCreate(base::AllocatorI* _allocator = NULL);
+
+///
+void spWriterDestroy(ShaderPackWriter* _writer);
+
+/// Add all shaders from existing shader pack file. Used to add shaders to pack incrementally.
+///
+/// @param[in] _writer Shader pack writer.
+/// @param[in] _filePath Shader pack file path.
+///
+/// @returns True if shader pack was read.
+///
+bool spWriterAddPack(ShaderPackWriter* _writer, const char* _filePath);
+
+/// Add shader binary to pack. Identical binaries are stored once, and shader with same name and
+/// overlapping renderer mask replaces previously added shader for those renderers.
+///
+/// @param[in] _writer Shader pack writer.
+/// @param[in] _name Shader name.
+/// @param[in] _rendererMask Renderers binary is compiled for. See `spRendererMask`.
+/// @param[in] _data Shader binary, as written by shaderc.
+/// @param[in] _size Shader binary size.
+///
+void spWriterAdd(
+	  ShaderPackWriter* _writer
+	, const char* _name
+	, uint32_t _rendererMask
+	, const void* _data
+	, uint32_t _size
+	);
+
+/// Write shader pack.
+///
+/// @param[in] _writer Shader pack writer.
+/// @param[in] _fileWriter Writer.
+/// @param[in] _compress Compress shader binaries with zlib. Compressed binaries can't be
+///   referenced from mapped file, and are inflated when shader is created.
+/// @param[in] _err Error.
+///
+/// @returns Number of bytes written.
+///
+int32_t spWriterWrite(
+	  ShaderPackWriter* _writer
+	, base::WriterI* _fileWriter
+	, bool _compress
+	, base::Error* _err = NULL
+	);
+
+/// Open shader pack file with memory mapped reader.
+///
+/// @param[in] _filePath Shader pack file path.
+/// @param[in] _allocator Allocator.
+///
+/// @returns Shader pack, or `NULL` if file is not valid shader pack.
+///
+ShaderPack* spOpen(const char* _filePath, base::AllocatorI* _allocator = NULL);
+
+/// Close shader pack. File stays mapped until renderer consumes all shaders created from it.
+///
+void spClose(ShaderPack* _pack);
+
+/// Returns number of shaders in pack.
+///
+uint32_t spGetNumShaders(const ShaderPack* _pack);
+
+/// Create shader for current renderer from shader pack. Uncompressed binaries are passed to
+/// renderer directly from mapped file, without copy.
+///
+/// @param[in] _pack Shader pack.
+/// @param[in] _name Shader name.
+///
+/// @returns Shader handle, or invalid handle if shader is not in pack.
+///
+graphics::ShaderHandle spCreateShader(ShaderPack* _pack, const char* _name);
+
+#endif // SHADER_PACK_H_HEADER_GUARD
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include <graphics/graphics.h>
+#include <bimg/bimg.h>
+#include "texturestream.h"
+#include "../mappedfile.h"
+
+#include <base/cpu.h>
+#include <base/debug.h>
+#include <base/file.h>
+#include <base/handlealloc.h>
+#include <base/uint32_t.h>
+
+#ifndef TEXTURE_STREAM_CONFIG_MAX_TEXTURES
+#	define TEXTURE_STREAM_CONFIG_MAX_TEXTURES 1024
+#endif // TEXTURE_STREAM_CONFIG_MAX_TEXTURES
+
+struct StreamTexture
+{
+	static void releaseFn(void* _ptr, void* _userData)
+	{
+		BASE_UNUSED(_ptr);
+
+		// Called from render thread once mip data is consumed.
+		StreamTexture* texture = (StreamTexture*)_userData;
+		base::atomicFetchAndSub<int32_t>(&texture->m_pending, 1);
+	}
+
+	bool isComplete() const
+	{
+		return 0 == m_residentMip;
+	}
+
+	uint32_t uploadMip(uint8_t _mip)
+	{
+		BASE_ASSERT(_mip < m_residentMip, "Mip %d is already resident.", _mip);
+
+		uint32_t size = 0;
+
+		for (uint16_t side = 0; side < m_numSides; ++side)
+		{
+			bimg::ImageMip mip;
+			if (!bimg::imageGetRawData(m_container, side, _mip, m_file.m_data, m_file.m_size, mip) )
+			{
+				continue;
+			}
+
+			base::atomicFetchAndAdd<int32_t>(&m_pending, 1);
+			const graphics::Memory* mem = graphics::makeRef(mip.m_data, mip.m_size, NULL, releaseFn, this);
+
+			if (m_container.m_cubeMap)
+			{
+				graphics::updateTextureCube(m_handle, side/6, uint8_t(side%6), _mip, 0, 0, uint16_t(mip.m_width), uint16_t(mip.m_height), mem);
+			}
+			else if (1 < m_container.m_depth)
+			{
+				graphics::updateTexture3D(m_handle, _mip, 0, 0, 0, uint16_t(mip.m_width), uint16_t(mip.m_height), uint16_t(mip.m_depth), mem);
+			}
+			else
+			{
+				graphics::updateTexture2D(m_handle, side, _mip, 0, 0, uint16_t(mip.m_width), uint16_t(mip.m_height), mem);
+			}
+
+			size += mip.m_size;
+		}
+
+		m_residentMip   = _mip;
+		m_residentSize += size;
+
+		// Mips above resident one are not initialized yet, they must never be sampled.
+		if (0 != (graphics::getCaps()->supported & GRAPHICS_CAPS_TEXTURE_MIN_MIP) )
+		{
+			graphics::setTextureMinMip(m_handle, _mip);
+		}
+
+		return size;
+	}
+
+	MappedFile m_file;
+	bimg::ImageContainer m_container;
+	graphics::TextureHandle m_handle;
+	uint32_t m_mipSize[16];
+	uint32_t m_residentSize;
+	uint32_t m_totalSize;
+	int32_t  m_pending;
+	uint16_t m_numSides;
+	uint8_t  m_residentMip;
+	bool     m_destroyed;
+};
+
+struct TextureStreamContext
+{
+	void init(uint32_t _budget, base::AllocatorI* _allocator)
+	{
+		m_allocator = _allocator;
+		m_budget    = _budget;
+		m_cursor    = 0;
+
+		if (NULL == _allocator)
+		{
+			static base::DefaultAllocator allocator;
+			m_allocator = &allocator;
+		}
+	}
+
+	uint32_t shutdown()
+	{
+		for (uint16_t ii = 0, num = m_slotAlloc.getNumHandles(); ii < num; ++ii)
+		{
+			StreamTexture& texture = m_slot[m_slotAlloc.getHandleAt(ii)];
+			if (!texture.m_destroyed)
+			{
+				destroy(texture.m_handle);
+			}
+		}
+
+		// Mapped memory can be released only after renderer consumed all in flight updates, caller
+		// drives frames until nothing is referenced anymore.
+		release();
+
+		const uint32_t num = m_slotAlloc.getNumHandles();
+
+		if (0 == num)
+		{
+			m_lookup.reset();
+		}
+
+		return num;
+	}
+
+	// Free slots of destroyed textures once renderer doesn't reference their mapped memory.
+	void release()
+	{
+		for (uint16_t ii = 0; ii < m_slotAlloc.getNumHandles();)
+		{
+			const uint16_t slot = m_slotAlloc.getHandleAt(ii);
+			StreamTexture& texture = m_slot[slot];
+
+			if (texture.m_destroyed
+			&&  0 == base::atomicLoad<int32_t>(&texture.m_pending) )
+			{
+				texture.m_file.close();
+				m_slotAlloc.free(slot);
+				continue;
+			}
+
+			++ii;
+		}
+	}
+
+	StreamTexture* find(graphics::TextureHandle _handle)
+	{
+		const uint16_t slot = m_lookup.find(_handle.idx);
+		return base::kInvalidHandle != slot
+			? &m_slot[slot]
+			: NULL
+			;
+	}
+
+	graphics::TextureHandle create(const char* _filePath, uint64_t _flags, uint16_t _tailSize, graphics::TextureInfo* _info)
+	{
+		const uint16_t slot = m_slotAlloc.alloc();
+		if (base::kInvalidHandle == slot)
+		{
+			BASE_TRACE("Failed to allocate texture stream slot (TEXTURE_STREAM_CONFIG_MAX_TEXTURES, max: %d)."
+				, TEXTURE_STREAM_CONFIG_MAX_TEXTURES
+				);
+			return GRAPHICS_INVALID_HANDLE;
+		}
+
+		StreamTexture& texture = m_slot[slot];
+
+		if (!texture.m_file.open(_filePath, m_allocator) )
+		{
+			BASE_TRACE("Failed to open texture '%s'.", _filePath);
+			m_slotAlloc.free(slot);
+			return GRAPHICS_INVALID_HANDLE;
+		}
+
+		// Only header is touched by parsing, mip data is paged in when it's uploaded. Supercompressed
+		// levels can't be referenced from mapped file.
+		bimg::ImageContainer& container = texture.m_container;
+		if (0 != bimg::imageGetKtx2InflatedSize(texture.m_file.m_data, texture.m_file.m_size)
+		||  !bimg::imageParse(container, texture.m_file.m_data, texture.m_file.m_size)
+		||  BASE_COUNTOF(texture.m_mipSize) < container.m_numMips)
+		{
+			BASE_TRACE("Failed to parse texture '%s'.", _filePath);
+			texture.m_file.close();
+			m_slotAlloc.free(slot);
+			return GRAPHICS_INVALID_HANDLE;
+		}
+
+		const graphics::TextureFormat::Enum format = graphics::TextureFormat::Enum(container.m_format);
+		const bool hasMips = 1 < container.m_numMips;
+		_flags |= container.m_srgb ? GRAPHICS_TEXTURE_SRGB : 0;
+
+		if (NULL != _info)
+		{
+			graphics::calcTextureSize(*_info
+				, uint16_t(container.m_width)
+				, uint16_t(container.m_height)
+				, uint16_t(container.m_depth)
+				, container.m_cubeMap
+				, hasMips
+				, container.m_numLayers
+				, format
+				);
+		}
+
+		if (container.m_cubeMap)
+		{
+			texture.m_handle = graphics::createTextureCube(uint16_t(container.m_width), hasMips, container.m_numLayers, format, _flags);
+		}
+		else if (1 < container.m_depth)
+		{
+			texture.m_handle = graphics::createTexture3D(uint16_t(container.m_width), uint16_t(container.m_height), uint16_t(container.m_depth), hasMips, format, _flags);
+		}
+		else
+		{
+			texture.m_handle = graphics::createTexture2D(uint16_t(container.m_width), uint16_t(container.m_height), hasMips, container.m_numLayers, format, _flags);
+		}
+
+		if (!isValid(texture.m_handle) )
+		{
+			texture.m_file.close();
+			m_slotAlloc.free(slot);
+			return GRAPHICS_INVALID_HANDLE;
+		}
+
+		texture.m_numSides     = container.m_numLayers * (container.m_cubeMap ? 6 : 1);
+		texture.m_residentMip  = container.m_numMips;
+		texture.m_residentSize = 0;
+		texture.m_totalSize    = 0;
+		texture.m_pending      = 0;
+		texture.m_destroyed    = false;
+
+		for (uint8_t lod = 0; lod < container.m_numMips; ++lod)
+		{
+			bimg::ImageMip mip;
+			bimg::imageGetRawData(container, 0, lod, texture.m_file.m_data, texture.m_file.m_size, mip);
+			texture.m_mipSize[lod] = mip.m_size * texture.m_numSides;
+			texture.m_totalSize   += texture.m_mipSize[lod];
+		}
+
+		// Smallest mip is always uploaded, and sampling is clamped to resident mips, so that texture
+		// is never sampled uninitialized. Without min mip clamp all mips are uploaded now.
+		const bool stream = 0 != (graphics::getCaps()->supported & GRAPHICS_CAPS_TEXTURE_MIN_MIP);
+
+		do
+		{
+			texture.uploadMip(texture.m_residentMip - 1);
+		}
+		while (0 < texture.m_residentMip
+			&& (!stream || base::max(container.m_width, container.m_height) >> (texture.m_residentMip - 1) <= _tailSize)
+			);
+
+		m_lookup.insert(texture.m_handle.idx, slot);
+
+		return texture.m_handle;
+	}
+
+	void destroy(graphics::TextureHandle _handle)
+	{
+		StreamTexture* texture = find(_handle);
+		BASE_ASSERT(NULL != texture, "Texture %d is not streamed.", _handle.idx);
+
+		if (NULL != texture)
+		{
+			m_lookup.removeByKey(_handle.idx);
+			graphics::destroy(_handle);
+			texture->m_destroyed = true;
+		}
+	}
+
+	uint32_t update()
+	{
+		uint32_t budget   = m_budget;
+		uint32_t numMips  = 0;
+		uint32_t numStreaming = 0;
+
+		const uint16_t num = m_slotAlloc.getNumHandles();
+
+		for (uint16_t ii = 0; ii < num; ++ii)
+		{
+			// Start from texture which stopped streaming last time, so that budget is shared
+			// between textures.
+			const uint16_t slot = m_slotAlloc.getHandleAt( (m_cursor + ii) % num);
+			StreamTexture& texture = m_slot[slot];
+
+			if (texture.m_destroyed
+			||  texture.isComplete() )
+			{
+				if (texture.m_file.isOpen()
+				&&  0 == base::atomicLoad<int32_t>(&texture.m_pending) )
+				{
+					texture.m_file.close();
+				}
+
+				continue;
+			}
+
+			while (!texture.isComplete() )
+			{
+				const uint8_t  mip  = texture.m_residentMip - 1;
+				const uint32_t size = texture.m_mipSize[mip];
+
+				if (size > budget
+				&&  0 < numMips)
+				{
+					break;
+				}
+
+				texture.uploadMip(mip);
+				budget -= base::min(size, budget);
+				++numMips;
+			}
+
+			if (!texture.isComplete() )
+			{
+				if (0 == numStreaming)
+				{
+					m_cursor = (m_cursor + ii) % num;
+				}
+
+				++numStreaming;
+			}
+		}
+
+		release();
+
+		return numStreaming;
+	}
+
+	base::AllocatorI* m_allocator;
+	uint32_t m_budget;
+	uint16_t m_cursor;
+
+	base::HandleAllocT<TEXTURE_STREAM_CONFIG_MAX_TEXTURES> m_slotAlloc;
+	base::HandleHashMapT<TEXTURE_STREAM_CONFIG_MAX_TEXTURES*2> m_lookup;
+	StreamTexture m_slot[TEXTURE_STREAM_CONFIG_MAX_TEXTURES];
+};
+
+static TextureStreamContext s_ts;
+
+void tsInit(uint32_t _budget, base::AllocatorI* _allocator)
+{
+	s_ts.init(_budget, _allocator);
+}
+
+uint32_t tsShutdown()
+{
+	return s_ts.shutdown();
+}
+
+void tsSetBudget(uint32_t _budget)
+{
+	s_ts.m_budget = _budget;
+}
+
+graphics::TextureHandle tsCreateTexture(const char* _filePath, uint64_t _flags, uint16_t _tailSize, graphics::TextureInfo* _info)
+{
+	return s_ts.create(_filePath, _flags, _tailSize, _info);
+}
+
+void tsDestroy(graphics::TextureHandle _handle)
+{
+	s_ts.destroy(_handle);
+}
+
+uint32_t tsUpdate()
+{
+	return s_ts.update();
+}
+
+bool tsGetResidency(graphics::TextureHandle _handle, TextureStreamResidency& _residency)
+{
+	const StreamTexture* texture = s_ts.find(_handle);
+	if (NULL == texture)
+	{
+		return false;
+	}
+
+	_residency.numMips      = texture->m_container.m_numMips;
+	_residency.residentMip  = texture->m_residentMip;
+	_residency.residentSize = texture->m_residentSize;
+	_residency.totalSize    = texture->m_totalSize;
+
+	return true;
+}
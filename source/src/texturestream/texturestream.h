@@ -0,0 +1,78 @@
+/*
+ * Copyright 2011-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef TEXTURE_STREAM_H_HEADER_GUARD
+#define TEXTURE_STREAM_H_HEADER_GUARD
+
+#include <base/allocator.h>
+#include <graphics/graphics.h>
+
+/// Texture streaming residency.
+///
+struct TextureStreamResidency
+{
+	uint8_t  numMips;      //!< Number of mips in texture.
+	uint8_t  residentMip;  //!< Most detailed mip uploaded so far, sampling is clamped to it. 0 when
+	                       //!  texture is fully resident.
+	uint32_t residentSize; //!< Number of bytes uploaded so far.
+	uint32_t totalSize;    //!< Number of bytes of all mips.
+};
+
+/// Initialize texture streaming.
+///
+/// @param[in] _budget Maximum number of bytes uploaded per `tsUpdate` call. At least one mip is
+///   uploaded per call even if it's larger than budget.
+/// @param[in] _allocator Allocator.
+///
+void tsInit(uint32_t _budget, base::AllocatorI* _allocator = NULL);
+
+/// Shutdown texture streaming. Destroys all streamed textures, and releases ones which are not
+/// referenced by in flight updates anymore. Caller must call `graphics::frame` and `tsShutdown`
+/// again until it returns 0, before shutting down renderer.
+///
+/// @returns Number of textures whose mapped files are still referenced by renderer.
+///
+uint32_t tsShutdown();
+
+/// Set number of bytes uploaded per `tsUpdate` call.
+///
+void tsSetBudget(uint32_t _budget);
+
+/// Open DDS, KTX or PVR texture container with memory mapped reader, and create texture with
+/// mip tail uploaded. Remaining mips are uploaded by `tsUpdate`, from smallest to largest, and
+/// sampling is clamped to uploaded mips. When renderer doesn't support
+/// `GRAPHICS_CAPS_TEXTURE_MIN_MIP` all mips are uploaded immediately.
+///
+/// @param[in] _filePath Texture container file path.
+/// @param[in] _flags Texture creation and sampler flags. See `GRAPHICS_TEXTURE_*` and
+///   `GRAPHICS_SAMPLER_*`.
+/// @param[in] _tailSize Mips with width and height less or equal to this size are uploaded
+///   immediately.
+/// @param[out] _info When non-`NULL` is specified it returns parsed texture information.
+/// @returns Texture handle.
+///
+graphics::TextureHandle tsCreateTexture(
+	  const char* _filePath
+	, uint64_t _flags = GRAPHICS_TEXTURE_NONE|GRAPHICS_SAMPLER_NONE
+	, uint16_t _tailSize = 64
+	, graphics::TextureInfo* _info = NULL
+	);
+
+/// Stop streaming and destroy texture created with `tsCreateTexture`.
+///
+void tsDestroy(graphics::TextureHandle _handle);
+
+/// Upload pending mips within budget. Must be called once per frame, from API thread.
+///
+/// @returns Number of textures that still have mips to stream.
+///
+uint32_t tsUpdate();
+
+/// Returns residency of texture created with `tsCreateTexture`. Returns `false` if texture is not
+/// streamed.
+///
+bool tsGetResidency(graphics::TextureHandle _handle, TextureStreamResidency& _residency);
+
+#endif // TEXTURE_STREAM_H_HEADER_GUARD
@@ -4,9 +4,13 @@
  */
 
 #include <base/allocator.h>
+#include <base/cpu.h>
 #include <base/debug.h>
 #include <base/math.h>
+#include <base/semaphore.h>
+#include <base/simd_t.h>
 #include <base/sort.h>
+#include <base/thread.h>
 #include <base/uint32_t.h>
 
 #include "config.h"
@@ -272,9 +276,10 @@ namespace graphics
 		return base::max(_a, _b, _c);
 	}
 
+	// Multiplies by reciprocal, same as simdAvg3, so that scalar and SIMD keys are identical.
 	inline float favg3(float _a, float _b, float _c)
 	{
-		return (_a + _b + _c) * 1.0f/3.0f;
+		return (_a + _b + _c) * (1.0f/3.0f);
 	}
 
 	const base::Vec3 vertexPos(const void* _vertices, uint32_t _stride, uint32_t _index)
@@ -283,48 +288,366 @@ namespace graphics
 		return base::load<base::Vec3>(&vertices[_index*_stride]);
 	}
 
+	// Scalar distance functions do operations in same order as simdDistanceDir and
+	// simdDistancePos, so that scalar remainder produces same keys as SIMD path.
 	inline float distanceDir(const float* _dir, const void* _vertices, uint32_t _stride, uint32_t _index)
 	{
-		return base::dot(vertexPos(_vertices, _stride, _index), base::load<base::Vec3>(_dir) );
+		const base::Vec3 pos = vertexPos(_vertices, _stride, _index);
+		return (pos.x*_dir[0] + pos.y*_dir[1]) + pos.z*_dir[2];
 	}
 
 	inline float distancePos(const float* _pos, const void* _vertices, uint32_t _stride, uint32_t _index)
 	{
-		const base::Vec3 tmp = base::sub(base::load<base::Vec3>(_pos), vertexPos(_vertices, _stride, _index) );
-		return base::sqrt(base::dot(tmp, tmp) );
+		using namespace base;
+
+		const Vec3 pos = vertexPos(_vertices, _stride, _index);
+		const float dx = _pos[0] - pos.x;
+		const float dy = _pos[1] - pos.y;
+		const float dz = _pos[2] - pos.z;
+
+		// Square root uses same instruction as SIMD path, base::sqrt might be implemented with
+		// different precision.
+		return simd_x(simd_sqrt(simd_splat<simd128_t>( (dx*dx + dy*dy) + dz*dz) ) );
+	}
+
+	inline base::simd128_t simdMin3(base::simd128_t _a, base::simd128_t _b, base::simd128_t _c)
+	{
+		return base::simd_min(base::simd_min(_a, _b), _c);
+	}
+
+	inline base::simd128_t simdMax3(base::simd128_t _a, base::simd128_t _b, base::simd128_t _c)
+	{
+		return base::simd_max(base::simd_max(_a, _b), _c);
+	}
+
+	inline base::simd128_t simdAvg3(base::simd128_t _a, base::simd128_t _b, base::simd128_t _c)
+	{
+		return base::simd_mul(base::simd_add(base::simd_add(_a, _b), _c), base::simd_splat<base::simd128_t>(1.0f/3.0f) );
+	}
+
+	// Positions of four vertices in SoA form.
+	struct SimdPos
+	{
+		base::simd128_t x, y, z;
+	};
+
+	inline SimdPos simdVertexPos(const void* _vertices, uint32_t _stride, const uint32_t* _index)
+	{
+		const base::Vec3 p0 = vertexPos(_vertices, _stride, _index[0]);
+		const base::Vec3 p1 = vertexPos(_vertices, _stride, _index[1]);
+		const base::Vec3 p2 = vertexPos(_vertices, _stride, _index[2]);
+		const base::Vec3 p3 = vertexPos(_vertices, _stride, _index[3]);
+
+		SimdPos result;
+		result.x = base::simd_ld<base::simd128_t>(p0.x, p1.x, p2.x, p3.x);
+		result.y = base::simd_ld<base::simd128_t>(p0.y, p1.y, p2.y, p3.y);
+		result.z = base::simd_ld<base::simd128_t>(p0.z, p1.z, p2.z, p3.z);
+		return result;
+	}
+
+	inline base::simd128_t simdDistanceDir(const SimdPos& _dirOrPos, const SimdPos& _pos)
+	{
+		using namespace base;
+		const simd128_t xx = simd_mul(_pos.x, _dirOrPos.x);
+		const simd128_t yy = simd_mul(_pos.y, _dirOrPos.y);
+		const simd128_t zz = simd_mul(_pos.z, _dirOrPos.z);
+		return simd_add(simd_add(xx, yy), zz);
+	}
+
+	inline base::simd128_t simdDistancePos(const SimdPos& _dirOrPos, const SimdPos& _pos)
+	{
+		using namespace base;
+		const simd128_t dx = simd_sub(_dirOrPos.x, _pos.x);
+		const simd128_t dy = simd_sub(_dirOrPos.y, _pos.y);
+		const simd128_t dz = simd_sub(_dirOrPos.z, _pos.z);
+		const simd128_t xx = simd_mul(dx, dx);
+		const simd128_t yy = simd_mul(dy, dy);
+		const simd128_t zz = simd_mul(dz, dz);
+		return simd_sqrt(simd_add(simd_add(xx, yy), zz) );
 	}
 
 	typedef float (*KeyFn)(float, float, float);
 	typedef float (*DistanceFn)(const float*, const void*, uint32_t, uint32_t);
+	typedef base::simd128_t (*SimdKeyFn)(base::simd128_t, base::simd128_t, base::simd128_t);
+	typedef base::simd128_t (*SimdDistanceFn)(const SimdPos&, const SimdPos&);
 
-	template<typename IndexT, DistanceFn dfn, KeyFn kfn, uint32_t xorBits>
-	inline void calcSortKeys(
+	// Computes sort keys for triangles `_values[_begin, _end)`. Four triangles are processed at
+	// the time with SIMD, the remainder with scalar code. Both paths produce identical keys.
+	template<typename IndexT, DistanceFn dfn, KeyFn kfn, SimdDistanceFn sdfn, SimdKeyFn skfn, uint32_t xorBits>
+	void calcSortKeys(
 		  uint32_t* _keys
-		, uint32_t* _values
+		, const uint32_t* _values
 		, const float _dirOrPos[3]
 		, const void* _vertices
 		, uint32_t _stride
-		, const IndexT* _indices
-		, uint32_t _num
+		, const void* _indices
+		, uint32_t _begin
+		, uint32_t _end
 		)
 	{
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		using namespace base;
+
+		const IndexT* indices = (const IndexT*)_indices;
+
+		SimdPos dirOrPos;
+		dirOrPos.x = simd_splat<simd128_t>(_dirOrPos[0]);
+		dirOrPos.y = simd_splat<simd128_t>(_dirOrPos[1]);
+		dirOrPos.z = simd_splat<simd128_t>(_dirOrPos[2]);
+
+		const simd128_t signBit = simd_isplat<simd128_t>(UINT32_C(0x80000000) );
+		const simd128_t xorMask = simd_isplat<simd128_t>(xorBits);
+
+		uint32_t ii = _begin;
+
+		for (const uint32_t end = _begin + ( (_end - _begin) & ~UINT32_C(3) ); ii < end; ii += 4)
 		{
-			const uint32_t idx0 = _indices[0];
-			const uint32_t idx1 = _indices[1];
-			const uint32_t idx2 = _indices[2];
-			_indices += 3;
+			uint32_t idx[3][4];
+
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				const IndexT* tri = &indices[_values[ii+jj]*3];
+				idx[0][jj] = tri[0];
+				idx[1][jj] = tri[1];
+				idx[2][jj] = tri[2];
+			}
+
+			const simd128_t distance0 = sdfn(dirOrPos, simdVertexPos(_vertices, _stride, idx[0]) );
+			const simd128_t distance1 = sdfn(dirOrPos, simdVertexPos(_vertices, _stride, idx[1]) );
+			const simd128_t distance2 = sdfn(dirOrPos, simdVertexPos(_vertices, _stride, idx[2]) );
 
-			float distance0 = dfn(_dirOrPos, _vertices, _stride, idx0);
-			float distance1 = dfn(_dirOrPos, _vertices, _stride, idx1);
-			float distance2 = dfn(_dirOrPos, _vertices, _stride, idx2);
+			// Same as floatFlip: negative floats flip all bits, positive floats flip sign bit.
+			const simd128_t key  = skfn(distance0, distance1, distance2);
+			const simd128_t mask = simd_or(simd_sra(key, 31), signBit);
+			simd_st(&_keys[ii], simd_xor(simd_xor(key, mask), xorMask) );
+		}
+
+		for (; ii < _end; ++ii)
+		{
+			const IndexT* tri = &indices[_values[ii]*3];
+
+			float distance0 = dfn(_dirOrPos, _vertices, _stride, tri[0]);
+			float distance1 = dfn(_dirOrPos, _vertices, _stride, tri[1]);
+			float distance2 = dfn(_dirOrPos, _vertices, _stride, tri[2]);
 
 			uint32_t ui = base::floatToBits(kfn(distance0, distance1, distance2) );
 			_keys[ii]   = base::floatFlip(ui) ^ xorBits;
-			_values[ii] = ii;
 		}
 	}
 
+	typedef void (*CalcSortKeysFn)(uint32_t*, const uint32_t*, const float*, const void*, uint32_t, const void*, uint32_t, uint32_t);
+
+	template<typename IndexT>
+	CalcSortKeysFn getCalcSortKeysFn(TopologySort::Enum _sort)
+	{
+		static const CalcSortKeysFn s_calcSortKeys[] =
+		{
+			calcSortKeys<IndexT, distanceDir, fmin3, simdDistanceDir, simdMin3, 0         >, // DirectionFrontToBackMin
+			calcSortKeys<IndexT, distanceDir, favg3, simdDistanceDir, simdAvg3, 0         >, // DirectionFrontToBackAvg
+			calcSortKeys<IndexT, distanceDir, fmax3, simdDistanceDir, simdMax3, 0         >, // DirectionFrontToBackMax
+			calcSortKeys<IndexT, distanceDir, fmin3, simdDistanceDir, simdMin3, UINT32_MAX>, // DirectionBackToFrontMin
+			calcSortKeys<IndexT, distanceDir, favg3, simdDistanceDir, simdAvg3, UINT32_MAX>, // DirectionBackToFrontAvg
+			calcSortKeys<IndexT, distanceDir, fmax3, simdDistanceDir, simdMax3, UINT32_MAX>, // DirectionBackToFrontMax
+			calcSortKeys<IndexT, distancePos, fmin3, simdDistancePos, simdMin3, 0         >, // DistanceFrontToBackMin
+			calcSortKeys<IndexT, distancePos, favg3, simdDistancePos, simdAvg3, 0         >, // DistanceFrontToBackAvg
+			calcSortKeys<IndexT, distancePos, fmax3, simdDistancePos, simdMax3, 0         >, // DistanceFrontToBackMax
+			calcSortKeys<IndexT, distancePos, fmin3, simdDistancePos, simdMin3, UINT32_MAX>, // DistanceBackToFrontMin
+			calcSortKeys<IndexT, distancePos, favg3, simdDistancePos, simdAvg3, UINT32_MAX>, // DistanceBackToFrontAvg
+			calcSortKeys<IndexT, distancePos, fmax3, simdDistancePos, simdMax3, UINT32_MAX>, // DistanceBackToFrontMax
+		};
+		BASE_STATIC_ASSERT(BASE_COUNTOF(s_calcSortKeys) == TopologySort::Count);
+
+		return s_calcSortKeys[_sort < TopologySort::Count ? _sort : TopologySort::DirectionFrontToBackMin];
+	}
+
+	struct CalcSortKeysJob
+	{
+		void exec() const
+		{
+			fn(keys, values, dirOrPos, vertices, stride, indices, begin, end);
+		}
+
+		CalcSortKeysFn  fn;
+		uint32_t*       keys;
+		const uint32_t* values;
+		const float*    dirOrPos;
+		const void*     vertices;
+		uint32_t        stride;
+		const void*     indices;
+		uint32_t        begin;
+		uint32_t        end;
+	};
+
+	struct TopologySortWorker
+	{
+		static int32_t threadFunc(base::Thread* _thread, void* _userData);
+
+		base::Thread    m_thread;
+		base::Semaphore m_start;
+		base::Semaphore m_done;
+		CalcSortKeysJob m_job;
+		bool            m_exit;
+	};
+
+	int32_t TopologySortWorker::threadFunc(base::Thread* _thread, void* _userData)
+	{
+		BASE_UNUSED(_thread);
+
+		TopologySortWorker* worker = (TopologySortWorker*)_userData;
+
+		for (;;)
+		{
+			worker->m_start.wait();
+
+			if (worker->m_exit)
+			{
+				break;
+			}
+
+			worker->m_job.exec();
+			worker->m_done.post();
+		}
+
+		return 0;
+	}
+
+	struct TopologySortWorkers
+	{
+		base::AllocatorI*   m_allocator;
+		TopologySortWorker* m_worker;
+		uint32_t            m_num;
+		int32_t             m_busy;
+	};
+
+	static TopologySortWorkers s_topologySortWorkers;
+
+	void topologySortInit(uint32_t _numThreads, base::AllocatorI* _allocator)
+	{
+		TopologySortWorkers& workers = s_topologySortWorkers;
+		BASE_ASSERT(0 == workers.m_num, "Topology sort workers are already initialized.");
+
+		workers.m_allocator = _allocator;
+		workers.m_num       = 0;
+		workers.m_busy      = 0;
+		workers.m_worker    = NULL;
+
+		if (0 == _numThreads)
+		{
+			return;
+		}
+
+		workers.m_worker = (TopologySortWorker*)base::alloc(_allocator, sizeof(TopologySortWorker)*_numThreads);
+
+		for (uint32_t ii = 0; ii < _numThreads; ++ii)
+		{
+			TopologySortWorker* worker = BASE_PLACEMENT_NEW(&workers.m_worker[ii], TopologySortWorker);
+			worker->m_exit = false;
+			worker->m_thread.init(TopologySortWorker::threadFunc, worker, 0, "graphics - topology sort");
+		}
+
+		workers.m_num = _numThreads;
+	}
+
+	void topologySortShutdown()
+	{
+		TopologySortWorkers& workers = s_topologySortWorkers;
+
+		for (uint32_t ii = 0; ii < workers.m_num; ++ii)
+		{
+			TopologySortWorker& worker = workers.m_worker[ii];
+			worker.m_exit = true;
+			worker.m_start.post();
+			worker.m_thread.shutdown();
+			worker.~TopologySortWorker();
+		}
+
+		if (NULL != workers.m_worker)
+		{
+			base::free(workers.m_allocator, workers.m_worker);
+			workers.m_worker = NULL;
+		}
+
+		workers.m_num = 0;
+	}
+
+	// Splits key generation across topology sort workers and calling thread. Falls back to calling
+	// thread only when there are no workers, mesh is small, or workers are used by another call.
+	static void calcSortKeys(const CalcSortKeysJob& _job)
+	{
+		TopologySortWorkers& workers = s_topologySortWorkers;
+
+		const uint32_t num        = _job.end - _job.begin;
+		const uint32_t numThreads = base::min(workers.m_num + 1, num / GRAPHICS_CONFIG_TOPOLOGY_SORT_MIN_TRIANGLES_PER_THREAD);
+
+		if (1 >= numThreads
+		||  0 != base::atomicCompareAndSwap<int32_t>(&workers.m_busy, 0, 1) )
+		{
+			_job.exec();
+			return;
+		}
+
+		// Keep ranges multiple of 4 so that only last range has scalar remainder.
+		const uint32_t perThread = base::alignUp( (num + numThreads - 1) / numThreads, 4);
+
+		for (uint32_t ii = 0; ii < numThreads-1; ++ii)
+		{
+			TopologySortWorker& worker = workers.m_worker[ii];
+			worker.m_job       = _job;
+			worker.m_job.begin = base::min(_job.begin + (ii+1)*perThread, _job.end);
+			worker.m_job.end   = base::min(worker.m_job.begin + perThread,  _job.end);
+			worker.m_start.post();
+		}
+
+		CalcSortKeysJob job = _job;
+		job.end = base::min(_job.begin + perThread, _job.end);
+		job.exec();
+
+		for (uint32_t ii = 0; ii < numThreads-1; ++ii)
+		{
+			workers.m_worker[ii].m_done.wait();
+		}
+
+		base::atomicExchange<int32_t>(&workers.m_busy, 0);
+	}
+
+	// Insertion sort of nearly sorted keys. Gives up when number of element moves exceeds
+	// `_maxMoves`, leaving a valid but only partially sorted permutation.
+	static bool insertionSort(uint32_t* _keys, uint32_t* _values, uint32_t _num, uint32_t _maxMoves)
+	{
+		uint32_t numMoves = 0;
+
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const uint32_t key = _keys[ii];
+
+			if (_keys[ii-1] <= key)
+			{
+				continue;
+			}
+
+			const uint32_t value = _values[ii];
+
+			uint32_t jj = ii;
+			do
+			{
+				_keys[jj]   = _keys[jj-1];
+				_values[jj] = _values[jj-1];
+				--jj;
+			}
+			while (0 < jj && _keys[jj-1] > key);
+
+			_keys[jj]   = key;
+			_values[jj] = value;
+
+			numMoves += ii - jj;
+			if (numMoves > _maxMoves)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	template<typename IndexT>
 	void topologySortTriList(
 		  TopologySort::Enum  _sort
@@ -339,28 +662,52 @@ namespace graphics
 		, const void* _vertices
 		, uint32_t    _stride
 		, const IndexT* _indices
+		, uint32_t*   _order
 		)
 	{
 		using namespace base;
 
-		switch (_sort)
+		// When previous order is available keys are generated in that order. With slowly moving
+		// view they are nearly sorted, and insertion sort is cheaper than radix sort from scratch.
+		const bool incremental = true
+			&& NULL != _order
+			&& UINT32_MAX != _order[0]
+			;
+
+		if (incremental)
 		{
-		default:
-		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		}
-
-		radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+			memCopy(_values, _order, _num*sizeof(uint32_t) );
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_values[ii] = ii;
+			}
+		}
+
+		CalcSortKeysJob job;
+		job.fn       = getCalcSortKeysFn<IndexT>(_sort);
+		job.keys     = _keys;
+		job.values   = _values;
+		job.dirOrPos = _sort >= TopologySort::DistanceFrontToBackMin && _sort < TopologySort::Count ? _pos : _dir;
+		job.vertices = _vertices;
+		job.stride   = _stride;
+		job.indices  = _indices;
+		job.begin    = 0;
+		job.end      = _num;
+		calcSortKeys(job);
+
+		if (!incremental
+		||  !insertionSort(_keys, _values, _num, _num*GRAPHICS_CONFIG_TOPOLOGY_SORT_MAX_MOVES_PER_TRIANGLE) )
+		{
+			radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+		}
+
+		if (NULL != _order)
+		{
+			memCopy(_order, _values, _num*sizeof(uint32_t) );
+		}
 
 		IndexT* sorted = _dst;
 
@@ -390,6 +737,7 @@ namespace graphics
 		, uint32_t    _numIndices
 		, bool        _index32
 		, base::AllocatorI* _allocator
+		, uint32_t*   _order
 		)
 	{
 		uint32_t indexSize = _index32
@@ -397,7 +745,14 @@ namespace graphics
 			: sizeof(uint16_t)
 			;
 		uint32_t  num  = base::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
-		uint32_t* temp = (uint32_t*)base::alloc(_allocator, sizeof(uint32_t)*num*4);
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		// Keys are stored with aligned SIMD stores.
+		uint32_t* temp = (uint32_t*)base::alloc(_allocator, sizeof(uint32_t)*num*4, 16);
 
 		uint32_t* keys       = &temp[num*0];
 		uint32_t* values     = &temp[num*1];
@@ -419,6 +774,7 @@ namespace graphics
 					, _vertices
 					, _stride
 					, (const uint32_t*)_indices
+					, _order
 					);
 		}
 		else
@@ -436,10 +792,67 @@ namespace graphics
 					, _vertices
 					, _stride
 					, (const uint16_t*)_indices
+					, _order
 					);
 		}
 
-		base::free(_allocator, temp);
+		base::free(_allocator, temp, 16);
+	}
+
+	void topologyCalcSortKeys(
+		  uint32_t*   _keys
+		, TopologySort::Enum _sort
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t    _stride
+		, const void* _indices
+		, uint32_t    _numIndices
+		, bool        _index32
+		, bool        _scalar
+		, base::AllocatorI* _allocator
+		)
+	{
+		const uint32_t num = _numIndices/3;
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		// Keys are stored with aligned SIMD stores.
+		uint32_t* temp = (uint32_t*)base::alloc(_allocator, sizeof(uint32_t)*num*2, 16);
+
+		uint32_t* keys   = &temp[num*0];
+		uint32_t* values = &temp[num*1];
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			values[ii] = ii;
+		}
+
+		const CalcSortKeysFn fn = _index32
+			? getCalcSortKeysFn<uint32_t>(_sort)
+			: getCalcSortKeysFn<uint16_t>(_sort)
+			;
+		const float* dirOrPos = _sort >= TopologySort::DistanceFrontToBackMin && _sort < TopologySort::Count ? _pos : _dir;
+
+		if (_scalar)
+		{
+			// Ranges shorter than 4 triangles are handled by scalar remainder only.
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				fn(keys, values, dirOrPos, _vertices, _stride, _indices, ii, ii+1);
+			}
+		}
+		else
+		{
+			fn(keys, values, dirOrPos, _vertices, _stride, _indices, 0, num);
+		}
+
+		base::memCopy(_keys, keys, num*sizeof(uint32_t) );
+
+		base::free(_allocator, temp, 16);
 	}
 
 } //namespace graphics
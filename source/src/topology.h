@@ -36,6 +36,10 @@ namespace graphics
 		, base::AllocatorI* _allocator
 		);
 
+	/// Sort triangle list indices, see `graphics::topologySortTriList`.
+	///
+	/// @param[inout] _order Optional triangle order from previous call, see
+	///    `graphics::topologySortTriList`.
 	///
 	void topologySortTriList(
 		  TopologySort::Enum _sort
@@ -49,8 +53,42 @@ namespace graphics
 		, uint32_t _numIndices
 		, bool _index32
 		, base::AllocatorI* _allocator
+		, uint32_t* _order = NULL
+		);
+
+	/// Compute triangle sort keys used by `topologySortTriList`, one key per triangle in index
+	/// buffer order. Used to check that SIMD key generation matches scalar one.
+	///
+	/// @param[out] _keys Sort keys, must be large enough for `_numIndices/3` keys.
+	/// @param[in] _scalar When true, keys are computed with scalar code only, otherwise four
+	///    triangles at the time with SIMD, and remainder with scalar code.
+	///
+	void topologyCalcSortKeys(
+		  uint32_t* _keys
+		, TopologySort::Enum _sort
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, bool _scalar
+		, base::AllocatorI* _allocator
 		);
 
+	/// Start worker threads used for sort key generation by `topologySortTriList`.
+	///
+	/// @param[in] _numThreads Number of worker threads. When 0, keys are generated on calling
+	///    thread only.
+	/// @param[in] _allocator Allocator.
+	///
+	void topologySortInit(uint32_t _numThreads, base::AllocatorI* _allocator);
+
+	/// Stop topology sort worker threads.
+	///
+	void topologySortShutdown();
+
 } // namespace graphics
 
 #endif // GRAPHICS_TOPOLOGY_H_HEADER_GUARD